@@ -0,0 +1,140 @@
+#!/bin/bash
+###############################################################################
+# Crash test of character database write-behind journal (CharacterDatabaseJournal)
+#
+# - starts mangosd, console commands are fed by fifo
+# - locks `mail` table from own MySQL session, so character DB async writes stall
+# - queues #count money mails to character (each mail is new `mail` row)
+# - kills mangosd (SIGKILL) with the mails still queued, then releases the lock
+# - starts mangosd again and checks that journal replay created exactly #count mails
+#
+# Usage: sqljournal_crashtest.sh mangosd_binary mangosd_conf character_name [count]
+# mangosd_conf must have CharacterDatabaseJournal set and Console.Enable = 1,
+# `sql_journal` table must exist in character database.
+###############################################################################
+mangosd=$1
+mangosConf=$2
+charName=$3
+count=${4:-100}
+startTimeout=600                                            # seconds for world load
+queueWait=10                                                # seconds for console commands to be queued
+
+if [ -z "$mangosd" ] || [ -z "$mangosConf" ] || [ -z "$charName" ]; then
+    echo "Usage: $0 mangosd_binary mangosd_conf character_name [count]"
+    exit 2
+fi
+
+workDir=$(mktemp -d)
+fifo=$workDir"/console"
+log=$workDir"/mangosd.log"
+mangosdPid=""
+lockPid=""
+
+# functions
+function cleanup()
+{
+    [ -n "$mangosdPid" ] && kill -9 $mangosdPid 2>/dev/null
+    [ -n "$lockPid" ] && kill $lockPid 2>/dev/null
+    exec 3>&- 2>/dev/null
+    rm -rf $workDir
+}
+
+function fail()
+{
+    echo "FAIL: $1"
+    echo "mangosd output: $log"
+    trap - EXIT
+    [ -n "$mangosdPid" ] && kill -9 $mangosdPid 2>/dev/null
+    [ -n "$lockPid" ] && kill $lockPid 2>/dev/null
+    exit 1
+}
+
+function conf_value()
+{
+    echo `cat $mangosConf|grep "^"$1" *="|sed 's/^.*= *//'|sed 's/\"//g'|sed 's/\r//g'`
+}
+
+function db_exec()
+{
+    mysql --host=$dbHost --port=$dbPort --user=$dbUser --password=$dbPass --database=$dbName --batch --silent --execute "$1"
+}
+
+function start_mangosd()
+{
+    rm -f $fifo
+    mkfifo $fifo
+    $mangosd -c $mangosConf <$fifo >$log 2>&1 &
+    mangosdPid=$!
+    exec 3>$fifo                                            # keep console open, EOF stops server
+
+    local waited=0
+    while ! grep -q "WORLD: World initialized" $log; do
+        kill -0 $mangosdPid 2>/dev/null || fail "mangosd exited at start"
+        [ $waited -ge $startTimeout ] && fail "mangosd not started in $startTimeout seconds"
+        sleep 1
+        waited=$((waited + 1))
+    done
+}
+
+trap cleanup EXIT
+
+journal=$(conf_value CharacterDatabaseJournal)
+[ -z "$journal" ] && fail "CharacterDatabaseJournal not set in $mangosConf"
+
+IFS=';' read dbHost dbPort dbUser dbPass dbName <<< "$(conf_value CharacterDatabaseInfo)"
+[ "$dbPort" = "." ] && dbPort=3306
+
+charGuid=$(db_exec "SELECT guid FROM characters WHERE name = '$charName'")
+[ -z "$charGuid" ] && fail "character $charName not found"
+
+subject="journaltest"$(date +%s)
+
+# first run, crash with queued writes
+start_mangosd
+echo "mangosd started, stalling character DB writes to mail table"
+
+mysql --host=$dbHost --port=$dbPort --user=$dbUser --password=$dbPass --database=$dbName \
+    --execute "LOCK TABLES mail WRITE; SELECT SLEEP($startTimeout);" >/dev/null 2>&1 &
+lockPid=$!
+sleep 2
+
+# one by one, console polls stdin before reading each line
+for ((i = 0; i < count; ++i)); do
+    echo "send money $charName \"$subject\" \"journal crash test\" 1" >&3
+    sleep 0.1
+done
+
+sleep $queueWait
+kill -9 $mangosdPid
+wait $mangosdPid 2>/dev/null
+mangosdPid=""
+exec 3>&-
+
+kill $lockPid 2>/dev/null
+wait $lockPid 2>/dev/null
+lockPid=""
+
+sent=$(grep -c "Mail sent to" $log)
+early=$(db_exec "SELECT COUNT(*) FROM mail WHERE receiver = $charGuid AND subject = '$subject'")
+echo "mangosd killed: $sent of $count mails queued, $early in DB before replay"
+[ "$sent" -ne "$count" ] && fail "not all mails queued in $queueWait seconds"
+[ "$early" -ne 0 ] && fail "stalled writes reached DB before kill"
+
+# second run, journal replay before world load
+start_mangosd
+replayLine=$(grep "SqlJournal: .* records replayed" $log)
+echo "$replayLine"
+
+exec 3>&-                                                   # console EOF stops server
+wait $mangosdPid 2>/dev/null
+mangosdPid=""
+
+mails=$(db_exec "SELECT COUNT(*) FROM mail WHERE receiver = $charGuid AND subject = '$subject'")
+money=$(db_exec "SELECT SUM(money) FROM mail WHERE receiver = $charGuid AND subject = '$subject'")
+db_exec "DELETE FROM mail WHERE receiver = $charGuid AND subject = '$subject'"
+
+[ "$mails" -ne "$count" ] && fail "expected $count mails after replay, found $mails"
+[ "$money" -ne "$count" ] && fail "expected $count money in mails after replay, found $money"
+
+echo "OK: $mails mails replayed from journal $journal"
+exit 0
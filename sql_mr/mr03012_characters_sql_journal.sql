@@ -0,0 +1,8 @@
+-- Last character database write-behind journal sequence applied
+
+DROP TABLE IF EXISTS `sql_journal`;
+CREATE TABLE `sql_journal` (
+  `sequence` bigint(20) unsigned NOT NULL DEFAULT '0'
+) ENGINE=InnoDB DEFAULT CHARSET=utf8 COMMENT='Write-behind journal state';
+
+INSERT INTO `sql_journal` VALUES (0);
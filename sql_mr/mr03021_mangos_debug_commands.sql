@@ -0,0 +1,20 @@
+-- Debug statistics and benchmark commands
+
+DELETE FROM `command` WHERE `name` IN ('debug loscache', 'debug playerlookup', 'debug worldstateupdate', 'debug sqlread', 'debug playersave', 'debug spellbench',
+    'debug eventbench', 'debug gridbench', 'debug mapstorebench', 'debug dormancy', 'debug loadbench', 'debug opcodestats');
+
+INSERT INTO `command`
+    (`name`, `security`, `help`)
+VALUES
+    ('debug loscache',3,'Syntax: .debug loscache\r\nShow line of sight cache statistic (entries, hit rate, invalidations) for current map.'),
+    ('debug playerlookup',4,'Syntax: .debug playerlookup [#threads [#lookups]]\r\nRun online player lookups by guid and by name in #threads threads (default 4), #lookups per thread (default 100000), in parallel to world update. Lookup rate is written to server log when done.'),
+    ('debug worldstateupdate',3,'Syntax: .debug worldstateupdate [#players]\r\nMeasure time of WorldState update lookups for #players (default 3000) players at your position: full states scan versus change journal.'),
+    ('debug sqlread',4,'Syntax: .debug sqlread $playername [#loops]\r\nMeasure time of character login queries for character $playername (#loops times, default 100) and of creature spawns query, fetched as text results versus binary prepared statement results. Runs in parallel to world update, times are written to server log when done.'),
+    ('debug playersave',3,'Syntax: .debug playersave\r\nShow number of player save sections (characters row rarely changed columns, auras, spell cooldowns) written and skipped as unchanged since last save, with statements and bytes of values written and skipped.'),
+    ('debug spellbench',4,'Syntax: .debug spellbench [#count]\r\nMeasure #count (default 10) passes over all spells of derived data (proc events, bonus data, range, spell specific, positive check) lookups from precomputed table and calculation of same data. Runs in parallel to world update, times are written to server log when done.'),
+    ('debug eventbench',4,'Syntax: .debug eventbench [#objects [#updates]]\r\nMeasure object event scheduling for #objects (default 10000) event processors updated #updates (default 100) times, with 2 events added per object update. Compare old multimap scheduling, timing wheel and timing wheel with pooled event memory. Runs in parallel to world update, times are written to server log when done.'),
+    ('debug gridbench',4,'Syntax: .debug gridbench $playername [#range [#queries]]\r\nRun #queries (default 10000) unit range searches in #range yards (default 30) around online player $playername, by walking cell object lists and by cell position index filter. Searches are done by next update of player map, times are written to server log.'),
+    ('debug mapstorebench',4,'Syntax: .debug mapstorebench $playername [#passes]\r\nRepeat #passes (default 1000) times the object guid lookups done by one update of map of online player $playername (active objects and all stored objects) with old UNORDERED_MAP store copy, with map slot store by guid and with slot store handles. Lookups are done by next update of that map, times are written to server log.'),
+    ('debug dormancy',3,'Syntax: .debug dormancy\r\nShow state of creature dormancy (Creature.Dormancy.Enable), count of dormant creatures in your current map and average time of object updates in active cells of map since previous command use.'),
+    ('debug loadbench',4,'Syntax: .debug loadbench [stop | $master city|quest|bg|raid #bots #seconds [#seed]]\r\nWithout arguments show state of load benchmark. Otherwise login up to #bots offline characters as playerbots of online player $master, place and drive them by pattern (raid pattern needs creature selected by $master as target) with random generator initialized by #seed (1 by default), and measure world update for #seconds. Bot characters are not saved. Report is written as JSON file into LogsDir. Use stop to finish benchmark early.'),
+    ('debug opcodestats',3,'Syntax: .debug opcodestats [#count | reset]\r\nShow #count (10 by default) opcode handlers with biggest total execution time: processing thread (world or map), calls, total, average and max time. Use reset to clear collected statistics.');
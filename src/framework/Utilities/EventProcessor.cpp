@@ -18,10 +18,23 @@
 
 #include "EventProcessor.h"
 
+#include <string.h>
+
+#define EVENT_WHEEL_SLOT_MASK       (EVENT_WHEEL_SLOTS - 1)
+
+ACE_Atomic_Op<ACE_Thread_Mutex, long> EventAllocatorStats::ms_heapBlocks(0);
+ACE_Atomic_Op<ACE_Thread_Mutex, long> EventAllocatorStats::ms_heapBytes(0);
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+    m_tick = 0;
+    m_addCounter = 0;
+    m_eventCount = 0;
+    memset(m_levelCount, 0, sizeof(m_levelCount));
+    memset(m_wheel, 0, sizeof(m_wheel));
+    m_overflow = NULL;
 }
 
 EventProcessor::~EventProcessor()
@@ -34,27 +47,52 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
-    {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+    uint64 targetTick = m_time >> EVENT_WHEEL_TICK_BITS;
 
-        if (!Event->to_Abort)
+    for (;;)
+    {
+        // main event loop, events added by executed events for passed time also executed
+        BasicEvent*& slot = m_wheel[0][m_tick & EVENT_WHEEL_SLOT_MASK];
+        while (slot && slot->m_execTime <= m_time)
         {
-            if (Event->Execute(m_time, p_time))
+            // get and remove event from queue
+            BasicEvent* Event = slot;
+            slot = Event->m_nextEvent;
+            Event->m_nextEvent = NULL;
+            --m_levelCount[0];
+            --m_eventCount;
+
+            if (!Event->to_Abort)
+            {
+                if (Event->Execute(m_time, p_time))
+                {
+                    // completely destroy event if it is not re-added
+                    delete Event;
+                }
+            }
+            else
             {
-                // completely destroy event if it is not re-added
+                Event->Abort(m_time);
                 delete Event;
             }
         }
-        else
-        {
-            Event->Abort(m_time);
-            delete Event;
-        }
+
+        if (m_tick >= targetTick)
+            break;
+
+        m_tick = GetNextTick(targetTick);
+
+        // higher levels with slot range started at new tick
+        uint32 levels = 0;
+        while (levels < EVENT_WHEEL_LEVELS && !(m_tick & ((uint64(1) << ((levels + 1) * EVENT_WHEEL_SLOT_BITS)) - 1)))
+            ++levels;
+
+        // move events to lower levels, from highest level
+        if (levels == EVENT_WHEEL_LEVELS)
+            Cascade(m_overflow, EVENT_WHEEL_LEVELS);
+
+        for (uint32 level = levels < EVENT_WHEEL_LEVELS ? levels : EVENT_WHEEL_LEVELS - 1; level > 0; --level)
+            Cascade(m_wheel[level][(m_tick >> (level * EVENT_WHEEL_SLOT_BITS)) & EVENT_WHEEL_SLOT_MASK], level);
     }
 }
 
@@ -64,25 +102,30 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
-    {
-        EventList::iterator i_old = i;
-        ++i;
+    for (uint32 level = 0; level < EVENT_WHEEL_LEVELS; ++level)
+        for (uint32 i = 0; i < EVENT_WHEEL_SLOTS; ++i)
+            KillEvents(m_wheel[level][i], level, force);
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
-        {
-            delete i_old->second;
+    KillEvents(m_overflow, EVENT_WHEEL_LEVELS, force);
+}
 
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
+void EventProcessor::KillEvents(BasicEvent*& list, uint32 level, bool force)
+{
+    BasicEvent** pos = &list;
+    while (BasicEvent* Event = *pos)
+    {
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
+        {
+            *pos = Event->m_nextEvent;                      // need per-element cleanup
+            --m_levelCount[level];
+            --m_eventCount;
+            delete Event;
         }
+        else
+            pos = &Event->m_nextEvent;
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -91,7 +134,102 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    InsertEvent(Event);
+}
+
+void EventProcessor::InsertEvent(BasicEvent* Event)
+{
+    Event->m_addOrder = m_addCounter++;
+    LinkEvent(Event);
+}
+
+void EventProcessor::LinkEvent(BasicEvent* Event)
+{
+    uint32 level;
+    BasicEvent*& slot = GetSlot(Event->m_execTime >> EVENT_WHEEL_TICK_BITS, level);
+
+    if (level == 0)
+    {
+        // executed in time order, same time events in adding order
+        BasicEvent** pos = &slot;
+        while (*pos && ((*pos)->m_execTime < Event->m_execTime ||
+                ((*pos)->m_execTime == Event->m_execTime && int32((*pos)->m_addOrder - Event->m_addOrder) < 0)))
+            pos = &(*pos)->m_nextEvent;
+
+        Event->m_nextEvent = *pos;
+        *pos = Event;
+    }
+    else
+    {
+        // sorted only at move to level 0
+        Event->m_nextEvent = slot;
+        slot = Event;
+    }
+
+    ++m_levelCount[level];
+    ++m_eventCount;
+}
+
+BasicEvent*& EventProcessor::GetSlot(uint64 tick, uint32& level)
+{
+    // passed time events executed at current tick
+    if (tick < m_tick)
+        tick = m_tick;
+
+    uint64 delta = tick - m_tick;
+    for (level = 0; level < EVENT_WHEEL_LEVELS; ++level)
+    {
+        uint32 shift = level * EVENT_WHEEL_SLOT_BITS;
+        if (delta < (uint64(1) << (shift + EVENT_WHEEL_SLOT_BITS)))
+            return m_wheel[level][(tick >> shift) & EVENT_WHEEL_SLOT_MASK];
+    }
+
+    return m_overflow;
+}
+
+void EventProcessor::Cascade(BasicEvent*& list, uint32 level)
+{
+    BasicEvent* events = list;
+    list = NULL;
+
+    while (BasicEvent* Event = events)
+    {
+        events = Event->m_nextEvent;
+        --m_levelCount[level];
+        --m_eventCount;
+        LinkEvent(Event);
+    }
+}
+
+uint64 EventProcessor::GetNextTick(uint64 targetTick) const
+{
+    if (!m_eventCount)
+        return targetTick;
+
+    // skip ticks of empty levels up to next slot range of first not empty level
+    uint64 next = m_tick + 1;
+    for (uint32 level = 0; level < EVENT_WHEEL_LEVELS && !m_levelCount[level]; ++level)
+    {
+        uint32 shift = (level + 1) * EVENT_WHEEL_SLOT_BITS;
+        next = ((m_tick >> shift) + 1) << shift;
+    }
+
+    return next < targetTick ? next : targetTick;
+}
+
+bool EventProcessor::HasEventOfType(uint32 type) const
+{
+    for (uint32 level = 0; level < EVENT_WHEEL_LEVELS; ++level)
+        for (uint32 i = 0; i < EVENT_WHEEL_SLOTS; ++i)
+            for (BasicEvent const* Event = m_wheel[level][i]; Event; Event = Event->m_nextEvent)
+                if (Event->m_type == type)
+                    return true;
+
+    for (BasicEvent const* Event = m_overflow; Event; Event = Event->m_nextEvent)
+        if (Event->m_type == type)
+            return true;
+
+    return false;
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset)
@@ -21,7 +21,10 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <ace/TSS_T.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+
 #include <queue>
 
 // Note. All times are in milliseconds here.
@@ -30,7 +33,7 @@ class BasicEvent
 {
     public:
         BasicEvent(uint32 type)
-            : to_Abort(false), m_type(type)
+            : to_Abort(false), m_type(type), m_nextEvent(NULL), m_addOrder(0)
         {};
 
         virtual ~BasicEvent()                               // override destructor to perform some actions on event removal
@@ -54,10 +57,139 @@ class BasicEvent
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
         uint32 const m_type;                                // Event type (for use in some calculation)
+
+    private:
+        friend class EventProcessor;
+
+        BasicEvent* m_nextEvent;                            // next event in same timing wheel slot
+        uint32 m_addOrder;                                  // execution order of same time events
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+// Heap usage of all event allocators (blocks in use and kept in free lists), updated only at heap allocation
+class MANGOS_DLL_SPEC EventAllocatorStats
+{
+    public:
+        static long GetHeapBlocks() { return ms_heapBlocks.value(); }
+        static long GetHeapBytes() { return ms_heapBytes.value(); }
 
+    protected:
+        static void* HeapAllocate(size_t size)
+        {
+            ++ms_heapBlocks;
+            ms_heapBytes += long(size);
+            return ::operator new(size);
+        }
+
+        static void HeapDeallocate(void* ptr, size_t size)
+        {
+            --ms_heapBlocks;
+            ms_heapBytes -= long(size);
+            ::operator delete(ptr);
+        }
+
+    private:
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> ms_heapBlocks;
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> ms_heapBytes;
+};
+
+// Per thread free lists of memory blocks for often created event types, see PooledEvent
+template<size_t Size>
+class EventAllocator : public EventAllocatorStats
+{
+    public:
+        static void* Allocate()
+        {
+            FreeList* list = ms_freeList;
+            if (FreeBlock* block = list->head)
+            {
+                list->head = block->next;
+                --list->count;
+                return block;
+            }
+
+            return HeapAllocate(Size);
+        }
+
+        static void Deallocate(void* ptr)
+        {
+            // blocks released in other thread than allocated kept by releasing thread
+            FreeList* list = ms_freeList;
+            if (list->count >= MAX_FREE_BLOCKS)
+            {
+                HeapDeallocate(ptr, Size);
+                return;
+            }
+
+            FreeBlock* block = static_cast<FreeBlock*>(ptr);
+            block->next = list->head;
+            list->head = block;
+            ++list->count;
+        }
+
+    private:
+        enum { MAX_FREE_BLOCKS = 1024 };
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct FreeList
+        {
+            FreeList() : head(NULL), count(0) {}
+            ~FreeList()
+            {
+                while (head)
+                {
+                    FreeBlock* block = head;
+                    head = head->next;
+                    HeapDeallocate(block, Size);
+                }
+            }
+
+            FreeBlock* head;
+            uint32 count;
+        };
+
+        static ACE_TSS<FreeList> ms_freeList;
+};
+
+template<size_t Size>
+ACE_TSS<typename EventAllocator<Size>::FreeList> EventAllocator<Size>::ms_freeList;
+
+// Base for often created event types, memory of deleted events reused for new events of same type
+template<class T>
+class PooledEvent : public BasicEvent
+{
+    public:
+        PooledEvent(uint32 type) : BasicEvent(type) {}
+
+        static void* operator new(size_t size)
+        {
+            // derived classes with own size use normal allocation
+            return size == sizeof(T) ? EventAllocator<sizeof(T)>::Allocate() : ::operator new(size);
+        }
+
+        static void operator delete(void* ptr, size_t size)
+        {
+            if (size == sizeof(T))
+                EventAllocator<sizeof(T)>::Deallocate(ptr);
+            else
+                ::operator delete(ptr);
+        }
+};
+
+#define EVENT_WHEEL_TICK_BITS       6                       // 64 ms per wheel tick
+#define EVENT_WHEEL_SLOT_BITS       3
+#define EVENT_WHEEL_SLOTS           (1 << EVENT_WHEEL_SLOT_BITS)
+#define EVENT_WHEEL_LEVELS          3                       // 0.5 sec, 4 sec, 32 sec wheels, later events in overflow list
+
+/**
+ * Events stored in hierarchical timing wheel: level 0 slots hold events of one tick each (sorted by
+ * execution time), higher level slots hold events of EVENT_WHEEL_SLOTS times longer ranges and are
+ * moved to lower level when time reach their range. Events linked by BasicEvent::m_nextEvent, so
+ * adding and executing events don't allocate memory. Events executed in execution time order.
+ */
 class MANGOS_DLL_SPEC EventProcessor
 {
     public:
@@ -70,11 +202,29 @@ class MANGOS_DLL_SPEC EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset);
 
+        uint32 GetEventCount() const { return m_eventCount; }
+        bool HasEventOfType(uint32 type) const;
+
     protected:
+        // add event with already set execution time
+        void InsertEvent(BasicEvent* Event);
 
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+    private:
+        BasicEvent*& GetSlot(uint64 tick, uint32& level);
+        void LinkEvent(BasicEvent* Event);
+        void Cascade(BasicEvent*& list, uint32 level);
+        void KillEvents(BasicEvent*& list, uint32 level, bool force);
+        uint64 GetNextTick(uint64 targetTick) const;
+
+        uint64 m_tick;                                      // current level 0 tick, earlier ticks processed
+        uint32 m_addCounter;
+        uint32 m_eventCount;
+        uint32 m_levelCount[EVENT_WHEEL_LEVELS + 1];        // events in wheel levels and overflow list
+        BasicEvent* m_wheel[EVENT_WHEEL_LEVELS][EVENT_WHEEL_SLOTS];
+        BasicEvent* m_overflow;
 };
 
 #endif
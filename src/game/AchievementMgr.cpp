@@ -3084,12 +3084,14 @@ AchievementCriteriaRequirementSet const* AchievementGlobalMgr::GetCriteriaRequir
 
 bool AchievementGlobalMgr::IsRealmCompleted(AchievementEntry const* achievement) const
 {
+    ACE_Guard<ACE_Thread_Mutex> guard(m_allCompletedLock);
     AllCompletedAchievements::const_iterator itr = m_allCompletedAchievements.find(achievement->ID);
     return itr != m_allCompletedAchievements.end() && time_t(itr->second + 2) < time(NULL);
 }
 
 void AchievementGlobalMgr::SetRealmCompleted(AchievementEntry const* achievement)
 {
+    ACE_Guard<ACE_Thread_Mutex> guard(m_allCompletedLock);
     if (m_allCompletedAchievements.find(achievement->ID) == m_allCompletedAchievements.end())
         m_allCompletedAchievements[achievement->ID] = time(NULL);
 }
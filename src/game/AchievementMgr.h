@@ -338,6 +338,7 @@ class AchievementGlobalMgr
 
         typedef UNORDERED_MAP<uint32, time_t> AllCompletedAchievements;
         AllCompletedAchievements m_allCompletedAchievements;
+        mutable ACE_Thread_Mutex m_allCompletedLock;        // realm completed by map and session domain threads
 
         AchievementRewardsMap       m_achievementRewards;
         AchievementRewardLocalesMap m_achievementRewardLocales;
@@ -41,6 +41,7 @@ class MANGOS_DLL_DECL AggressorAI : public CreatureAI
         void AttackStart(Unit*);
         void EnterEvadeMode();
         bool IsVisible(Unit*) const;
+        bool CanSleep() const { return true; }
 
         void UpdateAI(const uint32);
         static int Permissible(const Creature*);
@@ -23,8 +23,11 @@
 #include "Errors.h"
 #include "Player.h"
 #include "ObjectMgr.h"
+#include "World.h"
 
-Camera::Camera(Player& player) : m_owner(player), m_sourceGuid(ObjectGuid())
+Camera::Camera(Player& player) : m_owner(player), m_sourceGuid(ObjectGuid()),
+    m_visibilityMap(NULL), m_visibilityX(0.0f), m_visibilityY(0.0f), m_visibilityRadius(0.0f),
+    m_incrementalVisibilityUpdates(0)
 {
 }
 
@@ -52,6 +55,7 @@ void Camera::Reset()
 {
     GetBody()->GetViewPoint().Detach(GetOwner()->GetObjectGuid());
     m_sourceGuid.Clear();
+    ResetVisibilityState();
 }
 
 void Camera::ReceivePacket(WorldPacket* data)
@@ -146,6 +150,8 @@ void Camera::Event_AddedToWorld()
 
 void Camera::Event_RemovedFromWorld()
 {
+    ResetVisibilityState();
+
     if (GetOwner()->GetObjectGuid() == m_sourceGuid)
     {
         m_gridRef.unlink();
@@ -178,9 +184,104 @@ void Camera::UpdateVisibilityForOwner()
     if (!m_source->GetMap())
         return;
 
+    float radius = m_source->GetMap()->GetVisibilityDistance(m_source);
+
     MaNGOS::VisibleNotifier notifier(*this);
-    Cell::VisitAllObjects(m_source, notifier, m_source->GetMap()->GetVisibilityDistance(m_source), false);
+    Cell::VisitAllObjects(m_source, notifier, radius, false);
     notifier.Notify();
+
+    SaveVisibilityState(m_source, radius, false);
+}
+
+void Camera::UpdateVisibilityForOwnerIncremental()
+{
+    WorldObject* m_source = GetBody();
+    Map* map = m_source->GetMap();
+    if (!map)
+        return;
+
+    float radius = map->GetVisibilityDistance(m_source);
+
+    if (!CanUpdateVisibilityIncremental(m_source, radius))
+    {
+        UpdateVisibilityForOwner();
+        return;
+    }
+
+    float x = m_source->GetPositionX();
+    float y = m_source->GetPositionY();
+
+    // objects in this range from last update position already checked, and if not visible - not visible by
+    // reasons not related to viewpoint position (out of stealth detect range); objects moving less than
+    // relocation limit not send notifies
+    float innerRadius = m_visibilityRadius - World::GetRelocationLowerLimit();
+
+    MaNGOS::VisibleNotifier notifier(*this);
+    TypeContainerVisitor<MaNGOS::VisibleNotifier, GridTypeMapContainer> gnotifier(notifier);
+    TypeContainerVisitor<MaNGOS::VisibleNotifier, WorldTypeMapContainer> wnotifier(notifier);
+
+    float visitRadius = radius + m_source->GetObjectBoundingRadius();
+    CellArea area = Cell::CalculateCellArea(x, y, visitRadius);
+
+    for (uint32 cx = area.low_bound.x_coord; cx <= area.high_bound.x_coord; ++cx)
+    {
+        for (uint32 cy = area.low_bound.y_coord; cy <= area.high_bound.y_coord; ++cy)
+        {
+            CellPair cellPair(cx, cy);
+
+            // corners of the area, not reached by circle
+            if (!MaNGOS::IsCellInCircle(cellPair, x, y, visitRadius, false))
+                continue;
+
+            // entirely in range of last update and not moved out of range now - nothing changed here,
+            // except stealth detection that depends on distance, so cells in detect range of old or new position rechecked
+            if (innerRadius > 0.0f && MaNGOS::IsCellInCircle(cellPair, m_visibilityX, m_visibilityY, innerRadius, true) &&
+                MaNGOS::IsCellInCircle(cellPair, x, y, radius, true) &&
+                !MaNGOS::IsCellInCircle(cellPair, m_visibilityX, m_visibilityY, MAX_PLAYER_STEALTH_DETECT_RANGE, false) &&
+                !MaNGOS::IsCellInCircle(cellPair, x, y, MAX_PLAYER_STEALTH_DETECT_RANGE, false))
+                continue;
+
+            Cell cell(cellPair);
+            map->Visit(cell, gnotifier);
+            map->Visit(cell, wnotifier);
+        }
+    }
+
+    // not visited client objects in skipped cells stay in range
+    notifier.Notify(radius);
+
+    SaveVisibilityState(m_source, radius, true);
+}
+
+void Camera::SaveVisibilityState(WorldObject* body, float radius, bool incremental)
+{
+    m_visibilityBodyGuid = body->GetObjectGuid();
+    m_visibilityMap = body->GetMap();
+    m_visibilityX = body->GetPositionX();
+    m_visibilityY = body->GetPositionY();
+    m_visibilityRadius = radius;
+
+    if (incremental)
+        ++m_incrementalVisibilityUpdates;
+    else
+        m_incrementalVisibilityUpdates = 0;
+}
+
+bool Camera::CanUpdateVisibilityIncremental(WorldObject* body, float radius) const
+{
+    uint32 maxIncrementalUpdates = sWorld.getConfig(CONFIG_UINT32_VISIBILITY_INCREMENTAL_UPDATES);
+    if (!maxIncrementalUpdates || m_incrementalVisibilityUpdates >= maxIncrementalUpdates)
+        return false;
+
+    if (m_visibilityBodyGuid.IsEmpty() || m_visibilityBodyGuid != body->GetObjectGuid() || m_visibilityMap != body->GetMap())
+        return false;
+
+    // visibility distance changed, or viewer in flight (own visibility rules)
+    if (m_visibilityRadius != radius || m_owner.IsTaxiFlying())
+        return false;
+
+    // moved too far - nothing to save
+    return body->IsWithinDist2d(m_visibilityX, m_visibilityY, radius * 0.5f);
 }
 
 WorldObject* Camera::GetBody()
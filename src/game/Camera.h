@@ -62,7 +62,16 @@ class MANGOS_DLL_SPEC Camera
         // updates visibility of worldobjects around viewpoint for camera's owner
         void UpdateVisibilityForOwner();
 
+        // same as UpdateVisibilityForOwner, but at viewpoint relocation check only cells which was not
+        // in visibility range at last update or are in stealth detect range (full update used if incremental is not possible)
+        void UpdateVisibilityForOwnerIncremental();
+
     private:
+        // state of last visibility update, base for incremental updates
+        void SaveVisibilityState(WorldObject* body, float radius, bool incremental);
+        void ResetVisibilityState() { m_visibilityBodyGuid.Clear(); }
+        bool CanUpdateVisibilityIncremental(WorldObject* body, float radius) const;
+
         // called when viewpoint changes visibility state
         void Event_AddedToWorld();
         void Event_RemovedFromWorld();
@@ -72,6 +81,13 @@ class MANGOS_DLL_SPEC Camera
         Player& m_owner;
         ObjectGuid m_sourceGuid;
 
+        ObjectGuid m_visibilityBodyGuid;
+        Map const* m_visibilityMap;
+        float m_visibilityX;
+        float m_visibilityY;
+        float m_visibilityRadius;
+        uint32 m_incrementalVisibilityUpdates;
+
         void UpdateForCurrentViewPoint();
 
     public:
@@ -136,6 +152,11 @@ class MANGOS_DLL_SPEC ViewPoint
         {
             CameraCall(&Camera::UpdateVisibilityForOwner);
         }
+
+        void Call_UpdateVisibilityForOwnerIncremental()
+        {
+            CameraCall(&Camera::UpdateVisibilityForOwnerIncremental);
+        }
 };
 
 #endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "CellObjectIndex.h"
+#include "Object.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define CELL_INDEX_USE_SSE
+#endif
+
+void CellObjectIndex::Insert(WorldObject* obj)
+{
+    MANGOS_ASSERT(!obj->m_cellIndex);
+
+    obj->m_cellIndex = this;
+    obj->m_cellIndexSlot = m_objects.size();
+
+    m_x.push_back(obj->GetPositionX());
+    m_y.push_back(obj->GetPositionY());
+    m_z.push_back(obj->GetPositionZ());
+    m_guids.push_back(obj->GetObjectGuid());
+    m_typeIds.push_back(obj->GetTypeId());
+    m_phaseMasks.push_back(obj->GetPhaseMask());
+    m_objects.push_back(obj);
+
+    ++m_typeCount[obj->GetTypeId()];
+
+    float radius = obj->GetObjectBoundingRadius();
+    if (radius > m_maxRadius)
+        m_maxRadius = radius;
+}
+
+void CellObjectIndex::Remove(WorldObject* obj)
+{
+    MANGOS_ASSERT(obj->m_cellIndex == this);
+
+    uint32 slot = obj->m_cellIndexSlot;
+    uint32 last = m_objects.size() - 1;
+
+    // move last entry to free slot
+    if (slot != last)
+    {
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_z[slot] = m_z[last];
+        m_guids[slot] = m_guids[last];
+        m_typeIds[slot] = m_typeIds[last];
+        m_phaseMasks[slot] = m_phaseMasks[last];
+        m_objects[slot] = m_objects[last];
+        m_objects[slot]->m_cellIndexSlot = slot;
+    }
+
+    m_x.pop_back();
+    m_y.pop_back();
+    m_z.pop_back();
+    m_guids.pop_back();
+    m_typeIds.pop_back();
+    m_phaseMasks.pop_back();
+    m_objects.pop_back();
+
+    --m_typeCount[obj->GetTypeId()];
+
+    obj->m_cellIndex = NULL;
+    obj->m_cellIndexSlot = 0;
+
+    if (m_objects.empty())
+        m_maxRadius = 0.0f;
+}
+
+void CellObjectIndex::Update(WorldObject* obj)
+{
+    MANGOS_ASSERT(obj->m_cellIndex == this);
+
+    uint32 slot = obj->m_cellIndexSlot;
+    m_x[slot] = obj->GetPositionX();
+    m_y[slot] = obj->GetPositionY();
+    m_z[slot] = obj->GetPositionZ();
+    m_phaseMasks[slot] = obj->GetPhaseMask();
+
+    float radius = obj->GetObjectBoundingRadius();
+    if (radius > m_maxRadius)
+        m_maxRadius = radius;
+}
+
+void CellObjectIndex::Clear()
+{
+    for (std::vector<WorldObject*>::const_iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr)
+    {
+        (*itr)->m_cellIndex = NULL;
+        (*itr)->m_cellIndexSlot = 0;
+    }
+
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_guids.clear();
+    m_typeIds.clear();
+    m_phaseMasks.clear();
+    m_objects.clear();
+
+    memset(m_typeCount, 0, sizeof(m_typeCount));
+    m_maxRadius = 0.0f;
+}
+
+uint32 CellObjectIndex::FilterBlock(CellObjectIndexFilter const& filter, float range2, uint32 begin, uint32* slots) const
+{
+    uint32 end = begin + CELL_INDEX_BLOCK_SIZE;
+    if (end > m_objects.size())
+        end = m_objects.size();
+
+    uint32 count = 0;
+    uint32 i = begin;
+
+#ifdef CELL_INDEX_USE_SSE
+    __m128 const cx = _mm_set1_ps(filter.x);
+    __m128 const cy = _mm_set1_ps(filter.y);
+    __m128 const cz = _mm_set1_ps(filter.z);
+    __m128 const zFactor = _mm_set1_ps(filter.is3D ? 1.0f : 0.0f);
+    __m128 const r2 = _mm_set1_ps(range2);
+
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&m_x[i]), cx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&m_y[i]), cy);
+        __m128 dz = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_z[i]), cz), zFactor);
+        __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+        int mask = _mm_movemask_ps(_mm_cmple_ps(d2, r2));
+        if (!mask)
+            continue;
+
+        for (uint32 j = 0; j < 4; ++j)
+            if ((mask & (1 << j)) && m_typeIds[i + j] == filter.typeId && (m_phaseMasks[i + j] & filter.phaseMask))
+                slots[count++] = i + j;
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        float dx = m_x[i] - filter.x;
+        float dy = m_y[i] - filter.y;
+        float dz = filter.is3D ? m_z[i] - filter.z : 0.0f;
+
+        if (dx * dx + dy * dy + dz * dz <= range2 && m_typeIds[i] == filter.typeId && (m_phaseMasks[i] & filter.phaseMask))
+            slots[count++] = i;
+    }
+
+    return count;
+}
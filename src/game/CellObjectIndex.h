@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CELLOBJECTINDEX_H
+#define MANGOS_CELLOBJECTINDEX_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+#include <vector>
+
+class WorldObject;
+
+#define CELL_INDEX_BLOCK_SIZE   64                          // entries filtered per kernel call
+
+struct CellObjectIndexFilter
+{
+    CellObjectIndexFilter() : x(0.0f), y(0.0f), z(0.0f), range(0.0f), is3D(true), phaseMask(0), typeId(TYPEID_OBJECT) {}
+
+    float x, y, z;                                          // search center
+    float range;                                            // search range including center object size
+    bool is3D;
+    uint32 phaseMask;
+    TypeID typeId;
+};
+
+/**
+ * Structure-of-arrays copy of object positions in one grid cell container.
+ *
+ * Kept in sync by Map at grid add/remove and by WorldObject::Relocate, so range searches
+ * can reject far objects using packed coordinates without touching the objects themselves.
+ * Range filter is conservative: it uses largest object bounding radius of the cell,
+ * final check is always done by searcher check.
+ */
+class MANGOS_DLL_SPEC CellObjectIndex
+{
+    public:
+        CellObjectIndex() : m_maxRadius(0.0f) { memset(m_typeCount, 0, sizeof(m_typeCount)); }
+        ~CellObjectIndex() { Clear(); }
+
+        void Insert(WorldObject* obj);
+        void Remove(WorldObject* obj);
+        void Update(WorldObject* obj);                      // position, phase or size changed
+        void Clear();                                       // detach all objects
+
+        uint32 size() const { return m_objects.size(); }
+        uint32 Count(TypeID typeId) const { return m_typeCount[typeId]; }
+        WorldObject* GetObject(uint32 slot) const { return m_objects[slot]; }
+        ObjectGuid const& GetGuid(uint32 slot) const { return m_guids[slot]; }
+
+        // call visitor for all objects of filter type and phase, which can be in filter range
+        template<class VISITOR>
+        void VisitInRange(CellObjectIndexFilter const& filter, VISITOR& visitor) const
+        {
+            float range = filter.range + m_maxRadius;
+            uint32 slots[CELL_INDEX_BLOCK_SIZE];
+            for (uint32 begin = 0; begin < m_objects.size(); begin += CELL_INDEX_BLOCK_SIZE)
+            {
+                uint32 count = FilterBlock(filter, range * range, begin, slots);
+                for (uint32 i = 0; i < count; ++i)
+                    visitor(m_objects[slots[i]]);
+            }
+        }
+
+        // fill slots (up to CELL_INDEX_BLOCK_SIZE) of matched entries in block starting at begin, return count
+        uint32 FilterBlock(CellObjectIndexFilter const& filter, float range2, uint32 begin, uint32* slots) const;
+
+    private:
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_z;
+        std::vector<ObjectGuid> m_guids;
+        std::vector<uint8> m_typeIds;
+        std::vector<uint32> m_phaseMasks;
+        std::vector<WorldObject*> m_objects;
+
+        uint32 m_typeCount[MAX_TYPE_ID];
+        float m_maxRadius;                                  // largest bounding radius of indexed objects
+};
+
+#endif
@@ -21,9 +21,11 @@
 #include "ObjectMgr.h"
 #include "World.h"
 #include "SocialMgr.h"
+#include "WorldSocketMgr.h"
 
 Channel::Channel(const std::string& name, uint32 channel_id)
-    : m_announce(true), m_moderate(false), m_name(name), m_flags(0), m_channelId(channel_id)
+    : m_announce(true), m_moderate(false), m_name(name), m_flags(0), m_channelId(channel_id),
+    m_ignoreFilterGeneration(PlayerSocial::GetIgnoreGeneration()), m_ignoreFilterStale(0)
 {
     // set special flags if built-in channel
     ChatChannelsEntry const* ch = GetChannelEntryFor(channel_id);
@@ -107,6 +109,8 @@ void Channel::Join(ObjectGuid p, const char* pass)
     pinfo.player = p;
     pinfo.flags = 0;
 
+    AddMember(p, plr);
+
     MakeYouJoined(&data);
     SendToOne(&data, p);
 
@@ -147,6 +151,7 @@ void Channel::Leave(ObjectGuid p, bool send)
 
         bool changeowner = m_players[p].IsOwner();
 
+        RemoveMember(p);
         m_players.erase(p);
         if (m_announce && (!plr || plr->GetSession()->GetSecurity() < SEC_GAMEMASTER || !sWorld.getConfig(CONFIG_BOOL_SILENTLY_GM_JOIN_TO_CHANNEL)))
         {
@@ -214,6 +219,7 @@ void Channel::KickOrBan(ObjectGuid good, const char* badname, bool ban)
                 MakePlayerKicked(&data, bad->GetObjectGuid(), good);
 
             SendToAll(&data);
+            RemoveMember(bad->GetObjectGuid());
             m_players.erase(bad->GetObjectGuid());
             bad->LeftChannel(this);
 
@@ -663,13 +669,104 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, ObjectGuid p)
 {
-    for(PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
+    // per member ignore check only if some member may ignore sender
+    bool checkIgnore = p && IsIgnoredByMembers(p);
+
+    // big channels send from network threads, world thread only collect sockets
+    uint32 offloadSize = sWorld.getConfig(CONFIG_UINT32_CHANNEL_NETWORK_BROADCAST);
+    bool offload = offloadSize && m_members.size() >= offloadSize;
+
+    std::vector<WorldSocket*> sockets;
+    if (offload)
+        sockets.reserve(m_members.size());
+
+    for (MemberSessionList::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
     {
-        Player* plr = sObjectMgr.GetPlayer(i->first);
-        if (plr)
-            if (!p || !plr->GetSocial()->HasIgnore(p))
-                plr->GetSession()->SendPacket(data);
+        WorldSession* session = itr->session;
+        if (!session || !session->GetPlayer())
+            continue;
+
+        if (checkIgnore && session->GetPlayer()->GetSocial()->HasIgnore(p))
+            continue;
+
+        if (offload)
+        {
+            if (WorldSocket* socket = session->GetBroadcastSocket())
+            {
+                sockets.push_back(socket);
+                continue;
+            }
+        }
+
+        session->SendPacket(data);
     }
+
+    if (!sockets.empty())
+        sWorldSocketMgr->BroadcastPacket(*data, sockets);
+}
+
+void Channel::AddMember(ObjectGuid guid, Player* plr)
+{
+    RemoveMember(guid);
+
+    MemberSession member;
+    member.guid = guid;
+    member.session = plr ? plr->GetSession() : NULL;
+
+    m_players[guid].memberIndex = m_members.size();
+    m_members.push_back(member);
+
+    if (plr && plr->GetSocial())
+        plr->GetSocial()->AddIgnoresToFilter(m_ignoreFilter);
+}
+
+void Channel::RemoveMember(ObjectGuid guid)
+{
+    PlayerList::iterator itr = m_players.find(guid);
+    if (itr == m_players.end())
+        return;
+
+    uint32 index = itr->second.memberIndex;
+    if (index >= m_members.size() || m_members[index].guid != guid)
+        return;
+
+    // move last member to free place
+    if (index + 1 < m_members.size())
+    {
+        m_members[index] = m_members.back();
+        m_players[m_members[index].guid].memberIndex = index;
+    }
+
+    m_members.pop_back();
+
+    // filter still valid for left member ignores, only false positives grow
+    ++m_ignoreFilterStale;
+}
+
+bool Channel::IsIgnoredByMembers(ObjectGuid guid)
+{
+    if (m_ignoreFilterGeneration != PlayerSocial::GetIgnoreGeneration() || m_ignoreFilter.IsOverloaded() ||
+        m_ignoreFilterStale > m_members.size() / 4 + 16)
+        RebuildIgnoreFilter();
+
+    return m_ignoreFilter.MayContain(guid);
+}
+
+void Channel::RebuildIgnoreFilter()
+{
+    m_ignoreFilterGeneration = PlayerSocial::GetIgnoreGeneration();
+    m_ignoreFilterStale = 0;
+
+    uint32 count = 0;
+    for (MemberSessionList::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+        if (itr->session && itr->session->GetPlayer() && itr->session->GetPlayer()->GetSocial())
+            count += itr->session->GetPlayer()->GetSocial()->GetNumberOfSocialsWithFlag(SOCIAL_FLAG_IGNORED);
+
+    m_ignoreFilter.Reset(count);
+
+    for (MemberSessionList::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
+        if (itr->session && itr->session->GetPlayer() && itr->session->GetPlayer()->GetSocial())
+            itr->session->GetPlayer()->GetSocial()->AddIgnoresToFilter(m_ignoreFilter);
 }
 
 void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
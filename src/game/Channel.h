@@ -24,10 +24,12 @@
 #include "WorldPacket.h"
 #include "Opcodes.h"
 #include "Player.h"
+#include "SocialMgr.h"
 
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 enum ChatNotify
 {
@@ -121,8 +123,11 @@ class Channel
 
         struct PlayerInfo
         {
+            PlayerInfo() : flags(0), memberIndex(0) {}
+
             ObjectGuid player;
             uint8 flags;
+            uint32 memberIndex;                             // index in m_members
 
             bool HasFlag(uint8 flag) { return flags & flag; }
             void SetFlag(uint8 flag) { if (!HasFlag(flag)) flags |= flag; }
@@ -229,6 +234,14 @@ class Channel
         void SendToAll(WorldPacket* data, ObjectGuid p = ObjectGuid());
         void SendToOne(WorldPacket* data, ObjectGuid who);
 
+        // members sessions for broadcasts, resolved at join/leave
+        void AddMember(ObjectGuid guid, Player* plr);
+        void RemoveMember(ObjectGuid guid);
+
+        // false if no member ignore guid, true - possible ignored by some members
+        bool IsIgnoredByMembers(ObjectGuid guid);
+        void RebuildIgnoreFilter();
+
         bool IsOn(ObjectGuid who) const { return m_players.find(who) != m_players.end(); }
         bool IsBanned(ObjectGuid guid) const { return m_banned.find(guid) != m_banned.end(); }
 
@@ -279,5 +292,18 @@ class Channel
         typedef     std::map<ObjectGuid, PlayerInfo> PlayerList;
         PlayerList  m_players;
         GuidSet m_banned;
+
+        struct MemberSession
+        {
+            ObjectGuid guid;
+            WorldSession* session;                          // NULL for members not found online at join
+        };
+
+        typedef std::vector<MemberSession> MemberSessionList;
+        MemberSessionList m_members;
+
+        IgnoreFilter m_ignoreFilter;                        // ignores of all members
+        uint32 m_ignoreFilterGeneration;
+        uint32 m_ignoreFilterStale;                         // members left after filter rebuild
 };
 #endif
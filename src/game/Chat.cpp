@@ -253,10 +253,20 @@ ChatCommand* ChatHandler::getCommandTable()
         { "bg",             SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugBattlegroundCommand,        "", NULL },
         { "getitemstate",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetItemStateCommand,        "", NULL },
         { "lootrecipient",  SEC_GAMEMASTER,     false, &ChatHandler::HandleDebugGetLootRecipientCommand,    "", NULL },
+        { "loscache",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugLOSCacheCommand,            "", NULL },
         { "getitemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetItemValueCommand,        "", NULL },
         { "getvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetValueCommand,            "", NULL },
         { "moditemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModItemValueCommand,        "", NULL },
         { "modvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModValueCommand,            "", NULL },
+        { "playerlookup",   SEC_CONSOLE,        true,  &ChatHandler::HandleDebugPlayerLookupCommand,        "", NULL },
+        { "playersave",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugPlayerSaveCommand,          "", NULL },
+        { "spellbench",     SEC_CONSOLE,        true,  &ChatHandler::HandleDebugSpellBenchCommand,          "", NULL },
+        { "eventbench",     SEC_CONSOLE,        true,  &ChatHandler::HandleDebugEventBenchCommand,          "", NULL },
+        { "gridbench",      SEC_CONSOLE,        true,  &ChatHandler::HandleDebugGridBenchCommand,           "", NULL },
+        { "mapstorebench",  SEC_CONSOLE,        true,  &ChatHandler::HandleDebugMapStoreBenchCommand,       "", NULL },
+        { "dormancy",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugDormancyCommand,            "", NULL },
+        { "loadbench",      SEC_CONSOLE,        true,  &ChatHandler::HandleDebugLoadBenchCommand,           "", NULL },
+        { "opcodestats",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugOpcodeStatsCommand,         "", NULL },
         { "play",           SEC_MODERATOR,      false, NULL,                                                "", debugPlayCommandTable },
         { "send",           SEC_ADMINISTRATOR,  false, NULL,                                                "", debugSendCommandTable },
         { "setaurastate",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSetAuraStateCommand,        "", NULL },
@@ -265,6 +275,8 @@ ChatCommand* ChatHandler::getCommandTable()
         { "spellcheck",     SEC_CONSOLE,        true,  &ChatHandler::HandleDebugSpellCheckCommand,          "", NULL },
         { "spellcoefs",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugSpellCoefsCommand,          "", NULL },
         { "spellmods",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugSpellModsCommand,           "", NULL },
+        { "sqlread",        SEC_CONSOLE,        true,  &ChatHandler::HandleDebugSqlReadCommand,             "", NULL },
+        { "worldstateupdate",SEC_ADMINISTRATOR, false, &ChatHandler::HandleDebugWorldStateUpdateCommand,    "", NULL },
         { "entervehicle",   SEC_GAMEMASTER,     false, &ChatHandler::HandleDebugEnterVehicleCommand,        "", NULL },
         { NULL,             0,                  false, NULL,                                                "", NULL }
     };
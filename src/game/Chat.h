@@ -43,6 +43,7 @@ class GameObject;
 class Creature;
 class Player;
 class Unit;
+class ConsoleBenchmark;
 
 class ChatCommand
 {
@@ -219,6 +220,18 @@ class MANGOS_DLL_SPEC ChatHandler
         bool HandleDebugSpellCoefsCommand(char* args);
         bool HandleDebugSpellModsCommand(char* args);
         bool HandleDebugEnterVehicleCommand(char* args);
+        bool HandleDebugLOSCacheCommand(char* args);
+        bool HandleDebugPlayerLookupCommand(char* args);
+        bool HandleDebugWorldStateUpdateCommand(char* args);
+        bool HandleDebugSqlReadCommand(char* args);
+        bool HandleDebugPlayerSaveCommand(char* args);
+        bool HandleDebugSpellBenchCommand(char* args);
+        bool HandleDebugEventBenchCommand(char* args);
+        bool HandleDebugGridBenchCommand(char* args);
+        bool HandleDebugMapStoreBenchCommand(char* args);
+        bool HandleDebugDormancyCommand(char* args);
+        bool HandleDebugLoadBenchCommand(char* args);
+        bool HandleDebugOpcodeStatsCommand(char* args);
         bool HandleDebugSendCalendarResultCommand(char* args);
 
         bool HandleDebugPlayCinematicCommand(char* args);
@@ -714,6 +727,7 @@ class MANGOS_DLL_SPEC ChatHandler
         bool HandleGetValueHelper(Object* target, uint32 field, char* typeStr);
         bool HandlerDebugModValueHelper(Object* target, uint32 field, char* typeStr, char* valStr);
         bool HandleSetValueHelper(Object* target, uint32 field, char* typeStr, char* valStr);
+        bool StartConsoleBenchmarkHelper(ConsoleBenchmark* bench);
 
         bool HandleSendItemsHelper(MailDraft& draft, char* args);
         bool HandleSendMailHelper(MailDraft& draft, char* args);
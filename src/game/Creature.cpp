@@ -50,6 +50,7 @@
 #include "CellImpl.h"
 #include "TemporarySummon.h"
 #include "movement/MoveSplineInit.h"
+#include "movement/MoveSpline.h"
 #include "CreatureLinkingMgr.h"
 
 // apply implementation of the singletons
@@ -142,6 +143,7 @@ m_corpseDecayTimer(0), m_respawnTime(0), m_respawnDelay(25), m_corpseDelay(60),
 m_subtype(subtype), m_defaultMovementType(IDLE_MOTION_TYPE), m_equipmentId(0),
 m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false),
 m_regenHealth(true), m_AI_locked(false), m_isDeadByDefault(false),
+m_isDormant(false), m_dormancyId(0), m_dormancyCheckTimer(CREATURE_DORMANCY_CHECK_TIME),
 m_temporaryFactionFlags(TEMPFACTION_NONE), m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL), m_originalEntry(0),
 m_creatureInfo(NULL), m_modelInhabitType(-1)
 {
@@ -172,6 +174,9 @@ void Creature::AddToWorld()
 
 void Creature::RemoveFromWorld(bool remove)
 {
+    // wake up event of old map will not find creature
+    WakeUp();
+
     Unit::RemoveFromWorld(remove);
 }
 
@@ -574,6 +579,7 @@ void Creature::Update(uint32 update_diff, uint32 diff)
                 break;
 
             RegenerateAll(update_diff);
+            UpdateDormancy(update_diff);
             break;
         }
         default:
@@ -581,6 +587,75 @@ void Creature::Update(uint32 update_diff, uint32 diff)
     }
 }
 
+bool Creature::CanBeDormant()
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_CREATURE_DORMANCY))
+        return false;
+
+    // controlled, short living or kept active by scripts
+    if (IsPet() || IsTotem() || IsTemporarySummon() || IsVehicle() || isActiveObject() || m_isDeadByDefault ||
+        !GetCharmerOrOwnerGuid().IsEmpty())
+        return false;
+
+    if (isInCombat() || IsInEvadeMode() || !getThreatManager().isThreatListEmpty() || IsNonMeleeSpellCasted(false))
+        return false;
+
+    // regeneration is done by ticks, long update will not compress it
+    if (GetHealth() < GetMaxHealth() || (getPowerType() != POWER_RAGE && GetPower(getPowerType()) < GetMaxPower(getPowerType())))
+        return false;
+
+    if (!movespline->Finalized())
+        return false;
+
+    MovementGeneratorType moveType = GetMotionMaster()->GetCurrentMovementGeneratorType();
+    if (moveType != IDLE_MOTION_TYPE && moveType != RANDOM_MOTION_TYPE)
+        return false;
+
+    if (GetEvents()->size(true) || !AI() || !AI()->CanSleep())
+        return false;
+
+    // player movement wakes creatures in relocation notify distance, cells near players marked by map update
+    return !GetMap()->IsPlayerNearCell(MaNGOS::ComputeCellPair(GetPositionX(), GetPositionY()));
+}
+
+void Creature::UpdateDormancy(uint32 update_diff)
+{
+    // first update after wake up has all dormant time in update_diff, so check is done at once
+    if (m_dormancyCheckTimer > update_diff)
+    {
+        m_dormancyCheckTimer -= update_diff;
+        return;
+    }
+
+    m_dormancyCheckTimer = CREATURE_DORMANCY_CHECK_TIME;
+
+    if (!CanBeDormant())
+        return;
+
+    // wake up not later than nearest aura expire
+    uint32 wakeUpDelay = sWorld.getConfig(CONFIG_UINT32_CREATURE_DORMANCY_INTERVAL);
+    SpellAuraHolderMap const& holders = GetSpellAuraHolderMap();
+    for (SpellAuraHolderMap::const_iterator itr = holders.begin(); itr != holders.end(); ++itr)
+    {
+        if (itr->second->IsPermanent() || itr->second->GetAuraDuration() <= 0)
+            continue;
+
+        if (uint32(itr->second->GetAuraDuration()) < wakeUpDelay)
+            wakeUpDelay = uint32(itr->second->GetAuraDuration());
+    }
+
+    if (wakeUpDelay < CREATURE_DORMANCY_CHECK_TIME)
+        return;
+
+    MapObjectHandle handle = GetMap()->GetObjectHandle(GetObjectGuid());
+    if (handle.IsEmpty())
+        return;
+
+    m_isDormant = true;
+    ++m_dormancyId;
+    GetMap()->AddEvent(new CreatureWakeUpEvent(*GetMap(), handle, m_dormancyId), wakeUpDelay);
+}
+
 void Creature::RegenerateAll(uint32 update_diff)
 {
     if (m_regenTimer > 0)
@@ -753,6 +828,9 @@ bool Creature::AIM_Initialize()
     LockAI(true);
     CreatureAI* oldAI = i_AI;
 
+    // new AI can require normal update rate
+    WakeUp();
+
     GetMotionMaster()->Initialize();
 
     i_AI = FactorySelector::selectAI(this);
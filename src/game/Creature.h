@@ -419,6 +419,8 @@ struct TrainerSpellData
 
 #define MAX_VENDOR_ITEMS 150                                // Limitation in 3.x.x item count in SMSG_LIST_INVENTORY
 
+#define CREATURE_DORMANCY_CHECK_TIME 2000                   // (msecs) period of checks for going dormant
+
 enum VirtualItemSlot
 {
     VIRTUAL_ITEM_SLOT_0 = 0,
@@ -741,6 +743,11 @@ class MANGOS_DLL_SPEC Creature : public Unit
         void LockAI(bool lock) { m_AI_locked = lock; };
         bool IsAILocked() const { return m_AI_locked; };
 
+        // dormant creature is skipped by map updates until wake up event, player approach or any activity
+        bool IsDormant() const { return m_isDormant; }
+        uint32 GetDormancyId() const { return m_dormancyId; }
+        void WakeUp() { m_isDormant = false; }
+
         void SetVirtualItem(VirtualItemSlot slot, uint32 item_id) { SetUInt32Value(UNIT_VIRTUAL_ITEM_SLOT_ID + slot, item_id); }
 
     protected:
@@ -754,6 +761,9 @@ class MANGOS_DLL_SPEC Creature : public Unit
 
         void _RealtimeSetCreatureInfo();
 
+        bool CanBeDormant();
+        void UpdateDormancy(uint32 update_diff);
+
         static float _GetHealthMod(int32 Rank);
         static float _GetDamageMod(int32 Rank);
 
@@ -779,6 +789,9 @@ class MANGOS_DLL_SPEC Creature : public Unit
         bool m_regenHealth;
         bool m_AI_locked;
         bool m_isDeadByDefault;
+        bool m_isDormant;
+        uint32 m_dormancyId;                                // increased at each dormancy start, for skip outdated wake up events
+        uint32 m_dormancyCheckTimer;
         uint32 m_temporaryFactionFlags;                     // used for real faction changes (not auras etc)
 
         SpellSchoolMask m_meleeDamageSchoolMask;
@@ -260,6 +260,12 @@ class MANGOS_DLL_SPEC CreatureAI
          */
         virtual bool IsVisible(Unit* /*pWho*/) const { return false; }
 
+        /**
+         * Check if creature can be skipped by map updates while idle and no players near (dormant state)
+         * Note: AI which uses out of combat timers must not allow this, dormant creature is updated rarely
+         */
+        virtual bool CanSleep() const { return false; }
+
         // Called when victim entered water and creature can not enter water
         // TODO: rather unused
         virtual bool canReachByRangeAttack(Unit*) { return false; }
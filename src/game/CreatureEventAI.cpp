@@ -1231,6 +1231,16 @@ void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* pSpell)
                     ProcessEvent(*i, pUnit);
 }
 
+bool CreatureEventAI::CanSleep() const
+{
+    // out of combat timers must run at normal rate
+    for (CreatureEventAIList::const_iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        if (itr->Event.event_type == EVENT_T_TIMER_OOC || itr->Event.event_type == EVENT_T_TIMER_GENERIC)
+            return false;
+
+    return true;
+}
+
 void CreatureEventAI::UpdateAI(const uint32 diff)
 {
     // Check if we are in combat (also updates calls threat update code)
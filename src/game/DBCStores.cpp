@@ -26,6 +26,9 @@
 
 #include "DBCfmt.h"
 
+#include <ace/Task.h>
+#include <ace/OS_NS_unistd.h>
+
 #include <map>
 
 typedef UNORDERED_MAP<uint16, uint32> AreaFlagByAreaID;
@@ -308,57 +311,156 @@ struct LocalData
     uint32 checkedDbcLocaleBuilds;
 };
 
+class DBCLoadQueue;
+
+class DBCLoadJob
+{
+    public:
+        virtual ~DBCLoadJob() {}
+        virtual void Load(DBCLoadQueue& queue) = 0;
+};
+
+/**
+ * Independent DBC stores loaded in parallel by pool of threads.
+ * Shared state (locales availability, progress bar and problem list) accessed under queue lock.
+ */
+class DBCLoadQueue : protected ACE_Task_Base
+{
+    public:
+        DBCLoadQueue(LocalData& localeData, BarGoLink& bar, StoreProblemList& errlist)
+            : m_localeData(localeData), m_bar(bar), m_errlist(errlist) {}
+
+        ~DBCLoadQueue()
+        {
+            while (!m_jobs.empty())
+            {
+                delete m_jobs.front();
+                m_jobs.pop_front();
+            }
+        }
+
+        void Add(DBCLoadJob* job) { m_jobs.push_back(job); }
+
+        // load all queued stores, return after all loaded
+        void Run()
+        {
+            long numThreads = ACE_OS::num_processors_online();
+            if (numThreads < 1)
+                numThreads = 1;
+            if (numThreads > long(m_jobs.size()))
+                numThreads = long(m_jobs.size());
+
+            if (numThreads <= 1 || activate(THR_NEW_LWP | THR_JOINABLE, numThreads) == -1)
+            {
+                svc();
+                return;
+            }
+
+            wait();
+        }
+
+        LocalData& GetLocaleData() { return m_localeData; }
+        BarGoLink& GetBar() { return m_bar; }
+        StoreProblemList& GetProblemList() { return m_errlist; }
+        ACE_Thread_Mutex& GetLock() { return m_lock; }
+
+    protected:
+        int svc()
+        {
+            while (DBCLoadJob* job = NextJob())
+            {
+                job->Load(*this);
+                delete job;
+            }
+            return 0;
+        }
+
+    private:
+        DBCLoadJob* NextJob()
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+            if (m_jobs.empty())
+                return NULL;
+
+            DBCLoadJob* job = m_jobs.front();
+            m_jobs.pop_front();
+            return job;
+        }
+
+        LocalData& m_localeData;
+        BarGoLink& m_bar;
+        StoreProblemList& m_errlist;
+        ACE_Thread_Mutex m_lock;
+        std::list<DBCLoadJob*> m_jobs;
+};
+
 template<class T>
-inline void LoadDBC(LocalData& localeData, BarGoLink& bar, StoreProblemList& errlist, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
+inline void LoadDBC(DBCLoadQueue& queue, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
 {
     // compatibility format and C++ structure sizes
     MANGOS_ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
 
+    LocalData& localeData = queue.GetLocaleData();
+    StoreProblemList& errlist = queue.GetProblemList();
+
     std::string dbc_filename = dbc_path + filename;
     if (storage.Load(dbc_filename.c_str()))
     {
-        bar.step();
-        for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
         {
-            if (!(localeData.availableDbcLocales & (1 << i)))
-                continue;
+            ACE_Guard<ACE_Thread_Mutex> guard(queue.GetLock());
+            queue.GetBar().step();
+        }
 
+        for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
+        {
             LocaleNameStr const* localStr = &fullLocaleNameList[i];
 
             std::string dbc_dir_loc = dbc_path + localStr->name + "/";
 
-            if (!(localeData.checkedDbcLocaleBuilds & (1 << i)))
             {
-                localeData.checkedDbcLocaleBuilds |= (1 << i); // mark as checked for speedup next checks
+                ACE_Guard<ACE_Thread_Mutex> guard(queue.GetLock());
 
+                if (!(localeData.availableDbcLocales & (1 << i)))
+                    continue;
 
-                uint32 build_loc = ReadDBCBuild(dbc_dir_loc, localStr);
-                if (localeData.main_build != build_loc)
+                if (!(localeData.checkedDbcLocaleBuilds & (1 << i)))
                 {
-                    localeData.availableDbcLocales &= ~(1 << i); // mark as not available for speedup next checks
+                    localeData.checkedDbcLocaleBuilds |= (1 << i); // mark as checked for speedup next checks
 
-                    // exist but wrong build
-                    if (build_loc)
+
+                    uint32 build_loc = ReadDBCBuild(dbc_dir_loc, localStr);
+                    if (localeData.main_build != build_loc)
                     {
-                        std::string dbc_filename_loc = dbc_path + localStr->name + "/" + filename;
-                        char buf[200];
-                        snprintf(buf, 200, " (exist, but DBC locale subdir %s have DBCs for build %u instead expected build %u, it and other DBC from subdir skipped)", localStr->name, build_loc, localeData.main_build);
-                        errlist.push_back(dbc_filename_loc + buf);
+                        localeData.availableDbcLocales &= ~(1 << i); // mark as not available for speedup next checks
+
+                        // exist but wrong build
+                        if (build_loc)
+                        {
+                            std::string dbc_filename_loc = dbc_path + localStr->name + "/" + filename;
+                            char buf[200];
+                            snprintf(buf, 200, " (exist, but DBC locale subdir %s have DBCs for build %u instead expected build %u, it and other DBC from subdir skipped)", localStr->name, build_loc, localeData.main_build);
+                            errlist.push_back(dbc_filename_loc + buf);
+                        }
+
+                        continue;
                     }
-
-                    continue;
                 }
             }
 
             std::string dbc_filename_loc = dbc_path + localStr->name + "/" + filename;
             if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
+            {
+                ACE_Guard<ACE_Thread_Mutex> guard(queue.GetLock());
                 localeData.availableDbcLocales &= ~(1 << i);// mark as not available for speedup next checks
+            }
         }
     }
     else
     {
         // sort problematic dbc to (1) non compatible and (2) nonexistent
         FILE* f = fopen(dbc_filename.c_str(), "rb");
+
+        ACE_Guard<ACE_Thread_Mutex> guard(queue.GetLock());
         if (f)
         {
             char buf[100];
@@ -371,6 +473,27 @@ inline void LoadDBC(LocalData& localeData, BarGoLink& bar, StoreProblemList& err
     }
 }
 
+template<class T>
+class DBCStorageLoadJob : public DBCLoadJob
+{
+    public:
+        DBCStorageLoadJob(DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
+            : m_storage(storage), m_dbcPath(dbc_path), m_filename(filename) {}
+
+        void Load(DBCLoadQueue& queue) override { LoadDBC(queue, m_storage, m_dbcPath, m_filename); }
+
+    private:
+        DBCStorage<T>& m_storage;
+        std::string m_dbcPath;
+        std::string m_filename;
+};
+
+template<class T>
+inline void QueueDBC(DBCLoadQueue& queue, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
+{
+    queue.Add(new DBCStorageLoadJob<T>(storage, dbc_path, filename));
+}
+
 void LoadDBCStores(const std::string& dataPath)
 {
     std::string dbcPath = dataPath + "dbc/";
@@ -395,8 +518,114 @@ void LoadDBCStores(const std::string& dataPath)
     StoreProblemList bad_dbc_files;
 
     LocalData availableDbcLocales(build);
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaStore,                dbcPath, "AreaTable.dbc");
+    DBCLoadQueue dbcQueue(availableDbcLocales, bar, bad_dbc_files);
+
+    QueueDBC(dbcQueue, sAreaStore,                dbcPath, "AreaTable.dbc");
+    QueueDBC(dbcQueue, sAchievementStore,         dbcPath, "Achievement.dbc");
+    QueueDBC(dbcQueue, sAchievementCriteriaStore, dbcPath, "Achievement_Criteria.dbc");
+    QueueDBC(dbcQueue, sAreaTriggerStore,         dbcPath, "AreaTrigger.dbc");
+    QueueDBC(dbcQueue, sAreaGroupStore,           dbcPath, "AreaGroup.dbc");
+    QueueDBC(dbcQueue, sAuctionHouseStore,        dbcPath, "AuctionHouse.dbc");
+    QueueDBC(dbcQueue, sBankBagSlotPricesStore,   dbcPath, "BankBagSlotPrices.dbc");
+    QueueDBC(dbcQueue, sBattlemasterListStore,    dbcPath, "BattlemasterList.dbc");
+    QueueDBC(dbcQueue, sBarberShopStyleStore,     dbcPath, "BarberShopStyle.dbc");
+    QueueDBC(dbcQueue, sCharStartOutfitStore,     dbcPath, "CharStartOutfit.dbc");
+    QueueDBC(dbcQueue, sCharTitlesStore,          dbcPath, "CharTitles.dbc");
+    QueueDBC(dbcQueue, sChatChannelsStore,        dbcPath, "ChatChannels.dbc");
+    QueueDBC(dbcQueue, sChrClassesStore,          dbcPath, "ChrClasses.dbc");
+    QueueDBC(dbcQueue, sChrRacesStore,            dbcPath, "ChrRaces.dbc");
+    QueueDBC(dbcQueue, sCinematicSequencesStore,  dbcPath, "CinematicSequences.dbc");
+    QueueDBC(dbcQueue, sCreatureDisplayInfoStore, dbcPath, "CreatureDisplayInfo.dbc");
+    QueueDBC(dbcQueue, sCreatureDisplayInfoExtraStore, dbcPath, "CreatureDisplayInfoExtra.dbc");
+    QueueDBC(dbcQueue, sCreatureFamilyStore,      dbcPath, "CreatureFamily.dbc");
+    QueueDBC(dbcQueue, sCreatureModelDataStore,   dbcPath, "CreatureModelData.dbc");
+    QueueDBC(dbcQueue, sCreatureSpellDataStore,   dbcPath, "CreatureSpellData.dbc");
+    QueueDBC(dbcQueue, sCreatureTypeStore,        dbcPath, "CreatureType.dbc");
+    QueueDBC(dbcQueue, sCurrencyTypesStore,       dbcPath, "CurrencyTypes.dbc");
+    QueueDBC(dbcQueue, sDestructibleModelDataStore, dbcPath, "DestructibleModelData.dbc");
+    QueueDBC(dbcQueue, sDungeonEncounterStore,    dbcPath, "DungeonEncounter.dbc");
+    QueueDBC(dbcQueue, sDurabilityCostsStore,     dbcPath, "DurabilityCosts.dbc");
+    QueueDBC(dbcQueue, sDurabilityQualityStore,   dbcPath, "DurabilityQuality.dbc");
+    QueueDBC(dbcQueue, sEmotesStore,              dbcPath, "Emotes.dbc");
+    QueueDBC(dbcQueue, sEmotesTextStore,          dbcPath, "EmotesText.dbc");
+    QueueDBC(dbcQueue, sFactionStore,             dbcPath, "Faction.dbc");
+    QueueDBC(dbcQueue, sFactionTemplateStore,     dbcPath, "FactionTemplate.dbc");
+    QueueDBC(dbcQueue, sGameObjectDisplayInfoStore, dbcPath, "GameObjectDisplayInfo.dbc");
+    QueueDBC(dbcQueue, sGemPropertiesStore,       dbcPath, "GemProperties.dbc");
+    QueueDBC(dbcQueue, sGlyphPropertiesStore,     dbcPath, "GlyphProperties.dbc");
+    QueueDBC(dbcQueue, sGlyphSlotStore,           dbcPath, "GlyphSlot.dbc");
+    QueueDBC(dbcQueue, sGtBarberShopCostBaseStore, dbcPath, "gtBarberShopCostBase.dbc");
+    QueueDBC(dbcQueue, sGtCombatRatingsStore,     dbcPath, "gtCombatRatings.dbc");
+    QueueDBC(dbcQueue, sGtChanceToMeleeCritBaseStore, dbcPath, "gtChanceToMeleeCritBase.dbc");
+    QueueDBC(dbcQueue, sGtChanceToMeleeCritStore, dbcPath, "gtChanceToMeleeCrit.dbc");
+    QueueDBC(dbcQueue, sGtChanceToSpellCritBaseStore, dbcPath, "gtChanceToSpellCritBase.dbc");
+    QueueDBC(dbcQueue, sGtChanceToSpellCritStore, dbcPath, "gtChanceToSpellCrit.dbc");
+    QueueDBC(dbcQueue, sGtOCTClassCombatRatingScalarStore, dbcPath, "gtOCTClassCombatRatingScalar.dbc");
+    QueueDBC(dbcQueue, sGtOCTRegenHPStore,        dbcPath, "gtOCTRegenHP.dbc");
+    // QueueDBC(dbcQueue,sGtOCTRegenMPStore,        dbcPath,"gtOCTRegenMP.dbc");       -- not used currently
+    QueueDBC(dbcQueue, sGtRegenHPPerSptStore,     dbcPath, "gtRegenHPPerSpt.dbc");
+    QueueDBC(dbcQueue, sGtRegenMPPerSptStore,     dbcPath, "gtRegenMPPerSpt.dbc");
+    QueueDBC(dbcQueue, sHolidaysStore,            dbcPath, "Holidays.dbc");
+    QueueDBC(dbcQueue, sItemStore,                dbcPath, "Item.dbc");
+    QueueDBC(dbcQueue, sItemBagFamilyStore,       dbcPath, "ItemBagFamily.dbc");
+    QueueDBC(dbcQueue, sLFGDungeonStore,          dbcPath, "LFGDungeons.dbc");
+    QueueDBC(dbcQueue, sLFGDungeonExpansionStore, dbcPath, "LFGDungeonExpansion.dbc");
+    QueueDBC(dbcQueue, sItemClassStore,           dbcPath, "ItemClass.dbc");
+    // QueueDBC(dbcQueue,sItemDisplayInfoStore,     dbcPath,"ItemDisplayInfo.dbc");     -- not used currently
+    // QueueDBC(dbcQueue,sItemCondExtCostsStore,    dbcPath,"ItemCondExtCosts.dbc");
+    QueueDBC(dbcQueue, sItemExtendedCostStore,    dbcPath, "ItemExtendedCost.dbc");
+    QueueDBC(dbcQueue, sItemLimitCategoryStore,   dbcPath, "ItemLimitCategory.dbc");
+    QueueDBC(dbcQueue, sItemRandomPropertiesStore, dbcPath, "ItemRandomProperties.dbc");
+    QueueDBC(dbcQueue, sItemRandomSuffixStore,    dbcPath, "ItemRandomSuffix.dbc");
+    QueueDBC(dbcQueue, sItemSetStore,             dbcPath, "ItemSet.dbc");
+    QueueDBC(dbcQueue, sLiquidTypeStore,          dbcPath, "LiquidType.dbc");
+    QueueDBC(dbcQueue, sLockStore,                dbcPath, "Lock.dbc");
+    QueueDBC(dbcQueue, sMailTemplateStore,        dbcPath, "MailTemplate.dbc");
+    QueueDBC(dbcQueue, sMapStore,                 dbcPath, "Map.dbc");
+    QueueDBC(dbcQueue, sMapDifficultyStore,       dbcPath, "MapDifficulty.dbc");
+    QueueDBC(dbcQueue, sMovieStore,               dbcPath, "Movie.dbc");
+    QueueDBC(dbcQueue, sOverrideSpellDataStore,   dbcPath, "OverrideSpellData.dbc");
+    QueueDBC(dbcQueue, sQuestFactionRewardStore,  dbcPath, "QuestFactionReward.dbc");
+    QueueDBC(dbcQueue, sQuestSortStore,           dbcPath, "QuestSort.dbc");
+    QueueDBC(dbcQueue, sQuestXPLevelStore,        dbcPath, "QuestXP.dbc");
+    QueueDBC(dbcQueue, sPvPDifficultyStore,       dbcPath, "PvpDifficulty.dbc");
+    QueueDBC(dbcQueue, sRandomPropertiesPointsStore, dbcPath, "RandPropPoints.dbc");
+    QueueDBC(dbcQueue, sScalingStatDistributionStore, dbcPath, "ScalingStatDistribution.dbc");
+    QueueDBC(dbcQueue, sScalingStatValuesStore,   dbcPath, "ScalingStatValues.dbc");
+    QueueDBC(dbcQueue, sSkillLineStore,           dbcPath, "SkillLine.dbc");
+    QueueDBC(dbcQueue, sSkillLineAbilityStore,    dbcPath, "SkillLineAbility.dbc");
+    QueueDBC(dbcQueue, sSkillRaceClassInfoStore,  dbcPath, "SkillRaceClassInfo.dbc");
+    QueueDBC(dbcQueue, sSoundEntriesStore,        dbcPath, "SoundEntries.dbc");
+    QueueDBC(dbcQueue, sSpellStore,               dbcPath, "Spell.dbc");
+    QueueDBC(dbcQueue, sSpellCastTimesStore,      dbcPath, "SpellCastTimes.dbc");
+    QueueDBC(dbcQueue, sSpellDurationStore,       dbcPath, "SpellDuration.dbc");
+    QueueDBC(dbcQueue, sSpellDifficultyStore,     dbcPath, "SpellDifficulty.dbc");
+    QueueDBC(dbcQueue, sSpellFocusObjectStore,    dbcPath, "SpellFocusObject.dbc");
+    QueueDBC(dbcQueue, sSpellItemEnchantmentStore, dbcPath, "SpellItemEnchantment.dbc");
+    QueueDBC(dbcQueue, sSpellItemEnchantmentConditionStore, dbcPath, "SpellItemEnchantmentCondition.dbc");
+    QueueDBC(dbcQueue, sSpellRadiusStore,         dbcPath, "SpellRadius.dbc");
+    QueueDBC(dbcQueue, sSpellRangeStore,          dbcPath, "SpellRange.dbc");
+    QueueDBC(dbcQueue, sSpellRuneCostStore,       dbcPath, "SpellRuneCost.dbc");
+    QueueDBC(dbcQueue, sSpellShapeshiftFormStore, dbcPath, "SpellShapeshiftForm.dbc");
+    QueueDBC(dbcQueue, sStableSlotPricesStore,    dbcPath, "StableSlotPrices.dbc");
+    QueueDBC(dbcQueue, sSummonPropertiesStore,    dbcPath, "SummonProperties.dbc");
+    QueueDBC(dbcQueue, sTalentStore,              dbcPath, "Talent.dbc");
+    QueueDBC(dbcQueue, sTalentTabStore,           dbcPath, "TalentTab.dbc");
+    QueueDBC(dbcQueue, sTaxiNodesStore,           dbcPath, "TaxiNodes.dbc");
+    QueueDBC(dbcQueue, sTaxiPathStore,            dbcPath, "TaxiPath.dbc");
+    //## TaxiPathNode.dbc ## Loaded only for initialization different structures
+    QueueDBC(dbcQueue, sTaxiPathNodeStore,        dbcPath, "TaxiPathNode.dbc");
+    QueueDBC(dbcQueue, sTeamContributionPoints,   dbcPath, "TeamContributionPoints.dbc");
+    QueueDBC(dbcQueue, sTotemCategoryStore,       dbcPath, "TotemCategory.dbc");
+    QueueDBC(dbcQueue, sVehicleStore,             dbcPath, "Vehicle.dbc");
+    QueueDBC(dbcQueue, sVehicleSeatStore,         dbcPath, "VehicleSeat.dbc");
+    QueueDBC(dbcQueue, sWorldMapAreaStore,        dbcPath, "WorldMapArea.dbc");
+    QueueDBC(dbcQueue, sWMOAreaTableStore,        dbcPath, "WMOAreaTable.dbc");
+    QueueDBC(dbcQueue, sWorldMapOverlayStore,     dbcPath, "WorldMapOverlay.dbc");
+    QueueDBC(dbcQueue, sWorldSafeLocsStore,       dbcPath, "WorldSafeLocs.dbc");
+    QueueDBC(dbcQueue, sWorldStateStore,          dbcPath, "WorldStateUI.dbc");
+
+    dbcQueue.Run();
 
     // must be after sAreaStore loading
     for (uint32 i = 0; i < sAreaStore.GetNumRows(); ++i)    // areaflag numbered from 0
@@ -412,34 +641,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAchievementStore,         dbcPath, "Achievement.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAchievementCriteriaStore, dbcPath, "Achievement_Criteria.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaTriggerStore,         dbcPath, "AreaTrigger.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaGroupStore,           dbcPath, "AreaGroup.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAuctionHouseStore,        dbcPath, "AuctionHouse.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBankBagSlotPricesStore,   dbcPath, "BankBagSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBattlemasterListStore,    dbcPath, "BattlemasterList.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBarberShopStyleStore,     dbcPath, "BarberShopStyle.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharStartOutfitStore,     dbcPath, "CharStartOutfit.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharTitlesStore,          dbcPath, "CharTitles.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChatChannelsStore,        dbcPath, "ChatChannels.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChrClassesStore,          dbcPath, "ChrClasses.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChrRacesStore,            dbcPath, "ChrRaces.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCinematicSequencesStore,  dbcPath, "CinematicSequences.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureDisplayInfoStore, dbcPath, "CreatureDisplayInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureDisplayInfoExtraStore, dbcPath, "CreatureDisplayInfoExtra.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureFamilyStore,      dbcPath, "CreatureFamily.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureModelDataStore,   dbcPath, "CreatureModelData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureSpellDataStore,   dbcPath, "CreatureSpellData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureTypeStore,        dbcPath, "CreatureType.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCurrencyTypesStore,       dbcPath, "CurrencyTypes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDestructibleModelDataStore, dbcPath, "DestructibleModelData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDungeonEncounterStore,    dbcPath, "DungeonEncounter.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDurabilityCostsStore,     dbcPath, "DurabilityCosts.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDurabilityQualityStore,   dbcPath, "DurabilityQuality.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesStore,              dbcPath, "Emotes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesTextStore,          dbcPath, "EmotesText.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sFactionStore,             dbcPath, "Faction.dbc");
     for (uint32 i = 0; i < sFactionStore.GetNumRows(); ++i)
     {
         FactionEntry const* faction = sFactionStore.LookupEntry(i);
@@ -450,8 +651,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sFactionTemplateStore,     dbcPath, "FactionTemplate.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGameObjectDisplayInfoStore, dbcPath, "GameObjectDisplayInfo.dbc");
     for (uint32 i = 0; i < sGameObjectDisplayInfoStore.GetNumRows(); ++i)
     {
         if (GameObjectDisplayInfoEntry *info = const_cast<GameObjectDisplayInfoEntry*>(sGameObjectDisplayInfoStore.LookupEntry(i)))
@@ -465,49 +664,13 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGemPropertiesStore,       dbcPath, "GemProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGlyphPropertiesStore,     dbcPath, "GlyphProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGlyphSlotStore,           dbcPath, "GlyphSlot.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtBarberShopCostBaseStore, dbcPath, "gtBarberShopCostBase.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtCombatRatingsStore,     dbcPath, "gtCombatRatings.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToMeleeCritBaseStore, dbcPath, "gtChanceToMeleeCritBase.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToMeleeCritStore, dbcPath, "gtChanceToMeleeCrit.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToSpellCritBaseStore, dbcPath, "gtChanceToSpellCritBase.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToSpellCritStore, dbcPath, "gtChanceToSpellCrit.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtOCTClassCombatRatingScalarStore, dbcPath, "gtOCTClassCombatRatingScalar.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtOCTRegenHPStore,        dbcPath, "gtOCTRegenHP.dbc");
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sGtOCTRegenMPStore,        dbcPath,"gtOCTRegenMP.dbc");       -- not used currently
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtRegenHPPerSptStore,     dbcPath, "gtRegenHPPerSpt.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtRegenMPPerSptStore,     dbcPath, "gtRegenMPPerSpt.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sHolidaysStore,            dbcPath, "Holidays.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemStore,                dbcPath, "Item.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemBagFamilyStore,       dbcPath, "ItemBagFamily.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLFGDungeonStore,          dbcPath, "LFGDungeons.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLFGDungeonExpansionStore, dbcPath, "LFGDungeonExpansion.dbc");
     // fill data
     for(uint32 i = 1; i < sLFGDungeonExpansionStore.GetNumRows(); ++i)
     {
         if(LFGDungeonExpansionEntry const* entry = sLFGDungeonExpansionStore.LookupEntry(i))
             sLFGDungeonExpansionMap[MAKE_PAIR32(entry->dungeonID,entry->expansion)] = entry;
     }
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemClassStore,           dbcPath, "ItemClass.dbc");
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sItemDisplayInfoStore,     dbcPath,"ItemDisplayInfo.dbc");     -- not used currently
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sItemCondExtCostsStore,    dbcPath,"ItemCondExtCosts.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemExtendedCostStore,    dbcPath, "ItemExtendedCost.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemLimitCategoryStore,   dbcPath, "ItemLimitCategory.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemRandomPropertiesStore, dbcPath, "ItemRandomProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemRandomSuffixStore,    dbcPath, "ItemRandomSuffix.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemSetStore,             dbcPath, "ItemSet.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLiquidTypeStore,          dbcPath, "LiquidType.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLockStore,                dbcPath, "Lock.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMailTemplateStore,        dbcPath, "MailTemplate.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMapStore,                 dbcPath, "Map.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMapDifficultyStore,       dbcPath, "MapDifficulty.dbc");
+
     // fill data
     for (uint32 i = 1; i < sMapDifficultyStore.GetNumRows(); ++i)
     {
@@ -517,25 +680,11 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMovieStore,               dbcPath, "Movie.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sOverrideSpellDataStore,   dbcPath, "OverrideSpellData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sQuestFactionRewardStore,  dbcPath, "QuestFactionReward.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sQuestSortStore,           dbcPath, "QuestSort.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sQuestXPLevelStore,        dbcPath, "QuestXP.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sPvPDifficultyStore,       dbcPath, "PvpDifficulty.dbc");
     for (uint32 i = 0; i < sPvPDifficultyStore.GetNumRows(); ++i)
         if (PvPDifficultyEntry const* entry = sPvPDifficultyStore.LookupEntry(i))
             if (entry->bracketId > MAX_BATTLEGROUND_BRACKETS)
                 MANGOS_ASSERT(false && "Need update MAX_BATTLEGROUND_BRACKETS by DBC data");
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sRandomPropertiesPointsStore, dbcPath, "RandPropPoints.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sScalingStatDistributionStore, dbcPath, "ScalingStatDistribution.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sScalingStatValuesStore,   dbcPath, "ScalingStatValues.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillLineStore,           dbcPath, "SkillLine.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillLineAbilityStore,    dbcPath, "SkillLineAbility.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillRaceClassInfoStore,  dbcPath, "SkillRaceClassInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSoundEntriesStore,        dbcPath, "SoundEntries.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellStore,               dbcPath, "Spell.dbc");
     for (uint32 i = 1; i < sSpellStore.GetNumRows(); ++i)
     {
         SpellEntry const* spell = sSpellStore.LookupEntry(i);
@@ -579,20 +728,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellCastTimesStore,      dbcPath, "SpellCastTimes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellDurationStore,       dbcPath, "SpellDuration.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellDifficultyStore,     dbcPath, "SpellDifficulty.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellFocusObjectStore,    dbcPath, "SpellFocusObject.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellItemEnchantmentStore, dbcPath, "SpellItemEnchantment.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellItemEnchantmentConditionStore, dbcPath, "SpellItemEnchantmentCondition.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRadiusStore,         dbcPath, "SpellRadius.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRangeStore,          dbcPath, "SpellRange.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRuneCostStore,       dbcPath, "SpellRuneCost.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellShapeshiftFormStore, dbcPath, "SpellShapeshiftForm.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sStableSlotPricesStore,    dbcPath, "StableSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSummonPropertiesStore,    dbcPath, "SummonProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTalentStore,              dbcPath, "Talent.dbc");
-
     // create talent spells set
     for (unsigned int i = 0; i < sTalentStore.GetNumRows(); ++i)
     {
@@ -603,8 +738,6 @@ void LoadDBCStores(const std::string& dataPath)
                 sTalentSpellPosMap[talentInfo->RankID[j]] = TalentSpellPos(i, j);
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTalentTabStore,           dbcPath, "TalentTab.dbc");
-
     // prepare fast data access to bit pos of talent ranks for use at inspecting
     {
         // now have all max ranks (and then bit amount used for store talent ranks in inspect)
@@ -626,16 +759,11 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiNodesStore,           dbcPath, "TaxiNodes.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiPathStore,            dbcPath, "TaxiPath.dbc");
     for (uint32 i = 1; i < sTaxiPathStore.GetNumRows(); ++i)
         if (TaxiPathEntry const* entry = sTaxiPathStore.LookupEntry(i))
             sTaxiPathSetBySource[entry->from][entry->to] = TaxiPathBySourceAndDestination(entry->ID, entry->price);
     uint32 pathCount = sTaxiPathStore.GetNumRows();
 
-    //## TaxiPathNode.dbc ## Loaded only for initialization different structures
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiPathNodeStore,        dbcPath, "TaxiPathNode.dbc");
     // Calculate path nodes count
     std::vector<uint32> pathLength;
     pathLength.resize(pathCount);                           // 0 and some other indexes not used
@@ -705,11 +833,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTeamContributionPoints,   dbcPath, "TeamContributionPoints.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTotemCategoryStore,       dbcPath, "TotemCategory.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sVehicleStore,             dbcPath, "Vehicle.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sVehicleSeatStore,         dbcPath, "VehicleSeat.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldMapAreaStore,        dbcPath, "WorldMapArea.dbc");
     for (uint32 i = 0; i < sWorldMapAreaStore.GetNumRows(); ++i)
     {
         if (WorldMapAreaEntry const* entry = sWorldMapAreaStore.LookupEntry(i))
@@ -718,7 +841,6 @@ void LoadDBCStores(const std::string& dataPath)
                 sWorldMapAreaMap.insert(WorldMapAreaMap::value_type(entry->zone_id, entry));
         }
     }
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWMOAreaTableStore,        dbcPath, "WMOAreaTable.dbc");
     for (uint32 i = 0; i < sWMOAreaTableStore.GetNumRows(); ++i)
     {
         if (WMOAreaTableEntry const* entry = sWMOAreaTableStore.LookupEntry(i))
@@ -726,10 +848,6 @@ void LoadDBCStores(const std::string& dataPath)
             sWMOAreaInfoByTripple.insert(WMOAreaInfoByTripple::value_type(WMOAreaTableTripple(entry->rootId, entry->adtId, entry->groupId), entry));
         }
     }
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldMapOverlayStore,     dbcPath, "WorldMapOverlay.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldSafeLocsStore,       dbcPath, "WorldSafeLocs.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldStateStore,          dbcPath, "WorldStateUI.dbc");
-
     // error checks
     if (bad_dbc_files.size() >= DBCFilesCount)
     {
@@ -133,9 +133,8 @@ void WorldSession::HandleGMTicketCreateOpcode(WorldPacket& recv_data)
     data << uint32(2);                                      // 2 - nothing appears (3-error creating, 5-error updating)
     SendPacket(&data);
 
-    // TODO: Guard player map
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    PlayerRegistry::SnapshotPtr players = sObjectAccessor.GetPlayers();
+    for (PlayerRegistry::MapType::const_iterator itr = players->players.begin(); itr != players->players.end(); ++itr)
     {
         if (itr->second->GetSession()->GetSecurity() >= SEC_GAMEMASTER && itr->second->isAcceptTickets())
             ChatHandler(itr->second).PSendSysMessage(LANG_COMMAND_TICKETNEW, GetPlayer()->GetName());
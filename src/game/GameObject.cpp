@@ -2260,7 +2260,15 @@ void GameObject::EnableCollision(bool enable)
     /*if (enable && !GetMap()->Contains(*m_model))
         GetMap()->Insert(*m_model);*/
 
-    m_model->enable(enable ? GetPhaseMask() : 0);
+    uint32 phasemask = enable ? GetPhaseMask() : 0;
+    if (m_model->getPhaseMask() == phasemask)
+        return;
+
+    m_model->enable(phasemask);
+
+    // cached LOS results around this object are not valid anymore
+    if (GetMap() && GetMap()->ContainsGameObjectModel(*m_model))
+        GetMap()->UpdateGameObjectModel(*m_model);
 }
 
 bool GameObject::CalculateCurrentCollisionState() const
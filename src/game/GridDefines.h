@@ -170,6 +170,31 @@ namespace MaNGOS
         return Compute<CellPair, CENTER_GRID_CELL_ID>(x, y, CENTER_GRID_CELL_OFFSET, SIZE_OF_GRID_CELL);
     }
 
+    // check if cell square intersects circle (or entirely inside circle)
+    inline bool IsCellInCircle(CellPair const& cell, float x, float y, float radius, bool entirely)
+    {
+        float low_x = (float(cell.x_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+        float low_y = (float(cell.y_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+        float high_x = low_x + SIZE_OF_GRID_CELL;
+        float high_y = low_y + SIZE_OF_GRID_CELL;
+
+        float dx, dy;
+        if (entirely)
+        {
+            // farthest corner
+            dx = std::max(std::fabs(x - low_x), std::fabs(x - high_x));
+            dy = std::max(std::fabs(y - low_y), std::fabs(y - high_y));
+        }
+        else
+        {
+            // nearest point
+            dx = x < low_x ? low_x - x : (x > high_x ? x - high_x : 0.0f);
+            dy = y < low_y ? low_y - y : (y > high_y ? y - high_y : 0.0f);
+        }
+
+        return dx * dx + dy * dy <= radius * radius;
+    }
+
     inline void NormalizeMapCoord(float& c)
     {
         if (c > MAP_HALFSIZE - 0.5)
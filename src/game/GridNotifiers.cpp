@@ -33,23 +33,50 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
 {
     for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        iter->getSource()->UpdateVisibilityOf(&i_object);
+        Camera* camera = iter->getSource();
+
+        // far observer: object still at client and in visibility range, only short range
+        // stealth/invisibility detection may change - can wait next full update
+        if (i_lodDistance > 0.0f && !camera->GetBody()->IsWithinDist(&i_object, i_lodDistance, false) &&
+            camera->GetBody()->IsWithinDist(&i_object, i_object.GetMap()->GetVisibilityDistance(camera->GetBody()), false) &&
+            camera->GetOwner()->HaveAtClient(i_object.GetObjectGuid()))
+            continue;
+
+        camera->UpdateVisibilityOf(&i_object);
     }
 }
 
-void VisibleNotifier::Notify()
+void VisibleNotifier::Notify(float keepRange)
 {
     Player& player = *i_camera.GetOwner();
-    // at this moment i_clientGuids have guids that not iterate at grid level checks
+
+    player.TouchClientGuids(i_touched, i_stamp);
+
+    // client guids not touched by this update - not iterate at grid level checks
+    GuidSet clientGuids;
+    player.GetClientGuidsNotTouchedSince(i_stamp, clientGuids);
+
+    // at this moment clientGuids have guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     // FIXME - need remove this hack after full repair per-grid visibility on transport!
     if (Transport* transport = player.GetTransport())
-        transport->GetTransportBase()->CallForAllPassengers(UpdateVisibilityOfWithHelper(player, i_clientGuids, i_data, i_visibleNow));
+        transport->GetTransportBase()->CallForAllPassengers(UpdateVisibilityOfWithHelper(player, clientGuids, i_data, i_visibleNow));
+
+    WorldObject* viewPoint = i_camera.GetBody();
 
     // generate outOfRange for not iterate objects
-    for (GuidSet::iterator itr = i_clientGuids.begin(); itr != i_clientGuids.end(); ++itr)
+    for (GuidSet::iterator itr = clientGuids.begin(); itr != clientGuids.end(); ++itr)
     {
         ObjectGuid guid = *itr;
+
+        // incremental update skip cells where visibility can't be changed by viewpoint move (out of stealth detect range)
+        if (keepRange > 0.0f)
+        {
+            WorldObject* object = player.GetMap()->GetWorldObject(guid);
+            if (object && object->IsInWorld() && viewPoint->IsWithinDist2d(object->GetPositionX(), object->GetPositionY(), keepRange))
+                continue;
+        }
+
         if (!player.GetMap()->IsVisibleGlobally(guid))
         {
             i_data.AddOutOfRangeGuid(guid);
@@ -72,12 +99,18 @@ void VisibleNotifier::Notify()
         }
     }
 
+    // playerbots have no client
+    bool isBot = player.GetSession()->IsBotSession();
+
     if (i_data.HasData())
     {
         // send create/outofrange packet to player (except player create updates that already sent using SendUpdateToPlayer)
-        WorldPacket packet;
-        i_data.BuildPacket(&packet);
-        player.GetSession()->SendPacket(&packet);
+        if (!isBot)
+        {
+            WorldPacket packet;
+            i_data.BuildPacket(&packet);
+            player.GetSession()->SendPacket(&packet);
+        }
 
         // send out of range to other players if need
         GuidSet const& oor = i_data.GetOutOfRangeGuids();
@@ -97,7 +130,7 @@ void VisibleNotifier::Notify()
     for (WorldObjectSet::const_iterator vItr = i_visibleNow.begin(); vItr != i_visibleNow.end(); ++vItr)
     {
         // target aura duration for caster show only if target exist at caster client
-        if ((*vItr) != &player && (*vItr)->isType(TYPEMASK_UNIT))
+        if (!isBot && (*vItr) != &player && (*vItr)->isType(TYPEMASK_UNIT))
             player.SendAurasForTarget((Unit*)(*vItr));
     }
 }
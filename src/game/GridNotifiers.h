@@ -29,6 +29,7 @@
 #include "GameObject.h"
 #include "Player.h"
 #include "Unit.h"
+#include "CellObjectIndex.h"
 
 namespace MaNGOS
 {
@@ -36,20 +37,23 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGuids;
+        uint32 i_stamp;
         WorldObjectSet i_visibleNow;
+        std::vector<ObjectGuid> i_touched;                  // visited objects, client guids stamped at once in Notify
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGuids(c.GetOwner()->GetClientGuids()) {}
+        explicit VisibleNotifier(Camera& c) : i_camera(c), i_stamp(c.GetOwner()->NewClientGuidsStamp()) {}
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
-        void Notify(void);
+        // keepRange - for not visited client objects: still in this range objects keep state (used by incremental update)
+        void Notify(float keepRange = 0.0f);
     };
 
     struct MANGOS_DLL_DECL VisibleChangesNotifier
     {
         WorldObject& i_object;
+        float i_lodDistance;                                // observers farther skipped if object stays visible for them
 
-        explicit VisibleChangesNotifier(WorldObject& object) : i_object(object) {}
+        explicit VisibleChangesNotifier(WorldObject& object, float lodDistance = 0.0f) : i_object(object), i_lodDistance(lodDistance) {}
         template<class T> void Visit(GridRefManager<T>&) {}
         void Visit(CameraMapType&);
     };
@@ -281,6 +285,37 @@ namespace MaNGOS
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
 
+    // Cell object index helpers
+
+    // range filter used by searchers before check call, checks without overload visit all cell objects
+    template<class Check>
+    inline bool GetCellIndexFilter(Check const& /*check*/, CellObjectIndexFilter& /*filter*/) { return false; }
+
+    // objects which can pass IsWithinDistInMap(obj, range) 3d check
+    inline bool FillCellIndexFilter(CellObjectIndexFilter& filter, WorldObject const* obj, float range)
+    {
+        filter.x = obj->GetPositionX();
+        filter.y = obj->GetPositionY();
+        filter.z = obj->GetPositionZ();
+        filter.range = range + obj->GetObjectBoundingRadius();
+        filter.is3D = true;
+        return true;
+    }
+
+    // pass objects found by index to searcher
+    template<class T, class Searcher>
+    struct MANGOS_DLL_DECL CellIndexVisitor
+    {
+        Searcher& i_searcher;
+
+        explicit CellIndexVisitor(Searcher& searcher) : i_searcher(searcher) {}
+        void operator()(WorldObject* obj) { i_searcher.VisitObject(static_cast<T*>(obj)); }
+    };
+
+    // visit cell objects accepted by index range filter, return false if index can't be used for the cell
+    template<class T, class Check, class Searcher>
+    bool VisitCellIndex(GridRefManager<T>& m, Check const& check, uint32 phaseMask, Searcher& searcher);
+
     // Gameobject searchers
 
     template<class Check>
@@ -378,6 +413,7 @@ namespace MaNGOS
 
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
+        void VisitObject(Unit* u);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
@@ -426,6 +462,7 @@ namespace MaNGOS
             : i_phaseMask(check.GetFocusObject().GetPhaseMask()), i_objects(objects), i_check(check) {}
 
         void Visit(CreatureMapType& m);
+        void VisitObject(Creature* c);
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) {}
     };
@@ -870,6 +907,7 @@ namespace MaNGOS
                 i_controlledByPlayer = obj->IsControlledByPlayer();
             }
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            bool GetCellIndexFilter(CellObjectIndexFilter& filter) const { return FillCellIndexFilter(filter, i_obj, i_range); }
             bool operator()(Unit* u)
             {
                 if (u->isAlive() && i_obj->IsWithinDistInMap(u, i_range) && (i_controlledByPlayer ? !i_obj->IsFriendlyTo(u) : i_obj->IsHostileTo(u)))
@@ -883,6 +921,8 @@ namespace MaNGOS
             float i_range;
     };
 
+    inline bool GetCellIndexFilter(AnyUnfriendlyUnitInObjectRangeCheck const& check, CellObjectIndexFilter& filter) { return check.GetCellIndexFilter(filter); }
+
     class AnyUnfriendlyVisibleUnitInObjectRangeCheck
     {
         public:
@@ -907,6 +947,7 @@ namespace MaNGOS
         public:
             AnyFriendlyUnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            bool GetCellIndexFilter(CellObjectIndexFilter& filter) const { return FillCellIndexFilter(filter, i_obj, i_range); }
             bool operator()(Unit* u)
             {
                 if (u->isAlive() && i_obj->IsWithinDistInMap(u, i_range) && i_obj->IsFriendlyTo(u))
@@ -919,11 +960,14 @@ namespace MaNGOS
             float i_range;
     };
 
+    inline bool GetCellIndexFilter(AnyFriendlyUnitInObjectRangeCheck const& check, CellObjectIndexFilter& filter) { return check.GetCellIndexFilter(filter); }
+
     class AnyUnitInObjectRangeCheck
     {
         public:
             AnyUnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            bool GetCellIndexFilter(CellObjectIndexFilter& filter) const { return FillCellIndexFilter(filter, i_obj, i_range); }
             bool operator()(Unit* u)
             {
                 if (u->isAlive() && i_obj->IsWithinDistInMap(u, i_range))
@@ -936,6 +980,8 @@ namespace MaNGOS
             float i_range;
     };
 
+    inline bool GetCellIndexFilter(AnyUnitInObjectRangeCheck const& check, CellObjectIndexFilter& filter) { return check.GetCellIndexFilter(filter); }
+
     // Success at unit in range, range update for next check (this can be use with UnitLastSearcher to find nearest unit)
     class NearestAttackableUnitInObjectRangeCheck
     {
@@ -1013,6 +1059,7 @@ namespace MaNGOS
                 i_targetForPlayer = i_obj->IsControlledByPlayer();
             }
             WorldObject const& GetFocusObject() const { return *i_obj; }
+            bool GetCellIndexFilter(CellObjectIndexFilter& filter) const { return FillCellIndexFilter(filter, i_obj, i_range); }
             bool operator()(Unit* u)
             {
                 // Check contains checks for: live, non-selectable, non-attackable flags, flight check and GM check, ignore totems
@@ -1034,6 +1081,8 @@ namespace MaNGOS
             bool i_targetForPlayer;
     };
 
+    inline bool GetCellIndexFilter(AnyAoETargetUnitInObjectRangeCheck const& check, CellObjectIndexFilter& filter) { return check.GetCellIndexFilter(filter); }
+
     // do attack at call of help to friendly crearture
     class CallOfHelpCreatureInRangeDo
     {
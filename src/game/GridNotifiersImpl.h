@@ -30,13 +30,38 @@
 #include "DBCEnums.h"
 #include "DBCStores.h"
 
+template<class T, class Check, class Searcher>
+bool MaNGOS::VisitCellIndex(GridRefManager<T>& m, Check const& check, uint32 phaseMask, Searcher& searcher)
+{
+    if (m.isEmpty())
+        return true;
+
+    CellObjectIndexFilter filter;
+    if (!GetCellIndexFilter(check, filter))
+        return false;
+
+    // all objects of cell container are in same index
+    T* first = m.getFirst()->getSource();
+    CellObjectIndex const* index = first->GetCellObjectIndex();
+    filter.typeId = TypeID(first->GetTypeId());
+    filter.phaseMask = phaseMask;
+
+    // index not in sync with container (object added by way not updating index), walk container
+    if (!index || index->Count(filter.typeId) != m.getSize())
+        return false;
+
+    CellIndexVisitor<T, Searcher> visitor(searcher);
+    index->VisitInRange(filter, visitor);
+    return true;
+}
+
 template<class T>
 inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGuids.erase(iter->getSource()->GetObjectGuid());
+        i_touched.push_back(iter->getSource()->GetObjectGuid());
     }
 }
 
@@ -52,6 +77,10 @@ inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType& m)
 
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
+        // dormant creatures are updated after wake up with all skipped time
+        if (iter->getSource()->IsDormant())
+            continue;
+
         ++visitorsCount;
         lastUpdateTime = iter->getSource()->GetLastUpdateTime();
         if (lastUpdateTime == 0)
@@ -84,6 +113,9 @@ inline void MaNGOS::ObjectUpdater::Visit(CreatureMapType& m)
 
     for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
+        if (iter->getSource()->IsDormant())
+            continue;
+
         lastUpdateTime = iter->getSource()->GetLastUpdateTime();
         diffTime = WorldTimer::getMSTimeDiff(lastUpdateTime, WorldTimer::getMSTime());
 
@@ -112,6 +144,9 @@ inline void MaNGOS::ObjectUpdater::Visit(GameObjectMapType& m)
 
 inline void PlayerCreatureRelocationWorker(Player* pl, Creature* c)
 {
+    // player near, return to normal update rate
+    c->WakeUp();
+
     // Creature AI reaction
     if (!c->hasUnitState(UNIT_STAT_LOST_CONTROL))
     {
@@ -527,19 +562,29 @@ void MaNGOS::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
+    if (VisitCellIndex(m, i_check, i_phaseMask, *this))
+        return;
+
     for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
 }
 
 template<class Check>
 void MaNGOS::UnitListSearcher<Check>::Visit(CreatureMapType& m)
 {
+    if (VisitCellIndex(m, i_check, i_phaseMask, *this))
+        return;
+
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void MaNGOS::UnitListSearcher<Check>::VisitObject(Unit* u)
+{
+    if (u->InSamePhase(i_phaseMask))
+        if (i_check(u))
+            i_objects.push_back(u);
 }
 
 // Creature searchers
@@ -580,10 +625,19 @@ void MaNGOS::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 template<class Check>
 void MaNGOS::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
+    if (VisitCellIndex(m, i_check, i_phaseMask, *this))
+        return;
+
     for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+        VisitObject(itr->getSource());
+}
+
+template<class Check>
+void MaNGOS::CreatureListSearcher<Check>::VisitObject(Creature* c)
+{
+    if (c->InSamePhase(i_phaseMask))
+        if (i_check(c))
+            i_objects.push_back(c);
 }
 
 template<class Check>
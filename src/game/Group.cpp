@@ -39,6 +39,7 @@
 
 // Playerbot
 #include "playerbot/PlayerbotMgr.h"
+#include "playerbot/PlayerbotAI.h"
 
 #define LOOT_ROLL_TIMEOUT  (1*MINUTE*IN_MILLISECONDS)
 
@@ -721,6 +722,13 @@ void Group::SendLootStartRoll(uint32 CountDown, uint32 mapid, const Roll &r)
 
         // dependent from player
         RollVoteMask mask = r.GetVoteMaskFor(p);
+
+        if (PlayerbotAI* ai = p->GetPlayerbotAI())
+        {
+            ai->HandleLootStartRoll(r.lootedTargetGUID, r.itemSlot, uint8(mask));
+            continue;
+        }
+
         data.put<uint8>(voteMaskPos,uint8(mask));
 
         p->GetSession()->SendPacket(&data);
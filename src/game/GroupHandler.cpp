@@ -30,6 +30,9 @@
 #include "SocialMgr.h"
 #include "Util.h"
 
+// Playerbot mod
+#include "playerbot/PlayerbotAI.h"
+
 /* differeces from off:
     -you can uninvite yourself - is is useful
     -you can accept invitation even if leader went offline
@@ -54,6 +57,12 @@ void WorldSession::SendPartyResult(PartyOperation operation, const std::string&
 
 void WorldSession::SendGroupInvite(Player* player, bool alreadyInGroup /*= false*/)
 {
+    if (PlayerbotAI* ai = player->GetPlayerbotAI())
+    {
+        ai->HandleGroupInvite();
+        return;
+    }
+
     WorldPacket data(SMSG_GROUP_INVITE, 58);                // guess size
     data << uint8(alreadyInGroup ? 0 : 1);                  // invited/already in group flag
     data << GetPlayer()->GetName();                         // max len 48
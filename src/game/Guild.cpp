@@ -226,7 +226,11 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
     newmember.BankResetTimeMoney = 0;                       // this will force update at first query
     for (int i = 0; i < GUILD_BANK_MAX_TABS; ++i)
         newmember.BankResetTimeTab[i] = 0;
-    members[lowguid] = newmember;
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_membersLock);
+        members[lowguid] = newmember;
+    }
 
     std::string dbPnote   = newmember.Pnote;
     std::string dbOFFnote = newmember.OFFnote;
@@ -541,7 +545,10 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
         }
     }
 
-    members.erase(lowguid);
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_membersLock);
+        members.erase(lowguid);
+    }
 
     Player* player = sObjectMgr.GetPlayer(guid);
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
@@ -354,6 +354,7 @@ class Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = NULL)
         {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_membersLock);
             for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
                 if (Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
                     if (player != except)
@@ -465,6 +466,7 @@ class Guild
         RankList m_Ranks;
 
         MemberList members;
+        ACE_Thread_Mutex m_membersLock;                     // members add/remove vs BroadcastWorker of any session domain thread
 
         typedef std::vector<GuildBankTab*> TabListMap;
         TabListMap m_TabListMap;
@@ -675,6 +675,7 @@ bool ChatHandler::HandleReloadSpellDbcCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading `spell_dbc` Table!" );
     sSpellMgr.LoadSpellDbc();
+    sSpellMgr.LoadSpellDerivedData();
     SendGlobalSysMessage("DB table `spell_dbc` reloaded.");
     return true;
 }
@@ -739,6 +740,7 @@ bool ChatHandler::HandleReloadSpellBonusesCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Spell Bonus Data...");
     sSpellMgr.LoadSpellBonuses();
+    sSpellMgr.LoadSpellDerivedData();
     SendGlobalSysMessage("DB table `spell_bonus_data` (spell damage/healing coefficients) reloaded.");
     return true;
 }
@@ -755,6 +757,7 @@ bool ChatHandler::HandleReloadSpellElixirCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Spell Elixir types...");
     sSpellMgr.LoadSpellElixirs();
+    sSpellMgr.LoadSpellDerivedData();
     SendGlobalSysMessage("DB table `spell_elixir` (spell elixir types) reloaded.");
     return true;
 }
@@ -771,6 +774,7 @@ bool ChatHandler::HandleReloadSpellProcEventCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Spell Proc Event conditions...");
     sSpellMgr.LoadSpellProcEvents();
+    sSpellMgr.LoadSpellDerivedData();
     SendGlobalSysMessage("DB table `spell_proc_event` (spell proc trigger requirements) reloaded.");
     return true;
 }
@@ -5288,8 +5292,8 @@ bool ChatHandler::HandleResetAllCommand(char* args)
     }
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
-    HashMapHolder<Player>::MapType const& plist = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
+    PlayerRegistry::SnapshotPtr players = sObjectAccessor.GetPlayers();
+    for (PlayerRegistry::MapType::const_iterator itr = players->players.begin(); itr != players->players.end(); ++itr)
         itr->second->SetAtLoginFlag(atLogin);
 
     return true;
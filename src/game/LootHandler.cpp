@@ -134,6 +134,9 @@ void WorldSession::HandleAutostoreLootItemOpcode(WorldPacket& recv_data)
     {
         Item* newitem = player->StoreNewItem(dest, item->itemid, true, item->randomPropertyId, item->GetAllowedLooters());
 
+        if (newitem && newitem->GetProto()->Quality >= ITEM_QUALITY_RARE)
+            player->ScheduleUrgentSave();
+
         if (qitem)
         {
             qitem->is_looted = true;
@@ -571,6 +574,8 @@ void WorldSession::HandleLootMasterGiveOpcode(WorldPacket& recv_data)
     // now move item from loot to target inventory
     Item* newitem = target->StoreNewItem(dest, item.itemid, true, item.randomPropertyId, item.GetAllowedLooters());
     target->SendNewItem(newitem, uint32(item.count), false, false, true);
+    if (newitem->GetProto()->Quality >= ITEM_QUALITY_RARE)
+        target->ScheduleUrgentSave();
     target->GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM, item.itemid, item.count);
     target->GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE, pLoot->loot_type, item.count);
     target->GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_LOOT_EPIC_ITEM, item.itemid, item.count);
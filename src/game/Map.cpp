@@ -37,6 +37,7 @@
 #include "MoveMap.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include "Calendar.h"
+#include "WorldMetrics.h"
 
 Map::~Map()
 {
@@ -44,6 +45,10 @@ Map::~Map()
 
     WriteGuard Guard(GetLock(MAP_LOCK_TYPE_MAPOBJECTS));
 
+    for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+        for (uint32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+            delete i_gridIndex[x][y];
+
     if(!m_scriptSchedule.empty())
         sScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
@@ -82,7 +87,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
   i_id(id), i_InstanceId(InstanceId), m_unloadTimer(0),
   m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
   m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-  i_data(NULL), i_script_id(0)
+  i_data(NULL), i_script_id(0), i_objectUpdateTick(0),
+  m_activeCellsUpdateTime(0), m_activeCellsUpdateCount(0), m_clientPlayersCount(0)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
@@ -93,7 +99,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
         {
             //z code
             m_bLoadedGrids[idx][j] = false;
-            setNGrid(NULL, idx, j);
+            i_grids[idx][j] = NULL;
+            i_gridIndex[idx][j] = NULL;
         }
     }
 
@@ -136,12 +143,14 @@ template<class T>
 void Map::AddToGrid(T* obj, NGridType *grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).template AddGridObject<T>(obj);
+    AddToCellObjectIndex(obj, cell, false);
 }
 
 template<>
 void Map::AddToGrid(Player* obj, NGridType *grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).AddWorldObject(obj);
+    AddToCellObjectIndex(obj, cell, true);
 }
 
 template<>
@@ -151,11 +160,13 @@ void Map::AddToGrid(Corpse *obj, NGridType *grid, Cell const& cell)
     if(obj->GetType()!=CORPSE_BONES)
     {
         (*grid)(cell.CellX(), cell.CellY()).AddWorldObject(obj);
+        AddToCellObjectIndex(obj, cell, true);
     }
     // add to grid object store
     else
     {
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject(obj);
+        AddToCellObjectIndex(obj, cell, false);
     }
 }
 
@@ -166,12 +177,14 @@ void Map::AddToGrid(Creature* obj, NGridType *grid, Cell const& cell)
     if (obj->IsPet())
     {
         (*grid)(cell.CellX(), cell.CellY()).AddWorldObject<Creature>(obj);
+        AddToCellObjectIndex(obj, cell, true);
         obj->SetCurrentCell(cell);
     }
     // add to grid object store
     else
     {
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject<Creature>(obj);
+        AddToCellObjectIndex(obj, cell, false);
         obj->SetCurrentCell(cell);
     }
 }
@@ -183,11 +196,13 @@ void Map::AddToGrid(GameObject* obj, NGridType *grid, Cell const& cell)
     if (obj->GetObjectGuid().IsMOTransport())
     {
         (*grid)(cell.CellX(), cell.CellY()).AddWorldObject<GameObject>(obj);
+        AddToCellObjectIndex(obj, cell, true);
     }
     // add to grid object store
     else
     {
         (*grid)(cell.CellX(), cell.CellY()).AddGridObject<GameObject>(obj);
+        AddToCellObjectIndex(obj, cell, false);
     }
 }
 
@@ -195,12 +210,14 @@ template<class T>
 void Map::RemoveFromGrid(T* obj, NGridType *grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).template RemoveGridObject<T>(obj);
+    RemoveFromCellObjectIndex(obj);
 }
 
 template<>
 void Map::RemoveFromGrid(Player* obj, NGridType *grid, Cell const& cell)
 {
     (*grid)(cell.CellX(), cell.CellY()).RemoveWorldObject(obj);
+    RemoveFromCellObjectIndex(obj);
 }
 
 template<>
@@ -210,11 +227,13 @@ void Map::RemoveFromGrid(Corpse *obj, NGridType *grid, Cell const& cell)
     if(obj->GetType()!=CORPSE_BONES)
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveWorldObject(obj);
+        RemoveFromCellObjectIndex(obj);
     }
     // remove from grid object store
     else
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveGridObject(obj);
+        RemoveFromCellObjectIndex(obj);
     }
 }
 
@@ -225,11 +244,13 @@ void Map::RemoveFromGrid(Creature* obj, NGridType *grid, Cell const& cell)
     if (obj->IsPet())
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveWorldObject<Creature>(obj);
+        RemoveFromCellObjectIndex(obj);
     }
     // remove from grid object store
     else
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveGridObject<Creature>(obj);
+        RemoveFromCellObjectIndex(obj);
     }
 }
 
@@ -240,11 +261,13 @@ void Map::RemoveFromGrid(GameObject* obj, NGridType *grid, Cell const& cell)
     if (obj->GetObjectGuid().IsMOTransport())
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveWorldObject<GameObject>(obj);
+        RemoveFromCellObjectIndex(obj);
     }
     // remove from grid object store
     else
     {
         (*grid)(cell.CellX(), cell.CellY()).RemoveGridObject<GameObject>(obj);
+        RemoveFromCellObjectIndex(obj);
     }
 }
 
@@ -273,6 +296,9 @@ Map::EnsureGridCreated(const GridPair &p)
             WriteGuard Guard(GetLock(MAP_LOCK_TYPE_MAPOBJECTS));
             setNGrid(new NGridType(p.x_coord*MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN), sWorld.getConfig(CONFIG_BOOL_GRID_UNLOAD)),
                 p.x_coord, p.y_coord);
+
+            if (!i_gridIndex[p.x_coord][p.y_coord])
+                i_gridIndex[p.x_coord][p.y_coord] = new GridObjectIndex;
         }
 
         // build a linkage between this map and NGridType
@@ -397,6 +423,9 @@ bool Map::Add(Player* player)
     player->SetMap(this);
     CreateAttackersStorageFor(player->GetObjectGuid());
 
+    if (!player->GetSession()->IsBotSession())
+        ++m_clientPlayersCount;
+
     // update player state for other player and visa-versa
     AddToActive(player);
     player->AddToWorld();
@@ -553,6 +582,7 @@ bool Map::loaded(GridPair const& p) const
 void Map::Update(const uint32 &t_diff)
 {
     m_dyn_tree.update(t_diff);
+    m_losCache.Update(t_diff);
 
     // Load all objects in begin of update diff (loading objects count limited by time)
     uint32 loadingObjectToGridUpdateTime = WorldTimer::getMSTime();
@@ -643,8 +673,30 @@ void Map::Update(const uint32 &t_diff)
     }
 
     /// update active cells around players and active objects
+    ACE_Time_Value activeCellsUpdateStart = ACE_OS::gettimeofday();
     resetMarkedCells();
 
+    // cells where creatures can't go dormant, checked by creatures instead of searching players around
+    m_playerNearCells.reset();
+    if (sWorld.getConfig(CONFIG_BOOL_CREATURE_DORMANCY))
+    {
+        float distance = sWorld.getConfig(CONFIG_FLOAT_CREATURE_DORMANCY_DISTANCE);
+        if (distance <= 0.0f)
+            distance = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+
+        for (MapRefManager::iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
+        {
+            Player* plr = itr->getSource();
+            if (!plr->IsInWorld() || !plr->isAlive())
+                continue;
+
+            CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), distance);
+            for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+                for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+                    m_playerNearCells.set(y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x);
+        }
+    }
+
     MaNGOS::ObjectUpdater updater(t_diff);
     // for creature
     TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
@@ -684,6 +736,11 @@ void Map::Update(const uint32 &t_diff)
         }
     }
 
+    ACE_UINT64 activeCellsUpdateTime;
+    (ACE_OS::gettimeofday() - activeCellsUpdateStart).to_usec(activeCellsUpdateTime);
+    m_activeCellsUpdateTime += activeCellsUpdateTime;
+    ++m_activeCellsUpdateCount;
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
@@ -721,6 +778,9 @@ void Map::Remove(Player* player, bool remove)
 
     RemoveFromActive(player);
 
+    if (!player->GetSession()->IsBotSession())
+        --m_clientPlayersCount;
+
     if (remove)
         player->CleanupsBeforeDelete();
 
@@ -1008,6 +1068,10 @@ bool Map::UnloadGrid(NGridType& grid, bool pForce)
     unloader.UnloadN();
     setNGrid(NULL, grid.getX(), grid.getY());
 
+    // detach objects still placed in world containers of unloaded grid
+    delete i_gridIndex[grid.getX()][grid.getY()];
+    i_gridIndex[grid.getX()][grid.getY()] = NULL;
+
     DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Map::UnloadGrid unloading grid[%u,%u] for map %u finished", grid.getX(), grid.getY(), GetId(), GetInstanceId());
 
     int gx = (MAX_NUMBER_OF_GRIDS - 1) - grid.getX();
@@ -1121,10 +1185,10 @@ void UpdateObjectVisibilityWithHelper::operator() (WorldObject* object) const
     m_obj->GetMap()->UpdateObjectVisibility(object, m_cell, m_cellpair);
 }
 
-void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair)
+void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair, float lodDistance)
 {
     cell.SetNoCreate();
-    MaNGOS::VisibleChangesNotifier notifier(*obj);
+    MaNGOS::VisibleChangesNotifier notifier(*obj, lodDistance);
     TypeContainerVisitor<MaNGOS::VisibleChangesNotifier, WorldTypeMapContainer > player_notifier(notifier);
     cell.Visit(cellpair, player_notifier, *this, *obj, GetVisibilityDistance(obj));
     if (obj->IsTransport() && obj->GetTransportBase() && obj->GetTransportBase()->HasPassengers())
@@ -1231,9 +1295,33 @@ inline void Map::setNGrid(NGridType* grid, uint32 x, uint32 y)
         sLog.outError("map::setNGrid() Invalid grid coordinates found: %d, %d!",x,y);
         MANGOS_ASSERT(false);
     }
+
+    if (!i_grids[x][y] != !grid)
+        sWorldMetrics.AddLoadedGrids(grid ? 1 : -1);
+
     i_grids[x][y] = grid;
 }
 
+CellObjectIndex* Map::GetCellObjectIndex(Cell const& cell, bool worldObjects) const
+{
+    GridObjectIndex* index = i_gridIndex[cell.GridX()][cell.GridY()];
+    return index ? &index->cells[cell.CellX()][cell.CellY()][worldObjects ? 1 : 0] : NULL;
+}
+
+void Map::AddToCellObjectIndex(WorldObject* obj, Cell const& cell, bool worldObjects)
+{
+    RemoveFromCellObjectIndex(obj);
+
+    if (CellObjectIndex* index = GetCellObjectIndex(cell, worldObjects))
+        index->Insert(obj);
+}
+
+void Map::RemoveFromCellObjectIndex(WorldObject* obj)
+{
+    if (CellObjectIndex* index = obj->GetCellObjectIndex())
+        index->Remove(obj);
+}
+
 void Map::AddObjectToRemoveList(WorldObject* obj, bool immediateCleanup)
 {
     MANGOS_ASSERT(obj && obj->GetMap() == this);
@@ -2005,7 +2093,7 @@ void Map::InsertObject(WorldObject* object)
         return;
 
     WriteGuard Guard(GetLock(MAP_LOCK_TYPE_DEFAULT));
-    m_objectsStore.insert(MapStoredObjectTypesContainer::value_type(object->GetObjectGuid(), object));
+    m_objectsStore.Insert(object);
 }
 
 void Map::EraseObject(WorldObject* object)
@@ -2022,7 +2110,7 @@ void Map::EraseObject(ObjectGuid const& guid)
         return;
 
     WriteGuard Guard(GetLock(MAP_LOCK_TYPE_DEFAULT));
-    m_objectsStore.erase(guid);
+    m_objectsStore.Erase(guid);
 }
 
 WorldObject* Map::FindObject(ObjectGuid const& guid)
@@ -2031,8 +2119,25 @@ WorldObject* Map::FindObject(ObjectGuid const& guid)
         return NULL;
 
     ReadGuard Guard(GetLock(MAP_LOCK_TYPE_DEFAULT));
-    MapStoredObjectTypesContainer::iterator itr = m_objectsStore.find(guid);
-    return (itr == m_objectsStore.end()) ? NULL : itr->second;
+    return m_objectsStore.Find(guid);
+}
+
+WorldObject* Map::FindObject(MapObjectHandle const& handle)
+{
+    if (handle.IsEmpty())
+        return NULL;
+
+    ReadGuard Guard(GetLock(MAP_LOCK_TYPE_DEFAULT));
+    return m_objectsStore.Find(handle);
+}
+
+MapObjectHandle Map::GetObjectHandle(ObjectGuid const& guid)
+{
+    if (guid.IsEmpty())
+        return MapObjectHandle();
+
+    ReadGuard Guard(GetLock(MAP_LOCK_TYPE_DEFAULT));
+    return m_objectsStore.GetHandle(guid);
 }
 
 /**
@@ -2193,10 +2298,18 @@ void Map::RemoveUpdateObject(ObjectGuid const& guid)
     i_objectsToClientUpdate.erase(guid);
 }
 
+void Map::AddDeferredUpdateObject(ObjectGuid const& guid)
+{
+    WriteGuard Guard(GetLock(MAP_LOCK_TYPE_DEFAULT));
+    i_objectsToDeferredUpdate.insert(guid);
+}
+
 void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
 
+    ++i_objectUpdateTick;
+
     while (!GetObjectsUpdateQueue()->empty())
     {
         ObjectGuid guid;
@@ -2229,6 +2342,14 @@ void Map::SendObjectUpdates()
         }
     }
 
+    // objects still have changes not sent to far observers - process at next tick
+    if (!i_objectsToDeferredUpdate.empty())
+    {
+        WriteGuard Guard(GetLock(MAP_LOCK_TYPE_DEFAULT));
+        i_objectsToClientUpdate.insert(i_objectsToDeferredUpdate.begin(), i_objectsToDeferredUpdate.end());
+        i_objectsToDeferredUpdate.clear();
+    }
+
     if (!update_players.empty())
     {
         for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
@@ -2595,8 +2716,17 @@ float Map::GetVisibilityDistance(WorldObject const* obj) const
 
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
+    uint32 generation = m_dyn_tree.getGeneration();
+
+    bool result;
+    if (m_losCache.Lookup(srcX, srcY, srcZ, destX, destY, destZ, phasemask, generation, result))
+        return result;
+
+    result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
         && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+
+    m_losCache.Store(srcX, srcY, srcZ, destX, destY, destZ, phasemask, generation, result);
+    return result;
 }
 
 /**
@@ -2652,6 +2782,11 @@ bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
     return m_dyn_tree.contains(mdl);
 }
 
+void Map::UpdateGameObjectModel(const GameObjectModel& mdl)
+{
+    m_dyn_tree.onModelStateChanged(mdl);
+}
+
 template<class T> void Map::LoadObjectToGrid(uint32& guid, GridType& grid, BattleGround* bg)
 {
     T* obj = new T;
@@ -2664,6 +2799,7 @@ template<class T> void Map::LoadObjectToGrid(uint32& guid, GridType& grid, Battl
     {
         WriteGuard Guard(GetLock(MAP_LOCK_TYPE_MAPOBJECTS));
         grid.AddGridObject(obj);
+        AddToCellObjectIndex(obj, Cell(MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY())), false);
     }
     setUnitCell(obj);
 
@@ -40,7 +40,10 @@
 #include "ObjectLock.h"
 #include "ObjectHandler.h"
 #include "vmap/DynamicTree.h"
+#include "vmap/LineOfSightCache.h"
 #include "WorldObjectEvents.h"
+#include "CellObjectIndex.h"
+#include "MapObjectStore.h"
 
 #include <bitset>
 #include <list>
@@ -56,6 +59,12 @@ class MapPersistentState;
 class WorldPersistentState;
 class DungeonPersistentState;
 class BattleGroundPersistentState;
+
+// packed object positions of all cells in grid, separate for world and grid object containers
+struct GridObjectIndex
+{
+    CellObjectIndex cells[MAX_NUMBER_OF_CELLS][MAX_NUMBER_OF_CELLS][2];
+};
 struct ScriptInfo;
 class BattleGround;
 class GridMap;
@@ -217,6 +226,11 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER> &visitor);
 
+        // cell position index, NULL if grid not created
+        CellObjectIndex* GetCellObjectIndex(Cell const& cell, bool worldObjects) const;
+        void AddToCellObjectIndex(WorldObject* obj, Cell const& cell, bool worldObjects);
+        static void RemoveFromCellObjectIndex(WorldObject* obj);
+
         bool IsRemovalGrid(float x, float y) const
         {
             GridPair p = MaNGOS::ComputeGridPair(x, y);
@@ -288,13 +302,17 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         void AddObjectToRemoveList(WorldObject *obj, bool immediateCleanup = false);
         void RemoveObjectFromRemoveList(WorldObject* obj);
 
-        void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair);
+        void UpdateObjectVisibility(WorldObject* obj, Cell cell, CellPair cellpair, float lodDistance = 0.0f);
 
         void resetMarkedCells() { marked_cells.reset(); }
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
 
+        // player is in creature dormancy distance of cell, updated at each map update
+        bool IsPlayerNearCell(CellPair const& cell) const { return m_playerNearCells.test(cell.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + cell.x_coord); }
+
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
+        bool HaveClientPlayers() const { return m_clientPlayersCount > 0; }  // players except playerbots
         bool isFull() const { return GetPlayersCountExceptGMs() >= GetMaxPlayers(); }
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(uint32 x,uint32 y) const;
@@ -335,18 +353,24 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         WorldObject* GetWorldObject(ObjectGuid const& guid);       // only use if sure that need objects at current map, specially for player case
 
         // Container maked without any locks (for faster search), need make external locks!
-        typedef UNORDERED_MAP<ObjectGuid, WorldObject*> MapStoredObjectTypesContainer;
+        typedef MapObjectStore MapStoredObjectTypesContainer;
         MapStoredObjectTypesContainer const& GetObjectsStore() { return m_objectsStore; }
         void InsertObject(WorldObject* object);
         void EraseObject(WorldObject* object);
         void EraseObject(ObjectGuid const& guid);
         WorldObject* FindObject(ObjectGuid const& guid);
+        WorldObject* FindObject(MapObjectHandle const& handle);   // NULL if object removed from map after handle get
+        MapObjectHandle GetObjectHandle(ObjectGuid const& guid);
 
         // Manipulation with objects update queue
         void AddUpdateObject(ObjectGuid const& guid);
         void RemoveUpdateObject(ObjectGuid const& guid);
         GuidSet const* GetObjectsUpdateQueue() { return &i_objectsToClientUpdate; };
 
+        // objects with value changes deferred for far observers, requeued after current SendObjectUpdates
+        void AddDeferredUpdateObject(ObjectGuid const& guid);
+        uint32 GetObjectUpdateTick() const { return i_objectUpdateTick; }
+
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
 
@@ -396,6 +420,14 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         void InsertGameObjectModel(const GameObjectModel& mdl);
         void RemoveGameObjectModel(const GameObjectModel& mdl);
         bool ContainsGameObjectModel(const GameObjectModel& mdl) const;
+        void UpdateGameObjectModel(const GameObjectModel& mdl);
+
+        LineOfSightCacheStatistic GetLineOfSightCacheStatistic() const { return m_losCache.GetStatistic(); }
+
+        // time (usecs) of object updates in cells around active objects, summed since map creation;
+        // users keep own values from start of their measure and use difference
+        uint64 GetActiveCellsUpdateTime() const { return m_activeCellsUpdateTime; }
+        uint32 GetActiveCellsUpdateCount() const { return m_activeCellsUpdateCount; }
 
         void AddLoadingObject(LoadingObjectQueueMember* obj);
         LoadingObjectQueueMember* GetNextLoadingObject();
@@ -452,6 +484,7 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
         void SendObjectUpdates();
 
         GuidSet i_objectsToClientUpdate;
+        GuidSet i_objectsToDeferredUpdate;
 
         LoadingObjectsQueue i_loadingObjectQueue;
 
@@ -473,14 +506,17 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
     private:
 
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        GridObjectIndex* i_gridIndex[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
         //Shared geodata object with map coord info...
         TerrainInfo* const m_TerrainData;
         DynamicMapTree m_dyn_tree;
+        mutable LineOfSightCache m_losCache;
 
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> m_playerNearCells;
 
         UNORDERED_SET<WorldObject*> i_objectsToRemove;
 
@@ -489,6 +525,12 @@ class MANGOS_DLL_SPEC Map : public GridRefManager<NGridType>
 
         InstanceData* i_data;
         uint32 i_script_id;
+        uint32 i_objectUpdateTick;
+
+        uint64 m_activeCellsUpdateTime;
+        uint32 m_activeCellsUpdateCount;
+
+        uint32 m_clientPlayersCount;
 
         // Map local low guid counters
         ObjectGuidGenerator<HIGHGUID_UNIT> m_CreatureGuids;
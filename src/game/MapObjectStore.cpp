@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MapObjectStore.h"
+#include "Object.h"
+
+#define MAP_OBJECT_STORE_INITIAL_INDEX_SIZE 64
+
+MapObjectStore::MapObjectStore() : m_freeSlot(NO_SLOT), m_indexMask(0), m_count(0)
+{
+    IndexEntry empty = { 0, 0 };
+    m_index.assign(MAP_OBJECT_STORE_INITIAL_INDEX_SIZE, empty);
+    m_indexMask = MAP_OBJECT_STORE_INITIAL_INDEX_SIZE - 1;
+}
+
+bool MapObjectStore::Insert(WorldObject* object)
+{
+    uint64 guid = object->GetObjectGuid().GetRawValue();
+    if (!guid || FindIndex(guid) != NO_SLOT)
+        return false;
+
+    // keep index at least half empty for short probe sequences
+    if ((m_count + 1) * 2 > m_index.size())
+        GrowIndex();
+
+    uint32 slot;
+    if (m_freeSlot != NO_SLOT)
+    {
+        slot = m_freeSlot;
+        m_freeSlot = m_slots[slot].nextFree;
+    }
+    else
+    {
+        Slot newSlot = { NULL, 0, NO_SLOT };
+        slot = m_slots.size();
+        m_slots.push_back(newSlot);
+    }
+
+    Slot& data = m_slots[slot];
+    data.object = object;
+    data.nextFree = NO_SLOT;
+    if (!++data.generation)                                 // 0 reserved for empty handle
+        data.generation = 1;
+
+    InsertIndex(guid, slot);
+    ++m_count;
+    return true;
+}
+
+void MapObjectStore::Erase(ObjectGuid const& guid)
+{
+    uint32 pos = FindIndex(guid.GetRawValue());
+    if (pos == NO_SLOT)
+        return;
+
+    // release slot, generation change invalidate handles
+    uint32 slot = m_index[pos].slot;
+    Slot& data = m_slots[slot];
+    data.object = NULL;
+    if (!++data.generation)
+        data.generation = 1;
+    data.nextFree = m_freeSlot;
+    m_freeSlot = slot;
+
+    // backward shift deletion: move following entries of probe sequence to freed position
+    uint32 hole = pos;
+    for (uint32 next = (hole + 1) & m_indexMask; m_index[next].guid; next = (next + 1) & m_indexMask)
+    {
+        uint32 bucket = GetBucket(m_index[next].guid);
+
+        // entry can fill hole only if its bucket is not in (hole, next] cyclic range
+        bool inRange = hole <= next ? (bucket > hole && bucket <= next) : (bucket > hole || bucket <= next);
+        if (inRange)
+            continue;
+
+        m_index[hole] = m_index[next];
+        hole = next;
+    }
+
+    m_index[hole].guid = 0;
+    m_index[hole].slot = 0;
+    --m_count;
+}
+
+void MapObjectStore::Clear()
+{
+    IndexEntry empty = { 0, 0 };
+    m_index.assign(MAP_OBJECT_STORE_INITIAL_INDEX_SIZE, empty);
+    m_indexMask = MAP_OBJECT_STORE_INITIAL_INDEX_SIZE - 1;
+    m_slots.clear();
+    m_freeSlot = NO_SLOT;
+    m_count = 0;
+}
+
+MapObjectHandle MapObjectStore::GetHandle(ObjectGuid const& guid) const
+{
+    uint32 pos = FindIndex(guid.GetRawValue());
+    if (pos == NO_SLOT)
+        return MapObjectHandle();
+
+    uint32 slot = m_index[pos].slot;
+    return MapObjectHandle(slot, m_slots[slot].generation);
+}
+
+void MapObjectStore::InsertIndex(uint64 guid, uint32 slot)
+{
+    uint32 pos = GetBucket(guid);
+    while (m_index[pos].guid)
+        pos = (pos + 1) & m_indexMask;
+
+    m_index[pos].guid = guid;
+    m_index[pos].slot = slot;
+}
+
+void MapObjectStore::GrowIndex()
+{
+    std::vector<IndexEntry> oldIndex;
+    oldIndex.swap(m_index);
+
+    IndexEntry empty = { 0, 0 };
+    m_index.assign(oldIndex.size() * 2, empty);
+    m_indexMask = m_index.size() - 1;
+
+    for (std::vector<IndexEntry>::const_iterator itr = oldIndex.begin(); itr != oldIndex.end(); ++itr)
+        if (itr->guid)
+            InsertIndex(itr->guid, itr->slot);
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAPOBJECTSTORE_H
+#define MANGOS_MAPOBJECTSTORE_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+#include <vector>
+
+class WorldObject;
+
+// Reference to stored object, stale after object removed from store (slot can be reused by other object)
+struct MapObjectHandle
+{
+    MapObjectHandle() : slot(0), generation(0) {}
+    MapObjectHandle(uint32 _slot, uint32 _generation) : slot(_slot), generation(_generation) {}
+
+    bool IsEmpty() const { return generation == 0; }
+
+    uint32 slot;
+    uint32 generation;                                      // 0 for empty handle
+};
+
+/**
+ * Dense store of map objects.
+ *
+ * Objects are kept in generational slot array (freed slots reused, contiguous iteration) and
+ * found by guid through open addressing table of (guid, slot) pairs, so lookup is hash and
+ * few adjacent array reads without node allocations of UNORDERED_MAP.
+ * Players and database spawns use global guids, so guid can't be used as slot number directly.
+ */
+class MANGOS_DLL_SPEC MapObjectStore
+{
+    public:
+        MapObjectStore();
+
+        bool Insert(WorldObject* object);                   // false if guid already stored
+        void Erase(ObjectGuid const& guid);
+        void Clear();
+
+        WorldObject* Find(ObjectGuid const& guid) const
+        {
+            uint32 pos = FindIndex(guid.GetRawValue());
+            return pos != NO_SLOT ? m_slots[m_index[pos].slot].object : NULL;
+        }
+
+        MapObjectHandle GetHandle(ObjectGuid const& guid) const;
+
+        // NULL for stale or empty handle
+        WorldObject* Find(MapObjectHandle const& handle) const
+        {
+            if (handle.slot >= m_slots.size() || m_slots[handle.slot].generation != handle.generation)
+                return NULL;
+
+            return m_slots[handle.slot].object;
+        }
+
+        uint32 size() const { return m_count; }
+
+        // slots iteration, free slots have NULL object
+        uint32 GetSlotCount() const { return m_slots.size(); }
+        WorldObject* GetSlotObject(uint32 slot) const { return m_slots[slot].object; }
+
+    private:
+        enum { NO_SLOT = 0xFFFFFFFF };
+
+        struct Slot
+        {
+            WorldObject* object;
+            uint32 generation;
+            uint32 nextFree;
+        };
+
+        struct IndexEntry
+        {
+            uint64 guid;                                    // 0 for empty entry
+            uint32 slot;
+        };
+
+        uint32 GetBucket(uint64 guid) const { return uint32((guid * UI64LIT(0x9E3779B97F4A7C15)) >> 32) & m_indexMask; }
+
+        // position of guid in m_index or NO_SLOT
+        uint32 FindIndex(uint64 guid) const
+        {
+            if (!guid)
+                return NO_SLOT;
+
+            for (uint32 pos = GetBucket(guid);; pos = (pos + 1) & m_indexMask)
+            {
+                if (m_index[pos].guid == guid)
+                    return pos;
+
+                if (!m_index[pos].guid)
+                    return NO_SLOT;
+            }
+        }
+
+        void InsertIndex(uint64 guid, uint32 slot);
+        void GrowIndex();
+
+        std::vector<Slot> m_slots;
+        uint32 m_freeSlot;                                  // first free slot in list, NO_SLOT if none
+
+        std::vector<IndexEntry> m_index;                    // size is power of 2, at least half empty
+        uint32 m_indexMask;
+        uint32 m_count;
+};
+
+#endif
@@ -143,9 +143,8 @@ void WorldSession::HandleWhoOpcode( WorldPacket & recv_data )
     data << uint32(clientcount);                            // clientcount place holder, listed count
     data << uint32(clientcount);                            // clientcount place holder, online count
 
-    // TODO: Guard Player map
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    PlayerRegistry::SnapshotPtr players = sObjectAccessor.GetPlayers();
+    for (PlayerRegistry::MapType::const_iterator itr = players->players.begin(); itr != players->players.end(); ++itr)
     {
         Player* pl = itr->second;
 
@@ -253,7 +252,7 @@ void WorldSession::HandleWhoOpcode( WorldPacket & recv_data )
             break;
     }
 
-    uint32 count = m.size();
+    uint32 count = players->players.size();
     data.put( 0, clientcount );                             // insert right count, listed count
     data.put( 4, count > 50 ? count : clientcount );        // insert right count, online count
 
@@ -252,6 +252,9 @@ void MotionMaster::MoveDistract(uint32 timer)
 
 void MotionMaster::Mutate(MovementGenerator* mgen, UnitActionId stateId)
 {
+    if (m_owner->GetTypeId() == TYPEID_UNIT)
+        ((Creature*)m_owner)->WakeUp();
+
     GetUnitStateMgr()->PushAction(stateId, UnitActionPtr(mgen));
 }
 
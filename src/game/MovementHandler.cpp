@@ -211,6 +211,7 @@ void WorldSession::HandleMoveWorldportAckOpcode()
 
     // Set last WS update time to 0 - grant sending ALL WS updates from new map.
     GetPlayer()->SetLastWorldStateUpdateTime(time_t(0));
+    GetPlayer()->SetLastWorldStateVersion(0);
 }
 
 void WorldSession::HandleMoveTeleportAckOpcode(WorldPacket& recv_data)
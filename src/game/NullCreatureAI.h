@@ -34,6 +34,7 @@ class MANGOS_DLL_DECL NullCreatureAI : public CreatureAI
         void EnterEvadeMode() {}
 
         bool IsVisible(Unit *) const { return false;  }
+        bool CanSleep() const { return true; }
 
         void UpdateAI(const uint32) {}
         static int Permissible(const Creature *) { return PERMIT_BASE_IDLE;  }
@@ -37,6 +37,7 @@
 #include "WaypointMovementGenerator.h"
 #include "VMapFactory.h"
 #include "CellImpl.h"
+#include "CellObjectIndex.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "ObjectPosSelector.h"
@@ -1033,6 +1034,10 @@ void Object::BuildUpdateDataForPlayer(Player* player, UpdateDataMapType& update_
     if (!player)
         return;
 
+    // playerbots have no client, bot AI reads object state directly
+    if (player->GetSession()->IsBotSession())
+        return;
+
     UpdateData& data = update_players[player->GetObjectGuid()];
 
     BuildValuesUpdateBlockForPlayer(&data, player);
@@ -1070,12 +1075,16 @@ void Object::MarkForClientUpdate()
 
 WorldObject::WorldObject()
     : loot(this), m_groupLootTimer(0), m_groupLootId(0), m_lootGroupRecipientId(0), m_transportInfo(NULL), movespline(new Movement::MoveSpline()),
-    m_currMap(NULL), m_position(WorldLocation()), m_viewPoint(*this), m_isActiveObject(false), m_LastUpdateTime(WorldTimer::getMSTime())
+    m_currMap(NULL), m_position(WorldLocation()), m_cellIndex(NULL), m_cellIndexSlot(0), m_viewPoint(*this), m_isActiveObject(false), m_LastUpdateTime(WorldTimer::getMSTime()),
+    m_hasLodPendingValues(false)
 {
 }
 
 WorldObject::~WorldObject()
 {
+    if (m_cellIndex)
+        m_cellIndex->Remove(this);
+
     delete movespline;
 }
 
@@ -1131,6 +1140,7 @@ void WorldObject::Relocate(Position const& position)
     bool orientationChanged = bool(fabs(position.o - m_position.o) > M_NULL_F);
 
     m_position = position;
+    UpdateCellObjectIndex();
 
     if (isType(TYPEMASK_UNIT))
     {
@@ -1141,6 +1151,12 @@ void WorldObject::Relocate(Position const& position)
     }
 }
 
+void WorldObject::UpdateCellObjectIndex()
+{
+    if (m_cellIndex)
+        m_cellIndex->Update(this);
+}
+
 void WorldObject::SetOrientation(float orientation)
 {
     Relocate(Position(GetPositionX(), GetPositionY(), GetPositionZ(), orientation, GetPhaseMask()));
@@ -2050,6 +2066,7 @@ void WorldObject::GetNearPoint(WorldObject const* searcher, float &x, float &y,
 void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     m_position.SetPhaseMask(newPhaseMask);
+    UpdateCellObjectIndex();
 
     if (update && IsInWorld())
         UpdateVisibilityAndView();
@@ -2129,12 +2146,12 @@ Creature* WorldObject::GetClosestCreatureWithEntry(WorldObject* pSource, uint32
    return p_Creature;
 }
 
-void WorldObject::UpdateObjectVisibility()
+void WorldObject::UpdateObjectVisibility(float lodDistance)
 {
     CellPair p = MaNGOS::ComputeCellPair(GetPositionX(), GetPositionY());
     Cell cell(p);
 
-    GetMap()->UpdateObjectVisibility(this, cell, p);
+    GetMap()->UpdateObjectVisibility(this, cell, p, lodDistance);
 }
 
 void WorldObject::AddToClientUpdateList()
@@ -2151,7 +2168,16 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType &i_updateDatas;
     WorldObject &i_object;
-    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj)
+    float i_nearDistance;                                   // LOD rings, observers farther than ring distance
+    float i_farDistance;
+    bool i_nearDeferred;                                    // ring not updated at this tick
+    bool i_farDeferred;
+    bool i_deferred;                                        // some observers not updated
+    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d, bool nearDeferred, bool farDeferred) :
+        i_updateDatas(d), i_object(obj),
+        i_nearDistance(sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_NEAR)),
+        i_farDistance(sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_FAR)),
+        i_nearDeferred(nearDeferred), i_farDeferred(farDeferred), i_deferred(false)
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
@@ -2159,25 +2185,144 @@ struct WorldObjectChangeAccumulator
             i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
     }
 
+    bool IsDeferredFor(WorldObject const* viewPoint) const
+    {
+        if (i_farDistance > 0.0f && !viewPoint->IsWithinDist(&i_object, i_farDistance, false))
+            return i_farDeferred;
+
+        if (i_nearDistance > 0.0f && !viewPoint->IsWithinDist(&i_object, i_nearDistance, false))
+            return i_nearDeferred;
+
+        return false;
+    }
+
     void Visit(CameraMapType &m)
     {
         for(CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
         {
             Player* owner = iter->getSource()->GetOwner();
             if (owner && owner != &i_object && owner->HaveAtClient(i_object.GetObjectGuid()))
+            {
+                if ((i_nearDeferred || i_farDeferred) && IsDeferredFor(iter->getSource()->GetBody()))
+                {
+                    i_deferred = true;
+                    continue;
+                }
+
                 i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+            }
         }
     }
 
     template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
 };
 
+bool WorldObject::IsUpdateLODImmediateField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_FIELD_CHARMEDBY:
+            case UNIT_FIELD_CHARMEDBY + 1:
+            case UNIT_FIELD_TARGET:
+            case UNIT_FIELD_TARGET + 1:
+            case UNIT_FIELD_CHANNEL_OBJECT:
+            case UNIT_FIELD_CHANNEL_OBJECT + 1:
+            case UNIT_CHANNEL_SPELL:
+            case UNIT_FIELD_HEALTH:
+            case UNIT_FIELD_MAXHEALTH:
+            case UNIT_FIELD_FACTIONTEMPLATE:
+            case UNIT_FIELD_FLAGS:
+            case UNIT_FIELD_FLAGS_2:
+            case UNIT_FIELD_DISPLAYID:
+            case UNIT_FIELD_MOUNTDISPLAYID:
+            case UNIT_FIELD_BYTES_1:
+            case UNIT_DYNAMIC_FLAGS:
+                return true;
+            case PLAYER_FLAGS:
+                return GetTypeId() == TYPEID_PLAYER;
+            default:
+                return false;
+        }
+    }
+
+    if (GetTypeId() == TYPEID_GAMEOBJECT)
+        return index == GAMEOBJECT_FLAGS || index == GAMEOBJECT_BYTES_1 || index == GAMEOBJECT_DYNAMIC;
+
+    // other world objects not use LOD
+    return true;
+}
+
 void WorldObject::BuildUpdateData( UpdateDataMapType & update_players)
 {
-    WorldObjectChangeAccumulator notifier(*this, update_players);
+    bool nearDeferred = false;
+    bool farDeferred = false;
+
+    if (sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_NEAR) > 0.0f || sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_FAR) > 0.0f)
+    {
+        // coalesce ticks shifted by guid, to spread deferred updates between ticks
+        uint32 tick = GetMap()->GetObjectUpdateTick() + GetGUIDLow();
+        bool nearUpdate = sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_NEAR) > 0.0f && tick % sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_TICKS_NEAR) == 0;
+        bool farUpdate = sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_FAR) > 0.0f && tick % sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_TICKS_FAR) == 0;
+        nearDeferred = !nearUpdate;
+        farDeferred = !farUpdate;
+
+        bool hasChanges = false;
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+        {
+            if (!m_changedValues[index])
+                continue;
+
+            hasChanges = true;
+
+            // combat related changes flushed to all observers at once
+            if (IsUpdateLODImmediateField(index))
+            {
+                nearDeferred = false;
+                farDeferred = false;
+                break;
+            }
+        }
+
+        // only deferred changes left and no ring updated at this tick
+        if (!hasChanges && !nearUpdate && !farUpdate)
+        {
+            GetMap()->AddDeferredUpdateObject(GetObjectGuid());
+            return;
+        }
+
+        // resend deferred changes to all updated observers, some of them could be in LOD ring at previous ticks
+        if (m_hasLodPendingValues)
+        {
+            for (uint16 index = 0; index < m_valuesCount; ++index)
+                if (m_lodPendingValues[index])
+                    m_changedValues[index] = true;
+        }
+    }
+
+    WorldObjectChangeAccumulator notifier(*this, update_players, nearDeferred, farDeferred);
     Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance(this));
 
+    if (notifier.i_deferred)
+    {
+        m_lodPendingValues = m_changedValues;
+        m_hasLodPendingValues = true;
+    }
+    else if (m_hasLodPendingValues)
+    {
+        m_lodPendingValues.clear();
+        m_hasLodPendingValues = false;
+    }
+
     ClearUpdateMask(false);
+
+    // keep object in update queue until all observers updated
+    if (notifier.i_deferred)
+    {
+        m_objectUpdated = true;
+        GetMap()->AddDeferredUpdateObject(GetObjectGuid());
+    }
 }
 
 bool WorldObject::IsControlledByPlayer() const
@@ -2354,6 +2499,10 @@ void WorldObject::KillAllEvents(bool force)
 
 void WorldObject::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
+    // events are processed only by creature update
+    if (GetTypeId() == TYPEID_UNIT)
+        ((Creature*)this)->WakeUp();
+
     MAPLOCK_WRITE(this, MAP_LOCK_TYPE_DEFAULT);
     if (set_addtime)
         GetEvents()->AddEvent(Event, GetEvents()->CalculateTime(e_time), set_addtime);
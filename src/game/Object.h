@@ -79,6 +79,7 @@ class TerrainInfo;
 class Transport;
 class TransportBase;
 class TransportInfo;
+class CellObjectIndex;
 struct MangosStringLocale;
 
 typedef UNORDERED_MAP<ObjectGuid, UpdateData> UpdateDataMapType;
@@ -435,6 +436,7 @@ namespace Movement
 class MANGOS_DLL_SPEC WorldObject : public Object
 {
     friend struct WorldObjectChangeAccumulator;
+    friend class CellObjectIndex;
 
     public:
 
@@ -557,6 +559,10 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         bool InSamePhase(WorldObject const* obj) const { return InSamePhase(obj->GetPhaseMask()); }
         bool InSamePhase(uint32 phasemask) const { return (GetPhaseMask() & phasemask); }
 
+        // packed position copy of grid cell object currently placed in, NULL if not indexed
+        CellObjectIndex* GetCellObjectIndex() const { return m_cellIndex; }
+        void UpdateCellObjectIndex();
+
         uint32 GetZoneId() const;
         uint32 GetAreaId() const;
         void GetZoneAndAreaId(uint32& zoneid, uint32& areaid) const;
@@ -642,7 +648,7 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         void AddObjectToRemoveList();
         void RemoveObjectFromRemoveList();
 
-        void UpdateObjectVisibility();
+        void UpdateObjectVisibility(float lodDistance = 0.0f);
         virtual void UpdateVisibilityAndView();             // update visibility for object and object for all around
 
         // main visibility check function in normal case (ignore grey zone distance check)
@@ -725,6 +731,9 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         void  RemoveNotifiedClient(ObjectGuid const& guid) { m_notifiedClients.erase(guid); };
         bool  HasNotifiedClients() const { return !m_notifiedClients.empty(); };
 
+        // Update rate level of detail: fields always sent to far observers without delay
+        bool IsUpdateLODImmediateField(uint16 index) const;
+
     protected:
         explicit WorldObject();
 
@@ -748,6 +757,8 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         Map* m_currMap;                                     //current object's Map location
 
         WorldLocation m_position;                           // Contains all needed coords for object
+        CellObjectIndex* m_cellIndex;
+        uint32 m_cellIndexSlot;
 
         ViewPoint m_viewPoint;
         WorldUpdateCounter m_updateTracker;
@@ -758,6 +769,9 @@ class MANGOS_DLL_SPEC WorldObject : public Object
         WorldObjectEventProcessor m_Events;
 
         GuidSet    m_notifiedClients;
+
+        std::vector<bool> m_lodPendingValues;               // value changes not sent yet to observers in LOD rings
+        bool m_hasLodPendingValues;
 };
 
 #endif
@@ -78,7 +78,7 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
     if (!guid)
         return NULL;
 
-    Player* plr = HashMapHolder<Player>::Find(guid);
+    Player* plr = PlayerRegistry::Find(guid);
     if (!plr || (!plr->IsInWorld() && inWorld))
         return NULL;
 
@@ -87,21 +87,18 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
 
 Player* ObjectAccessor::FindPlayerByName(const char *name)
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-        if (iter->second->IsInWorld() && ( ::strcmp(name, iter->second->GetName()) == 0 ))
-            return iter->second;
+    Player* plr = PlayerRegistry::FindByName(name);
+    if (!plr || !plr->IsInWorld())
+        return NULL;
 
-    return NULL;
+    return plr;
 }
 
 void
 ObjectAccessor::SaveAllPlayers()
 {
-    HashMapHolder<Player>::ReadGuard g(HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType& m = sObjectAccessor.GetPlayers();
-    for (HashMapHolder<Player>::MapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    PlayerRegistry::SnapshotPtr players = GetPlayers();
+    for (PlayerRegistry::MapType::const_iterator itr = players->players.begin(); itr != players->players.end(); ++itr)
         itr->second->SaveToDB();
 }
 
@@ -184,11 +181,13 @@ ObjectAccessor::AddCorpsesToGrid(GridPair const& gridpair,GridType& grid,Map* ma
             if (iter->second->GetInstanceId() == map->GetInstanceId())
             {
                 grid.AddWorldObject(iter->second);
+                map->AddToCellObjectIndex(iter->second, Cell(MaNGOS::ComputeCellPair(iter->second->GetPositionX(), iter->second->GetPositionY())), true);
             }
         }
         else
         {
             grid.AddWorldObject(iter->second);
+            map->AddToCellObjectIndex(iter->second, Cell(MaNGOS::ComputeCellPair(iter->second->GetPositionX(), iter->second->GetPositionY())), true);
         }
     }
 }
@@ -274,6 +273,97 @@ void ObjectAccessor::RemoveOldCorpses()
     }
 }
 
+std::string PlayerRegistry::GetNameKey(char const* name)
+{
+    std::wstring wname;
+    if (!Utf8toWStr(name, wname))
+        return name;
+
+    wstrToLower(wname);
+
+    std::string key;
+    if (!WStrToUtf8(wname, key))
+        return name;
+
+    return key;
+}
+
+void PlayerRegistry::Publish(Snapshot* snapshot)
+{
+    m_snapshot = SnapshotPtr(snapshot);
+    ++m_generation;
+}
+
+void PlayerRegistry::Insert(Player* player)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_writeLock);
+
+    Snapshot* snapshot = new Snapshot(*m_snapshot);
+    snapshot->players[player->GetObjectGuid()] = player;
+    snapshot->names[GetNameKey(player->GetName())] = player;
+
+    Publish(snapshot);
+}
+
+void PlayerRegistry::Remove(Player* player)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_writeLock);
+
+    if (m_snapshot->players.find(player->GetObjectGuid()) == m_snapshot->players.end())
+        return;
+
+    Snapshot* snapshot = new Snapshot(*m_snapshot);
+    snapshot->players.erase(player->GetObjectGuid());
+
+    NameMapType::iterator itr = snapshot->names.find(GetNameKey(player->GetName()));
+    if (itr != snapshot->names.end() && itr->second == player)
+        snapshot->names.erase(itr);
+
+    Publish(snapshot);
+}
+
+PlayerRegistry::Snapshot const& PlayerRegistry::GetReaderSnapshot()
+{
+    ReaderCache* cache = m_readerCache.ts_object();
+
+    if (cache->generation != m_generation.value())
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_writeLock);
+        cache->snapshot = m_snapshot;
+        cache->generation = m_generation.value();
+    }
+
+    return *cache->snapshot;
+}
+
+Player* PlayerRegistry::Find(ObjectGuid guid)
+{
+    Snapshot const& snapshot = GetReaderSnapshot();
+    MapType::const_iterator itr = snapshot.players.find(guid);
+    return itr != snapshot.players.end() ? itr->second : NULL;
+}
+
+Player* PlayerRegistry::FindByName(char const* name)
+{
+    if (!name || !*name)
+        return NULL;
+
+    Snapshot const& snapshot = GetReaderSnapshot();
+    NameMapType::const_iterator itr = snapshot.names.find(GetNameKey(name));
+    return itr != snapshot.names.end() ? itr->second : NULL;
+}
+
+PlayerRegistry::SnapshotPtr PlayerRegistry::GetSnapshot()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_writeLock);
+    return m_snapshot;
+}
+
+ACE_Thread_Mutex PlayerRegistry::m_writeLock;
+PlayerRegistry::SnapshotPtr PlayerRegistry::m_snapshot(new PlayerRegistry::Snapshot);
+ACE_Atomic_Op<ACE_Thread_Mutex, long> PlayerRegistry::m_generation(0);
+PlayerRegistry::ReaderCacheTSS PlayerRegistry::m_readerCache;
+
 /// Define the static member of HashMapHolder
 
 template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
@@ -281,6 +371,5 @@ template <class T> MANGOSR2_MUTEX_MODEL HashMapHolder<T>::i_lock;
 
 /// Global definitions for the hashmap storage
 
-template class HashMapHolder<Player>;
 template class HashMapHolder<Corpse>;
 
@@ -24,6 +24,8 @@
 #include "Policies/Singleton.h"
 #include <ace/Thread_Mutex.h>
 #include <ace/RW_Thread_Mutex.h>
+#include <ace/Refcounted_Auto_Ptr.h>
+#include <ace/TSS_T.h>
 #include "Utilities/UnorderedMapSet.h"
 #include "Policies/ThreadingModel.h"
 
@@ -83,6 +85,64 @@ class HashMapHolder
         static MapType  m_objectMap;
 };
 
+/**
+ * Online players registry with RCU-like reads.
+ *
+ * Writers (player add/remove to world) build a new immutable snapshot under write lock and publish it
+ * by incrementing generation counter. Readers keep per-thread reference to last seen snapshot and
+ * take write lock only for refresh when generation changed, so in normal case lookup is lock free.
+ * Old snapshots are refcounted and freed after last thread release it.
+ * Snapshot also have name index (lowercase name) for fast lookup by name.
+ */
+class PlayerRegistry
+{
+    public:
+        typedef UNORDERED_MAP<ObjectGuid, Player*> MapType;
+        typedef UNORDERED_MAP<std::string, Player*> NameMapType;
+
+        struct Snapshot
+        {
+            MapType players;
+            NameMapType names;
+        };
+
+        typedef ACE_Refcounted_Auto_Ptr<Snapshot, ACE_Thread_Mutex> SnapshotPtr;
+
+        static void Insert(Player* player);
+        static void Remove(Player* player);
+
+        static Player* Find(ObjectGuid guid);
+        static Player* FindByName(char const* name);
+
+        // safe for iteration without locks, not include players added/removed after call
+        static SnapshotPtr GetSnapshot();
+
+        static std::string GetNameKey(char const* name);
+
+    private:
+        struct ReaderCache
+        {
+            ReaderCache() : generation(-1) {}
+
+            long generation;
+            SnapshotPtr snapshot;
+        };
+
+        typedef ACE_TSS<ReaderCache> ReaderCacheTSS;
+
+        // snapshot actual for current thread
+        static Snapshot const& GetReaderSnapshot();
+        static void Publish(Snapshot* snapshot);
+
+        //Non instanceable only static
+        PlayerRegistry() {}
+
+        static ACE_Thread_Mutex m_writeLock;
+        static SnapshotPtr m_snapshot;
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> m_generation;
+        static ReaderCacheTSS m_readerCache;
+};
+
 class MANGOS_DLL_DECL ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLevelLockable<ObjectAccessor, ACE_Null_Mutex> >
 {
     friend class MaNGOS::OperatorNew<ObjectAccessor>;
@@ -104,9 +164,9 @@ class MANGOS_DLL_DECL ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor,
         static Player* FindPlayerByName(const char *name);
         static void KickPlayer(ObjectGuid guid);
 
-        HashMapHolder<Player>::MapType& GetPlayers()
+        PlayerRegistry::SnapshotPtr GetPlayers()
         {
-            return HashMapHolder<Player>::GetContainer();
+            return PlayerRegistry::GetSnapshot();
         }
 
         void SaveAllPlayers();
@@ -122,9 +182,9 @@ class MANGOS_DLL_DECL ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor,
 
         // For call from Player/Corpse AddToWorld/RemoveFromWorld only
         void AddObject(Corpse *object) { HashMapHolder<Corpse>::Insert(object); }
-        void AddObject(Player *object) { HashMapHolder<Player>::Insert(object); }
+        void AddObject(Player *object) { PlayerRegistry::Insert(object); }
         void RemoveObject(Corpse *object) { HashMapHolder<Corpse>::Remove(object); }
-        void RemoveObject(Player *object) { HashMapHolder<Player>::Remove(object); }
+        void RemoveObject(Player *object) { PlayerRegistry::Remove(object); }
 
     private:
 
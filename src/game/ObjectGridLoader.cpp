@@ -133,6 +133,7 @@ void LoadHelper(CellCorpseSet const& cell_corpses, CellPair& cell, CorpseMapType
             continue;
 
         grid.AddWorldObject(obj);
+        map->AddToCellObjectIndex(obj, Cell(cell), true);
 
         addUnitState(obj,cell);
         obj->SetMap(map);
@@ -72,6 +72,7 @@ std::string ObjectGuid::GetString() const
 template<HighGuid high>
 uint32 ObjectGuidGenerator<high>::Generate()
 {
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
     if (m_nextGuid >= ObjectGuid::GetMaxCounter(high)-1)
     {
         sLog.outError("%s guid overflow!! Can't continue, shutting down server. ",ObjectGuid::GetTypeName(high));
@@ -308,6 +308,7 @@ class ObjectGuidGenerator
 
     private:                                                // fields
         uint32 m_nextGuid;
+        ACE_Thread_Mutex m_lock;                            // item guids generated by map and session domain threads
 };
 
 ByteBuffer& operator<< (ByteBuffer& buf, ObjectGuid const& guid);
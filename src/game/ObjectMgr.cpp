@@ -131,6 +131,7 @@ bool SpellClickInfo::IsFitToRequirements(Player const* player, Creature const* c
 template<typename T>
 T IdGenerator<T>::Generate()
 {
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
     if (m_nextGuid >= std::numeric_limits<T>::max()-1)
     {
         sLog.outError("%s guid overflow!! Can't continue, shutting down server. ",m_name);
@@ -463,6 +464,8 @@ struct SQLCreatureLoader : public SQLStorageLoaderBase<SQLCreatureLoader, SQLSto
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    uint32 GetSnapshotKey() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 void ObjectMgr::LoadCreatureTemplates()
@@ -1203,8 +1206,11 @@ void ObjectMgr::LoadCreatureModelRace()
 void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
-    //                                                0                       1   2    3
-    QueryResult *result = WorldDatabase.Query("SELECT creature.guid, creature.id, map, modelid,"
+    // fetched by binary protocol, no text parsing of ~20 fields of every spawn
+    static SqlStatementID loadCreatures;
+    SqlStatement stmt = WorldDatabase.CreateStatement(loadCreatures,
+    //          0              1            2    3
+        "SELECT creature.guid, creature.id, map, modelid,"
     //   4             5           6           7           8            9              10         11
         "equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint,"
     //   12         13       14          15            16         17         18
@@ -1216,6 +1222,7 @@ void ObjectMgr::LoadCreatures()
         "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid "
         "LEFT OUTER JOIN pool_creature_template ON creature.id = pool_creature_template.id");
 
+    QueryResult *result = stmt.Query();
     if (!result)
     {
         BarGoLink bar(1);
@@ -1753,6 +1760,8 @@ struct SQLItemLoader : public SQLStorageLoaderBase<SQLItemLoader, SQLStorage>
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    uint32 GetSnapshotKey() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 void ObjectMgr::LoadItemPrototypes()
@@ -4947,6 +4956,8 @@ struct SQLInstanceLoader : public SQLStorageLoaderBase<SQLInstanceLoader, SQLSto
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    uint32 GetSnapshotKey() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 void ObjectMgr::LoadInstanceTemplate()
@@ -5008,6 +5019,8 @@ struct SQLWorldLoader : public SQLStorageLoaderBase<SQLWorldLoader, SQLStorage>
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    uint32 GetSnapshotKey() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 void ObjectMgr::LoadWorldTemplate()
@@ -6310,6 +6323,8 @@ struct SQLGameObjectLoader : public SQLStorageLoaderBase<SQLGameObjectLoader, SQ
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    uint32 GetSnapshotKey() const { return sScriptMgr.GetScriptNamesHash(); }
 };
 
 inline void CheckGOLockId(GameObjectInfo const* goInfo,uint32 dataN,uint32 N)
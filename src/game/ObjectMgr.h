@@ -587,6 +587,7 @@ class IdGenerator
     private:                                                // fields
         char const* m_name;
         T m_nextGuid;
+        ACE_Thread_Mutex m_lock;                            // ids generated by map and session domain threads
 };
 
 class ObjectMgr
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "OpcodeStats.h"
+#include "WorldMetrics.h"
+#include "Opcodes.h"
+
+#include <ace/TSS_T.h>
+
+#include <algorithm>
+
+#define CLASS_LOCK MaNGOS::ClassLevelLockable<OpcodeStats, ACE_Thread_Mutex>
+INSTANTIATE_SINGLETON_2(OpcodeStats, CLASS_LOCK);
+INSTANTIATE_CLASS_MUTEX(OpcodeStats, ACE_Thread_Mutex);
+
+#define OPCODE_STATS_FLUSH_INTERVAL     1000                // ms between merges of thread local tables
+
+// handler records of one thread, not merged to totals yet
+struct OpcodeLocalStats
+{
+    OpcodeLocalStats() : lastFlush(0), recorded(false) {}
+
+    OpcodeStatEntry entries[MAX_OPCODE_STAT_THREADS][NUM_MSG_TYPES];
+    uint32 lastFlush;
+    bool recorded;
+};
+
+typedef ACE_TSS<OpcodeLocalStats> OpcodeLocalStatsTSS;
+static OpcodeLocalStatsTSS localStats;
+
+OpcodeStats::OpcodeStats() : m_stats(MAX_OPCODE_STAT_THREADS * NUM_MSG_TYPES)
+{
+}
+
+void OpcodeStats::Record(uint16 opcode, OpcodeStatThread thread, uint32 time, uint32 now)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    OpcodeLocalStats& local = *localStats;
+
+    OpcodeStatEntry& entry = local.entries[thread][opcode];
+    ++entry.count;
+    entry.totalTime += time;
+    if (time > entry.maxTime)
+        entry.maxTime = time;
+
+    local.recorded = true;
+
+    if (WorldTimer::getMSTimeDiff(local.lastFlush, now) >= OPCODE_STATS_FLUSH_INTERVAL)
+        Flush(local, now);
+}
+
+void OpcodeStats::Flush(OpcodeLocalStats& local, uint32 now)
+{
+    local.lastFlush = now;
+    if (!local.recorded)
+        return;
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    for (uint32 thread = 0; thread < MAX_OPCODE_STAT_THREADS; ++thread)
+    {
+        for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+        {
+            OpcodeStatEntry& entry = local.entries[thread][opcode];
+            if (!entry.count)
+                continue;
+
+            OpcodeStatEntry& total = m_stats[thread * NUM_MSG_TYPES + opcode];
+            total.count += entry.count;
+            total.totalTime += entry.totalTime;
+            if (entry.maxTime > total.maxTime)
+                total.maxTime = entry.maxTime;
+
+            sWorldMetrics.CountOpcodeHandler(opcode, OpcodeStatThread(thread), entry.count, entry.totalTime);
+
+            entry = OpcodeStatEntry();
+        }
+    }
+
+    local.recorded = false;
+}
+
+OpcodeStatEntry OpcodeStats::GetStat(uint16 opcode, OpcodeStatThread thread) const
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return OpcodeStatEntry();
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, OpcodeStatEntry());
+    return m_stats[thread * NUM_MSG_TYPES + opcode];
+}
+
+static bool CompareByTotalTime(OpcodeStatReport const& a, OpcodeStatReport const& b)
+{
+    return a.stat.totalTime > b.stat.totalTime;
+}
+
+void OpcodeStats::GetTop(std::vector<OpcodeStatReport>& report, uint32 count) const
+{
+    report.clear();
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+        for (uint32 thread = 0; thread < MAX_OPCODE_STAT_THREADS; ++thread)
+        {
+            for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+            {
+                if (!m_stats[thread * NUM_MSG_TYPES + opcode].count)
+                    continue;
+
+                OpcodeStatReport entry;
+                entry.opcode = opcode;
+                entry.thread = OpcodeStatThread(thread);
+                entry.stat = m_stats[thread * NUM_MSG_TYPES + opcode];
+                report.push_back(entry);
+            }
+        }
+    }
+
+    std::sort(report.begin(), report.end(), CompareByTotalTime);
+    if (report.size() > count)
+        report.resize(count);
+}
+
+void OpcodeStats::Reset()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    m_stats.assign(m_stats.size(), OpcodeStatEntry());
+}
+
+char const* OpcodeStats::GetThreadName(OpcodeStatThread thread)
+{
+    switch (thread)
+    {
+        case OPCODE_STAT_WORLD:  return "world";
+        case OPCODE_STAT_MAP:    return "map";
+        case OPCODE_STAT_DOMAIN: return "domain";
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MANGOS_OPCODESTATS_H
+#define MANGOS_OPCODESTATS_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <ace/Thread_Mutex.h>
+
+#include <vector>
+
+// Thread kind where opcode handler was executed
+enum OpcodeStatThread
+{
+    OPCODE_STAT_WORLD           = 0,                        // World::UpdateSessions, thread-unsafe packets
+    OPCODE_STAT_MAP             = 1,                        // Map::Update, thread-safe packets
+    OPCODE_STAT_DOMAIN          = 2,                        // SessionDomainUpdater, thread-unsafe packets of independent domains
+};
+
+#define MAX_OPCODE_STAT_THREADS   3
+
+struct OpcodeStatEntry
+{
+    OpcodeStatEntry() : count(0), totalTime(0), maxTime(0) {}
+
+    uint64 count;
+    uint64 totalTime;                                       // microseconds
+    uint32 maxTime;                                         // microseconds
+};
+
+struct OpcodeLocalStats;
+
+struct OpcodeStatReport
+{
+    uint16 opcode;
+    OpcodeStatThread thread;
+    OpcodeStatEntry stat;
+};
+
+/**
+ * Call count and execution time of opcode handlers.
+ *
+ * Handlers are recorded into thread local tables without locking, each thread merges its table
+ * into shared totals (and world metrics) at most once per flush interval.
+ */
+class OpcodeStats : public MaNGOS::Singleton<OpcodeStats, MaNGOS::ClassLevelLockable<OpcodeStats, ACE_Thread_Mutex> >
+{
+    public:
+        OpcodeStats();
+
+        // time in microseconds, now is WorldTimer::getMSTime() of caller
+        void Record(uint16 opcode, OpcodeStatThread thread, uint32 time, uint32 now);
+
+        OpcodeStatEntry GetStat(uint16 opcode, OpcodeStatThread thread) const;
+        // up to count entries with biggest total time
+        void GetTop(std::vector<OpcodeStatReport>& report, uint32 count) const;
+        void Reset();
+
+        static char const* GetThreadName(OpcodeStatThread thread);
+
+    private:
+        void Flush(OpcodeLocalStats& local, uint32 now);
+
+        mutable ACE_Thread_Mutex m_lock;
+        std::vector<OpcodeStatEntry> m_stats;               // thread major, NUM_MSG_TYPES entries per thread
+};
+
+#define sOpcodeStats OpcodeStats::Instance()
+
+#endif
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "PacketRateLimiter.h"
+#include "OpcodeStats.h"
+#include "Opcodes.h"
+#include "Log.h"
+#include "Config/Config.h"
+#include "Metrics/Metrics.h"
+
+INSTANTIATE_SINGLETON_1(PacketRateLimiter);
+
+#define PACKET_RATE_RECLASSIFY_INTERVAL     (60 * IN_MILLISECONDS)
+#define PACKET_RATE_RECLASSIFY_MIN_CALLS    100             // handler calls before its average time is trusted
+
+struct PacketRateClassInfo
+{
+    char const* name;
+    char const* configName;
+    float defaultRate;                                      // packets per second
+    float defaultBurst;
+};
+
+static PacketRateClassInfo const rateClassInfo[MAX_PACKET_RATE_CLASSES] =
+{
+    { "unlimited", NULL,                                  0.0f,   0.0f },
+    { "default",   "Network.RateLimit.Default",         100.0f, 300.0f },
+    { "movement",  "Network.RateLimit.Movement",        100.0f, 200.0f },
+    { "chat",      "Network.RateLimit.Chat",             10.0f,  30.0f },
+    { "query",     "Network.RateLimit.Query",            50.0f, 500.0f },
+    { "expensive", "Network.RateLimit.Expensive",         2.0f,  10.0f },
+};
+
+// listed opcodes are never moved to expensive class by measured handler time
+struct PacketRateOpcode
+{
+    Opcodes opcode;
+    PacketRateClass rateClass;
+};
+
+static PacketRateOpcode const rateOpcodes[] =
+{
+    { CMSG_AUTH_SESSION,                PACKET_RATE_UNLIMITED },
+    { CMSG_PING,                        PACKET_RATE_UNLIMITED },
+    { CMSG_KEEP_ALIVE,                  PACKET_RATE_UNLIMITED },
+
+    // dropped ack leaves player stuck in teleport or with not applied speed/root/fly change
+    { MSG_MOVE_WORLDPORT_ACK,                               PACKET_RATE_UNLIMITED },
+    { MSG_MOVE_TELEPORT_ACK,                                PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_RUN_SPEED_CHANGE_ACK,                      PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_RUN_BACK_SPEED_CHANGE_ACK,                 PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_SWIM_SPEED_CHANGE_ACK,                     PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_SWIM_BACK_SPEED_CHANGE_ACK,                PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_WALK_SPEED_CHANGE_ACK,                     PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_TURN_RATE_CHANGE_ACK,                      PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_FLIGHT_SPEED_CHANGE_ACK,                   PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_FLIGHT_BACK_SPEED_CHANGE_ACK,              PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_PITCH_RATE_CHANGE_ACK,                     PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_MOVE_ROOT_ACK,                             PACKET_RATE_UNLIMITED },
+    { CMSG_FORCE_MOVE_UNROOT_ACK,                           PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_KNOCK_BACK_ACK,                             PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_HOVER_ACK,                                  PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_FEATHER_FALL_ACK,                           PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_WATER_WALK_ACK,                             PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_SET_CAN_FLY_ACK,                            PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_SET_CAN_TRANSITION_BETWEEN_SWIM_AND_FLY_ACK, PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_GRAVITY_DISABLE_ACK,                        PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_GRAVITY_ENABLE_ACK,                         PACKET_RATE_UNLIMITED },
+    { CMSG_MOVE_SET_COLLISION_HGT_ACK,                      PACKET_RATE_UNLIMITED },
+
+    // login and transfer keep default budget, but are never moved to expensive class
+    { CMSG_CHAR_ENUM,                   PACKET_RATE_DEFAULT },
+    { CMSG_PLAYER_LOGIN,                PACKET_RATE_DEFAULT },
+    { CMSG_LOGOUT_REQUEST,              PACKET_RATE_DEFAULT },
+    { CMSG_READY_FOR_ACCOUNT_DATA_TIMES, PACKET_RATE_DEFAULT },
+    { CMSG_SET_ACTIVE_MOVER,            PACKET_RATE_DEFAULT },
+    { CMSG_TIME_SYNC_RESP,              PACKET_RATE_DEFAULT },
+
+    { CMSG_MESSAGECHAT,                 PACKET_RATE_CHAT },
+    { CMSG_TEXT_EMOTE,                  PACKET_RATE_CHAT },
+    { CMSG_EMOTE,                       PACKET_RATE_CHAT },
+    { CMSG_JOIN_CHANNEL,                PACKET_RATE_CHAT },
+    { CMSG_CHANNEL_LIST,                PACKET_RATE_CHAT },
+
+    { CMSG_NAME_QUERY,                  PACKET_RATE_QUERY },
+    { CMSG_CREATURE_QUERY,              PACKET_RATE_QUERY },
+    { CMSG_GAMEOBJECT_QUERY,            PACKET_RATE_QUERY },
+    { CMSG_ITEM_QUERY_SINGLE,           PACKET_RATE_QUERY },
+    { CMSG_ITEM_NAME_QUERY,             PACKET_RATE_QUERY },
+    { CMSG_ITEM_TEXT_QUERY,             PACKET_RATE_QUERY },
+    { CMSG_PAGE_TEXT_QUERY,             PACKET_RATE_QUERY },
+    { CMSG_NPC_TEXT_QUERY,              PACKET_RATE_QUERY },
+    { CMSG_QUEST_QUERY,                 PACKET_RATE_QUERY },
+    { CMSG_GUILD_QUERY,                 PACKET_RATE_QUERY },
+
+    { CMSG_WHO,                         PACKET_RATE_EXPENSIVE },
+    { CMSG_AUCTION_LIST_ITEMS,          PACKET_RATE_EXPENSIVE },
+    { CMSG_AUCTION_LIST_BIDDER_ITEMS,   PACKET_RATE_EXPENSIVE },
+    { CMSG_AUCTION_LIST_OWNER_ITEMS,    PACKET_RATE_EXPENSIVE },
+    { CMSG_AUCTION_LIST_PENDING_SALES,  PACKET_RATE_EXPENSIVE },
+    { CMSG_GUILD_ROSTER,                PACKET_RATE_EXPENSIVE },
+    { CMSG_GUILD_BANK_QUERY_TAB,        PACKET_RATE_EXPENSIVE },
+    { CMSG_ARENA_TEAM_ROSTER,           PACKET_RATE_EXPENSIVE },
+    { CMSG_CALENDAR_GET_CALENDAR,       PACKET_RATE_EXPENSIVE },
+    { CMSG_CONTACT_LIST,                PACKET_RATE_EXPENSIVE },
+    { CMSG_GET_MAIL_LIST,               PACKET_RATE_EXPENSIVE },
+    { CMSG_BATTLEFIELD_LIST,            PACKET_RATE_EXPENSIVE },
+    { CMSG_REQUEST_RAID_INFO,           PACKET_RATE_EXPENSIVE },
+    { CMSG_QUERY_INSPECT_ACHIEVEMENTS,  PACKET_RATE_EXPENSIVE },
+};
+
+static char const* GetRateClassLabel(uint32 rateClass)
+{
+    return PacketRateLimiter::GetClassName(rateClass);
+}
+
+PacketRateBuckets::PacketRateBuckets()
+{
+    for (uint32 i = 0; i < MAX_PACKET_RATE_CLASSES; ++i)
+    {
+        m_tokens[i] = -1.0f;                                // filled to burst at first use
+        m_lastTime[i] = 0;
+    }
+}
+
+bool PacketRateBuckets::Consume(PacketRateClass rateClass, uint32 now)
+{
+    float rate = sPacketRateLimiter.GetRate(rateClass);
+    if (rate <= 0.0f)
+        return true;
+
+    float burst = sPacketRateLimiter.GetBurst(rateClass);
+    float& tokens = m_tokens[rateClass];
+
+    if (tokens < 0.0f)
+        tokens = burst;
+    else
+    {
+        tokens += WorldTimer::getMSTimeDiff(m_lastTime[rateClass], now) * rate / IN_MILLISECONDS;
+        if (tokens > burst)
+            tokens = burst;
+    }
+
+    m_lastTime[rateClass] = now;
+
+    if (tokens < 1.0f)
+        return false;
+
+    tokens -= 1.0f;
+    return true;
+}
+
+PacketRateLimiter::PacketRateLimiter() : m_enabled(false), m_classes(NUM_MSG_TYPES, AtomicRateClass(PACKET_RATE_DEFAULT)),
+    m_maxQueueSize(0), m_costlyHandlerTime(0)
+{
+    for (uint32 i = 0; i < MAX_PACKET_RATE_CLASSES; ++i)
+    {
+        m_rates[i] = rateClassInfo[i].defaultRate;
+        m_bursts[i] = rateClassInfo[i].defaultBurst;
+    }
+
+    m_shedCounters[PACKET_SHED_RATE_LIMIT] = sMetrics.AddCounterArray("mangos_packets_shed_total", "Client packets dropped or causing disconnect by rate class",
+        MAX_PACKET_RATE_CLASSES, "class", &GetRateClassLabel, "reason=\"rate_limit\"");
+    m_shedCounters[PACKET_SHED_QUEUE_LIMIT] = sMetrics.AddCounterArray("mangos_packets_shed_total", "Client packets dropped or causing disconnect by rate class",
+        MAX_PACKET_RATE_CLASSES, "class", &GetRateClassLabel, "reason=\"queue_limit\"");
+
+    m_reclassifyTimer.SetInterval(PACKET_RATE_RECLASSIFY_INTERVAL);
+    InitClasses();
+}
+
+void PacketRateLimiter::InitClasses()
+{
+    // built aside, so socket threads never see opcode in intermediate class at config reload
+    std::vector<uint8> classes(NUM_MSG_TYPES, PACKET_RATE_DEFAULT);
+    m_fixedClasses.assign(NUM_MSG_TYPES, false);
+
+    for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+    {
+        char const* name = LookupOpcodeName(opcode);
+        if (strncmp(name, "MSG_MOVE_", 9) == 0 || strncmp(name, "CMSG_MOVE_", 10) == 0 || strncmp(name, "CMSG_FORCE_", 11) == 0)
+            classes[opcode] = PACKET_RATE_MOVEMENT;
+    }
+
+    for (uint32 i = 0; i < countof(rateOpcodes); ++i)
+    {
+        classes[rateOpcodes[i].opcode] = rateOpcodes[i].rateClass;
+        m_fixedClasses[rateOpcodes[i].opcode] = true;
+    }
+
+    for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+        m_classes[opcode] = classes[opcode];
+}
+
+void PacketRateLimiter::LoadConfig()
+{
+    m_enabled = sConfig.GetBoolDefault("Network.RateLimit.Enable", false);
+
+    for (uint32 i = 0; i < MAX_PACKET_RATE_CLASSES; ++i)
+    {
+        PacketRateClassInfo const& info = rateClassInfo[i];
+        if (!info.configName)
+            continue;
+
+        float rate = sConfig.GetFloatDefault((std::string(info.configName) + ".Rate").c_str(), info.defaultRate);
+        float burst = sConfig.GetFloatDefault((std::string(info.configName) + ".Burst").c_str(), info.defaultBurst);
+
+        if (rate < 0.0f)
+        {
+            sLog.outError("%s.Rate (%f) must be >= 0, using default %f.", info.configName, rate, info.defaultRate);
+            rate = info.defaultRate;
+        }
+
+        if (rate > 0.0f && burst < 1.0f)
+        {
+            sLog.outError("%s.Burst (%f) must be >= 1, using 1.", info.configName, burst);
+            burst = 1.0f;
+        }
+
+        m_rates[i] = m_enabled ? rate : 0.0f;
+        m_bursts[i] = burst;
+    }
+
+    // queue cap is part of rate limiting, disabled with it
+    m_maxQueueSize = m_enabled ? sConfig.GetIntDefault("Network.RateLimit.MaxQueueSize", 1000) : 0;
+    m_costlyHandlerTime = sConfig.GetIntDefault("Network.RateLimit.CostlyHandlerTime", 2000);
+
+    // drop opcodes moved by measurements, they are moved again if still costly
+    InitClasses();
+}
+
+void PacketRateLimiter::Update(uint32 diff)
+{
+    if (!m_enabled || !m_costlyHandlerTime)
+        return;
+
+    m_reclassifyTimer.Update(diff);
+    if (!m_reclassifyTimer.Passed())
+        return;
+
+    m_reclassifyTimer.Reset();
+
+    for (uint32 opcode = 0; opcode < NUM_MSG_TYPES; ++opcode)
+    {
+        if (m_fixedClasses[opcode] || m_classes[opcode].value() != PACKET_RATE_DEFAULT)
+            continue;
+
+        uint64 count = 0;
+        uint64 totalTime = 0;
+        for (uint32 thread = 0; thread < MAX_OPCODE_STAT_THREADS; ++thread)
+        {
+            OpcodeStatEntry stat = sOpcodeStats.GetStat(opcode, OpcodeStatThread(thread));
+            count += stat.count;
+            totalTime += stat.totalTime;
+        }
+
+        if (count < PACKET_RATE_RECLASSIFY_MIN_CALLS || totalTime / count < m_costlyHandlerTime)
+            continue;
+
+        m_classes[opcode] = PACKET_RATE_EXPENSIVE;
+        sLog.outString("PacketRateLimiter: opcode %s (0x%.4X) moved to expensive rate class, average handler time " UI64FMTD " us",
+            LookupOpcodeName(opcode), opcode, totalTime / count);
+    }
+}
+
+void PacketRateLimiter::CountShed(PacketShedReason reason, PacketRateClass rateClass)
+{
+    m_shedCounters[reason]->Inc(rateClass);
+}
+
+char const* PacketRateLimiter::GetClassName(uint32 rateClass)
+{
+    return rateClass < MAX_PACKET_RATE_CLASSES ? rateClassInfo[rateClass].name : "unknown";
+}
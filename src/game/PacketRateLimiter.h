@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MANGOS_PACKETRATELIMITER_H
+#define MANGOS_PACKETRATELIMITER_H
+
+#include "Common.h"
+#include "Timer.h"
+#include "Policies/Singleton.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+
+#include <vector>
+
+class MetricCounterArray;
+
+// Budget groups of client opcodes
+enum PacketRateClass
+{
+    PACKET_RATE_UNLIMITED       = 0,                        // auth and ping, limited by own checks
+    PACKET_RATE_DEFAULT         = 1,
+    PACKET_RATE_MOVEMENT        = 2,
+    PACKET_RATE_CHAT            = 3,
+    PACKET_RATE_QUERY           = 4,                        // cache queries, bursts at login
+    PACKET_RATE_EXPENSIVE       = 5,                        // listings and rosters, and opcodes with measured costly handlers
+};
+
+#define MAX_PACKET_RATE_CLASSES   6
+
+enum PacketShedReason
+{
+    PACKET_SHED_RATE_LIMIT      = 0,                        // packet dropped, over class budget
+    PACKET_SHED_QUEUE_LIMIT     = 1,                        // session disconnected, too many not processed packets
+};
+
+#define MAX_PACKET_SHED_REASONS   2
+
+/// Token buckets of one client connection, used only by socket thread
+class PacketRateBuckets
+{
+    public:
+        PacketRateBuckets();
+
+        // take token of opcode class, false if packet must be dropped
+        bool Consume(PacketRateClass rateClass, uint32 now);
+
+    private:
+        float m_tokens[MAX_PACKET_RATE_CLASSES];
+        uint32 m_lastTime[MAX_PACKET_RATE_CLASSES];         // 0 for not used bucket
+};
+
+/**
+ * Client packet budgets, checked by WorldSocket before packet allocation.
+ *
+ * Each opcode belongs to rate class with token bucket (Network.RateLimit.<Class>.Rate/.Burst) per connection.
+ * Opcodes of default class which handlers are measured (OpcodeStats) as costly are moved to expensive class,
+ * except login, transfer and ack opcodes listed in rateOpcodes. Class of opcode is atomic, read by socket threads.
+ */
+class PacketRateLimiter
+{
+    public:
+        PacketRateLimiter();
+
+        void LoadConfig();
+
+        // reclassify opcodes by measured handler time, world thread
+        void Update(uint32 diff);
+
+        bool IsEnabled() const { return m_enabled; }
+        PacketRateClass GetClass(uint16 opcode) const { return opcode < m_classes.size() ? PacketRateClass(m_classes[opcode].value()) : PACKET_RATE_DEFAULT; }
+        float GetRate(PacketRateClass rateClass) const { return m_rates[rateClass]; }
+        float GetBurst(PacketRateClass rateClass) const { return m_bursts[rateClass]; }
+        uint32 GetMaxQueueSize() const { return m_maxQueueSize; }
+
+        void CountShed(PacketShedReason reason, PacketRateClass rateClass);
+
+        static char const* GetClassName(uint32 rateClass);
+
+    private:
+        void InitClasses();
+
+        bool m_enabled;
+        typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> AtomicRateClass;
+        std::vector<AtomicRateClass> m_classes;             // PacketRateClass by opcode, sized once in constructor
+        std::vector<bool> m_fixedClasses;                   // opcodes never reclassified, world thread only
+        float m_rates[MAX_PACKET_RATE_CLASSES];             // tokens per second, 0 for unlimited
+        float m_bursts[MAX_PACKET_RATE_CLASSES];
+        uint32 m_maxQueueSize;
+        uint32 m_costlyHandlerTime;                         // microseconds, 0 for no reclassification
+
+        ShortIntervalTimer m_reclassifyTimer;
+        MetricCounterArray* m_shedCounters[MAX_PACKET_SHED_REASONS];
+};
+
+#define sPacketRateLimiter MaNGOS::Singleton<PacketRateLimiter>::Instance()
+
+#endif
@@ -65,6 +65,7 @@
 #include "DBCStores.h"
 #include "SQLStorages.h"
 #include "Calendar.h"
+#include "PlayerSaveScheduler.h"
 
 #include <cmath>
 
@@ -383,6 +384,8 @@ void TradeData::SetAccepted(bool state, bool crosssend /*= false*/)
 
 //== Player ====================================================
 
+PlayerSaveSectionStats Player::ms_saveSectionStats[MAX_PLAYER_SAVE_SECTIONS];
+
 Player::Player (WorldSession *session): Unit(), m_mover(this), m_camera(NULL), m_achievementMgr(this), m_reputationMgr(this)
 {
     m_speakTime = 0;
@@ -422,6 +425,12 @@ Player::Player (WorldSession *session): Unit(), m_mover(this), m_camera(NULL), m
     // randomize first save time in range [CONFIG_UINT32_INTERVAL_SAVE] around [CONFIG_UINT32_INTERVAL_SAVE]
     // this must help in case next save after mass player load after server startup
     m_nextSave = urand(m_nextSave/2,m_nextSave*3/2);
+    m_saveDisabled = false;
+
+    for (int i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+        m_saveSectionHash[i] = 0;
+    m_characterRowSaved = false;
+    m_urgentSave = false;
 
     clearResurrectRequestData();
 
@@ -477,11 +486,14 @@ Player::Player (WorldSession *session): Unit(), m_mover(this), m_camera(NULL), m
     m_deathExpireTime = 0;
 
     m_lastWSUpdateTime = 0; // == 0 in initialise, for review all updates
+    m_lastWSVersion = 0;
 
     m_swingErrorMsg = 0;
 
     m_DetectInvTimer = 1*IN_MILLISECONDS;
 
+    m_clientGUIDsStamp = 0;
+
     for (int j=0; j < PLAYER_MAX_BATTLEGROUND_QUEUES; ++j)
     {
         m_bgBattleGroundQueueID[j].bgQueueTypeId  = BATTLEGROUND_QUEUE_NONE;
@@ -1406,9 +1418,14 @@ void Player::Update(uint32 update_diff, uint32 p_time)
     {
         if (update_diff >= m_nextSave)
         {
-            // m_nextSave reseted in SaveToDB call
-            SaveToDB();
-            DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            if (sPlayerSaveScheduler.RequestSave(m_urgentSave))
+            {
+                // m_nextSave reseted in SaveToDB call
+                SaveToDB();
+                DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            }
+            else
+                m_nextSave = 1;                             // retry at next update
         }
         else
             m_nextSave -= update_diff;
@@ -2757,6 +2774,8 @@ void Player::GiveLevel(uint32 level)
     if (level == getLevel())
         return;
 
+    ScheduleUrgentSave();
+
     PlayerLevelInfo info;
     sObjectMgr.GetPlayerLevelInfo(getRace(),getClass(),level,&info);
 
@@ -3905,22 +3924,38 @@ void Player::_SaveSpellCooldowns()
     static SqlStatementID deleteSpellCooldown ;
     static SqlStatementID insertSpellCooldown ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
     time_t curTime = time(NULL);
     time_t infTime = curTime + infinityCooldownDelayCheck;
 
     // remove outdated and save active
     RemoveOutdatedSpellCooldowns();
+
+    ByteBuffer data;
+    uint32 count = 0;
     for (SpellCooldowns::const_iterator itr = GetSpellCooldownMap()->begin();itr != GetSpellCooldownMap()->end(); ++itr)
     {
         if (itr->second.end <= infTime)                 // not save locked cooldowns, it will be reset or set at reload
         {
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid,spell,item,time) VALUES(?, ?, ?, ?)");
-            stmt.PExecute(GetGUIDLow(), itr->first, itr->second.itemid, uint64(itr->second.end));
+            data << uint32(itr->first) << uint32(itr->second.itemid) << uint64(itr->second.end);
+            ++count;
         }
     }
+
+    if (!_IsSaveSectionChanged(PLAYER_SAVE_SPELL_COOLDOWNS, data, count + 1))
+        return;
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM character_spell_cooldown WHERE guid = ?");
+    stmt.PExecute(GetGUIDLow());
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint32 spellId = data.read<uint32>();
+        uint32 itemId = data.read<uint32>();
+        uint64 end = data.read<uint64>();
+
+        stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO character_spell_cooldown (guid,spell,item,time) VALUES(?, ?, ?, ?)");
+        stmt.PExecute(GetGUIDLow(), spellId, itemId, end);
+    }
 }
 
 uint32 Player::resetTalentsCost() const
@@ -8793,7 +8828,10 @@ void Player::SendUpdatedWorldStates(bool force)
     if (IsBeingTeleported() || GetLastWorldStateUpdateTime() == time(NULL))
         return;
 
-    if (WorldStateSet* wsSet = sWorldStateMgr.GetUpdatedWorldStatesFor(this, force ? 0 : GetLastWorldStateUpdateTime()))
+    if (force)
+        m_lastWSVersion = 0;
+
+    if (WorldStateSet* wsSet = sWorldStateMgr.GetUpdatedWorldStatesFor(this, m_lastWSVersion))
     {
         for (uint8 i = 0; i < wsSet->count(); ++i)
         {
@@ -16344,6 +16382,8 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder *holder)
         sLFGMgr.RemoveMemberFromLFDGroup(GetGroup(),GetObjectGuid());
     }
 
+    m_characterRowSaved = true;
+
     return true;
 }
 
@@ -17662,6 +17702,10 @@ void Player::SaveToDB()
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    m_urgentSave = false;
+
+    if (m_saveDisabled)
+        return;
 
     //lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
@@ -17678,35 +17722,94 @@ void Player::SaveToDB()
 
     CharacterDatabase.BeginTransaction();
 
-    static SqlStatementID delChar ;
-    static SqlStatementID insChar ;
+    // rarely changed columns, hashed for skip update while unchanged
+    ByteBuffer profile(256);
+    profile << uint32(GetSession()->GetAccountId());
+    profile << m_name;
+    profile << uint8(getRace());
+    profile << uint8(getClass());
+    profile << uint8(getGender());
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delChar, "DELETE FROM characters WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
+    std::ostringstream ss;
+    ss << m_taxi;                                   // string with TaxiMaskSize numbers
+    profile << ss.str();
+    ss.str(std::string());
+
+    profile << uint32(m_resetTalentsCost);
+    profile << uint64(m_resetTalentsTime);
+    profile << uint32(m_ExtraFlags);
+    profile << uint32(m_stableSlots);                       // to prevent save uint8 as char
+    profile << m_taxi.SaveTaxiDestinationsToString();
+    profile << uint32(GetUInt32Value(PLAYER_CHOSEN_TITLE));
+    profile << uint64(GetUInt64Value(PLAYER_FIELD_KNOWN_CURRENCIES));
+    profile << uint32(m_specsCount);
+
+    for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)
+        ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << " ";
+    profile << ss.str();
+    ss.str(std::string());
 
-    SqlStatement uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (guid,account,name,race,class,gender,level,xp,money,playerBytes,playerBytes2,playerFlags,"
-        "map, dungeon_difficulty, position_x, position_y, position_z, orientation, "
-        "taximask, online, cinematic, "
-        "totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, resettalents_cost, resettalents_time, "
-        "trans_x, trans_y, trans_z, trans_o, transguid, extra_flags, stable_slots, at_login, zone, "
-        "death_expire_time, taxi_path, arenaPoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, "
-        "todayKills, yesterdayKills, chosenTitle, knownCurrencies, watchedFaction, drunk, health, power1, power2, power3, "
-        "power4, power5, power6, power7, specCount, activeSpec, exploredZones, equipmentCache, ammoId, knownTitles, actionBars, grantableLevels) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
-        "?, ?, ?, ?, ?, ?, "
-        "?, ?, ?, "
-        "?, ?, ?, ?, ?, ?, ?, "
-        "?, ?, ?, ?, ?, ?, ?, ?, ?, "
-        "?, ?, ?, ?, ?, ?, ?, "
-        "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
-        "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?) ");
+    for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)
+        ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i) << " ";
+    profile << ss.str();
+    ss.str(std::string());
+
+    for (uint32 i = 0; i < KNOWN_TITLES_SIZE*2; ++i)
+        ss << GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i) << " ";
+    profile << ss.str();
+    ss.str(std::string());
+
+    profile << uint32(GetByteValue(PLAYER_FIELD_BYTES, 2));
+    profile << uint32(m_GrantableLevelsCount);
+
+    bool profileChanged = _IsSaveSectionChanged(PLAYER_SAVE_CHARACTER, profile, 0);
+
+    static SqlStatementID insChar ;
+    static SqlStatementID updChar ;
+    static SqlStatementID updCharShort ;
+
+    // all statement forms bind often changed columns first, then profile columns and guid last
+    SqlStatement uberInsert = CharacterDatabase.CreateStatement(updCharShort, "UPDATE characters SET level = ?, xp = ?, money = ?, playerBytes = ?, playerBytes2 = ?, playerFlags = ?, "
+        "map = ?, dungeon_difficulty = ?, position_x = ?, position_y = ?, position_z = ?, orientation = ?, "
+        "online = ?, cinematic = ?, totaltime = ?, leveltime = ?, rest_bonus = ?, logout_time = ?, is_logout_resting = ?, "
+        "trans_x = ?, trans_y = ?, trans_z = ?, trans_o = ?, transguid = ?, at_login = ?, zone = ?, death_expire_time = ?, "
+        "arenaPoints = ?, totalHonorPoints = ?, todayHonorPoints = ?, yesterdayHonorPoints = ?, totalKills = ?, todayKills = ?, yesterdayKills = ?, "
+        "watchedFaction = ?, drunk = ?, health = ?, power1 = ?, power2 = ?, power3 = ?, power4 = ?, power5 = ?, power6 = ?, power7 = ?, "
+        "activeSpec = ?, ammoId = ? WHERE guid = ?");
+
+    if (!m_characterRowSaved)
+        uberInsert = CharacterDatabase.CreateStatement(insChar, "INSERT INTO characters (level, xp, money, playerBytes, playerBytes2, playerFlags, "
+            "map, dungeon_difficulty, position_x, position_y, position_z, orientation, "
+            "online, cinematic, totaltime, leveltime, rest_bonus, logout_time, is_logout_resting, "
+            "trans_x, trans_y, trans_z, trans_o, transguid, at_login, zone, death_expire_time, "
+            "arenaPoints, totalHonorPoints, todayHonorPoints, yesterdayHonorPoints, totalKills, todayKills, yesterdayKills, "
+            "watchedFaction, drunk, health, power1, power2, power3, power4, power5, power6, power7, "
+            "activeSpec, ammoId, "
+            "account, name, race, class, gender, taximask, resettalents_cost, resettalents_time, "
+            "extra_flags, stable_slots, taxi_path, chosenTitle, knownCurrencies, specCount, exploredZones, equipmentCache, knownTitles, "
+            "actionBars, grantableLevels, guid) "
+            "VALUES (?, ?, ?, ?, ?, ?, "
+            "?, ?, ?, ?, ?, ?, "
+            "?, ?, ?, ?, ?, ?, ?, "
+            "?, ?, ?, ?, ?, ?, ?, ?, "
+            "?, ?, ?, ?, ?, ?, ?, "
+            "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+            "?, ?, "
+            "?, ?, ?, ?, ?, ?, ?, ?, "
+            "?, ?, ?, ?, ?, ?, ?, ?, ?, "
+            "?, ?, ?)");
+    else if (profileChanged)
+        uberInsert = CharacterDatabase.CreateStatement(updChar, "UPDATE characters SET level = ?, xp = ?, money = ?, playerBytes = ?, playerBytes2 = ?, playerFlags = ?, "
+            "map = ?, dungeon_difficulty = ?, position_x = ?, position_y = ?, position_z = ?, orientation = ?, "
+            "online = ?, cinematic = ?, totaltime = ?, leveltime = ?, rest_bonus = ?, logout_time = ?, is_logout_resting = ?, "
+            "trans_x = ?, trans_y = ?, trans_z = ?, trans_o = ?, transguid = ?, at_login = ?, zone = ?, death_expire_time = ?, "
+            "arenaPoints = ?, totalHonorPoints = ?, todayHonorPoints = ?, yesterdayHonorPoints = ?, totalKills = ?, todayKills = ?, yesterdayKills = ?, "
+            "watchedFaction = ?, drunk = ?, health = ?, power1 = ?, power2 = ?, power3 = ?, power4 = ?, power5 = ?, power6 = ?, power7 = ?, "
+            "activeSpec = ?, ammoId = ?, "
+            "account = ?, name = ?, race = ?, class = ?, gender = ?, taximask = ?, resettalents_cost = ?, resettalents_time = ?, "
+            "extra_flags = ?, stable_slots = ?, taxi_path = ?, chosenTitle = ?, knownCurrencies = ?, specCount = ?, exploredZones = ?, equipmentCache = ?, knownTitles = ?, "
+            "actionBars = ?, grantableLevels = ? WHERE guid = ?");
 
-    uberInsert.addUInt32(GetGUIDLow());
-    uberInsert.addUInt32(GetSession()->GetAccountId());
-    uberInsert.addString(m_name);
-    uberInsert.addUInt8(getRace());
-    uberInsert.addUInt8(getClass());
-    uberInsert.addUInt8(getGender());
     uberInsert.addUInt32(getLevel());
     uberInsert.addUInt32(GetUInt32Value(PLAYER_XP));
     uberInsert.addUInt32(GetMoney());
@@ -17733,10 +17836,6 @@ void Player::SaveToDB()
         uberInsert.addFloat(finiteAlways(GetTeleportDest().getO()));
     }
 
-    std::ostringstream ss;
-    ss << m_taxi;                                   // string with TaxiMaskSize numbers
-    uberInsert.addString(ss);
-
     uberInsert.addUInt32(IsInWorld() ? 1 : 0);
 
     uberInsert.addUInt32(m_cinematic);
@@ -17749,8 +17848,6 @@ void Player::SaveToDB()
     uberInsert.addUInt32(HasFlag(PLAYER_FLAGS, PLAYER_FLAGS_RESTING) ? 1 : 0);
                                                             //save, far from tavern/city
                                                             //save, but in tavern/city
-    uberInsert.addUInt32(m_resetTalentsCost);
-    uberInsert.addUInt64(uint64(m_resetTalentsTime));
 
     uberInsert.addFloat(finiteAlways(m_movementInfo.GetTransportPos()->x));
     uberInsert.addFloat(finiteAlways(m_movementInfo.GetTransportPos()->y));
@@ -17761,19 +17858,12 @@ void Player::SaveToDB()
     else
         uberInsert.addUInt32(0);
 
-    uberInsert.addUInt32(m_ExtraFlags);
-
-    uberInsert.addUInt32(uint32(m_stableSlots));                    // to prevent save uint8 as char
-
     uberInsert.addUInt32(uint32(m_atLoginFlags));
 
     uberInsert.addUInt32(IsInWorld() ? GetZoneId() : GetCachedZoneId());
 
     uberInsert.addUInt64(uint64(m_deathExpireTime));
 
-    ss << m_taxi.SaveTaxiDestinationsToString();       //string
-    uberInsert.addString(ss);
-
     uberInsert.addUInt32(GetArenaPoints());
 
     uberInsert.addUInt32(GetHonorPoints());
@@ -17788,10 +17878,6 @@ void Player::SaveToDB()
 
     uberInsert.addUInt16(GetUInt16Value(PLAYER_FIELD_KILLS, 1));
 
-    uberInsert.addUInt32(GetUInt32Value(PLAYER_CHOSEN_TITLE));
-
-    uberInsert.addUInt64(GetUInt64Value(PLAYER_FIELD_KNOWN_CURRENCIES));
-
     // FIXME: at this moment send to DB as unsigned, including unit32(-1)
     uberInsert.addUInt32(GetUInt32Value(PLAYER_FIELD_WATCHED_FACTION_INDEX));
 
@@ -17802,35 +17888,46 @@ void Player::SaveToDB()
     for (uint32 i = 0; i < MAX_POWERS; ++i)
         uberInsert.addUInt32(GetPower(Powers(i)));
 
-    uberInsert.addUInt32(uint32(m_specsCount));
     uberInsert.addUInt32(uint32(m_activeSpec));
 
-    for (uint32 i = 0; i < PLAYER_EXPLORED_ZONES_SIZE; ++i)         //string
-    {
-        ss << GetUInt32Value(PLAYER_EXPLORED_ZONES_1 + i) << " ";
-    }
-    uberInsert.addString(ss);
-
-    for (uint32 i = 0; i < EQUIPMENT_SLOT_END * 2; ++i)             //string
-    {
-        ss << GetUInt32Value(PLAYER_VISIBLE_ITEM_1_ENTRYID + i) << " ";
-    }
-    uberInsert.addString(ss);
-
     uberInsert.addUInt32(GetUInt32Value(PLAYER_AMMO_ID));
 
-    for (uint32 i = 0; i < KNOWN_TITLES_SIZE*2; ++i)                //string
-    {
-        ss << GetUInt32Value(PLAYER__FIELD_KNOWN_TITLES + i) << " ";
+    if (!m_characterRowSaved || profileChanged)
+    {
+        // same order as profile data above
+        std::string str;
+        uberInsert.addUInt32(profile.read<uint32>());
+        profile >> str;
+        uberInsert.addString(str);
+        uberInsert.addUInt8(profile.read<uint8>());
+        uberInsert.addUInt8(profile.read<uint8>());
+        uberInsert.addUInt8(profile.read<uint8>());
+        profile >> str;
+        uberInsert.addString(str);
+        uberInsert.addUInt32(profile.read<uint32>());
+        uberInsert.addUInt64(profile.read<uint64>());
+        uberInsert.addUInt32(profile.read<uint32>());
+        uberInsert.addUInt32(profile.read<uint32>());
+        profile >> str;
+        uberInsert.addString(str);
+        uberInsert.addUInt32(profile.read<uint32>());
+        uberInsert.addUInt64(profile.read<uint64>());
+        uberInsert.addUInt32(profile.read<uint32>());
+        for (int i = 0; i < 3; ++i)                         // exploredZones, equipmentCache, knownTitles
+        {
+            profile >> str;
+            uberInsert.addString(str);
+        }
+        uberInsert.addUInt32(profile.read<uint32>());
+        uberInsert.addUInt32(profile.read<uint32>());
     }
-    uberInsert.addString(ss);
 
-    uberInsert.addUInt32(uint32(GetByteValue(PLAYER_FIELD_BYTES, 2)));
-
-    uberInsert.addUInt32(uint32(m_GrantableLevelsCount));
+    uberInsert.addUInt32(GetGUIDLow());
 
     uberInsert.Execute();
 
+    m_characterRowSaved = true;
+
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail();
 
@@ -17864,15 +17961,34 @@ void Player::SaveToDB()
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
 }
 
+void Player::ScheduleUrgentSave()
+{
+    uint32 delay = sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_URGENT_DELAY);
+
+    // autosave disabled
+    if (!delay || !m_nextSave)
+        return;
+
+    if (m_nextSave > delay)
+        m_nextSave = delay;
+    m_urgentSave = true;
+}
+
 // fast save function for item/money cheating preventing - save only inventory and money state
 void Player::SaveInventoryAndGoldToDB()
 {
+    if (m_saveDisabled)
+        return;
+
     _SaveInventory();
     SaveGoldToDB();
 }
 
 void Player::SaveGoldToDB()
 {
+    if (m_saveDisabled)
+        return;
+
     static SqlStatementID updateGold ;
 
     SqlStatement stmt = CharacterDatabase.CreateStatement(updateGold, "UPDATE characters SET money = ? WHERE guid = ?");
@@ -17942,18 +18058,11 @@ void Player::_SaveAuras()
 
     MAPLOCK_READ(this,MAP_LOCK_TYPE_AURAS);
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
-    stmt.PExecute(GetGUIDLow());
-
     SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
 
-    if (auraHolders.empty())
-        return;
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
-        "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
+    // collect saved values first, auras without duration not changed between saves usually
+    ByteBuffer data;
+    uint32 count = 0;
     for (SpellAuraHolderMap::const_iterator itr = auraHolders.begin(); itr != auraHolders.end(); ++itr)
     {
         // skip all holders from spells that are passive or channeled
@@ -17987,25 +18096,58 @@ void Player::_SaveAuras()
             if (!effIndexMask)
                 continue;
 
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt64(itr->second->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(itr->second->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(itr->second->GetId());
-            stmt.addUInt32(itr->second->GetStackAmount());
-            stmt.addUInt8(itr->second->GetAuraCharges());
+            data << uint64(itr->second->GetCasterGuid().GetRawValue());
+            data << uint32(itr->second->GetCastItemGuid().GetCounter());
+            data << uint32(itr->second->GetId());
+            data << uint32(itr->second->GetStackAmount());
+            data << uint8(itr->second->GetAuraCharges());
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-                stmt.addInt32(damage[i]);
+                data << int32(damage[i]);
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-                stmt.addUInt32(periodicTime[i]);
+                data << uint32(periodicTime[i]);
 
-            stmt.addInt32(itr->second->GetAuraMaxDuration());
-            stmt.addInt32(itr->second->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
-            stmt.Execute();
+            data << int32(itr->second->GetAuraMaxDuration());
+            data << int32(itr->second->GetAuraDuration());
+            data << uint32(effIndexMask);
+            ++count;
         }
     }
+
+    if (!_IsSaveSectionChanged(PLAYER_SAVE_AURAS, data, count + 1))
+        return;
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM character_aura WHERE guid = ?");
+    stmt.PExecute(GetGUIDLow());
+
+    if (!count)
+        return;
+
+    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO character_aura (guid, caster_guid, item_guid, spell, stackcount, remaincharges, "
+        "basepoints0, basepoints1, basepoints2, periodictime0, periodictime1, periodictime2, maxduration, remaintime, effIndexMask) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+    for (uint32 n = 0; n < count; ++n)
+    {
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt64(data.read<uint64>());
+        stmt.addUInt32(data.read<uint32>());
+        stmt.addUInt32(data.read<uint32>());
+        stmt.addUInt32(data.read<uint32>());
+        stmt.addUInt8(data.read<uint8>());
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+            stmt.addInt32(data.read<int32>());
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+            stmt.addUInt32(data.read<uint32>());
+
+        stmt.addInt32(data.read<int32>());
+        stmt.addInt32(data.read<int32>());
+        stmt.addUInt32(data.read<uint32>());
+        stmt.Execute();
+    }
 }
 
 void Player::_SaveGlyphs()
@@ -18472,6 +18614,34 @@ void Player::_SaveTalents()
     }
 }
 
+bool Player::_IsSaveSectionChanged(PlayerSaveSection section, ByteBuffer const& data, uint32 statements)
+{
+    // FNV-1a
+    uint64 hash = UI64LIT(14695981039346656037);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        hash ^= data.contents()[i];
+        hash *= UI64LIT(1099511628211);
+    }
+
+    PlayerSaveSectionStats& stats = ms_saveSectionStats[section];
+
+    if (m_saveSectionHash[section] == hash)
+    {
+        ++stats.skipped;
+        stats.statementsSkipped += statements;
+        stats.bytesSkipped += data.size();
+        return false;
+    }
+
+    m_saveSectionHash[section] = hash;
+
+    ++stats.written;
+    stats.statementsWritten += statements;
+    stats.bytesWritten += data.size();
+    return true;
+}
+
 // save player stats -- only for external usage
 // real stats will be recalculated on player login
 void Player::_SaveStats()
@@ -20468,7 +20638,7 @@ bool Player::HaveAtClient(ObjectGuid const& guid) const
 void Player::AddClientGuid(ObjectGuid const& guid)
 {
     MAPLOCK_WRITE(this,MAP_LOCK_TYPE_MAPOBJECTS);
-    m_clientGUIDs.insert(guid);
+    m_clientGUIDs[guid] = m_clientGUIDsStamp;
 }
 
 void Player::RemoveClientGuid(ObjectGuid const& guid)
@@ -20483,6 +20653,25 @@ bool Player::HasClientGuid(ObjectGuid const& guid) const
     return (m_clientGUIDs.find(guid) != m_clientGUIDs.end());
 }
 
+void Player::TouchClientGuids(std::vector<ObjectGuid> const& guids, uint32 stamp)
+{
+    MAPLOCK_WRITE(this,MAP_LOCK_TYPE_MAPOBJECTS);
+    for (std::vector<ObjectGuid>::const_iterator guid = guids.begin(); guid != guids.end(); ++guid)
+    {
+        ClientGuidsMap::iterator itr = m_clientGUIDs.find(*guid);
+        if (itr != m_clientGUIDs.end() && itr->second < stamp)
+            itr->second = stamp;
+    }
+}
+
+void Player::GetClientGuidsNotTouchedSince(uint32 stamp, GuidSet& guids) const
+{
+    MAPLOCK_READ(const_cast<Player*>(this),MAP_LOCK_TYPE_MAPOBJECTS);
+    for (ClientGuidsMap::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+        if (itr->second < stamp)
+            guids.insert(itr->first);
+}
+
 void Player::BeforeVisibilityDestroy(WorldObject* t)
 {
     if (GetPetGuid() == t->GetObjectGuid() && ((Creature*)t)->IsPet())
@@ -20523,14 +20712,15 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
         {
             if (!GetMap()->IsVisibleGlobally(target->GetObjectGuid()))
             {
-                target->SendCreateUpdateToPlayer(this);
+                if (!GetSession()->IsBotSession())
+                    target->SendCreateUpdateToPlayer(this);
                 AddClientGuid(target->GetObjectGuid());
 
                 DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "Player::UpdateVisibilityOf (by viewPoint) %s is visible now for %s, distance = %f", target->GetObjectGuid().GetString().c_str(), GetObjectGuid().GetString().c_str(), GetDistance(target));
 
                 // target aura duration for caster show only if target exist at caster client
                 // send data at target visibility change (adding to client)
-                if (target != this && target->isType(TYPEMASK_UNIT))
+                if (target != this && target->isType(TYPEMASK_UNIT) && !GetSession()->IsBotSession())
                     SendAurasForTarget((Unit*)target);
             }
         }
@@ -20558,7 +20748,9 @@ void Player::UpdateVisibilityOf(WorldObject const* viewPoint, WorldObject* targe
         if (target->isVisibleForInState(this,viewPoint,false))
         {
             visibleNow.insert(target);
-            target->BuildCreateUpdateBlockForPlayer(&data, this);
+            // visibility still tracked for bots, but create block only for real client
+            if (!GetSession()->IsBotSession())
+                target->BuildCreateUpdateBlockForPlayer(&data, this);
             AddClientGuid(target->GetObjectGuid());
 
             DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "Player::UpdateVisibilityOf %s is visible now for %s, distance = %f", target->GetGuidStr().c_str(), GetGuidStr().c_str(), GetDistance(target));
@@ -21194,16 +21386,16 @@ void Player::UpdateForQuestWorldObjects()
 
     UpdateData udata;
     WorldPacket packet;
-    for (GuidSet::const_iterator itr = GetClientGuids().begin(); itr != GetClientGuids().end(); ++itr)
+    for (ClientGuidsMap::const_iterator itr = GetClientGuids().begin(); itr != GetClientGuids().end(); ++itr)
     {
-        if (itr->IsGameObject())
+        if (itr->first.IsGameObject())
         {
-            if (GameObject *obj = GetMap()->GetGameObject(*itr))
+            if (GameObject *obj = GetMap()->GetGameObject(itr->first))
                 obj->BuildValuesUpdateBlockForPlayer(&udata,this);
         }
-        else if (itr->IsCreatureOrVehicle())
+        else if (itr->first.IsCreatureOrVehicle())
         {
-            Creature *obj = GetMap()->GetAnyTypeCreature(*itr);
+            Creature *obj = GetMap()->GetAnyTypeCreature(itr->first);
             if (!obj)
                 continue;
 
@@ -684,6 +684,26 @@ struct EquipmentSet
 
 typedef std::map<uint32, EquipmentSet> EquipmentSets;
 
+// Player::SaveToDB parts rewritten as whole, skipped while content same as at last save
+enum PlayerSaveSection
+{
+    PLAYER_SAVE_CHARACTER       = 0,                        // rarely changed `characters` columns
+    PLAYER_SAVE_AURAS           = 1,
+    PLAYER_SAVE_SPELL_COOLDOWNS = 2,
+};
+
+#define MAX_PLAYER_SAVE_SECTIONS 3
+
+struct PlayerSaveSectionStats
+{
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> written;          // section saves executed
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> skipped;          // section saves skipped as unchanged
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> statementsWritten;
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> statementsSkipped;
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> bytesWritten;     // size of saved values
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> bytesSkipped;
+};
+
 struct ItemPosCount
 {
     ItemPosCount(uint16 _pos, uint32 _count) : pos(_pos), count(_count) {}
@@ -1506,6 +1526,8 @@ class MANGOS_DLL_SPEC Player : public Unit
         void SaveToDB();
         void SaveInventoryAndGoldToDB();                    // fast save function for item/money cheating preventing
         void SaveGoldToDB();
+        void ScheduleUrgentSave();                          // autosave soon and before not urgent autosaves
+        static PlayerSaveSectionStats const& GetSaveSectionStats(PlayerSaveSection section) { return ms_saveSectionStats[section]; }
         static void SetUInt32ValueInArray(Tokens& data,uint16 index, uint32 value);
         static void SetFloatValueInArray(Tokens& data,uint16 index, float value);
         static void Customize(ObjectGuid guid, uint8 gender, uint8 skin, uint8 face, uint8 hairStyle, uint8 hairColor, uint8 facialHair);
@@ -2055,6 +2077,7 @@ class MANGOS_DLL_SPEC Player : public Unit
         void SendUpdatedWorldStates(bool force = false);
         time_t const& GetLastWorldStateUpdateTime() { return m_lastWSUpdateTime; };
         void SetLastWorldStateUpdateTime(time_t _time)   { m_lastWSUpdateTime = _time; };
+        void SetLastWorldStateVersion(uint32 version)    { m_lastWSVersion = version; };
 
         void SendDirectMessage(WorldPacket* data) const;
 
@@ -2259,6 +2282,8 @@ class MANGOS_DLL_SPEC Player : public Unit
 
         uint32 GetSaveTimer() const { return m_nextSave; }
         void   SetSaveTimer(uint32 timer) { m_nextSave = timer; }
+        // character state in DB kept unchanged (load test bots), all saves skipped
+        void   SetSaveDisabled(bool disabled) { m_saveDisabled = disabled; }
 
         // Recall position
         WorldLocation m_recall;
@@ -2271,12 +2296,18 @@ class MANGOS_DLL_SPEC Player : public Unit
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
         // list of currently visible objects, stored at player client
-        GuidSet const& GetClientGuids() { return m_clientGUIDs; };
+        // each guid stored with stamp of last visibility update which confirmed it, for find not visited guids without storage copy
+        typedef UNORDERED_MAP<ObjectGuid, uint32> ClientGuidsMap;
+        ClientGuidsMap const& GetClientGuids() { return m_clientGUIDs; };
         bool HaveAtClient(ObjectGuid const& guid) const;
         void AddClientGuid(ObjectGuid const& guid);
         void RemoveClientGuid(ObjectGuid const& guid);
         bool HasClientGuid(ObjectGuid const& guid) const;
 
+        uint32 NewClientGuidsStamp() { return ++m_clientGUIDsStamp; }
+        void TouchClientGuids(std::vector<ObjectGuid> const& guids, uint32 stamp);
+        void GetClientGuidsNotTouchedSince(uint32 stamp, GuidSet& guids) const;
+
         bool IsVisibleInGridForPlayer(Player* pl) const;
         bool IsVisibleGloballyFor(Player* pl) const;
         void BeforeVisibilityDestroy(WorldObject* obj);
@@ -2523,6 +2554,16 @@ class MANGOS_DLL_SPEC Player : public Unit
         void _SaveTalents();
         void _SaveStats();
 
+        // false if section data same as at last save, update save statistics
+        bool _IsSaveSectionChanged(PlayerSaveSection section, ByteBuffer const& data, uint32 statements);
+
+        uint64 m_saveSectionHash[MAX_PLAYER_SAVE_SECTIONS]; // hash of section data at last save
+        bool m_characterRowSaved;                           // `characters` row exists, UPDATE instead INSERT
+        bool m_urgentSave;                                  // autosave shortened by ScheduleUrgentSave
+        bool m_saveDisabled;
+
+        static PlayerSaveSectionStats ms_saveSectionStats[MAX_PLAYER_SAVE_SECTIONS];
+
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
         /*********************************************************/
@@ -2622,6 +2663,7 @@ class MANGOS_DLL_SPEC Player : public Unit
         time_t m_deathExpireTime;
 
         time_t m_lastWSUpdateTime;
+        uint32 m_lastWSVersion;                             // last WorldStateMgr change version sent to client
 
         uint32 m_restTime;
 
@@ -2755,7 +2797,8 @@ class MANGOS_DLL_SPEC Player : public Unit
         uint32 m_DetectInvTimer;
 
         // Visible object storage
-        GuidSet m_clientGUIDs;
+        ClientGuidsMap m_clientGUIDs;
+        uint32 m_clientGUIDsStamp;
 
         // Temporary removed pet cache
         PetNumberList m_temporaryUnsummonedPetNumber;
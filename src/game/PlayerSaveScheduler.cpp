@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PlayerSaveScheduler.h"
+#include "World.h"
+#include "Database/DatabaseEnv.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(PlayerSaveScheduler);
+
+PlayerSaveScheduler::PlayerSaveScheduler() : m_credit(0.0), m_urgentAllowance(0), m_normalAllowance(0), m_waiting(0),
+    m_allowedSaves(0), m_delayedRequests(0), m_throttledTicks(0)
+{
+}
+
+void PlayerSaveScheduler::Update(uint32 diff)
+{
+    // not used allowance of previous tick
+    long unused = m_normalAllowance.value();
+    if (unused > 0)
+        m_credit += unused;
+
+    long waiting = m_waiting.value();
+    m_waiting = 0;
+
+    uint32 interval = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    if (!interval)                                          // autosave disabled
+    {
+        m_urgentAllowance = 0;
+        m_normalAllowance = 0;
+        return;
+    }
+
+    // every online player once per interval, credit of ticks without waiting players not kept
+    double rate = double(sWorld.GetActiveSessionCount()) * diff / interval;
+    m_credit = std::min(m_credit + rate, double(waiting) + rate + 1.0);
+
+    uint32 queueSize = CharacterDatabase.GetAsyncQueueSize();
+    uint32 maxQueueSize = sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_QUEUE_SIZE);
+    uint32 maxTime = sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_AVERAGE_TIME);
+
+    if ((maxQueueSize && queueSize >= maxQueueSize) ||
+        (maxTime && CharacterDatabase.GetAsyncAverageTime() >= maxTime * 1000))
+    {
+        ++m_throttledTicks;
+        m_urgentAllowance = 1;
+        m_normalAllowance = 0;
+        return;
+    }
+
+    long headroom = maxQueueSize ? long(maxQueueSize - queueSize) : 0x7FFFFFFF;
+    long allowance = std::min(long(m_credit), headroom);
+
+    m_credit -= allowance;
+    m_normalAllowance = allowance;
+    m_urgentAllowance = headroom - allowance;
+}
+
+bool PlayerSaveScheduler::RequestSave(bool urgent)
+{
+    ACE_Atomic_Op<ACE_Thread_Mutex, long>& allowance = urgent ? m_urgentAllowance : m_normalAllowance;
+
+    if (--allowance >= 0)
+    {
+        ++m_allowedSaves;
+        return true;
+    }
+
+    ++allowance;
+
+    if (!urgent)
+        ++m_waiting;
+
+    ++m_delayedRequests;
+    return false;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PLAYER_SAVE_SCHEDULER_H
+#define MANGOS_PLAYER_SAVE_SCHEDULER_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+
+/**
+ * Rate limit of player autosaves.
+ *
+ * Every world tick Update() converts online players count and PlayerSave.Interval into a number of
+ * allowed autosaves, so on average every player is saved once per interval and saves are spread over
+ * the interval even if the players save timers expire at same time (after restart or mass login).
+ * Allowed saves are reduced by the character DB async queue size and not given at all while the queue
+ * or average request time are over the configured limits. Urgent saves (rare loot, trade, level up) are
+ * not spread over the interval, only limited by the DB load (one per tick while over limits).
+ *
+ * Players whose save timer expired call RequestSave() from map update threads and retry at next update
+ * if not allowed. Manual and logout saves call Player::SaveToDB directly and are not limited.
+ */
+class PlayerSaveScheduler
+{
+    public:
+        PlayerSaveScheduler();
+
+        // world thread, before map updates
+        void Update(uint32 diff);
+
+        // map update threads, true if player can save now
+        bool RequestSave(bool urgent);
+
+        uint32 GetAllowedSaves() const { return uint32(m_allowedSaves.value()); }
+        uint32 GetDelayedRequests() const { return uint32(m_delayedRequests.value()); }
+        uint32 GetThrottledTicks() const { return m_throttledTicks; }
+
+    private:
+        // fractional autosaves accumulated from previous ticks
+        double m_credit;
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_urgentAllowance;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_normalAllowance;
+
+        // not urgent saves not allowed in current tick, retried at next one
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_waiting;
+
+        // statistics
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_allowedSaves;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_delayedRequests;
+        uint32 m_throttledTicks;                            // ticks without normal saves by DB load
+};
+
+#define sPlayerSaveScheduler MaNGOS::Singleton<PlayerSaveScheduler>::Instance()
+
+#endif
@@ -622,11 +622,11 @@ void WorldSession::HandleQuestgiverStatusMultipleQuery(WorldPacket& /*recvPacket
     WorldPacket data(SMSG_QUESTGIVER_STATUS_MULTIPLE, 4);
     data << uint32(count);                                  // placeholder
 
-    for(GuidSet::const_iterator itr = _player->GetClientGuids().begin(); itr != _player->GetClientGuids().end(); ++itr)
+    for(Player::ClientGuidsMap::const_iterator itr = _player->GetClientGuids().begin(); itr != _player->GetClientGuids().end(); ++itr)
     {
         uint8 dialogStatus = DIALOG_STATUS_NONE;
 
-        ObjectGuid guid = *itr;
+        ObjectGuid guid = itr->first;
         if (guid.IsEmpty())
             continue;
 
@@ -1958,6 +1958,15 @@ uint32 ScriptMgr::GetScriptId(const char *name) const
     return uint32(itr - m_scriptNames.begin());
 }
 
+uint32 ScriptMgr::GetScriptNamesHash() const
+{
+    uint64 hash = SQLStorageSnapshot::Hash(NULL, 0);
+    for (ScriptNameMap::const_iterator itr = m_scriptNames.begin(); itr != m_scriptNames.end(); ++itr)
+        hash = SQLStorageSnapshot::Hash(itr->c_str(), itr->size() + 1, hash);
+
+    return uint32(hash ^ (hash >> 32));
+}
+
 uint32 ScriptMgr::GetAreaTriggerScriptId(uint32 triggerId) const
 {
     AreaTriggerScriptMap::const_iterator itr = m_AreaTriggerScripts.find(triggerId);
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SessionDomainUpdater.h"
+#include "Opcodes.h"
+#include "WorldPacket.h"
+#include "WorldMetrics.h"
+#include "SharedDefines.h"
+#include "Log.h"
+
+// used domains besides own, mails are sent from auction and calendar, calendar reads guilds
+static uint32 const sessionDomainUses[MAX_SESSION_DOMAINS] =
+{
+    0,                                                      // SESSION_DOMAIN_MAIL
+    0,                                                      // SESSION_DOMAIN_GUILD
+    (1 << SESSION_DOMAIN_MAIL),                             // SESSION_DOMAIN_AUCTION
+    0,                                                      // SESSION_DOMAIN_CHANNEL
+    0,                                                      // SESSION_DOMAIN_LFG
+    (1 << SESSION_DOMAIN_MAIL) | (1 << SESSION_DOMAIN_GUILD)// SESSION_DOMAIN_CALENDAR
+};
+
+// channel message without chat command, commands can touch anything
+static bool IsChannelChatMessage(WorldPacket const& packet)
+{
+    // uint32 type, uint32 lang, channel name, message
+    if (packet.size() < 4 + 4 + 1 + 1 || packet.read<uint32>(0) != CHAT_MSG_CHANNEL)
+        return false;
+
+    size_t pos = 4 + 4;
+    while (pos < packet.size() && packet.contents()[pos])
+        ++pos;
+
+    if (++pos >= packet.size())
+        return false;                                       // malformed, error reported by world thread
+
+    uint8 first = packet.contents()[pos];
+    return first != '.' && first != '!';
+}
+
+SessionUpdateDomain GetPacketSessionDomain(WorldPacket const& packet)
+{
+    switch (packet.GetOpcode())
+    {
+        case CMSG_SEND_MAIL:
+        case CMSG_GET_MAIL_LIST:
+        case CMSG_MAIL_TAKE_MONEY:
+        case CMSG_MAIL_TAKE_ITEM:
+        case CMSG_MAIL_MARK_AS_READ:
+        case CMSG_MAIL_RETURN_TO_SENDER:
+        case CMSG_MAIL_DELETE:
+        case CMSG_MAIL_CREATE_TEXT_ITEM:
+        case MSG_QUERY_NEXT_MAIL_TIME:
+            return SESSION_DOMAIN_MAIL;
+
+        // opcodes changing other members or calendar (promote, remove, leave, disband, ranks) are global
+        case CMSG_GUILD_QUERY:
+        case CMSG_GUILD_INVITE:
+        case CMSG_GUILD_ACCEPT:
+        case CMSG_GUILD_DECLINE:
+        case CMSG_GUILD_INFO:
+        case CMSG_GUILD_ROSTER:
+        case CMSG_GUILD_MOTD:
+        case CMSG_GUILD_SET_PUBLIC_NOTE:
+        case CMSG_GUILD_SET_OFFICER_NOTE:
+        case CMSG_GUILD_INFO_TEXT:
+        case MSG_SAVE_GUILD_EMBLEM:
+        case MSG_GUILD_PERMISSIONS:
+        case MSG_GUILD_EVENT_LOG_QUERY:
+        case CMSG_GUILD_BANKER_ACTIVATE:
+        case CMSG_GUILD_BANK_QUERY_TAB:
+        case CMSG_GUILD_BANK_SWAP_ITEMS:
+        case CMSG_GUILD_BANK_BUY_TAB:
+        case CMSG_GUILD_BANK_UPDATE_TAB:
+        case CMSG_GUILD_BANK_DEPOSIT_MONEY:
+        case CMSG_GUILD_BANK_WITHDRAW_MONEY:
+        case MSG_GUILD_BANK_LOG_QUERY:
+        case MSG_GUILD_BANK_MONEY_WITHDRAWN:
+        case MSG_QUERY_GUILD_BANK_TEXT:
+        case CMSG_SET_GUILD_BANK_TEXT:
+            return SESSION_DOMAIN_GUILD;
+
+        case MSG_AUCTION_HELLO:
+        case CMSG_AUCTION_SELL_ITEM:
+        case CMSG_AUCTION_REMOVE_ITEM:
+        case CMSG_AUCTION_LIST_ITEMS:
+        case CMSG_AUCTION_LIST_OWNER_ITEMS:
+        case CMSG_AUCTION_PLACE_BID:
+        case CMSG_AUCTION_LIST_BIDDER_ITEMS:
+        case CMSG_AUCTION_LIST_PENDING_SALES:
+            return SESSION_DOMAIN_AUCTION;
+
+        case CMSG_JOIN_CHANNEL:
+        case CMSG_LEAVE_CHANNEL:
+        case CMSG_CHANNEL_LIST:
+        case CMSG_CHANNEL_PASSWORD:
+        case CMSG_CHANNEL_SET_OWNER:
+        case CMSG_CHANNEL_OWNER:
+        case CMSG_CHANNEL_MODERATOR:
+        case CMSG_CHANNEL_UNMODERATOR:
+        case CMSG_CHANNEL_MUTE:
+        case CMSG_CHANNEL_UNMUTE:
+        case CMSG_CHANNEL_INVITE:
+        case CMSG_CHANNEL_KICK:
+        case CMSG_CHANNEL_BAN:
+        case CMSG_CHANNEL_UNBAN:
+        case CMSG_CHANNEL_ANNOUNCEMENTS:
+        case CMSG_CHANNEL_MODERATE:
+        case CMSG_CHANNEL_DISPLAY_LIST:
+        case CMSG_GET_CHANNEL_MEMBER_COUNT:
+        case CMSG_SET_CHANNEL_WATCH:
+            return SESSION_DOMAIN_CHANNEL;
+
+        // other chat types use groups, guilds, whisper targets (and playerbots) or map
+        case CMSG_MESSAGECHAT:
+            return IsChannelChatMessage(packet) ? SESSION_DOMAIN_CHANNEL : SESSION_DOMAIN_GLOBAL;
+
+        // other lfg opcodes are thread-safe and processed by maps
+        case CMSG_LFG_GET_PLAYER_INFO:
+            return SESSION_DOMAIN_LFG;
+
+        case CMSG_CALENDAR_GET_CALENDAR:
+        case CMSG_CALENDAR_GET_EVENT:
+        case CMSG_CALENDAR_GUILD_FILTER:
+        case CMSG_CALENDAR_ARENA_TEAM:
+        case CMSG_CALENDAR_ADD_EVENT:
+        case CMSG_CALENDAR_UPDATE_EVENT:
+        case CMSG_CALENDAR_REMOVE_EVENT:
+        case CMSG_CALENDAR_COPY_EVENT:
+        case CMSG_CALENDAR_EVENT_INVITE:
+        case CMSG_CALENDAR_EVENT_RSVP:
+        case CMSG_CALENDAR_EVENT_REMOVE_INVITE:
+        case CMSG_CALENDAR_EVENT_STATUS:
+        case CMSG_CALENDAR_EVENT_MODERATOR_STATUS:
+        case CMSG_CALENDAR_COMPLAIN:
+        case CMSG_CALENDAR_GET_NUM_PENDING:
+        case CMSG_CALENDAR_EVENT_SIGNUP:
+            return SESSION_DOMAIN_CALENDAR;
+
+        default:
+            return SESSION_DOMAIN_GLOBAL;
+    }
+}
+
+// locks domains of mask in domain order
+class SessionDomainGuard
+{
+    public:
+        SessionDomainGuard(SessionDomainUpdater& updater, uint32 mask) : m_updater(updater), m_mask(mask) { m_updater.LockDomains(m_mask); }
+        ~SessionDomainGuard() { m_updater.UnlockDomains(m_mask); }
+
+    private:
+        SessionDomainUpdater& m_updater;
+        uint32 const m_mask;
+};
+
+void SessionDomain::Initialize(SessionDomainUpdater* updater, SessionUpdateDomain domain)
+{
+    m_updater = updater;
+    m_domain = domain;
+    m_lockMask = (1 << domain) | sessionDomainUses[domain];
+}
+
+void SessionDomain::Update(uint32 /*diff*/)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    for (std::vector<WorldSession*>::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+    {
+        SessionDomainGuard guard(*m_updater, m_lockMask);
+        SessionDomainFilter updater(*itr, m_domain);
+        (*itr)->ProcessQueuedPackets(updater);
+    }
+
+    m_sessions.clear();
+    m_updateTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    m_updater->FinishDomain();
+}
+
+SessionDomainUpdater::SessionDomainUpdater() : ObjectUpdateTaskBase<SessionDomain>(),
+    m_threadsCount(0), m_finishLock(), m_finishCondition(m_finishLock), m_runningDomains(0)
+{
+    for (uint32 i = 0; i < MAX_SESSION_DOMAINS; ++i)
+        m_domains[i].Initialize(this, SessionUpdateDomain(i));
+}
+
+void SessionDomainUpdater::Initialize(uint32 threads)
+{
+    if (!threads)
+        return;
+
+    if (activate(threads) == -1)
+    {
+        sLog.outError("SessionDomainUpdater: can't start %u session update threads, thread-unsafe packets processed by world thread only", threads);
+        return;
+    }
+
+    m_threadsCount = threads;
+    sLog.outString("Session update threads started: %u", threads);
+}
+
+void SessionDomainUpdater::AddSession(WorldSession* session)
+{
+    SessionUpdateDomain domain = session->GetQueuedPacketDomain();
+    if (domain < MAX_SESSION_DOMAINS)
+        m_domains[domain].AddSession(session);
+}
+
+void SessionDomainUpdater::Update(uint32 diff)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+
+    reactivate(m_threadsCount);
+
+    bool updated[MAX_SESSION_DOMAINS];
+    for (uint32 i = 0; i < MAX_SESSION_DOMAINS; ++i)
+    {
+        updated[i] = !m_domains[i].IsEmpty();
+        if (!updated[i])
+            continue;
+
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_finishLock);
+            ++m_runningDomains;
+        }
+
+        // not expected, world thread update domain itself, still in parallel with other domains
+        if (schedule_update(m_domains[i], diff) == -1)
+            m_domains[i].Update(diff);
+    }
+
+    // own barrier instead of queue_wait, world thread must not continue while any domain is processed
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_finishLock);
+        while (m_runningDomains > 0)
+            m_finishCondition.wait();
+    }
+
+    for (uint32 i = 0; i < MAX_SESSION_DOMAINS; ++i)
+        if (updated[i])
+            sWorldMetrics.ObserveSessionDomain(SessionUpdateDomain(i), m_domains[i].GetUpdateTime());
+
+    sWorldMetrics.ObserveSessionDomains(WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()));
+}
+
+void SessionDomainUpdater::FinishDomain()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_finishLock);
+    --m_runningDomains;
+    m_finishCondition.signal();
+}
+
+void SessionDomainUpdater::LockDomains(uint32 mask)
+{
+    for (uint32 i = 0; i < MAX_SESSION_DOMAINS; ++i)
+        if (mask & (1 << i))
+            m_domains[i].GetLock().acquire();
+}
+
+void SessionDomainUpdater::UnlockDomains(uint32 mask)
+{
+    for (uint32 i = MAX_SESSION_DOMAINS; i > 0; --i)
+        if (mask & (1 << (i - 1)))
+            m_domains[i - 1].GetLock().release();
+}
+
+char const* SessionDomainUpdater::GetDomainName(SessionUpdateDomain domain)
+{
+    switch (domain)
+    {
+        case SESSION_DOMAIN_MAIL:     return "mail";
+        case SESSION_DOMAIN_GUILD:    return "guild";
+        case SESSION_DOMAIN_AUCTION:  return "auction";
+        case SESSION_DOMAIN_CHANNEL:  return "channel";
+        case SESSION_DOMAIN_LFG:      return "lfg";
+        case SESSION_DOMAIN_CALENDAR: return "calendar";
+        default:                      break;
+    }
+
+    return "global";
+}
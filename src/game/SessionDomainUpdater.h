@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_SESSIONDOMAINUPDATER_H
+#define MANGOS_SESSIONDOMAINUPDATER_H
+
+#include "Common.h"
+#include "ObjectUpdateTaskBase.h"
+#include "WorldSession.h"
+
+#include <vector>
+
+class WorldPacket;
+class SessionDomainUpdater;
+
+// domain of thread-unsafe opcode, SESSION_DOMAIN_GLOBAL for opcodes which can touch state of other domains
+SessionUpdateDomain GetPacketSessionDomain(WorldPacket const& packet);
+
+// Sessions with first queued packet of one domain, updated as one request of SessionDomainUpdater
+class SessionDomain
+{
+    public:
+        SessionDomain() : m_updater(NULL), m_domain(SESSION_DOMAIN_GLOBAL), m_lockMask(0), m_updateTime(0) {}
+
+        void Initialize(SessionDomainUpdater* updater, SessionUpdateDomain domain);
+
+        void AddSession(WorldSession* session) { m_sessions.push_back(session); }
+        bool IsEmpty() const { return m_sessions.empty(); }
+
+        // called from update thread, diff unused
+        void Update(uint32 diff);
+
+        uint32 GetUpdateTime() const { return m_updateTime; }
+        ACE_Thread_Mutex& GetLock() { return m_lock; }
+
+    private:
+        SessionDomainUpdater* m_updater;
+        SessionUpdateDomain m_domain;
+        uint32 m_lockMask;                                  // own and used domains, locked while session packets processed
+        std::vector<WorldSession*> m_sessions;
+        ACE_Thread_Mutex m_lock;
+        uint32 m_updateTime;                                // ms, last update
+};
+
+/**
+ * Parallel processing of thread-unsafe packets in World::UpdateSessions.
+ *
+ * Each session is given to domain of its first queued packet, domain thread processes packets of
+ * session while they belong to that domain, so session is never processed by two threads and packets
+ * order is kept. Rest of packets (and logout) processed after by world thread as before.
+ * Domains using state of other domain (auction and calendar send mails) lock it together with own lock
+ * for each session, locks are always taken in domain order.
+ * Achievements can be completed by any domain (money and items of mails, auctions, guild bank), state
+ * touched by completion has own locks: realm completed achievements, guild members broadcast and ids
+ * of reward mails.
+ * Map updates run after World::UpdateSessions, so domain threads never run together with map threads.
+ */
+class SessionDomainUpdater : public ObjectUpdateTaskBase<SessionDomain>
+{
+    public:
+        SessionDomainUpdater();
+
+        // 0 threads - all packets processed by world thread
+        void Initialize(uint32 threads);
+        bool IsEnabled() const { return m_threadsCount > 0; }
+
+        // world thread, before Update
+        void AddSession(WorldSession* session);
+        // world thread, process added sessions and wait all domains
+        void Update(uint32 diff);
+
+        // called by SessionDomain at end of its update
+        void FinishDomain();
+
+        void LockDomains(uint32 mask);
+        void UnlockDomains(uint32 mask);
+
+        static char const* GetDomainName(SessionUpdateDomain domain);
+
+    private:
+        SessionDomain m_domains[MAX_SESSION_DOMAINS];
+        uint32 m_threadsCount;
+
+        ACE_Thread_Mutex m_finishLock;
+        ACE_Condition_Thread_Mutex m_finishCondition;
+        uint32 m_runningDomains;                            // scheduled and not finished domains of current update
+};
+
+#endif
@@ -72,6 +72,9 @@ bool PlayerSocial::AddToSocialList(ObjectGuid const& friend_guid, bool ignore)
     SaveFriendInfo(friend_guid, fi);
     CharacterDatabase.CommitTransaction();
 
+    if (ignore)
+        ++m_ignoreGeneration;
+
     return true;
 }
 
@@ -167,6 +170,54 @@ bool PlayerSocial::HasIgnore(ObjectGuid const& ignore_guid)
     return false;
 }
 
+void PlayerSocial::AddIgnoresToFilter(IgnoreFilter& filter) const
+{
+    for (PlayerSocialMap::const_iterator itr = m_playerSocialMap.begin(); itr != m_playerSocialMap.end(); ++itr)
+        if (itr->second.Flags & SOCIAL_FLAG_IGNORED)
+            filter.Add(itr->first);
+}
+
+ACE_Atomic_Op<ACE_Thread_Mutex, uint32> PlayerSocial::m_ignoreGeneration(0);
+
+void IgnoreFilter::Reset(uint32 expectedEntries)
+{
+    // ~8 bits per entry, 2 hashes - about 5% false positives at full load
+    uint32 size = 32;
+    while (size < expectedEntries * 8)
+        size <<= 1;
+
+    m_bits.assign(size / 32, 0);
+    m_entries = 0;
+}
+
+void IgnoreFilter::Add(ObjectGuid const& guid)
+{
+    if (m_bits.empty())
+        Reset(16);
+
+    uint64 hash = guid.GetRawValue() * UI64LIT(0x9E3779B97F4A7C15);
+    uint32 mask = m_bits.size() * 32 - 1;
+    uint32 bit1 = uint32(hash >> 32) & mask;
+    uint32 bit2 = uint32(hash) & mask;
+
+    m_bits[bit1 / 32] |= uint32(1) << (bit1 % 32);
+    m_bits[bit2 / 32] |= uint32(1) << (bit2 % 32);
+    ++m_entries;
+}
+
+bool IgnoreFilter::MayContain(ObjectGuid const& guid) const
+{
+    if (m_bits.empty())
+        return false;
+
+    uint64 hash = guid.GetRawValue() * UI64LIT(0x9E3779B97F4A7C15);
+    uint32 mask = m_bits.size() * 32 - 1;
+    uint32 bit1 = uint32(hash >> 32) & mask;
+    uint32 bit2 = uint32(hash) & mask;
+
+    return (m_bits[bit1 / 32] & (uint32(1) << (bit1 % 32))) && (m_bits[bit2 / 32] & (uint32(1) << (bit2 % 32)));
+}
+
 void PlayerSocial::SaveFriendInfo(ObjectGuid const& friend_guid, FriendInfo const& fi)
 {
     static SqlStatementID delstmtId;
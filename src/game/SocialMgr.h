@@ -111,6 +111,25 @@ enum FriendsResult
 #define SOCIALMGR_FRIEND_LIMIT  50
 #define SOCIALMGR_IGNORE_LIMIT  50
 
+// Bloom filter of ignored guids, allow skip per receiver ignore checks at broadcasts
+class IgnoreFilter
+{
+    public:
+        IgnoreFilter() : m_entries(0) {}
+
+        void Reset(uint32 expectedEntries);
+        void Add(ObjectGuid const& guid);
+        // false - guid surely not added, true - guid possibly added
+        bool MayContain(ObjectGuid const& guid) const;
+
+        // false positive rate too high, reset with bigger size advised
+        bool IsOverloaded() const { return m_entries * 8 > m_bits.size() * 32; }
+
+    private:
+        std::vector<uint32> m_bits;
+        uint32 m_entries;
+};
+
 class PlayerSocial
 {
     friend class SocialMgr;
@@ -126,15 +145,21 @@ class PlayerSocial
         // Misc
         bool HasFriend(ObjectGuid const& friend_guid);
         bool HasIgnore(ObjectGuid const& ignore_guid);
+        void AddIgnoresToFilter(IgnoreFilter& filter) const;
         void SetPlayerGuid(ObjectGuid const& guid) { m_playerGuid = guid; }
         uint32 GetNumberOfSocialsWithFlag(SocialFlag flag);
 
+        // changed when any player add new ignore, IgnoreFilter users must be rebuilt
+        static uint32 GetIgnoreGeneration() { return m_ignoreGeneration.value(); }
+
         // Saving
         void SaveFriendInfo(ObjectGuid const& friend_guid, FriendInfo const& fi);
 
     private:
         PlayerSocialMap m_playerSocialMap;
         ObjectGuid m_playerGuid;
+
+        static ACE_Atomic_Op<ACE_Thread_Mutex, uint32> m_ignoreGeneration;
 };
 
 class SocialMgr
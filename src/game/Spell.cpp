@@ -46,6 +46,7 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "Chat.h"
+#include "playerbot/PlayerbotAI.h"
 
 extern pEffect SpellEffects[TOTAL_SPELL_EFFECTS];
 
@@ -466,7 +467,7 @@ Spell::~Spell()
 template<typename T> WorldObject* Spell::FindCorpseUsing(uint32 corpseTypeMask)
 {
     // non-standard target selection
-    SpellRangeEntry const* srange = sSpellRangeStore.LookupEntry(m_spellInfo->GetRangeIndex());
+    SpellRangeEntry const* srange = sSpellMgr.GetSpellRangeEntry(m_spellInfo);
     float max_range = GetSpellMaxRange(srange);
 
     WorldObject* result = NULL;
@@ -2688,7 +2689,7 @@ void Spell::SetTargetMap(SpellEffectIndex effIndex, uint32 targetMode, UnitList&
             // Some spells untested, for affected GO type 33. May need further adjustments for spells related.
 
             std::list<GameObject*> tempTargetGOList;
-            float fSearchDistance = GetSpellMaxRange(sSpellRangeStore.LookupEntry(m_spellInfo->GetRangeIndex()));
+            float fSearchDistance = GetSpellMaxRange(sSpellMgr.GetSpellRangeEntry(m_spellInfo));
             SQLMultiStorage::SQLMSIteratorBounds<SpellTargetEntry> bounds = sSpellScriptTargetStorage.getBounds<SpellTargetEntry>(m_spellInfo->Id);
             if (bounds.first !=  bounds.second)
             {
@@ -3407,7 +3408,7 @@ void Spell::SetTargetMap(SpellEffectIndex effIndex, uint32 targetMode, UnitList&
         {
             if (!(m_targets.m_targetMask & TARGET_FLAG_DEST_LOCATION))
             {
-                SpellRangeEntry const* rEntry = sSpellRangeStore.LookupEntry(m_spellInfo->GetRangeIndex());
+                SpellRangeEntry const* rEntry = sSpellMgr.GetSpellRangeEntry(m_spellInfo);
                 float minRange = GetSpellMinRange(rEntry);
                 float maxRange = GetSpellMaxRange(rEntry);
                 float dist = minRange+ rand_norm_f()*(maxRange-minRange);
@@ -4649,6 +4650,13 @@ void Spell::SendCastResult(Player* caster, SpellEntry const* spellInfo, uint8 ca
     if (result == SPELL_CAST_OK)
         return;
 
+    if (PlayerbotAI* ai = caster->GetPlayerbotAI())
+    {
+        if (!isPetCastResult)
+            ai->HandleSpellResult(spellInfo->Id, result);
+        return;
+    }
+
     WorldPacket data(isPetCastResult ? SMSG_PET_CAST_FAILED : SMSG_CAST_FAILED, (4 + 1 + 2));
     data << uint8(cast_count);                              // single cast or multi 2.3 (0/1)
     data << uint32(spellInfo->Id);
@@ -4740,6 +4748,10 @@ void Spell::SendSpellStart()
 
     DEBUG_FILTER_LOG(LOG_FILTER_SPELL_CAST, "Sending SMSG_SPELL_START id=%u", m_spellInfo->Id);
 
+    if (m_caster->GetTypeId() == TYPEID_PLAYER)
+        if (PlayerbotAI* ai = ((Player*)m_caster)->GetPlayerbotAI())
+            ai->HandleSpellStart(m_spellInfo, m_timer);
+
     uint32 castFlags = CAST_FLAG_UNKNOWN2;
     if (IsRangedSpell())
         castFlags |= CAST_FLAG_AMMO;
@@ -5152,6 +5164,10 @@ void Spell::SendInterrupted(uint8 result)
     if (!m_caster || !m_caster->IsInWorld())
         return;
 
+    if (m_caster->GetTypeId() == TYPEID_PLAYER)
+        if (PlayerbotAI* ai = ((Player*)m_caster)->GetPlayerbotAI())
+            ai->HandleSpellResult(m_spellInfo->Id, SpellCastResult(result));
+
     WorldPacket data(SMSG_SPELL_FAILURE, 8 + 1 + 4 + 1);
     data << m_caster->GetPackGUID();
     data << uint8(m_cast_count);
@@ -6210,7 +6226,7 @@ SpellCastResult Spell::CheckCast(bool strict)
                         sLog.outErrorDb("Spell entry %u, effect %i has EffectImplicitTargetA/EffectImplicitTargetB = TARGET_FOCUS_OR_SCRIPTED_GAMEOBJECT, but gameobject are not defined in `spell_script_target`", m_spellInfo->Id, j);
                 }
 
-                SpellRangeEntry const* srange = sSpellRangeStore.LookupEntry(m_spellInfo->GetRangeIndex());
+                SpellRangeEntry const* srange = sSpellMgr.GetSpellRangeEntry(m_spellInfo);
                 float range = GetSpellMaxRange(srange);
 
                 Creature* targetExplicit = NULL;            // used for cases where a target is provided (by script for example)
@@ -6428,7 +6444,7 @@ SpellCastResult Spell::CheckCast(bool strict)
                 {
                     UnitList targets;
 
-                    float radius = GetSpellMaxRange(sSpellRangeStore.LookupEntry(m_spellInfo->GetRangeIndex()));
+                    float radius = GetSpellMaxRange(sSpellMgr.GetSpellRangeEntry(m_spellInfo));
 
                     MaNGOS::AnyUnfriendlyVisibleUnitInObjectRangeCheck unitCheck(m_caster, m_caster, radius);
                     MaNGOS::UnitListSearcher<MaNGOS::AnyUnfriendlyVisibleUnitInObjectRangeCheck> checker(targets, unitCheck);
@@ -7519,7 +7535,7 @@ SpellCastResult Spell::CheckRange(bool strict, WorldObject* checkTarget)
     Unit* target = (checkTarget && checkTarget->GetObjectGuid().IsUnit()) ? (Unit*)checkTarget : m_targets.getUnitTarget();
     GameObject* pGoTarget = (checkTarget && checkTarget->GetObjectGuid().IsGameObject()) ? (GameObject*)checkTarget : m_targets.getGOTarget();
 
-    SpellRangeEntry const* srange = sSpellRangeStore.LookupEntry(m_spellInfo->GetRangeIndex());
+    SpellRangeEntry const* srange = sSpellMgr.GetSpellRangeEntry(m_spellInfo);
 
     bool friendly = target ? target->IsFriendlyTo(m_caster) : false;
     float max_range = GetSpellMaxRange(srange, friendly);
@@ -8913,7 +8929,7 @@ bool Spell::FillCustomTargetMap(SpellEffectIndex i, UnitList& targetUnitMap, uin
     if (m_spellInfo->EffectRadiusIndex[i])
         radius = GetSpellRadius(sSpellRadiusStore.LookupEntry(m_spellInfo->EffectRadiusIndex[i]));
     else
-        radius = GetSpellMaxRange(sSpellRangeStore.LookupEntry(m_spellInfo->GetRangeIndex()));
+        radius = GetSpellMaxRange(sSpellMgr.GetSpellRangeEntry(m_spellInfo));
 
     // Resulting effect depends on spell that we want to cast
     switch (m_spellInfo->Id)
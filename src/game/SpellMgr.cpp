@@ -396,12 +396,8 @@ int32 CompareAuraRanks(uint32 spellId_1, uint32 spellId_2)
     return 0;
 }
 
-SpellSpecific GetSpellSpecific(uint32 spellId)
+static SpellSpecific CalculateSpellSpecific(SpellEntry const* spellInfo)
 {
-    SpellEntry const *spellInfo = sSpellStore.LookupEntry(spellId);
-    if(!spellInfo)
-        return SPELL_NORMAL;
-
     switch(spellInfo->SpellFamilyName)
     {
         case SPELLFAMILY_GENERIC:
@@ -559,6 +555,18 @@ SpellSpecific GetSpellSpecific(uint32 spellId)
     return SPELL_NORMAL;
 }
 
+SpellSpecific GetSpellSpecific(uint32 spellId)
+{
+    if (SpellDerivedData const* data = sSpellMgr.GetSpellDerivedData(spellId))
+        return data->specific;
+
+    SpellEntry const *spellInfo = sSpellStore.LookupEntry(spellId);
+    if(!spellInfo)
+        return SPELL_NORMAL;
+
+    return CalculateSpellSpecific(spellInfo);
+}
+
 // target not allow have more one spell specific from same caster
 bool IsSingleFromSpellSpecificPerTargetPerCaster(SpellSpecific spellSpec1,SpellSpecific spellSpec2)
 {
@@ -1076,23 +1084,34 @@ bool IsPositiveEffect(SpellEntry const *spellproto, SpellEffectIndex effIndex)
     return true;
 }
 
+static bool CalculatePositiveSpell(SpellEntry const *spellproto)
+{
+    // spells with at least one negative effect are considered negative
+    // some self-applied spells have negative effects but in self casting case negative check ignored.
+    for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+        if (spellproto->Effect[i] && !IsPositiveEffect(spellproto, SpellEffectIndex(i)))
+            return false;
+    return true;
+}
+
 bool IsPositiveSpell(uint32 spellId)
 {
+    if (SpellDerivedData const* data = sSpellMgr.GetSpellDerivedData(spellId))
+        return data->flags & SPELL_DERIVED_POSITIVE;
+
     SpellEntry const *spellproto = sSpellStore.LookupEntry(spellId);
     if (!spellproto)
         return false;
 
-    return IsPositiveSpell(spellproto);
+    return CalculatePositiveSpell(spellproto);
 }
 
 bool IsPositiveSpell(SpellEntry const *spellproto)
 {
-    // spells with at least one negative effect are considered negative
-    // some self-applied spells have negative effects but in self casting case negative check ignored.
-    for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
-        if (spellproto->Effect[i] && !IsPositiveEffect(spellproto, SpellEffectIndex(i)))
-            return false;
-    return true;
+    if (SpellDerivedData const* data = sSpellMgr.GetSpellDerivedData(spellproto->Id))
+        return data->flags & SPELL_DERIVED_POSITIVE;
+
+    return CalculatePositiveSpell(spellproto);
 }
 
 bool IsNonPositiveSpell(uint32 spellId)
@@ -2099,6 +2118,55 @@ void SpellMgr::LoadSpellElixirs()
     sLog.outString( ">> Loaded %u spell elixir definitions", count );
 }
 
+void SpellMgr::CalculateSpellDerivedData(uint32 spellId, SpellDerivedData& data) const
+{
+    data = SpellDerivedData();
+
+    SpellEntry const* spellInfo = sSpellStore.LookupEntry(spellId);
+    if (!spellInfo)
+        return;
+
+    SpellProcEventMap::const_iterator procItr = mSpellProcEventMap.find(spellId);
+    if (procItr != mSpellProcEventMap.end())
+        data.procEvent = &procItr->second;
+
+    SpellBonusMap::const_iterator bonusItr = mSpellBonusMap.find(spellId);
+    if (bonusItr != mSpellBonusMap.end())
+        data.bonusData = &bonusItr->second;
+
+    data.range = sSpellRangeStore.LookupEntry(spellInfo->GetRangeIndex());
+    data.specific = CalculateSpellSpecific(spellInfo);
+
+    if (CalculatePositiveSpell(spellInfo))
+        data.flags |= SPELL_DERIVED_POSITIVE;
+}
+
+void SpellMgr::LoadSpellDerivedData()
+{
+    // calculation must not use old table data
+    mSpellDerivedData.clear();
+
+    SpellDerivedDataVector derivedData(sSpellStore.GetNumRows());
+
+    BarGoLink bar(derivedData.size());
+
+    uint32 count = 0;
+    for (uint32 spellId = 0; spellId < derivedData.size(); ++spellId)
+    {
+        bar.step();
+
+        CalculateSpellDerivedData(spellId, derivedData[spellId]);
+
+        if (sSpellStore.LookupEntry(spellId))
+            ++count;
+    }
+
+    mSpellDerivedData.swap(derivedData);
+
+    sLog.outString();
+    sLog.outString(">> Precomputed derived data for %u spells", count);
+}
+
 struct DoSpellThreat
 {
     DoSpellThreat(SpellThreatMap& _threatMap) : threatMap(_threatMap), count(0) {}
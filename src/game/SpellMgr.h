@@ -943,6 +943,25 @@ struct SpellBonusEntry
 typedef UNORDERED_MAP<uint32, SpellProcEventEntry> SpellProcEventMap;
 typedef UNORDERED_MAP<uint32, SpellBonusEntry>     SpellBonusMap;
 
+enum SpellDerivedFlags
+{
+    SPELL_DERIVED_POSITIVE      = 0x01,                     // IsPositiveSpell
+};
+
+// Spell properties derived from spell data at load, accessed by spell id in hot spell paths
+struct SpellDerivedData
+{
+    SpellDerivedData() : procEvent(NULL), bonusData(NULL), range(NULL), specific(SPELL_NORMAL), flags(0) {}
+
+    SpellProcEventEntry const* procEvent;                   // points into SpellMgr maps, rebuilt at their reload
+    SpellBonusEntry const* bonusData;
+    SpellRangeEntry const* range;
+    SpellSpecific specific;
+    uint32 flags;                                           // SpellDerivedFlags
+};
+
+typedef std::vector<SpellDerivedData> SpellDerivedDataVector;
+
 #define ELIXIR_BATTLE_MASK    0x01
 #define ELIXIR_GUARDIAN_MASK  0x02
 #define ELIXIR_FLASK_MASK     (ELIXIR_BATTLE_MASK|ELIXIR_GUARDIAN_MASK)
@@ -1261,6 +1280,9 @@ class SpellMgr
         // Spell proc events
         SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const
         {
+            if (SpellDerivedData const* data = GetSpellDerivedData(spellId))
+                return data->procEvent;
+
             SpellProcEventMap::const_iterator itr = mSpellProcEventMap.find(spellId);
             if ( itr != mSpellProcEventMap.end( ) )
                 return &itr->second;
@@ -1282,6 +1304,9 @@ class SpellMgr
         // Spell bonus data
         SpellBonusEntry const* GetSpellBonusData(uint32 spellId) const
         {
+            if (SpellDerivedData const* data = GetSpellDerivedData(spellId))
+                return data->bonusData;
+
             // Lookup data
             SpellBonusMap::const_iterator itr = mSpellBonusMap.find(spellId);
             if ( itr != mSpellBonusMap.end( ) )
@@ -1507,6 +1532,23 @@ class SpellMgr
 
         void CheckUsedSpells(char const* table);
 
+        // Precomputed spell data, NULL before LoadSpellDerivedData or for spell id out of spell store
+        SpellDerivedData const* GetSpellDerivedData(uint32 spellId) const
+        {
+            return spellId < mSpellDerivedData.size() ? &mSpellDerivedData[spellId] : NULL;
+        }
+
+        SpellRangeEntry const* GetSpellRangeEntry(SpellEntry const* spellInfo) const
+        {
+            if (SpellDerivedData const* data = GetSpellDerivedData(spellInfo->Id))
+                return data->range;
+
+            return sSpellRangeStore.LookupEntry(spellInfo->GetRangeIndex());
+        }
+
+        // calculate data without precomputed table, for table build and comparison
+        void CalculateSpellDerivedData(uint32 spellId, SpellDerivedData& data) const;
+
         // Loading data at server startup
         void LoadSpellChains();
         void LoadSpellLearnSkills();
@@ -1527,6 +1569,7 @@ class SpellMgr
         void LoadSpellAreas();
         void LoadSkillDiscoveryTable();
         void LoadSpellDbc();
+        void LoadSpellDerivedData();                        // must be after all spell data used by it, and at its reload
 
     private:
         bool LoadPetDefaultSpells_helper(CreatureInfo const* cInfo, PetDefaultSpellsEntry& petDefSpells);
@@ -1553,6 +1596,7 @@ class SpellMgr
         SpellAreaForAreaMap  mSpellAreaForAreaMap;
         SkillDiscoveryMap    mSkillDiscoveryStore;
         SkillExtraItemMap    mSkillExtraItemStore;
+        SpellDerivedDataVector mSpellDerivedData;
 };
 
 #define sSpellMgr SpellMgr::Instance()
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "StartupLoader.h"
+#include "Log.h"
+#include "ProgressBar.h"
+#include "Threading.h"
+#include "Timer.h"
+#include "Database/DatabaseEnv.h"
+
+#include <algorithm>
+
+class StartupLoaderThread : public ACE_Based::Runnable
+{
+    public:
+        explicit StartupLoaderThread(StartupLoader* loader) : m_loader(loader) {}
+
+        void run() override
+        {
+            WorldDatabase.ThreadStart();                    // let thread do safe mySQL requests
+            m_loader->ThreadLoop();
+            WorldDatabase.ThreadEnd();
+        }
+
+    private:
+        StartupLoader* m_loader;
+};
+
+StartupLoader::StartupLoader() : m_firstTask(0), m_left(0), m_totalTime(0), m_condition(m_lock)
+{
+}
+
+StartupLoader::~StartupLoader()
+{
+    for (std::vector<Task*>::const_iterator itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        delete *itr;
+}
+
+uint32 StartupLoader::AddTask(Task* task, uint32 dep1, uint32 dep2, uint32 dep3)
+{
+    uint32 id = m_tasks.size();
+    m_tasks.push_back(task);
+
+    AddDependency(id, dep1);
+    AddDependency(id, dep2);
+    AddDependency(id, dep3);
+    return id;
+}
+
+void StartupLoader::AddDependency(uint32 task, uint32 dependency)
+{
+    // tasks finished in previous Run() calls not need wait
+    if (dependency == STARTUP_LOADER_NO_TASK || dependency < m_firstTask)
+        return;
+
+    MANGOS_ASSERT(dependency < task && task < m_tasks.size());
+
+    m_tasks[dependency]->dependents.push_back(task);
+    ++m_tasks[task]->waitCount;
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    if (m_firstTask >= m_tasks.size())
+        return;
+
+    uint32 startTime = WorldTimer::getMSTime();
+
+    m_ready.clear();
+    for (uint32 i = m_firstTask; i < m_tasks.size(); ++i)
+        if (!m_tasks[i]->waitCount)
+            m_ready.push_back(i);
+
+    m_left = m_tasks.size() - m_firstTask;
+
+    if (threads <= 1)
+        ThreadLoop();
+    else
+    {
+        // progress bars of parallel loaders only mix output
+        bool showBars = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+
+        std::vector<ACE_Based::Thread*> workers;
+        for (uint32 i = 0; i < threads; ++i)
+            workers.push_back(new ACE_Based::Thread(new StartupLoaderThread(this)));
+
+        for (uint32 i = 0; i < threads; ++i)
+        {
+            workers[i]->wait();
+            delete workers[i];
+        }
+
+        BarGoLink::SetOutputState(showBars);
+    }
+
+    uint32 runTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+    m_totalTime += runTime;
+
+    sLog.outString(">> %u loaders executed in %u threads in %u ms", uint32(m_tasks.size() - m_firstTask), threads > 1 ? threads : 1, runTime);
+    sLog.outString();
+
+    m_firstTask = m_tasks.size();
+}
+
+void StartupLoader::ThreadLoop()
+{
+    for (;;)
+    {
+        uint32 task;
+
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+            while (m_ready.empty() && m_left)
+                m_condition.wait();
+
+            if (!m_left)
+                return;
+
+            task = m_ready.front();
+            m_ready.erase(m_ready.begin());
+        }
+
+        ExecuteTask(task);
+
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+            std::vector<uint32> const& dependents = m_tasks[task]->dependents;
+            for (std::vector<uint32>::const_iterator itr = dependents.begin(); itr != dependents.end(); ++itr)
+                if (!--m_tasks[*itr]->waitCount)
+                    m_ready.insert(std::lower_bound(m_ready.begin(), m_ready.end(), *itr), *itr);
+
+            --m_left;
+
+            // wake up all - new ready tasks or end of work
+            m_condition.broadcast();
+        }
+    }
+}
+
+void StartupLoader::ExecuteTask(uint32 task)
+{
+    Task* loader = m_tasks[task];
+
+    sLog.outString("Loading %s...", loader->name.c_str());
+
+    uint32 startTime = WorldTimer::getMSTime();
+    loader->Load();
+    loader->time = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+static bool StartupLoaderTimeOrder(StartupLoader::Task const* a, StartupLoader::Task const* b)
+{
+    return a->time > b->time;
+}
+
+void StartupLoader::OutputTimings() const
+{
+    std::vector<Task const*> tasks(m_tasks.begin(), m_tasks.begin() + m_firstTask);
+    std::sort(tasks.begin(), tasks.end(), StartupLoaderTimeOrder);
+
+    uint32 sumTime = 0;
+    for (std::vector<Task const*>::const_iterator itr = tasks.begin(); itr != tasks.end(); ++itr)
+        sumTime += (*itr)->time;
+
+    sLog.outString("Startup loaders timings (%u loaders, %u ms in loaders, %u ms elapsed):", uint32(tasks.size()), sumTime, m_totalTime);
+    for (std::vector<Task const*>::const_iterator itr = tasks.begin(); itr != tasks.end(); ++itr)
+        sLog.outString("  %7u ms  %s", (*itr)->time, (*itr)->name.c_str());
+    sLog.outString();
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_STARTUP_LOADER_H
+#define MANGOS_STARTUP_LOADER_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <vector>
+#include <string>
+
+#define STARTUP_LOADER_NO_TASK  uint32(-1)
+
+/**
+ * Task graph for world startup data loading.
+ *
+ * Loaders are added in the usual (sequential) load order together with the loaders they depend on
+ * (tables they read or containers they share). Run() executes them on a number of threads: a loader
+ * starts as soon as all its dependencies are finished, the earliest added ready loader first.
+ * With one thread loaders are executed in the added order. World DB queries of loader threads are
+ * spread over the WorldDatabaseConnections query connections.
+ *
+ * Time of every executed loader is kept, OutputTimings() prints them sorted by time.
+ */
+class StartupLoader
+{
+    public:
+        struct Task
+        {
+            explicit Task(char const* _name) : name(_name), waitCount(0), time(0) {}
+            virtual ~Task() {}
+            virtual void Load() = 0;
+
+            std::string name;
+            std::vector<uint32> dependents;                 // tasks waiting for this one
+            uint32 waitCount;                               // not finished dependencies
+            uint32 time;                                    // load time in ms
+        };
+
+        template<class T>
+        struct MethodTask : public Task
+        {
+            typedef void (T::*Method)();
+
+            MethodTask(char const* _name, T* _object, Method _method) : Task(_name), object(_object), method(_method) {}
+            void Load() override { (object->*method)(); }
+
+            T* object;
+            Method method;
+        };
+
+        struct FunctionTask : public Task
+        {
+            typedef void (*Function)();
+
+            FunctionTask(char const* _name, Function _function) : Task(_name), function(_function) {}
+            void Load() override { (*function)(); }
+
+            Function function;
+        };
+
+    public:
+        StartupLoader();
+        ~StartupLoader();
+
+        // returns task id for use in dependencies of later tasks
+        template<class T>
+        uint32 Add(char const* name, T* object, void (T::*method)(),
+            uint32 dep1 = STARTUP_LOADER_NO_TASK, uint32 dep2 = STARTUP_LOADER_NO_TASK, uint32 dep3 = STARTUP_LOADER_NO_TASK)
+        {
+            return AddTask(new MethodTask<T>(name, object, method), dep1, dep2, dep3);
+        }
+
+        uint32 Add(char const* name, void (*function)(),
+            uint32 dep1 = STARTUP_LOADER_NO_TASK, uint32 dep2 = STARTUP_LOADER_NO_TASK, uint32 dep3 = STARTUP_LOADER_NO_TASK)
+        {
+            return AddTask(new FunctionTask(name, function), dep1, dep2, dep3);
+        }
+
+        void AddDependency(uint32 task, uint32 dependency);
+
+        // execute all added and not yet executed tasks, return after all finished
+        void Run(uint32 threads);
+
+        void OutputTimings() const;
+
+    private:
+        friend class StartupLoaderThread;
+
+        uint32 AddTask(Task* task, uint32 dep1, uint32 dep2, uint32 dep3);
+
+        // worker threads part
+        void ThreadLoop();
+        void ExecuteTask(uint32 task);
+
+        std::vector<Task*> m_tasks;                         // all added tasks, executed kept for timings output
+
+        uint32 m_firstTask;                                 // first not executed task
+        std::vector<uint32> m_ready;                        // sorted, lowest id first
+        uint32 m_left;                                      // not finished tasks of current Run()
+        uint32 m_totalTime;                                 // sum of Run() times
+
+        ACE_Thread_Mutex m_lock;
+        ACE_Condition_Thread_Mutex m_condition;
+};
+
+#endif
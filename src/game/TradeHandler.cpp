@@ -30,8 +30,17 @@
 #include "Language.h"
 #include "DBCStores.h"
 
+// Playerbot mod
+#include "playerbot/PlayerbotAI.h"
+
 void WorldSession::SendTradeStatus(TradeStatus status)
 {
+    if (PlayerbotAI* ai = _player->GetPlayerbotAI())
+    {
+        ai->HandleTradeStatus(status);
+        return;
+    }
+
     WorldPacket data;
 
     switch(status)
@@ -496,6 +505,9 @@ void WorldSession::HandleAcceptTradeOpcode(WorldPacket& recvPacket)
         trader->SaveInventoryAndGoldToDB();
         CharacterDatabase.CommitTransaction();
 
+        _player->ScheduleUrgentSave();
+        trader->ScheduleUrgentSave();
+
         trader->GetSession()->SendTradeStatus(TRADE_STATUS_TRADE_COMPLETE);
         SendTradeStatus(TRADE_STATUS_TRADE_COMPLETE);
     }
@@ -633,6 +645,12 @@ void WorldSession::HandleInitiateTradeOpcode(WorldPacket& recvPacket)
     _player->m_trade = new TradeData(_player, pOther);
     pOther->m_trade = new TradeData(pOther, _player);
 
+    if (PlayerbotAI* ai = pOther->GetPlayerbotAI())
+    {
+        ai->HandleTradeStatus(TRADE_STATUS_BEGIN_TRADE);
+        return;
+    }
+
     WorldPacket data(SMSG_TRADE_STATUS, 12);
     data << uint32(TRADE_STATUS_BEGIN_TRADE);
     data << ObjectGuid(_player->GetObjectGuid());
@@ -232,6 +232,7 @@ Unit::Unit() :
 
     m_Visibility = VISIBILITY_ON;
     m_AINotifyScheduled = false;
+    m_relocationVisibilityCounter = 0;
 
     m_detectInvisibilityMask = 0;
     m_invisibilityMask = 0;
@@ -4970,6 +4971,10 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolderPtr holder)
         return false;
     }
 
+    // new aura must tick and expire in time, dormancy delay is recalculated at next check
+    if (GetTypeId() == TYPEID_UNIT)
+        ((Creature*)this)->WakeUp();
+
     if (holder->GetTarget() != this)
     {
         sLog.outError("Unit::AddSpellAuraHolder cannot add SpellAuraHolder %u, caster %s, to %s, due to different target (%s)!",
@@ -9826,6 +9831,8 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy)
 
         Creature* pCreature = (Creature*)this;
 
+        pCreature->WakeUp();
+
         if (pCreature->AI())
             pCreature->AI()->EnterCombat(enemy);
 
@@ -12801,6 +12808,9 @@ void Unit::UpdateModelData()
 
     SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, boundingRadius);
     SetFloatValue(UNIT_FIELD_COMBATREACH, combatReach);
+
+    // size used by cell index range filter
+    UpdateCellObjectIndex();
 }
 
 void Unit::ClearComboPointHolders()
@@ -13977,8 +13987,16 @@ void Unit::OnRelocated()
     {
         m_last_notified_position = GetPosition();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
-        UpdateObjectVisibility();
+        GetViewPoint().Call_UpdateVisibilityForOwnerIncremental();
+
+        // observers in LOD rings updated only at each N-th relocation
+        float lodDistance = sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_NEAR);
+        if (lodDistance > 0.0f && ++m_relocationVisibilityCounter >= sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOD_TICKS_NEAR))
+        {
+            m_relocationVisibilityCounter = 0;
+            lodDistance = 0.0f;
+        }
+        UpdateObjectVisibility(lodDistance);
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
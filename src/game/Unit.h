@@ -2346,6 +2346,7 @@ class MANGOS_DLL_SPEC Unit : public WorldObject
 
         UnitVisibility m_Visibility;
         WorldLocation m_last_notified_position;
+        uint32 m_relocationVisibilityCounter;               // relocations since far observers visibility update
         bool m_AINotifyScheduled;
 
         Diminishing m_Diminishing;
@@ -58,6 +58,7 @@
 #include "GameEventMgr.h"
 #include "PoolManager.h"
 #include "Database/DatabaseImpl.h"
+#include "Database/SQLStorageSnapshot.h"
 #include "GridNotifiersImpl.h"
 #include "CellImpl.h"
 #include "MapPersistentStateMgr.h"
@@ -70,6 +71,12 @@
 #include "CreatureLinkingMgr.h"
 #include "LFGMgr.h"
 #include "warden/WardenDataStorage.h"
+#include "StartupLoader.h"
+#include "PlayerSaveScheduler.h"
+#include "playerbot/PlayerbotLoadBenchmark.h"
+#include "WorldMetrics.h"
+#include "PacketRateLimiter.h"
+#include "SessionDomainUpdater.h"
 
 INSTANTIATE_SINGLETON_1( World );
 
@@ -101,6 +108,7 @@ World::World()
     m_maxQueuedSessionCount = 0;
     m_NextDailyQuestReset = 0;
     m_NextWeeklyQuestReset = 0;
+    m_sessionDomainUpdater = NULL;
 
     m_defaultDbcLocale = LOCALE_enUS;
     m_availableDbcLocaleMask = 0;
@@ -129,6 +137,8 @@ World::~World()
         m_sessions.erase(m_sessions.begin());
     }
 
+    delete m_sessionDomainUpdater;
+
     ///- Empty the WeatherMap
     for (WeatherMap::const_iterator itr = m_weathers.begin(); itr != m_weathers.end(); ++itr)
         delete itr->second;
@@ -571,6 +581,9 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_INTERVAL_SAVE, "PlayerSave.Interval", 15 * MINUTE * IN_MILLISECONDS);
     setConfigMinMax(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, 0, MAX_LEVEL);
     setConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
+    setConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_QUEUE_SIZE, "PlayerSave.MaxQueueSize", 200);
+    setConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_AVERAGE_TIME, "PlayerSave.MaxAverageTime", 50);
+    setConfig(CONFIG_UINT32_PLAYER_SAVE_URGENT_DELAY, "PlayerSave.UrgentDelay", 10 * IN_MILLISECONDS);
 
     setConfigMin(CONFIG_UINT32_INTERVAL_GRIDCLEAN, "GridCleanUpDelay", 5 * MINUTE * IN_MILLISECONDS, MIN_GRID_DELAY);
 
@@ -585,6 +598,26 @@ void World::LoadConfigSettings(bool reload)
     }
 #endif
 
+    setConfigMinMax(CONFIG_UINT32_STARTUP_LOADER_THREADS, "StartupLoader.Threads", 4, 1, 16);
+
+#ifdef MANGOSR2_SINGLE_THREAD
+    if (getConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS) > 1)
+    {
+        sLog.outError(" Your OS (%s) not support set StartupLoader.Threads > 1! Resetted to 1", MANGOSR2_SINGLE_THREAD);
+        setConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS, "fakeString", 1);
+    }
+#endif
+
+    setConfigMinMax(CONFIG_UINT32_SESSION_UPDATE_THREADS, "SessionUpdate.Threads", 0, 0, MAX_SESSION_DOMAINS);
+
+#ifdef MANGOSR2_SINGLE_THREAD
+    if (getConfig(CONFIG_UINT32_SESSION_UPDATE_THREADS) > 0)
+    {
+        sLog.outError(" Your OS (%s) not support set SessionUpdate.Threads > 0! Resetted to 0", MANGOSR2_SINGLE_THREAD);
+        setConfig(CONFIG_UINT32_SESSION_UPDATE_THREADS, "fakeString", 0);
+    }
+#endif
+
     setConfigMinMax(CONFIG_FLOAT_LOADBALANCE_HIGHVALUE, "MapUpdate.LoadBalanceHighValue", 0.8f, 0.5f, 1.0f);
     setConfigMinMax(CONFIG_FLOAT_LOADBALANCE_LOWVALUE, "MapUpdate.LoadBalanceLowValue", 0.2f, 0.0f, 0.5f);
 
@@ -807,6 +840,10 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_ASSISTANCE_DELAY, "CreatureFamilyAssistanceDelay", 1500);
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_FLEE_DELAY,       "CreatureFamilyFleeDelay",       7000);
 
+    setConfig(CONFIG_BOOL_CREATURE_DORMANCY, "Creature.Dormancy.Enable", false);
+    setConfigMinMax(CONFIG_UINT32_CREATURE_DORMANCY_INTERVAL, "Creature.Dormancy.Interval", 5000, 1000, 60000);
+    setConfigPos(CONFIG_FLOAT_CREATURE_DORMANCY_DISTANCE, "Creature.Dormancy.Distance", 0.0f);
+
     setConfig(CONFIG_UINT32_WORLD_BOSS_LEVEL_DIFF, "WorldBossLevelDiff", 3);
 
     setConfigMinMax(CONFIG_INT32_QUEST_LOW_LEVEL_HIDE_DIFF, "Quests.LowLevelHideDiff", 4, -1, MAX_LEVEL);
@@ -824,6 +861,7 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_RESTRICTED_LFG_CHANNEL,      "Channel.RestrictedLfg", true);
     setConfig(CONFIG_BOOL_SILENTLY_GM_JOIN_TO_CHANNEL, "Channel.SilentlyGMJoin", false);
+    setConfig(CONFIG_UINT32_CHANNEL_NETWORK_BROADCAST, "Channel.NetworkBroadcastThreshold", 500);
 
     setConfig(CONFIG_BOOL_TALENTS_INSPECTING,           "TalentsInspecting", true);
     setConfig(CONFIG_BOOL_CHAT_FAKE_MESSAGE_PREVENTING, "ChatFakeMessagePreventing", false);
@@ -888,6 +926,8 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET, "OffhandCheckAtTalentsReset", false);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
+    setConfig(CONFIG_UINT32_SLOW_OPCODE_HANDLER_TIME, "Network.SlowHandlerTime", 100);
+    sPacketRateLimiter.LoadConfig();
 
     if (int clientCacheId = sConfig.GetIntDefault("ClientCacheVersion", 0))
     {
@@ -928,8 +968,21 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_DYNAMIC_VMAP_DOUBLE_CHECK,"vmap.Dynamic.DoubleCheck", false);
 
+    setConfigMinMax(CONFIG_FLOAT_LOS_CACHE_GRID, "vmap.LOSCache.Grid", 0.5f, 0.0f, 5.0f);
+    setConfigMinMax(CONFIG_UINT32_LOS_CACHE_LIFETIME, "vmap.LOSCache.LifeTime", 1000, 100, 60000);
+
     m_relocation_ai_notify_delay = sConfig.GetIntDefault("Visibility.AIRelocationNotifyDelay", 1000u);
     m_relocation_lower_limit     = sConfig.GetFloatDefault("Visibility.RelocationLowerLimit", 10.0f);
+    setConfig(CONFIG_UINT32_VISIBILITY_INCREMENTAL_UPDATES, "Visibility.IncrementalUpdates", 10);
+    setConfigMinMax(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_NEAR, "Visibility.LOD.Distance.Near", 0.0f, 0.0f, MAX_VISIBILITY_DISTANCE);
+    setConfigMinMax(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_FAR, "Visibility.LOD.Distance.Far", 0.0f, 0.0f, MAX_VISIBILITY_DISTANCE);
+    setConfigMinMax(CONFIG_UINT32_VISIBILITY_LOD_TICKS_NEAR, "Visibility.LOD.Ticks.Near", 2, 1, 20);
+    setConfigMinMax(CONFIG_UINT32_VISIBILITY_LOD_TICKS_FAR, "Visibility.LOD.Ticks.Far", 4, 1, 20);
+    if (getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_FAR) > 0.0f && getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_FAR) < getConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_NEAR))
+    {
+        sLog.outError("Visibility.LOD.Distance.Far can't be less Visibility.LOD.Distance.Near, far ring disabled.");
+        setConfig(CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_FAR, 0.0f);
+    }
 
     m_VisibleUnitGreyDistance = sConfig.GetFloatDefault("Visibility.Distance.Grey.Unit", 1);
     if (m_VisibleUnitGreyDistance >  MAX_VISIBILITY_DISTANCE)
@@ -1023,6 +1076,12 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("BOOT: Using DataDir %s", m_dataPath.c_str());
     }
 
+    ///- Read the world DB tables snapshot directory, empty string disable snapshots
+    std::string snapshotPath = sConfig.GetStringDefault("SnapshotDir", "");
+    SQLStorageSnapshot::SetDirectory(snapshotPath);
+    if (!snapshotPath.empty())
+        sLog.outString("BOOT: Using SnapshotDir %s", snapshotPath.c_str());
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = true;
     bool enableHeight = true;
@@ -1033,6 +1092,7 @@ void World::LoadConfigSettings(bool reload)
 
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
+    VMAP::VMapFactory::createOrGetVMapManager()->setLineOfSightCacheSettings(getConfig(CONFIG_FLOAT_LOS_CACHE_GRID), getConfig(CONFIG_UINT32_LOS_CACHE_LIFETIME));
     VMAP::VMapFactory::preventSpellsFromBeingTestedForLoS(ignoreSpellIds.c_str());
     sLog.outString( "BOOT: VMap support included. LineOfSight:%i, getHeight:%i, indoorCheck:%i",
         enableLOS, enableHeight, getConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK) ? 1 : 0);
@@ -1140,6 +1200,9 @@ void World::SetInitialWorldSettings()
     ///- Initialize config settings
     LoadConfigSettings();
 
+    ///- Register world metrics before grids loading, exported by network listener
+    sWorldMetrics.Initialize();
+
     ///- Check the existence of the map files for all races start areas.
     if (!MapManager::ExistMapAndVMap(0,-6240.32f, 331.033f) ||
         !MapManager::ExistMapAndVMap(0,-8949.95f,-132.493f) ||
@@ -1225,90 +1288,41 @@ void World::SetInitialWorldSettings()
     sObjectMgr.SetHighestGuids();                           // must be after PackInstances() and PackGroupIds()
     sLog.outString();
 
-    sLog.outString( "Loading Page Texts..." );
-    sObjectMgr.LoadPageTexts();
-
-    sLog.outString( "Loading Game Object Templates..." );   // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
-
-    sLog.outString( "Loading Spell Chain Data..." );
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString( "Loading Spell Elixir types..." );
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString( "Loading Spell Learn Skills..." );
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString( "Loading Spell Learn Spells..." );
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString( "Loading Spell Proc Event conditions..." );
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString( "Loading Spell Bonus Data..." );
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
-
-    sLog.outString( "Loading Spell Proc Item Enchant..." );
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString( "Loading Spell Linked definitions..." );
-    sSpellMgr.LoadSpellLinked();                            // must be after LoadSpellChains
-
-    sLog.outString( "Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
-
-    sLog.outString( "Loading NPC Texts..." );
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString( "Loading Item Random Enchantments Table..." );
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Items...");                     // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemConverts();
-
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
-    sObjectMgr.LoadItemExpireConverts();
-
-    sLog.outString( "Loading Creature Model Based Info Data..." );
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString( "Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
+    ///- Independent static tables, loaded in parallel by dependencies
+    StartupLoader loader;
+    uint32 pageTexts        = loader.Add("Page Texts", &sObjectMgr, &ObjectMgr::LoadPageTexts);
+    uint32 goInfo           = loader.Add("Game Object Templates", &sObjectMgr, &ObjectMgr::LoadGameobjectInfo, pageTexts);
+    uint32 spellChains      = loader.Add("Spell Chain Data", &sSpellMgr, &SpellMgr::LoadSpellChains);
+    loader.Add("Spell Elixir types", &sSpellMgr, &SpellMgr::LoadSpellElixirs);
+    loader.Add("Spell Learn Skills", &sSpellMgr, &SpellMgr::LoadSpellLearnSkills, spellChains);
+    loader.Add("Spell Learn Spells", &sSpellMgr, &SpellMgr::LoadSpellLearnSpells, spellChains);
+    loader.Add("Spell Proc Event conditions", &sSpellMgr, &SpellMgr::LoadSpellProcEvents, spellChains);
+    loader.Add("Spell Bonus Data", &sSpellMgr, &SpellMgr::LoadSpellBonuses, spellChains);
+    loader.Add("Spell Proc Item Enchant", &sSpellMgr, &SpellMgr::LoadSpellProcItemEnchant, spellChains);
+    loader.Add("Spell Linked definitions", &sSpellMgr, &SpellMgr::LoadSpellLinked, spellChains);
+    loader.Add("Aggro Spells Definitions", &sSpellMgr, &SpellMgr::LoadSpellThreats, spellChains);
+    loader.Add("NPC Texts", &sObjectMgr, &ObjectMgr::LoadGossipText);
+    uint32 randomEnchants   = loader.Add("Item Random Enchantments Table", &LoadRandomEnchantmentsTable);
+    uint32 items            = loader.Add("Items", &sObjectMgr, &ObjectMgr::LoadItemPrototypes, randomEnchants, pageTexts);
+    loader.Add("Item converts", &sObjectMgr, &ObjectMgr::LoadItemConverts, items);
+    loader.Add("Item expire converts", &sObjectMgr, &ObjectMgr::LoadItemExpireConverts, items);
+    uint32 modelInfo        = loader.Add("Creature Model Based Info Data", &sObjectMgr, &ObjectMgr::LoadCreatureModelInfo);
+    uint32 equipment        = loader.Add("Equipment templates", &sObjectMgr, &ObjectMgr::LoadEquipmentTemplates);
     // FIXME! currently spells must be loaded _before_ templates for correct detection.
-    sLog.outString( "Loading Creature spells..." );
-    sObjectMgr.LoadCreatureSpells();
-
-    sLog.outString( "Loading Creature templates..." );
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString( "Loading Creature Model for race..." ); // must be after creature templates
-    sObjectMgr.LoadCreatureModelRace();
-
-    sLog.outString( "Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
-
-    sLog.outString("Loading Vehicle Accessory...");         // must be after creature templates
-    sObjectMgr.LoadVehicleAccessory();
-
-    sLog.outString( "Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString( "Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString( "Loading Creature Reputation OnKill Data..." );
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString( "Loading Reputation Spillover Data..." );
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString( "Loading Points Of Interest Data..." );
-    sObjectMgr.LoadPointsOfInterest();
+    uint32 creatureSpells   = loader.Add("Creature spells", &sObjectMgr, &ObjectMgr::LoadCreatureSpells);
+    uint32 creatureInfo     = loader.Add("Creature templates", &sObjectMgr, &ObjectMgr::LoadCreatureTemplates, creatureSpells, modelInfo, equipment);
+    loader.Add("Creature Model for race", &sObjectMgr, &ObjectMgr::LoadCreatureModelRace, creatureInfo);
+    loader.Add("SpellsScriptTarget", &sSpellMgr, &SpellMgr::LoadSpellScriptTarget, creatureInfo, goInfo, spellChains);
+    loader.Add("Vehicle Accessory", &sObjectMgr, &ObjectMgr::LoadVehicleAccessory, creatureInfo);
+    loader.Add("ItemRequiredTarget", &sObjectMgr, &ObjectMgr::LoadItemRequiredTarget, items, creatureInfo);
+    loader.Add("Reputation Reward Rates", &sObjectMgr, &ObjectMgr::LoadReputationRewardRate);
+    loader.Add("Creature Reputation OnKill Data", &sObjectMgr, &ObjectMgr::LoadReputationOnKill, creatureInfo);
+    loader.Add("Reputation Spillover Data", &sObjectMgr, &ObjectMgr::LoadReputationSpilloverTemplate);
+    loader.Add("Points Of Interest Data", &sObjectMgr, &ObjectMgr::LoadPointsOfInterest);
+    loader.Run(getConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS));
+
+    sLog.outString( "Loading Spell derived data..." );
+    sSpellMgr.LoadSpellDerivedData();                       // must be after all spell data tables
 
     sLog.outString( "Loading Creature Data..." );
     sObjectMgr.LoadCreatures();
@@ -1433,47 +1447,35 @@ void World::SetInitialWorldSettings()
     sLog.outString( "Loading Spell disabled..." );
     sObjectMgr.LoadSpellDisabledEntrys();
 
-    sLog.outString( "Loading Loot Tables..." );
-    sLog.outString();
-    LoadLootTables();
-    sLog.outString( ">>> Loot Tables loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading Skill Discovery Table..." );
-    sSpellMgr.LoadSkillDiscoveryTable();
-
-    sLog.outString( "Loading Skill Extra Item Table..." );
-    sSpellMgr.LoadSkillExtraItemTable();
-
-    sLog.outString( "Loading Skill Fishing base level requirements..." );
-    sObjectMgr.LoadFishingBaseSkillLevel();
-
-    sLog.outString();
-    sLog.outString( "Loading Achievements..." );
-    sAchievementMgr.LoadAchievementReferenceList();
-    sAchievementMgr.LoadAchievementCriteriaList();
-    sAchievementMgr.LoadAchievementCriteriaRequirements();
-    sAchievementMgr.LoadRewards();
-    sAchievementMgr.LoadRewardLocales();
-    sAchievementMgr.LoadCompletedAchievements();
-    sLog.outString( ">>> Achievements loaded" );
-    sLog.outString();
-
-    sLog.outString( "Loading Instance encounters data..." );  // must be after Creature loading
-    sObjectMgr.LoadInstanceEncounters();
-
-    sLog.outString( "Loading Gossip scripts..." );
-    sScriptMgr.LoadGossipScripts();                         // must be before gossip menu options
-
-    sObjectMgr.LoadGossipMenus();
-
-    sLog.outString( "Loading Vendors..." );
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
-
-    sLog.outString( "Loading Trainers..." );
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
+    ///- Tables dependent from templates and spawns, loaded in parallel by dependencies
+    loader.Add("Loot Tables", &LoadLootTables);
+    loader.Add("Skill Discovery Table", &sSpellMgr, &SpellMgr::LoadSkillDiscoveryTable);
+    loader.Add("Skill Extra Item Table", &sSpellMgr, &SpellMgr::LoadSkillExtraItemTable);
+    loader.Add("Skill Fishing base level requirements", &sObjectMgr, &ObjectMgr::LoadFishingBaseSkillLevel);
+    uint32 achievementRefs  = loader.Add("Achievement references", &sAchievementMgr, &AchievementGlobalMgr::LoadAchievementReferenceList);
+    uint32 criteria         = loader.Add("Achievement criteria", &sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaList, achievementRefs);
+    loader.Add("Achievement criteria requirements", &sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaRequirements, criteria);
+    uint32 achievementRewards = loader.Add("Achievement rewards", &sAchievementMgr, &AchievementGlobalMgr::LoadRewards, achievementRefs);
+    uint32 rewardLocales    = loader.Add("Achievement reward locales", &sAchievementMgr, &AchievementGlobalMgr::LoadRewardLocales, achievementRewards);
+    loader.Add("Completed achievements", &sAchievementMgr, &AchievementGlobalMgr::LoadCompletedAchievements, achievementRefs);
+    loader.Add("Instance encounters data", &sObjectMgr, &ObjectMgr::LoadInstanceEncounters);
+    uint32 gossipScripts    = loader.Add("Gossip scripts", &sScriptMgr, &ScriptMgr::LoadGossipScripts);
+    uint32 gossipMenus      = loader.Add("Gossip menus", &sObjectMgr, &ObjectMgr::LoadGossipMenus, gossipScripts);
+    uint32 vendorTemplates  = loader.Add("Vendor templates", &sObjectMgr, &ObjectMgr::LoadVendorTemplates);
+    loader.Add("Vendors", &sObjectMgr, &ObjectMgr::LoadVendors, vendorTemplates);
+    uint32 trainerTemplates = loader.Add("Trainer templates", &sObjectMgr, &ObjectMgr::LoadTrainerTemplates);
+    loader.Add("Trainers", &sObjectMgr, &ObjectMgr::LoadTrainers, trainerTemplates);
+
+    // Localization data, locale loaders share locale index list - one by one
+    uint32 locales = loader.Add("Creature locales", &sObjectMgr, &ObjectMgr::LoadCreatureLocales, rewardLocales);
+    locales = loader.Add("GameObject locales", &sObjectMgr, &ObjectMgr::LoadGameObjectLocales, locales);
+    locales = loader.Add("Item locales", &sObjectMgr, &ObjectMgr::LoadItemLocales, locales);
+    locales = loader.Add("Quest locales", &sObjectMgr, &ObjectMgr::LoadQuestLocales, locales);
+    locales = loader.Add("NPC Text locales", &sObjectMgr, &ObjectMgr::LoadGossipTextLocales, locales);
+    locales = loader.Add("Page Text locales", &sObjectMgr, &ObjectMgr::LoadPageTextLocales, locales);
+    locales = loader.Add("Gossip menu option locales", &sObjectMgr, &ObjectMgr::LoadGossipMenuItemsLocales, locales, gossipMenus);
+    loader.Add("Points Of Interest locales", &sObjectMgr, &ObjectMgr::LoadPointOfInterestLocales, locales);
+    loader.Run(getConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS));
 
     sLog.outString( "Loading Waypoint scripts..." );        // before loading from creature_movement
     sScriptMgr.LoadCreatureMovementScripts();
@@ -1482,19 +1484,6 @@ void World::SetInitialWorldSettings()
     sLog.outString();
     sWaypointMgr.Load();
 
-    ///- Loading localization data
-    sLog.outString( "Loading Localization strings..." );
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sLog.outString( ">>> Localization strings loaded" );
-    sLog.outString();
-
     sLog.outString("Loading LFG rewards...");               // After load all static data
     sLFGMgr.LoadRewards();
 
@@ -1634,6 +1623,10 @@ void World::SetInitialWorldSettings()
     sLog.outString( "Starting Map System" );
     sMapMgr.Initialize();
 
+    ///- Initialize parallel session update
+    m_sessionDomainUpdater = new SessionDomainUpdater();
+    m_sessionDomainUpdater->Initialize(getConfig(CONFIG_UINT32_SESSION_UPDATE_THREADS));
+
     ///- Initialize Battlegrounds
     sLog.outString( "Starting BattleGround System" );
     sBattleGroundMgr.CreateInitialBattleGrounds();
@@ -1679,6 +1672,8 @@ void World::SetInitialWorldSettings()
 
     sLog.outString( "WORLD: World initialized" );
 
+    loader.OutputTimings();
+
     uint32 uStartInterval = WorldTimer::getMSTimeDiff(uStartTime, WorldTimer::getMSTime());
     sLog.outString( "SERVER STARTUP TIME: %i minutes %i seconds", uStartInterval / 60000, (uStartInterval % 60000) / 1000 );
 }
@@ -1733,6 +1728,7 @@ void World::DetectDBCLang()
 void World::Update(uint32 diff)
 {
     m_updateTime = diff;
+    uint32 worldStartTime = WorldTimer::getMSTime();
 
     ///- Update the different timers
     for(int i = 0; i < WUPDATE_COUNT; ++i)
@@ -1789,7 +1785,9 @@ void World::Update(uint32 diff)
     }
 
     /// <li> Handle session updates
+    uint32 sessionsStartTime = WorldTimer::getMSTime();
     UpdateSessions(diff);
+    uint32 sessionsTime = WorldTimer::getMSTimeDiff(sessionsStartTime, WorldTimer::getMSTime());
 
     /// <li> Update groups
     for (ObjectMgr::GroupMap::iterator itr = sObjectMgr.GetGroupMapBegin(); itr != sObjectMgr.GetGroupMapEnd(); ++itr)
@@ -1829,7 +1827,10 @@ void World::Update(uint32 diff)
 
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
+    sPlayerSaveScheduler.Update(diff);
+    uint32 mapsStartTime = WorldTimer::getMSTime();
     sMapMgr.Update(diff);
+    uint32 mapsTime = WorldTimer::getMSTimeDiff(mapsStartTime, WorldTimer::getMSTime());
     sBattleGroundMgr.Update(diff);
     sOutdoorPvPMgr.Update(diff);
 
@@ -1899,6 +1900,16 @@ void World::Update(uint32 diff)
 
     //cleanup unused GridMap objects as well as VMaps
     sTerrainMgr.Update(diff);
+
+    uint32 worldTime = WorldTimer::getMSTimeDiff(worldStartTime, WorldTimer::getMSTime());
+
+    // playerbot load benchmark driving and measurement, if started
+    sLoadBenchmark.Update(diff, sessionsTime, mapsTime, worldTime);
+
+    sWorldMetrics.Update(diff, sessionsTime, mapsTime, worldTime);
+
+    // move opcodes with costly handlers to expensive rate class
+    sPacketRateLimiter.Update(diff);
 }
 
 /// Send a packet to all players (except self if mentioned)
@@ -2306,6 +2317,15 @@ void World::UpdateSessions(uint32 diff)
     while(addSessQueue.next(sess))
         AddSession_ (sess);
 
+    ///- Process packets of independent domains in parallel, first queued packets of session only
+    if (m_sessionDomainUpdater && m_sessionDomainUpdater->IsEnabled())
+    {
+        for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+            m_sessionDomainUpdater->AddSession(itr->second);
+
+        m_sessionDomainUpdater->Update(diff);
+    }
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
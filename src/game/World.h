@@ -43,6 +43,7 @@ class Weather;
 class SqlResultQueue;
 class QueryResult;
 class WorldSocket;
+class SessionDomainUpdater;
 
 // ServerMessages.dbc
 enum ServerMessageType
@@ -223,6 +224,18 @@ enum eConfigUInt32Values
     CONFIG_UINT32_POSITION_UPDATE_DELAY,
     CONFIG_UINT32_RESIST_CALC_METHOD,
     CONFIG_UINT32_GROUPLEADER_RECONNECT_PERIOD,
+    CONFIG_UINT32_LOS_CACHE_LIFETIME,
+    CONFIG_UINT32_VISIBILITY_INCREMENTAL_UPDATES,
+    CONFIG_UINT32_VISIBILITY_LOD_TICKS_NEAR,
+    CONFIG_UINT32_VISIBILITY_LOD_TICKS_FAR,
+    CONFIG_UINT32_CHANNEL_NETWORK_BROADCAST,
+    CONFIG_UINT32_STARTUP_LOADER_THREADS,
+    CONFIG_UINT32_PLAYER_SAVE_MAX_QUEUE_SIZE,
+    CONFIG_UINT32_PLAYER_SAVE_MAX_AVERAGE_TIME,
+    CONFIG_UINT32_PLAYER_SAVE_URGENT_DELAY,
+    CONFIG_UINT32_CREATURE_DORMANCY_INTERVAL,
+    CONFIG_UINT32_SLOW_OPCODE_HANDLER_TIME,
+    CONFIG_UINT32_SESSION_UPDATE_THREADS,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -317,6 +330,10 @@ enum eConfigFloatValues
     CONFIG_FLOAT_CROWDCONTROL_HP_BASE,
     CONFIG_FLOAT_LOADBALANCE_HIGHVALUE,
     CONFIG_FLOAT_LOADBALANCE_LOWVALUE,
+    CONFIG_FLOAT_LOS_CACHE_GRID,
+    CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_NEAR,
+    CONFIG_FLOAT_VISIBILITY_LOD_DISTANCE_FAR,
+    CONFIG_FLOAT_CREATURE_DORMANCY_DISTANCE,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -424,6 +441,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_RESIST_ADD_BY_OVER_LEVEL,
     CONFIG_BOOL_DYNAMIC_VMAP_DOUBLE_CHECK,
     CONFIG_BOOL_INSTANCES_RESET_GROUP_ANNOUNCE,
+    CONFIG_BOOL_CREATURE_DORMANCY,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -781,6 +799,9 @@ class World
         void AddSession_(WorldSession* s);
         ACE_Based::LockedQueue<WorldSession*, ACE_Thread_Mutex> addSessQueue;
 
+        // parallel processing of independent thread-unsafe packets in UpdateSessions
+        SessionDomainUpdater* m_sessionDomainUpdater;
+
         //used versions
         std::string m_DBVersion;
         std::string m_CreatureEventAIVersion;
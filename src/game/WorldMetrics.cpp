@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "WorldMetrics.h"
+#include "World.h"
+#include "MapManager.h"
+#include "MoveMap.h"
+#include "Opcodes.h"
+#include "Database/DatabaseEnv.h"
+#include "Config/Config.h"
+#include "Utilities/EventProcessor.h"
+#include "SessionDomainUpdater.h"
+
+INSTANTIATE_SINGLETON_1(WorldMetrics);
+
+#define WORLD_METRICS_SAMPLE_INTERVAL   1000                // gauges sample interval, ms
+
+static uint32 const tickTimeBounds[] = { 5, 10, 25, 50, 75, 100, 150, 200, 300, 500, 1000, 2000, 5000 };
+
+static char const* GetOpcodeLabel(uint32 opcode)
+{
+    return LookupOpcodeName(uint16(opcode));
+}
+
+WorldMetrics::WorldMetrics() :
+    m_tickDiff(NULL), m_sessionsTime(NULL), m_mapsTime(NULL), m_worldTime(NULL), m_sessionDomainsTime(NULL),
+    m_packetsSent(NULL), m_packetsReceived(NULL), m_bytesSent(NULL), m_bytesReceived(NULL),
+    m_activeSessions(NULL), m_queuedSessions(NULL), m_maps(NULL), m_instances(NULL), m_loadedGrids(NULL),
+    m_loadedMMaps(NULL), m_loadedMMapTiles(NULL), m_eventPoolBlocks(NULL), m_eventPoolBytes(NULL)
+{
+    memset(m_handlerCalls, 0, sizeof(m_handlerCalls));
+    memset(m_handlerTime, 0, sizeof(m_handlerTime));
+    memset(m_sessionDomainTime, 0, sizeof(m_sessionDomainTime));
+    m_sampleTimer.SetInterval(WORLD_METRICS_SAMPLE_INTERVAL);
+}
+
+void WorldMetrics::Initialize()
+{
+    if (!sConfig.GetBoolDefault("Metrics.Enable", false))
+        return;
+
+    m_tickDiff = sMetrics.AddHistogram("mangos_world_tick_diff_milliseconds", "Time between world updates",
+        tickTimeBounds, countof(tickTimeBounds));
+    m_sessionsTime = sMetrics.AddHistogram("mangos_world_update_phase_milliseconds", "Duration of world update phases",
+        tickTimeBounds, countof(tickTimeBounds), "phase=\"sessions\"");
+    m_mapsTime = sMetrics.AddHistogram("mangos_world_update_phase_milliseconds", "Duration of world update phases",
+        tickTimeBounds, countof(tickTimeBounds), "phase=\"maps\"");
+    m_worldTime = sMetrics.AddHistogram("mangos_world_update_milliseconds", "Duration of world update",
+        tickTimeBounds, countof(tickTimeBounds));
+    m_sessionDomainsTime = sMetrics.AddHistogram("mangos_world_update_phase_milliseconds", "Duration of world update phases",
+        tickTimeBounds, countof(tickTimeBounds), "phase=\"session_domains\"");
+
+    for (uint32 i = 0; i < MAX_SESSION_DOMAINS; ++i)
+    {
+        std::string labels = std::string("domain=\"") + SessionDomainUpdater::GetDomainName(SessionUpdateDomain(i)) + "\"";
+        m_sessionDomainTime[i] = sMetrics.AddHistogram("mangos_session_domain_update_milliseconds", "Duration of parallel session update by packet domain",
+            tickTimeBounds, countof(tickTimeBounds), labels.c_str());
+    }
+
+    m_packetsSent = sMetrics.AddCounterArray("mangos_packets_sent_total", "Packets sent to clients by opcode",
+        NUM_MSG_TYPES, "opcode", &GetOpcodeLabel);
+    m_packetsReceived = sMetrics.AddCounterArray("mangos_packets_received_total", "Packets received from clients by opcode",
+        NUM_MSG_TYPES, "opcode", &GetOpcodeLabel);
+    m_bytesSent = sMetrics.AddCounter("mangos_packet_bytes_sent_total", "Packet payload bytes sent to clients");
+    m_bytesReceived = sMetrics.AddCounter("mangos_packet_bytes_received_total", "Packet payload bytes received from clients");
+
+    for (uint32 i = 0; i < MAX_OPCODE_STAT_THREADS; ++i)
+    {
+        std::string labels = std::string("thread=\"") + OpcodeStats::GetThreadName(OpcodeStatThread(i)) + "\"";
+        m_handlerCalls[i] = sMetrics.AddCounterArray("mangos_opcode_handler_calls_total", "Opcode handler calls by opcode and processing thread",
+            NUM_MSG_TYPES, "opcode", &GetOpcodeLabel, labels.c_str());
+        m_handlerTime[i] = sMetrics.AddCounterArray("mangos_opcode_handler_microseconds_total", "Opcode handler execution time by opcode and processing thread",
+            NUM_MSG_TYPES, "opcode", &GetOpcodeLabel, labels.c_str());
+    }
+
+    m_activeSessions = sMetrics.AddGauge("mangos_sessions", "World sessions", "state=\"active\"");
+    m_queuedSessions = sMetrics.AddGauge("mangos_sessions", "World sessions", "state=\"queued\"");
+    m_maps = sMetrics.AddGauge("mangos_maps", "Created maps including instances");
+    m_instances = sMetrics.AddGauge("mangos_instances", "Created instance and battleground maps");
+    m_loadedGrids = sMetrics.AddGauge("mangos_loaded_grids", "Loaded grids of all maps");
+    m_loadedMMaps = sMetrics.AddGauge("mangos_mmap_loaded_maps", "Maps with loaded movement map data");
+    m_loadedMMapTiles = sMetrics.AddGauge("mangos_mmap_loaded_tiles", "Loaded movement map tiles");
+    m_eventPoolBlocks = sMetrics.AddGauge("mangos_event_pool_heap_blocks", "Heap blocks of pooled events, in use and free");
+    m_eventPoolBytes = sMetrics.AddGauge("mangos_event_pool_heap_bytes", "Heap bytes of pooled events, in use and free");
+}
+
+void WorldMetrics::Update(uint32 diff, uint32 sessionsTime, uint32 mapsTime, uint32 worldTime)
+{
+    if (!m_tickDiff)
+        return;
+
+    m_tickDiff->Observe(diff);
+    m_sessionsTime->Observe(sessionsTime);
+    m_mapsTime->Observe(mapsTime);
+    m_worldTime->Observe(worldTime);
+
+    m_sampleTimer.Update(diff);
+    if (m_sampleTimer.Passed())
+    {
+        m_sampleTimer.Reset();
+        SampleGauges();
+    }
+}
+
+void WorldMetrics::SampleGauges()
+{
+    m_activeSessions->Set(sWorld.GetActiveSessionCount());
+    m_queuedSessions->Set(sWorld.GetQueuedSessionCount());
+    m_maps->Set(sMapMgr.Maps().size());
+    m_instances->Set(sMapMgr.GetNumInstances());
+
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    m_loadedMMaps->Set(mmap->getLoadedMapsCount());
+    m_loadedMMapTiles->Set(mmap->getLoadedTilesCount());
+
+    m_eventPoolBlocks->Set(EventAllocatorStats::GetHeapBlocks());
+    m_eventPoolBytes->Set(EventAllocatorStats::GetHeapBytes());
+
+    WorldDatabase.UpdateMetrics();
+    CharacterDatabase.UpdateMetrics();
+    LoginDatabase.UpdateMetrics();
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MANGOS_WORLDMETRICS_H
+#define MANGOS_WORLDMETRICS_H
+
+#include "Common.h"
+#include "Timer.h"
+#include "Policies/Singleton.h"
+#include "Metrics/Metrics.h"
+#include "OpcodeStats.h"
+#include "WorldSession.h"
+
+/**
+ * Metrics of world server, exported by MetricsSocket listener (Metrics.Enable).
+ *
+ * Packet and grid counters are updated where events happen (any thread),
+ * gauges of sessions, maps, movement maps, event pools and databases are sampled from world thread.
+ */
+class WorldMetrics
+{
+    public:
+        WorldMetrics();
+
+        // register metrics if Metrics.Enable, must be called before other threads use metrics
+        void Initialize();
+
+        // called at end of World::Update with tick diff and measured times of tick phases
+        void Update(uint32 diff, uint32 sessionsTime, uint32 mapsTime, uint32 worldTime);
+
+        void CountSentPacket(uint16 opcode, size_t size)
+        {
+            if (m_packetsSent)
+            {
+                m_packetsSent->Inc(opcode);
+                m_bytesSent->Inc(size);
+            }
+        }
+
+        void CountReceivedPacket(uint16 opcode, size_t size)
+        {
+            if (m_packetsReceived)
+            {
+                m_packetsReceived->Inc(opcode);
+                m_bytesReceived->Inc(size);
+            }
+        }
+
+        // merged thread local handler records, time in microseconds
+        void CountOpcodeHandler(uint16 opcode, OpcodeStatThread thread, uint64 count, uint64 time)
+        {
+            if (m_handlerCalls[thread])
+            {
+                m_handlerCalls[thread]->Inc(opcode, count);
+                m_handlerTime[thread]->Inc(opcode, time);
+            }
+        }
+
+        void AddLoadedGrids(int32 count) { if (m_loadedGrids) m_loadedGrids->Add(count); }
+
+        // parallel part of World::UpdateSessions and update time of each domain in it, world thread
+        void ObserveSessionDomains(uint32 time) { if (m_sessionDomainsTime) m_sessionDomainsTime->Observe(time); }
+        void ObserveSessionDomain(SessionUpdateDomain domain, uint32 time)
+        {
+            if (m_sessionDomainTime[domain])
+                m_sessionDomainTime[domain]->Observe(time);
+        }
+
+    private:
+        void SampleGauges();
+
+        MetricHistogram* m_tickDiff;
+        MetricHistogram* m_sessionsTime;
+        MetricHistogram* m_mapsTime;
+        MetricHistogram* m_worldTime;
+        MetricHistogram* m_sessionDomainsTime;
+        MetricHistogram* m_sessionDomainTime[MAX_SESSION_DOMAINS];
+
+        MetricCounterArray* m_packetsSent;
+        MetricCounterArray* m_packetsReceived;
+        MetricCounter* m_bytesSent;
+        MetricCounter* m_bytesReceived;
+        MetricCounterArray* m_handlerCalls[MAX_OPCODE_STAT_THREADS];
+        MetricCounterArray* m_handlerTime[MAX_OPCODE_STAT_THREADS];
+
+        MetricGauge* m_activeSessions;
+        MetricGauge* m_queuedSessions;
+        MetricGauge* m_maps;
+        MetricGauge* m_instances;
+        MetricGauge* m_loadedGrids;
+        MetricGauge* m_loadedMMaps;
+        MetricGauge* m_loadedMMapTiles;
+        MetricGauge* m_eventPoolBlocks;
+        MetricGauge* m_eventPoolBytes;
+
+        ShortIntervalTimer m_sampleTimer;
+};
+
+#define sWorldMetrics MaNGOS::Singleton<WorldMetrics>::Instance()
+
+#endif
@@ -26,6 +26,7 @@
 #include "PetAI.h"
 #include "ObjectMgr.h"
 #include "Vehicle.h"
+#include "Map.h"
 #include "InstanceData.h"
 #include "GridNotifiersImpl.h"
 #include "CellImpl.h"
@@ -36,7 +37,6 @@
 WorldObjectEventProcessor::WorldObjectEventProcessor()
 {
     //m_time = WorldTimer::getMSTime();
-    m_events.clear();
 }
 
 void WorldObjectEventProcessor::Update(uint32 p_time, bool force)
@@ -78,15 +78,11 @@ void WorldObjectEventProcessor::RenewEvents()
                 case WORLDOBJECT_EVENT_TYPE_UNIQUE:
                 case WORLDOBJECT_EVENT_TYPE_EVADE_UNIQUE:
                 {
-                    for (EventList::const_iterator i = m_events.begin(); i != m_events.end(); ++i)
+                    if (HasEventOfType(eventType))
                     {
-                        if (i->second->GetType() == eventType)
-                        {
-                            BasicEvent* event = m_queue.front().second;
-                            delete event;
-                            needInsert = false;
-                            break;
-                        }
+                        BasicEvent* event = m_queue.front().second;
+                        delete event;
+                        needInsert = false;
                     }
                     break;
                 }
@@ -97,7 +93,7 @@ void WorldObjectEventProcessor::RenewEvents()
                     break;
             }
             if (needInsert)
-                m_events.insert(m_queue.front());
+                InsertEvent(m_queue.front().second);
         }
         m_queue.pop();
     }
@@ -110,7 +106,7 @@ void WorldObjectEventProcessor::CleanupEventList()
 }
 
 // Spell events
-SpellEvent::SpellEvent(Spell* spell) : BasicEvent(WORLDOBJECT_EVENT_TYPE_COMMON)
+SpellEvent::SpellEvent(Spell* spell) : PooledEvent<SpellEvent>(WORLDOBJECT_EVENT_TYPE_COMMON)
 {
     m_Spell = spell;
 }
@@ -230,7 +226,7 @@ bool SpellEvent::IsDeletable() const
 }
 
 // Unit events
-RelocationNotifyEvent::RelocationNotifyEvent(Unit& owner) : BasicEvent(WORLDOBJECT_EVENT_TYPE_COMMON), m_owner(owner)
+RelocationNotifyEvent::RelocationNotifyEvent(Unit& owner) : PooledEvent<RelocationNotifyEvent>(WORLDOBJECT_EVENT_TYPE_COMMON), m_owner(owner)
 {
     m_owner._SetAINotifyScheduled(true);
 }
@@ -345,7 +341,7 @@ bool ForcedDespawnDelayEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
 }
 
 EvadeDelayEvent::EvadeDelayEvent(Unit& owner, bool force /*=false*/) :
-    BasicEvent(WORLDOBJECT_EVENT_TYPE_EVADE_UNIQUE), m_owner(owner), b_force(force)
+    PooledEvent<EvadeDelayEvent>(WORLDOBJECT_EVENT_TYPE_EVADE_UNIQUE), m_owner(owner), b_force(force)
 {
     if (m_owner.GetTypeId() == TYPEID_UNIT)
         m_owner.addUnitState(UNIT_STAT_DELAYED_EVADE);
@@ -426,6 +422,20 @@ bool EvadeDelayEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
     return true;
 }
 
+bool CreatureWakeUpEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
+{
+    WorldObject* object = m_map.FindObject(m_handle);
+    if (object && object->GetTypeId() == TYPEID_UNIT)
+    {
+        Creature* creature = (Creature*)object;
+
+        // creature can be woken and go dormant again before event execute
+        if (creature->IsDormant() && creature->GetDormancyId() == m_dormancyId)
+            creature->WakeUp();
+    }
+    return true;
+}
+
 AiDelayEventAround::AiDelayEventAround(AIEventType eventType, ObjectGuid invokerGuid, Creature& owner, std::list<Creature*> const& receivers, uint32 miscValue) :
     BasicEvent(WORLDOBJECT_EVENT_TYPE_COMMON),
     m_eventType(eventType),
@@ -23,10 +23,12 @@
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
 #include "WorldLocation.h"
+#include "MapObjectStore.h"
 
 class Spell;
 class Unit;
 class Creature;
+class Map;
 struct WorldLocation;
 
 enum WorldObjectEventType
@@ -53,8 +55,8 @@ class MANGOS_DLL_SPEC WorldObjectEventProcessor : public EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         void RenewEvents();
 
-        uint32 size(bool withQueue = false)  const { return (withQueue ? (m_events.size() + m_queue.size()) :  m_events.size()); };
-        bool   empty() const { return m_events.empty(); };
+        uint32 size(bool withQueue = false)  const { return (withQueue ? (GetEventCount() + m_queue.size()) :  GetEventCount()); };
+        bool   empty() const { return !GetEventCount(); };
 
     protected:
         void _AddEvents();
@@ -62,7 +64,7 @@ class MANGOS_DLL_SPEC WorldObjectEventProcessor : public EventProcessor
 };
 
 // Spell events
-class SpellEvent : public BasicEvent
+class SpellEvent : public PooledEvent<SpellEvent>
 {
     public:
         SpellEvent(Spell* spell);
@@ -76,17 +78,17 @@ class SpellEvent : public BasicEvent
 };
 
 // Unit events
-class ManaUseEvent : public BasicEvent
+class ManaUseEvent : public PooledEvent<ManaUseEvent>
 {
     public:
-        ManaUseEvent(Unit& caster) : BasicEvent(WORLDOBJECT_EVENT_TYPE_COMMON), m_caster(caster) {}
+        ManaUseEvent(Unit& caster) : PooledEvent<ManaUseEvent>(WORLDOBJECT_EVENT_TYPE_COMMON), m_caster(caster) {}
         bool Execute(uint64 e_time, uint32 p_time);
 
     private:
         Unit& m_caster;
 };
 
-class RelocationNotifyEvent : public BasicEvent
+class RelocationNotifyEvent : public PooledEvent<RelocationNotifyEvent>
 {
     public:
         RelocationNotifyEvent(Unit& owner);
@@ -136,11 +138,11 @@ class ForcedDespawnDelayEvent : public BasicEvent
         Creature& m_owner;
 };
 
-class AttackResumeEvent : public BasicEvent
+class AttackResumeEvent : public PooledEvent<AttackResumeEvent>
 {
     public:
-        AttackResumeEvent(Unit& owner) : BasicEvent(WORLDOBJECT_EVENT_TYPE_UNIQUE), m_owner(owner), b_force(false) {};
-        AttackResumeEvent(Unit& owner, bool force) : BasicEvent(WORLDOBJECT_EVENT_TYPE_UNIQUE), m_owner(owner), b_force(force) {};
+        AttackResumeEvent(Unit& owner) : PooledEvent<AttackResumeEvent>(WORLDOBJECT_EVENT_TYPE_UNIQUE), m_owner(owner), b_force(false) {};
+        AttackResumeEvent(Unit& owner, bool force) : PooledEvent<AttackResumeEvent>(WORLDOBJECT_EVENT_TYPE_UNIQUE), m_owner(owner), b_force(force) {};
         bool Execute(uint64 e_time, uint32 p_time);
     private:
         AttackResumeEvent();
@@ -148,7 +150,7 @@ class AttackResumeEvent : public BasicEvent
         bool    b_force;
 };
 
-class EvadeDelayEvent : public BasicEvent
+class EvadeDelayEvent : public PooledEvent<EvadeDelayEvent>
 {
     public:
         EvadeDelayEvent(Unit& owner, bool force = false);
@@ -159,6 +161,20 @@ class EvadeDelayEvent : public BasicEvent
         bool    b_force;
 };
 
+// Map event, creature can be removed from map while dormant
+class CreatureWakeUpEvent : public PooledEvent<CreatureWakeUpEvent>
+{
+    public:
+        CreatureWakeUpEvent(Map& map, MapObjectHandle const& handle, uint32 dormancyId)
+            : PooledEvent<CreatureWakeUpEvent>(WORLDOBJECT_EVENT_TYPE_COMMON), m_map(map), m_handle(handle), m_dormancyId(dormancyId) {}
+        bool Execute(uint64 e_time, uint32 p_time);
+    private:
+        CreatureWakeUpEvent();
+        Map&            m_map;
+        MapObjectHandle m_handle;
+        uint32          m_dormancyId;
+};
+
 class AiDelayEventAround : public BasicEvent
 {
     public:
@@ -37,6 +37,7 @@
 #include "MapManager.h"
 #include "SocialMgr.h"
 #include "LFGMgr.h"
+#include "SessionDomainUpdater.h"
 #include "Auth/AuthCrypt.h"
 #include "Auth/HMACSHA1.h"
 #include "zlib/zlib.h"
@@ -46,6 +47,7 @@
 // Playerbot mod
 #include "playerbot/PlayerbotMgr.h"
 #include "playerbot/PlayerbotAI.h"
+#include "playerbot/PlayerbotLoadBenchmark.h"
 
 // select opcodes appropriate for processing in Map::Update context for current session state
 static bool MapSessionFilterHelper(WorldSession* session, OpcodeHandler const& opHandle)
@@ -87,9 +89,15 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return !MapSessionFilterHelper(m_pSession, opHandle);
 }
 
+bool SessionDomainFilter::Process(WorldPacket* packet)
+{
+    // session state checked by WorldSession::GetQueuedPacketDomain before session given to domain thread
+    return GetPacketSessionDomain(*packet) == m_domain;
+}
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, WorldSocket *sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale) :
-m_muteTime(mute_time), _player(NULL), m_Socket(sock),_security(sec), _accountId(id), m_expansion(expansion), _logoutTime(0),
+m_muteTime(mute_time), _player(NULL), m_Socket(sock), m_isBotSession(!sock), _security(sec), _accountId(id), m_expansion(expansion), _logoutTime(0),
 m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerRecentlyLogout(false), m_playerSave(false),
 m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
 m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED), m_Warden(NULL)
@@ -140,6 +148,8 @@ char const* WorldSession::GetPlayerName() const
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
+    sLoadBenchmark.CountSentPacket(packet->size());
+
     // Playerbot mod: send packet to bot AI
     if (!sWorld.getConfig(CONFIG_BOOL_PLAYERBOT_DISABLE))
     {
@@ -195,9 +205,19 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         m_Socket->CloseSocket ();
 }
 
+WorldSocket* WorldSession::GetBroadcastSocket() const
+{
+    if (!m_Socket || m_Socket->IsClosed())
+        return NULL;
+
+    // Playerbot mod: broadcast packets bypass PlayerbotMgr::HandleMasterOutgoingPacket, it handles no opcodes now
+    return m_Socket;
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
+    sLoadBenchmark.CountReceivedPacket(new_packet->size());
     _recvQueue.add(new_packet);
 }
 
@@ -219,8 +239,7 @@ void WorldSession::LogUnprocessedTail(WorldPacket *packet)
         packet->rpos(),packet->wpos());
 }
 
-/// Update the WorldSession (triggered by World update)
-bool WorldSession::Update(PacketFilter& updater)
+void WorldSession::ProcessQueuedPackets(PacketFilter& updater)
 {
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
@@ -246,7 +265,7 @@ bool WorldSession::Update(PacketFilter& updater)
                             LogUnexpectedOpcode(packet, "the player has not logged in yet");
                     }
                     else if(_player->IsInWorld())
-                        ExecuteOpcode(opHandle, packet);
+                        ExecuteOpcode(opHandle, packet, updater.GetStatThread());
 
                     // lag can cause STATUS_LOGGEDIN opcodes to arrive after the player started a transfer
 
@@ -263,7 +282,7 @@ bool WorldSession::Update(PacketFilter& updater)
                     }
                     else
                         // not expected _player or must checked in packet hanlder
-                        ExecuteOpcode(opHandle, packet);
+                        ExecuteOpcode(opHandle, packet, updater.GetStatThread());
                     break;
                 case STATUS_TRANSFER:
                     if(!_player)
@@ -271,7 +290,7 @@ bool WorldSession::Update(PacketFilter& updater)
                     else if(_player->IsInWorld())
                         LogUnexpectedOpcode(packet, "the player is still in world");
                     else
-                        ExecuteOpcode(opHandle, packet);
+                        ExecuteOpcode(opHandle, packet, updater.GetStatThread());
                     break;
                 case STATUS_AUTHED:
                     // prevent cheating with skip queue wait
@@ -286,7 +305,7 @@ bool WorldSession::Update(PacketFilter& updater)
                     if (packet->GetOpcode() != CMSG_SET_ACTIVE_VOICE_CHANNEL)
                         m_playerRecentlyLogout = false;
 
-                    ExecuteOpcode(opHandle, packet);
+                    ExecuteOpcode(opHandle, packet, updater.GetStatThread());
                     break;
                 case STATUS_NEVER:
                     sLog.outError( "SESSION: received not allowed opcode %s (0x%.4X)",
@@ -326,6 +345,12 @@ bool WorldSession::Update(PacketFilter& updater)
 
         delete packet;
     }
+}
+
+/// Update the WorldSession (triggered by World update)
+bool WorldSession::Update(PacketFilter& updater)
+{
+    ProcessQueuedPackets(updater);
 
     // Playerbot mod - Process player bot packets
     // The PlayerbotAI class adds to the packet queue to simulate a real player
@@ -382,6 +407,32 @@ bool WorldSession::Update(PacketFilter& updater)
     return true;
 }
 
+// queue checker, only remember domain of first packet
+struct QueuedPacketDomainCheck
+{
+    QueuedPacketDomainCheck() : domain(SESSION_DOMAIN_GLOBAL) {}
+
+    bool Process(WorldPacket* packet)
+    {
+        domain = GetPacketSessionDomain(*packet);
+        return false;
+    }
+
+    SessionUpdateDomain domain;
+};
+
+SessionUpdateDomain WorldSession::GetQueuedPacketDomain()
+{
+    // not logged in, loading, transferring or leaving players use only World::UpdateSessions
+    if (!m_Socket || m_Socket->IsClosed() || !_player || !_player->IsInWorld() || m_playerLoading || m_playerLogout)
+        return SESSION_DOMAIN_GLOBAL;
+
+    QueuedPacketDomainCheck check;
+    WorldPacket* packet = NULL;
+    _recvQueue.next(packet, check);
+    return check.domain;
+}
+
 /// %Log the player out
 void WorldSession::LogoutPlayer(bool Save)
 {
@@ -1051,15 +1102,29 @@ void WorldSession::SendRedirectClient(std::string& ip, uint16 port)
     SendPacket(&pkt);
 }
 
-void WorldSession::ExecuteOpcode( OpcodeHandler const& opHandle, WorldPacket* packet )
+void WorldSession::ExecuteOpcode( OpcodeHandler const& opHandle, WorldPacket* packet, OpcodeStatThread statThread )
 {
     // need prevent do internal far teleports in handlers because some handlers do lot steps
     // or call code that can do far teleports in some conditions unexpectedly for generic way work code
     if (_player)
         _player->SetCanDelayTeleport(true);
 
+    ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
     (this->*opHandle.handler)(*packet);
 
+    ACE_UINT64 handlerTime;
+    (ACE_OS::gettimeofday() - startTime).to_usec(handlerTime);
+    sOpcodeStats.Record(packet->GetOpcode(), statThread, uint32(handlerTime), WorldTimer::getMSTime());
+
+    if (uint32 slowTime = sWorld.getConfig(CONFIG_UINT32_SLOW_OPCODE_HANDLER_TIME))
+    {
+        if (handlerTime >= slowTime * 1000)
+            sLog.outError("Slow opcode handler %s (0x%.4X) took %u ms in %s thread, account %u, player %s",
+                LookupOpcodeName(packet->GetOpcode()), packet->GetOpcode(), uint32(handlerTime / 1000),
+                OpcodeStats::GetThreadName(statThread), GetAccountId(), _player ? _player->GetGuidStr().c_str() : "<none>");
+    }
+
     if (_player)
     {
         // can be not set in fact for login opcode, but this not create porblems.
@@ -32,6 +32,7 @@
 #include "AuctionHouseMgr.h"
 #include "Item.h"
 #include "warden/WardenBase.h"
+#include "OpcodeStats.h"
 
 struct ItemPrototype;
 struct AuctionEntry;
@@ -151,6 +152,20 @@ enum TutorialDataState
     TUTORIALDATA_NEW       = 2
 };
 
+// Groups of thread-unsafe opcodes using state not touched by other groups, processed in parallel by SessionDomainUpdater
+enum SessionUpdateDomain
+{
+    SESSION_DOMAIN_MAIL         = 0,                        // lower domains locked first, see SessionDomainUpdater
+    SESSION_DOMAIN_GUILD        = 1,
+    SESSION_DOMAIN_AUCTION      = 2,
+    SESSION_DOMAIN_CHANNEL      = 3,
+    SESSION_DOMAIN_LFG          = 4,
+    SESSION_DOMAIN_CALENDAR     = 5,
+    SESSION_DOMAIN_GLOBAL       = 6,                        // processed only in World::UpdateSessions
+};
+
+#define MAX_SESSION_DOMAINS       6
+
 //class to deal with packet processing
 //allows to determine if next packet is safe to be processed
 class PacketFilter
@@ -161,6 +176,7 @@ class PacketFilter
 
         virtual bool Process(WorldPacket* /*packet*/) { return true; }
         virtual bool ProcessLogout() const { return true; }
+        virtual OpcodeStatThread GetStatThread() const { return OPCODE_STAT_WORLD; }
 
     protected:
         WorldSession * const m_pSession;
@@ -176,6 +192,7 @@ class MapSessionFilter : public PacketFilter
         virtual bool Process(WorldPacket * packet);
         //in Map::Update() we do not process player logout!
         virtual bool ProcessLogout() const { return false; }
+        virtual OpcodeStatThread GetStatThread() const { return OPCODE_STAT_MAP; }
 };
 
 //class used to filer only thread-unsafe packets from queue
@@ -189,6 +206,22 @@ class WorldSessionFilter : public PacketFilter
         virtual bool Process(WorldPacket* packet);
 };
 
+//process thread-unsafe packets of one domain in SessionDomainUpdater threads
+//stops at first packet of other domain, so packets order of session is kept
+class SessionDomainFilter : public PacketFilter
+{
+    public:
+        SessionDomainFilter(WorldSession * pSession, SessionUpdateDomain domain) : PacketFilter(pSession), m_domain(domain) {}
+        ~SessionDomainFilter() {}
+
+        virtual bool Process(WorldPacket* packet);
+        virtual bool ProcessLogout() const { return false; }
+        virtual OpcodeStatThread GetStatThread() const { return OPCODE_STAT_DOMAIN; }
+
+    private:
+        SessionUpdateDomain const m_domain;
+};
+
 /// Player session in the World
 class MANGOS_DLL_SPEC WorldSession
 {
@@ -208,6 +241,10 @@ class MANGOS_DLL_SPEC WorldSession
         void SendAddonsInfo();
 
         void SendPacket(WorldPacket const* packet);
+        // socket for send packet from network thread, NULL if packet must be sent by SendPacket
+        WorldSocket* GetBroadcastSocket() const;
+        // playerbot session: no client, update packets not built, bot AI events delivered directly
+        bool IsBotSession() const { return m_isBotSession; }
         void SendNotification(const char *format,...) ATTR_PRINTF(2,3);
         void SendNotification(int32 string_id,...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName *declinedName);
@@ -252,9 +289,15 @@ class MANGOS_DLL_SPEC WorldSession
         void KickPlayer();
 
         void QueuePacket(WorldPacket* new_packet);
+        size_t GetRecvQueueSize() { return _recvQueue.size(); }
 
         bool Update(PacketFilter& updater);
 
+        // domain of first queued packet, SESSION_DOMAIN_GLOBAL if it can be processed only in World::UpdateSessions
+        SessionUpdateDomain GetQueuedPacketDomain();
+        // execute queued packets accepted by filter, without socket cleanup and logout done by Update
+        void ProcessQueuedPackets(PacketFilter& updater);
+
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
 
@@ -890,7 +933,7 @@ class MANGOS_DLL_SPEC WorldSession
         bool VerifyMovementInfo(MovementInfo const& movementInfo, ObjectGuid const& guid) const;
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
-        void ExecuteOpcode( OpcodeHandler const& opHandle, WorldPacket* packet );
+        void ExecuteOpcode( OpcodeHandler const& opHandle, WorldPacket* packet, OpcodeStatThread statThread );
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket *packet, const char * reason);
@@ -900,6 +943,7 @@ class MANGOS_DLL_SPEC WorldSession
         Player *_player;
         WorldSocket *m_Socket;
         std::string m_Address;
+        bool m_isBotSession;                                // created without socket, only playerbot sessions
 
         AccountTypes _security;
         uint32 _accountId;
@@ -43,6 +43,7 @@
 #include "WorldSocketMgr.h"
 #include "Log.h"
 #include "DBCStores.h"
+#include "WorldMetrics.h"
 
 #if defined( __GNUC__ )
 #pragma pack(1)
@@ -105,6 +106,8 @@ m_Session(0),
 m_RecvWPct(0),
 m_RecvPct(),
 m_Header(sizeof(ClientPktHeader)),
+m_SkipPayload(false),
+m_SkipBytes(0),
 m_OutBuffer(0),
 m_OutBufferSize(65536),
 m_OutActive(false),
@@ -165,6 +168,50 @@ int WorldSocket::SendPacket(const WorldPacket& pct)
     if (closing_)
         return -1;
 
+    // broadcasts queued before this packet go first
+    if (iSendSharedPackets() == -1)
+        return -1;
+
+    return iSendPacket(pct);
+}
+
+int WorldSocket::QueueSharedPacket(const SharedPacketPtr& pct)
+{
+    ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
+
+    if (closing_)
+        return -1;
+
+    m_SharedPackets.push_back(pct);
+    return 0;
+}
+
+int WorldSocket::SendSharedPackets(void)
+{
+    ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
+
+    if (closing_)
+        return -1;
+
+    return iSendSharedPackets();
+}
+
+int WorldSocket::iSendSharedPackets(void)
+{
+    while (!m_SharedPackets.empty())
+    {
+        SharedPacketPtr pct = m_SharedPackets.front();
+        m_SharedPackets.pop_front();
+
+        if (iSendPacket(*pct) == -1)
+            return -1;
+    }
+
+    return 0;
+}
+
+int WorldSocket::iSendPacket(const WorldPacket& pct)
+{
     uint16 realOpcode = sObjectMgr.GetOpcodeValue(pct.GetOpcode());
     if (realOpcode == 0)
     {
@@ -175,6 +222,8 @@ int WorldSocket::SendPacket(const WorldPacket& pct)
     // Dump outgoing packet.
     sLog.outWorldPacketDump(uint32(get_handle()), pct.GetOpcode(), LookupOpcodeName(pct.GetOpcode()), &pct, false);
 
+    sWorldMetrics.CountSentPacket(pct.GetOpcode(), pct.size());
+
     ServerPktHeader header(pct.size()+2, realOpcode);
     m_Crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
 
@@ -510,6 +559,19 @@ int WorldSocket::handle_input_header(void)
         return -1;
     }
 
+    // over budget packet dropped before allocation, its payload skipped in input stream
+    PacketRateClass rateClass = sPacketRateLimiter.GetClass(internalOpcode);
+    if (!m_RateBuckets.Consume(rateClass, WorldTimer::getMSTime()))
+    {
+        DEBUG_LOG("WorldSocket::handle_input_header dropped opcode %s from %s, over %s rate limit",
+            LookupOpcodeName(internalOpcode), GetRemoteAddress().c_str(), PacketRateLimiter::GetClassName(rateClass));
+        sPacketRateLimiter.CountShed(PACKET_SHED_RATE_LIMIT, rateClass);
+
+        m_SkipPayload = true;
+        m_SkipBytes = header.size;
+        return 0;
+    }
+
     ACE_NEW_RETURN(m_RecvWPct, WorldPacket(internalOpcode, header.size), -1);
 
     if (header.size > 0)
@@ -590,6 +652,26 @@ int WorldSocket::handle_input_missing_data(void)
             }
         }
 
+        // skip payload of dropped packet
+        if (m_SkipPayload)
+        {
+            const size_t to_skip = (message_block.length() > m_SkipBytes ? m_SkipBytes : message_block.length());
+            message_block.rd_ptr(to_skip);
+            m_SkipBytes -= to_skip;
+
+            if (m_SkipBytes > 0)
+            {
+                // Couldn't skip the whole payload this time.
+                MANGOS_ASSERT(message_block.length() == 0);
+                errno = EWOULDBLOCK;
+                return -1;
+            }
+
+            m_SkipPayload = false;
+            m_Header.reset();
+            continue;
+        }
+
         // Its possible on some error situations that this happens
         // for example on closing when epoll receives more chunked data and stuff
         // hope this is not hack ,as proper m_RecvWPct is asserted around
@@ -688,6 +770,8 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
     // Dump received packet.
     sLog.outWorldPacketDump(uint32(get_handle()), new_pct->GetOpcode(), LookupOpcodeName(new_pct->GetOpcode()), new_pct, true);
 
+    sWorldMetrics.CountReceivedPacket(opcode, new_pct->size());
+
     try
     {
         switch(opcode)
@@ -712,6 +796,16 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
 
                 if (m_Session != NULL)
                 {
+                    // session not processing its packets fast enough, client flood or stuck session
+                    uint32 maxQueueSize = sPacketRateLimiter.GetMaxQueueSize();
+                    if (maxQueueSize && m_Session->GetRecvQueueSize() >= maxQueueSize)
+                    {
+                        sLog.outError("WorldSocket::ProcessIncoming: account %u from %s has %u not processed packets (last opcode %s), disconnecting",
+                            m_Session->GetAccountId(), GetRemoteAddress().c_str(), maxQueueSize, LookupOpcodeName(opcode));
+                        sPacketRateLimiter.CountShed(PACKET_SHED_QUEUE_LIMIT, sPacketRateLimiter.GetClass(opcode));
+                        return -1;
+                    }
+
                     // OK ,give the packet to WorldSession
                     aptr.release ();
                     // WARNING here we call it with locks held.
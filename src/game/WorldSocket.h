@@ -35,6 +35,7 @@
 #include <ace/Guard_T.h>
 #include <ace/Unbounded_Queue.h>
 #include <ace/Message_Block.h>
+#include <ace/Refcounted_Auto_Ptr.h>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -43,11 +44,17 @@
 #include "Common.h"
 #include "Auth/AuthCrypt.h"
 #include "Auth/BigNumber.h"
+#include "PacketRateLimiter.h"
+
+#include <deque>
 
 class ACE_Message_Block;
 class WorldPacket;
 class WorldSession;
 
+/// Packet payload shared by all sockets of broadcast.
+typedef ACE_Refcounted_Auto_Ptr<WorldPacket, ACE_Thread_Mutex> SharedPacketPtr;
+
 /// Handler that can communicate over stream sockets.
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
 
@@ -116,6 +123,15 @@ class WorldSocket : protected WorldHandler
         /// @return -1 of failure
         int SendPacket (const WorldPacket& pct);
 
+        /// Queue broadcast packet, written to output by network thread (SendSharedPackets)
+        /// or before next SendPacket, so packets order is kept.
+        /// @return -1 of failure
+        int QueueSharedPacket (const SharedPacketPtr& pct);
+
+        /// Write queued broadcast packets to output, called by network thread.
+        /// @return -1 of failure
+        int SendSharedPackets (void);
+
         /// Add reference to this object.
         long AddReference (void);
 
@@ -163,6 +179,12 @@ class WorldSocket : protected WorldHandler
         /// Drain the queue if its not empty.
         int handle_output_queue (GuardType& g);
 
+        /// Put packet to output buffer or queue, m_OutBufferLock must be held.
+        int iSendPacket (const WorldPacket& pct);
+
+        /// Put queued broadcast packets to output, m_OutBufferLock must be held.
+        int iSendSharedPackets (void);
+
         /// process one incoming packet.
         /// @param new_pct received packet ,note that you need to delete it.
         int ProcessIncoming (WorldPacket* new_pct);
@@ -203,6 +225,13 @@ class WorldSocket : protected WorldHandler
         /// Fragment of the received header.
         ACE_Message_Block m_Header;
 
+        /// Payload of dropped packet is skipped without allocation.
+        bool m_SkipPayload;
+        size_t m_SkipBytes;
+
+        /// Per opcode class budgets of received packets.
+        PacketRateBuckets m_RateBuckets;
+
         /// Mutex for protecting output related data.
         LockType m_OutBufferLock;
 
@@ -215,6 +244,9 @@ class WorldSocket : protected WorldHandler
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
+        /// Broadcast packets not yet put to output, protected by m_OutBufferLock.
+        std::deque<SharedPacketPtr> m_SharedPackets;
+
         uint32 m_Seed;
 
         BigNumber m_s;
@@ -31,6 +31,7 @@
 #include <ace/Dev_Poll_Reactor.h>
 #include <ace/Guard_T.h>
 #include <ace/Atomic_Op.h>
+#include <ace/Refcounted_Auto_Ptr.h>
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
@@ -43,6 +44,8 @@
 #include "Config/Config.h"
 #include "Database/DatabaseEnv.h"
 #include "WorldSocket.h"
+#include "WorldPacket.h"
+#include "Metrics/MetricsSocket.h"
 
 /**
 * This is a helper class to WorldSocketMgr ,that manages
@@ -122,7 +125,38 @@ class ReactorRunnable : protected ACE_Task_Base
             return m_Reactor;
         }
 
+        // sockets with queued broadcast packets, must be referenced, reference released after send
+        void AddBroadcast(std::vector<WorldSocket*> const& sockets)
+        {
+            ACE_GUARD (ACE_Thread_Mutex, Guard, m_Broadcasts_Lock);
+
+            m_Broadcasts.insert(m_Broadcasts.end(), sockets.begin(), sockets.end());
+        }
+
     protected:
+        void SendBroadcasts(bool send = true)
+        {
+            SocketList broadcasts;
+
+            {
+                ACE_GUARD (ACE_Thread_Mutex, Guard, m_Broadcasts_Lock);
+
+                if (m_Broadcasts.empty())
+                    return;
+
+                broadcasts.swap(m_Broadcasts);
+            }
+
+            // socket listed once per broadcast, already sent packets skipped
+            for (SocketList::const_iterator sock = broadcasts.begin(); sock != broadcasts.end(); ++sock)
+            {
+                if (send && !(*sock)->IsClosed() && (*sock)->SendSharedPackets() == -1)
+                    (*sock)->CloseSocket();
+
+                (*sock)->RemoveReference();
+            }
+        }
+
         void AddNewSockets()
         {
             ACE_GUARD (ACE_Thread_Mutex, Guard, m_NewSockets_Lock);
@@ -167,6 +201,8 @@ class ReactorRunnable : protected ACE_Task_Base
 
                 AddNewSockets();
 
+                SendBroadcasts();
+
                 for (i = m_Sockets.begin(); i != m_Sockets.end();)
                 {
                     if ((*i)->Update() == -1)
@@ -183,6 +219,9 @@ class ReactorRunnable : protected ACE_Task_Base
                 }
             }
 
+            // release socket references of not sent broadcasts
+            SendBroadcasts(false);
+
             WorldDatabase.ThreadEnd();
 
             DEBUG_LOG ("Network Thread Exitting");
@@ -202,6 +241,11 @@ class ReactorRunnable : protected ACE_Task_Base
 
         SocketSet m_NewSockets;
         ACE_Thread_Mutex m_NewSockets_Lock;
+
+        typedef std::vector<WorldSocket*> SocketList;
+
+        SocketList m_Broadcasts;
+        ACE_Thread_Mutex m_Broadcasts_Lock;
 };
 
 WorldSocketMgr::WorldSocketMgr():
@@ -210,7 +254,9 @@ WorldSocketMgr::WorldSocketMgr():
     m_SockOutKBuff(-1),
     m_SockOutUBuff(65536),
     m_UseNoDelay(true),
-    m_Acceptor(0)
+    m_Acceptor(0),
+    m_MetricsAcceptor(0),
+    m_MetricsThread(0)
 {
 }
 
@@ -221,6 +267,12 @@ WorldSocketMgr::~WorldSocketMgr()
 
     if(m_Acceptor)
         delete m_Acceptor;
+
+    if (m_MetricsAcceptor)
+        delete m_MetricsAcceptor;
+
+    if (m_MetricsThread)
+        delete m_MetricsThread;
 }
 
 int WorldSocketMgr::StartReactiveIO (ACE_UINT16 port, const char* address)
@@ -263,9 +315,29 @@ int WorldSocketMgr::StartReactiveIO (ACE_UINT16 port, const char* address)
         return -1;
     }
 
+    // metrics listener has own thread, export and blocking send to scraper not delay acceptor and game sockets
+    if (sConfig.GetBoolDefault("Metrics.Enable", false))
+    {
+        m_MetricsThread = new ReactorRunnable;
+
+        MetricsSocket::Acceptor* metricsAcc = new MetricsSocket::Acceptor;
+        m_MetricsAcceptor = metricsAcc;
+
+        std::string metricsIP = sConfig.GetStringDefault("Metrics.IP", "127.0.0.1");
+        ACE_INET_Addr metricsAddr(uint16(sConfig.GetIntDefault("Metrics.Port", 9101)), metricsIP.c_str());
+
+        if (metricsAcc->open(metricsAddr, m_MetricsThread->GetReactor(), ACE_NONBLOCK) == -1)
+            sLog.outError("Failed to open metrics acceptor on %s:%u, metrics not available", metricsIP.c_str(), uint32(metricsAddr.get_port_number()));
+        else
+            sLog.outString("Metrics listener started on %s:%u", metricsIP.c_str(), uint32(metricsAddr.get_port_number()));
+    }
+
     for (size_t i = 0; i < m_NetThreadsCount; ++i)
         m_NetThreads[i].Start();
 
+    if (m_MetricsThread)
+        m_MetricsThread->Start();
+
     return 0;
 }
 
@@ -293,15 +365,58 @@ void WorldSocketMgr::StopNetwork()
             acc->close();
     }
 
+    if (m_MetricsAcceptor)
+    {
+        MetricsSocket::Acceptor* acc = dynamic_cast<MetricsSocket::Acceptor*>(m_MetricsAcceptor);
+
+        if (acc)
+            acc->close();
+    }
+
     if (m_NetThreadsCount != 0)
     {
         for (size_t i = 0; i < m_NetThreadsCount; ++i)
             m_NetThreads[i].Stop();
     }
 
+    if (m_MetricsThread)
+        m_MetricsThread->Stop();
+
     Wait();
 }
 
+void WorldSocketMgr::BroadcastPacket(WorldPacket const& packet, std::vector<WorldSocket*> const& sockets)
+{
+    if (sockets.empty())
+        return;
+
+    // one payload copy shared by all network threads
+    SharedPacketPtr sharedPacket(new WorldPacket(packet));
+
+    // packet queued in socket own order with directly sent packets, written by network thread owning socket
+    std::vector<std::vector<WorldSocket*> > threadSockets(m_NetThreadsCount);
+
+    for (std::vector<WorldSocket*>::const_iterator itr = sockets.begin(); itr != sockets.end(); ++itr)
+    {
+        for (size_t i = 0; i < m_NetThreadsCount; ++i)
+        {
+            if (m_NetThreads[i].GetReactor() == (*itr)->reactor())
+            {
+                if ((*itr)->QueueSharedPacket(sharedPacket) == 0)
+                {
+                    (*itr)->AddReference();
+                    threadSockets[i].push_back(*itr);
+                }
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m_NetThreadsCount; ++i)
+        if (!threadSockets[i].empty())
+            m_NetThreads[i].AddBroadcast(threadSockets[i]);
+}
+
 void WorldSocketMgr::Wait()
 {
     if (m_NetThreadsCount != 0)
@@ -309,6 +424,9 @@ void WorldSocketMgr::Wait()
         for (size_t i = 0; i < m_NetThreadsCount; ++i)
             m_NetThreads[i].Wait();
     }
+
+    if (m_MetricsThread)
+        m_MetricsThread->Wait();
 }
 
 int WorldSocketMgr::OnSocketOpen(WorldSocket* sock)
@@ -30,8 +30,10 @@
 #include <ace/Thread_Mutex.h>
 
 #include <string>
+#include <vector>
 
 class WorldSocket;
+class WorldPacket;
 class ReactorRunnable;
 class ACE_Event_Handler;
 
@@ -51,6 +53,9 @@ class WorldSocketMgr
         /// Wait untill all network threads have "joined" .
         void Wait();
 
+        /// Send same packet to many sockets, sending done by network threads owning sockets .
+        void BroadcastPacket(WorldPacket const& packet, std::vector<WorldSocket*> const& sockets);
+
         std::string& GetBindAddress() { return m_addr; }
         ACE_UINT16 GetBindPort() { return m_port; }
 
@@ -75,6 +80,8 @@ class WorldSocketMgr
         ACE_UINT16 m_port;
 
         ACE_Event_Handler* m_Acceptor;
+        ACE_Event_Handler* m_MetricsAcceptor;               ///< Metrics HTTP listener, in own network thread
+        ReactorRunnable* m_MetricsThread;                   ///< Slow scrape or export never delays game sockets
 };
 
 #define sWorldSocketMgr WorldSocketMgr::Instance()
@@ -65,9 +65,9 @@ void WorldStateMgr::Update()
                         if (bl && bl->HolidayWorldStateId == state->GetId())
                         {
                             if (BattleGroundMgr::IsBGWeekend(BattleGroundTypeId(bl->id)))
-                                state->SetValue(WORLD_STATE_ADD);
+                                SetStateValue(state, WORLD_STATE_ADD);
                             else
-                                state->SetValue(WORLD_STATE_REMOVE);
+                                SetStateValue(state, WORLD_STATE_REMOVE);
                         }
                     }
                     break;
@@ -96,6 +96,7 @@ void WorldStateMgr::Update()
                 if (state->HasFlag(WORLD_STATE_FLAG_INITIAL_STATE))
                 {
                     state->Initialize();
+                    AddToJournal(state);
                     continue;
                 }
 
@@ -113,7 +114,10 @@ void WorldStateMgr::Update()
         for (WorldStateMap::iterator itr = m_worldState.begin(); itr != m_worldState.end();)
         {
             if (itr->second.HasFlag(WORLD_STATE_FLAG_DELETED))
+            {
+                RemoveFromJournal(&itr->second);
                 m_worldState.erase(itr++);
+            }
             else
                 ++itr;
         }
@@ -374,6 +378,12 @@ void WorldStateMgr::LoadFromDB()
 {
     // cannot be reloaded!
     m_worldState.clear();
+
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_journalLock);
+        for (uint32 i = 0; i < WORLD_STATE_JOURNAL_MAX; ++i)
+            m_journals[i].clear();
+    }
     //                                                            0           1       2            3        4        5            6
     QueryResult* result = CharacterDatabase.Query("SELECT `state_id`, `instance`, `type`, `condition`, `flags`, `value`, `renewtime` FROM `worldstate_data`");
 
@@ -407,16 +417,16 @@ void WorldStateMgr::LoadFromDB()
             if (WorldState const* state = GetWorldState(tmpl, instanceId))
             {
                 if (state->GetValue() != _value)
-                    const_cast<WorldState*>(state)->SetValue(_value);
+                    SetStateValue(const_cast<WorldState*>(state), _value);
             }
             else
-                m_worldState.insert(WorldStateMap::value_type(stateId, WorldState(tmpl, instanceId, flags, _value, renewtime)));
+                AddToJournal(&m_worldState.insert(WorldStateMap::value_type(stateId, WorldState(tmpl, instanceId, flags, _value, renewtime)))->second);
         }
         else if (type == WORLD_STATE_TYPE_CUSTOM)
         {
             DEBUG_FILTER_LOG(LOG_FILTER_DB_STRICTED_CHECK,"WorldStateMgr::LoadFromDB loaded custom state %u (%u %u %u %u %u %ld)",
                 stateId, instanceId, type, condition, flags, _value, renewtime);
-            m_worldState.insert(WorldStateMap::value_type(stateId, WorldState(stateId, instanceId, flags, _value, renewtime)));
+            AddToJournal(&m_worldState.insert(WorldStateMap::value_type(stateId, WorldState(stateId, instanceId, flags, _value, renewtime)))->second);
         }
         else
         {
@@ -750,33 +760,127 @@ WorldStateSet* WorldStateMgr::GetWorldStatesFor(Player* player, uint32 flags)
     return stateSet;
 }
 
-WorldStateSet* WorldStateMgr::GetUpdatedWorldStatesFor(Player* player, time_t updateTime)
+WorldStateSet* WorldStateMgr::GetUpdatedWorldStatesFor(Player* player, uint32& lastVersion)
 {
+    // nothing changed since last call, usual case for most players
+    if (lastVersion == m_version.value())
+        return NULL;
+
     WorldStateSet* stateSet = NULL;
 
-    for (WorldStateMap::iterator itr = m_worldState.begin(); itr != m_worldState.end(); ++itr)
+    ACE_Guard<ACE_Thread_Mutex> guard(m_journalLock);
+
+    // only journals of scopes, which states may fit to player position
+    AddJournalUpdates(&stateSet, player, WORLD_STATE_JOURNAL_GLOBAL, 0, lastVersion);
+    AddJournalUpdates(&stateSet, player, WORLD_STATE_JOURNAL_MAP, player->GetMapId(), lastVersion);
+    AddJournalUpdates(&stateSet, player, WORLD_STATE_JOURNAL_ZONE, player->GetZoneId(), lastVersion);
+    AddJournalUpdates(&stateSet, player, WORLD_STATE_JOURNAL_AREA, player->GetAreaId(), lastVersion);
+
+    lastVersion = m_version.value();
+    return stateSet;
+}
+
+void WorldStateMgr::AddJournalUpdates(WorldStateSet** stateSet, Player* player, WorldStateJournalScope scope, uint32 condition, uint32 lastVersion)
+{
+    WorldStateJournalMap::const_iterator journal = m_journals[scope].find(MakeJournalKey(condition, scope == WORLD_STATE_JOURNAL_GLOBAL ? 0 : player->GetInstanceId()));
+    if (journal == m_journals[scope].end())
+        return;
+
+    for (WorldStateJournal::const_iterator itr = journal->second.upper_bound(lastVersion); itr != journal->second.end(); ++itr)
     {
-        WorldState* state = &itr->second;
+        WorldState* state = itr->second;
 
-        if (!state || state->HasFlag(WORLD_STATE_FLAG_DELETED))
+        if (state->HasFlag(WORLD_STATE_FLAG_DELETED) || !state->HasFlag(WORLD_STATE_FLAG_ACTIVE))
             continue;
 
-        if (state->HasFlag(WORLD_STATE_FLAG_ACTIVE) &&
-            state->GetRenewTime() >= updateTime &&
-            state->GetRenewTime() != time(NULL) &&
-            IsFitToCondition(player, state))
-        {
-            // Always send UpLinked worldstate with own chains
-            // Attention! possible need sent ALL linked chain in this case. need tests.
-            if (state->GetTemplate() && state->GetTemplate()->m_linkedId)
-                if (WorldStateTemplate const* tmpl = FindTemplate(state->GetTemplate()->m_linkedId, state->GetType(), state->GetCondition()))
-                    if (WorldState const* state1 = GetWorldState(tmpl, state->GetInstance()))
-                        AddToWorldStateSet(&stateSet, state1);
-
-            AddToWorldStateSet(&stateSet, state);
-        }
+        if (!IsFitToCondition(player, state))
+            continue;
+
+        // Always send UpLinked worldstate with own chains
+        // Attention! possible need sent ALL linked chain in this case. need tests.
+        if (state->GetTemplate() && state->GetTemplate()->m_linkedId)
+            if (WorldStateTemplate const* tmpl = FindTemplate(state->GetTemplate()->m_linkedId, state->GetType(), state->GetCondition()))
+                if (WorldState const* state1 = GetWorldState(tmpl, state->GetInstance()))
+                    AddToWorldStateSet(stateSet, state1);
+
+        AddToWorldStateSet(stateSet, state);
     }
-    return stateSet;
+}
+
+uint32 WorldStateMgr::GetVersion()
+{
+    return m_version.value();
+}
+
+void WorldStateMgr::SetStateValue(WorldState* state, uint32 value)
+{
+    state->SetValue(value);
+    AddToJournal(state);
+}
+
+WorldStateJournalScope WorldStateMgr::GetJournalScope(WorldState const* state)
+{
+    switch (state->GetType())
+    {
+        case WORLD_STATE_TYPE_MAP:
+        case WORLD_STATE_TYPE_BATTLEGROUND:
+            return WORLD_STATE_JOURNAL_MAP;
+        case WORLD_STATE_TYPE_ZONE:
+            return WORLD_STATE_JOURNAL_ZONE;
+        case WORLD_STATE_TYPE_AREA:
+            return WORLD_STATE_JOURNAL_AREA;
+        default:
+            break;
+    }
+    return WORLD_STATE_JOURNAL_GLOBAL;
+}
+
+uint64 WorldStateMgr::GetJournalKey(WorldState const* state)
+{
+    return GetJournalScope(state) == WORLD_STATE_JOURNAL_GLOBAL ? 0 : MakeJournalKey(state->GetCondition(), state->GetInstance());
+}
+
+WorldStateJournal* WorldStateMgr::GetJournal(WorldState const* state, bool create)
+{
+    WorldStateJournalScope scope = GetJournalScope(state);
+    uint64 key = GetJournalKey(state);
+
+    if (create)
+        return &m_journals[scope][key];
+
+    WorldStateJournalMap::iterator itr = m_journals[scope].find(key);
+    return itr != m_journals[scope].end() ? &itr->second : NULL;
+}
+
+void WorldStateMgr::AddToJournal(WorldState* state)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_journalLock);
+
+    WorldStateJournal* journal = GetJournal(state, true);
+
+    // keep only last change of state
+    if (state->GetVersion())
+        journal->erase(state->GetVersion());
+
+    state->SetVersion(++m_version);
+    (*journal)[state->GetVersion()] = state;
+}
+
+void WorldStateMgr::RemoveFromJournal(WorldState* state)
+{
+    if (!state->GetVersion())
+        return;
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_journalLock);
+
+    if (WorldStateJournal* journal = GetJournal(state, false))
+    {
+        journal->erase(state->GetVersion());
+        if (journal->empty())
+            m_journals[GetJournalScope(state)].erase(GetJournalKey(state));
+    }
+
+    state->SetVersion(0);
 }
 
 bool WorldStateMgr::IsFitToCondition(Player* player, WorldState const* state)
@@ -1043,7 +1147,7 @@ void WorldStateMgr::SetWorldStateValueFor(Player* player, uint32 stateId, uint32
             if (IsFitToCondition(player, &itr->second))
             {
                 if ((&itr->second)->GetValue() != value)
-                    const_cast<WorldState*>(&itr->second)->SetValue(value);
+                    SetStateValue(const_cast<WorldState*>(&itr->second), value);
                 return;
             }
         }
@@ -1065,7 +1169,7 @@ void WorldStateMgr::SetWorldStateValueFor(Map* map, uint32 stateId, uint32 value
             if (IsFitToCondition(map, &itr->second))
             {
                 if ((&itr->second)->GetValue() != value)
-                    const_cast<WorldState*>(&itr->second)->SetValue(value);
+                    SetStateValue(const_cast<WorldState*>(&itr->second), value);
                 return;
             }
         }
@@ -1089,7 +1193,7 @@ void WorldStateMgr::SetWorldStateValueFor(uint32 zoneId, uint32 stateId, uint32
             if (IsFitToCondition(mapId, 0, zoneId, 0, &itr->second))
             {
                 if ((&itr->second)->GetValue() != value)
-                    const_cast<WorldState*>(&itr->second)->SetValue(value);
+                    SetStateValue(const_cast<WorldState*>(&itr->second), value);
                 return;
             }
         }
@@ -1132,7 +1236,7 @@ void WorldStateMgr::SetWorldStateValueFor(WorldObject* object, uint32 stateId, u
             if (IsFitToCondition(object->GetMap()->GetId(), object->GetObjectGuid().GetCounter(), 0, 0, _state))
             {
                 if (_state->GetValue() != value)
-                    const_cast<WorldState*>(_state)->SetValue(value);
+                    SetStateValue(const_cast<WorldState*>(_state), value);
 
                 DEBUG_LOG("WorldStateMgr::SetWorldStateValueFor tru set state %u instance %u, type %u  value %u (%u)  for %s",
                     _state->GetId(), _state->GetInstance(),
@@ -1173,7 +1277,7 @@ WorldState const* WorldStateMgr::CreateWorldState(WorldStateTemplate const* tmpl
     {
         DEBUG_LOG("WorldStateMgr::CreateWorldState tru create  state %u  instance %u type %u (value %u) but state exists (value %u).",
             tmpl->m_stateId, instanceId, tmpl->m_stateType, value, _state->GetValue());
-        const_cast<WorldState*>(_state)->SetValue(value);
+        SetStateValue(const_cast<WorldState*>(_state), value);
         return _state;
     }
 
@@ -1191,6 +1295,8 @@ WorldState const* WorldStateMgr::CreateWorldState(WorldStateTemplate const* tmpl
     if (!tmpl->HasFlag(WORLD_STATE_FLAG_PASSIVE_AT_CREATE))
         _state->AddFlag(WORLD_STATE_FLAG_ACTIVE);
 
+    AddToJournal(_state);
+
     DEBUG_LOG("WorldStateMgr::CreateWorldState state %u instance %u created, type %u (%u) flags %u (%u) value %u (%u, %u)",
         _state->GetId(), _state->GetInstance(),
         _state->GetType(), tmpl->m_stateType,
@@ -149,14 +149,14 @@ struct WorldState
     public:
     // For create new state
     WorldState(WorldStateTemplate const* _state, uint32 _instance)
-        : m_pState(_state), m_stateId(m_pState->m_stateId), m_instanceId(_instance), m_type(m_pState->m_stateType)
+        : m_pState(_state), m_stateId(m_pState->m_stateId), m_instanceId(_instance), m_type(m_pState->m_stateType), m_version(0)
     {
         Initialize();
     }
 
     // For load
     WorldState(WorldStateTemplate const* _state, uint32 _instance, uint32 _flags, uint32 _value, time_t _renewtime)
-        : m_pState(_state), m_stateId(m_pState->m_stateId), m_instanceId(_instance), m_type(m_pState->m_stateType), m_flags(_flags), m_value(_value), m_renewTime(_renewtime)
+        : m_pState(_state), m_stateId(m_pState->m_stateId), m_instanceId(_instance), m_type(m_pState->m_stateType), m_flags(_flags), m_value(_value), m_renewTime(_renewtime), m_version(0)
     {
         m_linkedGuid.Clear();
         m_clientGuids.clear();
@@ -165,14 +165,14 @@ struct WorldState
 
     // For load custom state
     WorldState(uint32 _stateid, uint32 _instance, uint32 _flags, uint32 _value, time_t _renewtime)
-        : m_pState(NULL), m_stateId(_stateid), m_instanceId(_instance), m_type(WORLD_STATE_TYPE_CUSTOM), m_flags(_flags), m_value(_value), m_renewTime(_renewtime)
+        : m_pState(NULL), m_stateId(_stateid), m_instanceId(_instance), m_type(WORLD_STATE_TYPE_CUSTOM), m_flags(_flags), m_value(_value), m_renewTime(_renewtime), m_version(0)
     {
         Initialize();
     }
 
     // For create new custom state
     WorldState(uint32 _stateid, uint32 _instance, uint32 value)
-        : m_pState(NULL), m_stateId(_stateid), m_instanceId(_instance), m_type(WORLD_STATE_TYPE_CUSTOM), m_value(value)
+        : m_pState(NULL), m_stateId(_stateid), m_instanceId(_instance), m_type(WORLD_STATE_TYPE_CUSTOM), m_value(value), m_version(0)
     {
         Initialize();
     }
@@ -273,6 +273,10 @@ struct WorldState
         m_renewTime = time(NULL);
     }
 
+    // Version of last change, assigned by WorldStateMgr change journal
+    uint32 const& GetVersion()   const { return m_version; }
+    void          SetVersion(uint32 version) { m_version = version; }
+
     private:
     // const parameters (must be setted in constructor)
     const WorldStateTemplate*          m_pState;        // pointer to template (may be NULL for custom states)
@@ -287,11 +291,26 @@ struct WorldState
     ObjectGuid                         m_linkedGuid;    // Guid of GO/creature/etc, which linked to WorldState (CapturePoint mostly)
     GuidSet                            m_clientGuids;   // List of player Guids, wich already received this WorldState update
     uint32                             m_phasemask;     // Phase mask for this state
+    uint32                             m_version;       // version of last change (0 - not in journal)
 };
 
 typedef UNORDERED_MULTIMAP<uint32 /* state id */, WorldState> WorldStateMap;
 typedef std::pair<WorldStateMap::const_iterator, WorldStateMap::const_iterator> WorldStateBounds;
 
+// Change journal scopes - states grouped by player position part, which IsFitToCondition check for them
+enum WorldStateJournalScope
+{
+    WORLD_STATE_JOURNAL_GLOBAL                  = 0,    // global, custom, capture point and other states
+    WORLD_STATE_JOURNAL_MAP                     = 1,    // map and battleground states, key map+instance
+    WORLD_STATE_JOURNAL_ZONE                    = 2,    // zone states, key zone+instance
+    WORLD_STATE_JOURNAL_AREA                    = 3,    // area states, key area+instance
+    WORLD_STATE_JOURNAL_MAX
+};
+
+// Changed states of one scope, ordered by change version. Each state stored only with last version.
+typedef std::map<uint32 /* version */, WorldState*> WorldStateJournal;
+typedef UNORDERED_MAP<uint64 /* condition+instance */, WorldStateJournal> WorldStateJournalMap;
+
 #define MAX_WORD_STATE_SET_COUNT 254
 
 class WorldStateSet
@@ -322,7 +341,7 @@ inline void AddToWorldStateSet(WorldStateSet** wss, WorldState const* wState)
 class MANGOS_DLL_DECL WorldStateMgr : public MaNGOS::Singleton<WorldStateMgr, MaNGOS::ClassLevelLockable<WorldStateMgr, ACE_Thread_Mutex> >
 {
     public:
-        WorldStateMgr() {}
+        WorldStateMgr() : m_version(0) {}
 
     public:
         void Initialize();
@@ -380,7 +399,9 @@ class MANGOS_DLL_DECL WorldStateMgr : public MaNGOS::Singleton<WorldStateMgr, Ma
         WorldStateSet* GetWorldStatesFor(Player* player, WorldStateFlags flag) { return GetWorldStatesFor(player, (1 << flag)); };
         WorldStateSet* GetWorldStatesFor(Player* player, uint32 flags = UINT32_MAX);
 
-        WorldStateSet* GetUpdatedWorldStatesFor(Player* player, time_t lastUpdateTime = 0);
+        // states changed after version 'lastVersion' (0 - all), 'lastVersion' set to current version
+        WorldStateSet* GetUpdatedWorldStatesFor(Player* player, uint32& lastVersion);
+        uint32 GetVersion();
 
         WorldStateSet* GetInstanceStates(Map* map, uint32 flags = 0, bool full = false);
         WorldStateSet* GetInstanceStates(uint32 mapId, uint32 instanceId, uint32 flags = 0, bool full = false);
@@ -402,8 +423,22 @@ class MANGOS_DLL_DECL WorldStateMgr : public MaNGOS::Singleton<WorldStateMgr, Ma
         uint32 GetMapIdByZoneId(uint32 zoneId) const;
 
     private:
+        // Change journal operations
+        void SetStateValue(WorldState* state, uint32 value);
+        void AddToJournal(WorldState* state);
+        void RemoveFromJournal(WorldState* state);
+        WorldStateJournal* GetJournal(WorldState const* state, bool create);
+        void AddJournalUpdates(WorldStateSet** stateSet, Player* player, WorldStateJournalScope scope, uint32 condition, uint32 lastVersion);
+        static WorldStateJournalScope GetJournalScope(WorldState const* state);
+        static uint64 GetJournalKey(WorldState const* state);
+        static uint64 MakeJournalKey(uint32 condition, uint32 instanceId) { return (uint64(condition) << 32) | instanceId; }
+
         WorldStateTemplateMap   m_worldStateTemplates;    // templates storage
         WorldStateMap           m_worldState;             // data storage
+
+        WorldStateJournalMap    m_journals[WORLD_STATE_JOURNAL_MAX];
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> m_version; // version of last state change, changed only under m_journalLock
+        ACE_Thread_Mutex        m_journalLock;
 };
 
 #define sWorldStateMgr MaNGOS::Singleton<WorldStateMgr>::Instance()
@@ -31,6 +31,15 @@
 #include "ObjectMgr.h"
 #include "ObjectGuid.h"
 #include "SpellMgr.h"
+#include "ObjectAccessor.h"
+#include "Threading.h"
+#include "WorldStateMgr.h"
+#include "PlayerSaveScheduler.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "CellImpl.h"
+#include "playerbot/PlayerbotLoadBenchmark.h"
+#include "OpcodeStats.h"
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1173,3 +1182,916 @@ bool ChatHandler::HandleDebugEnterVehicleCommand(char* args)
     m_session->GetPlayer()->EnterVehicle(target->GetVehicleKit(), seat);
     return true;
 }
+
+bool ChatHandler::HandleDebugLOSCacheCommand(char* /*args*/)
+{
+    Map* map = m_session->GetPlayer()->GetMap();
+    LineOfSightCacheStatistic stat = map->GetLineOfSightCacheStatistic();
+
+    if (stat.gridSize <= 0.0f)
+    {
+        PSendSysMessage("LOS cache for map %u (instance %u) disabled", map->GetId(), map->GetInstanceId());
+        return true;
+    }
+
+    PSendSysMessage("LOS cache for map %u (instance %u), grid %.2f yards:", map->GetId(), map->GetInstanceId(), stat.gridSize);
+    PSendSysMessage(" %u entries, " UI64FMTD " hits, " UI64FMTD " misses, hit rate %.2f%%",
+        stat.entries, stat.hits, stat.misses, stat.GetHitRate());
+    PSendSysMessage(" %u invalidations by dynamic collision changes, %u entries expired",
+        stat.invalidations, stat.expirations);
+    return true;
+}
+
+/**
+ * Console benchmark, run by own thread to not block world update, results are written to server log.
+ * Only one benchmark runs at a time.
+ */
+class ConsoleBenchmark : public ACE_Based::Runnable
+{
+    public:
+        void run() override
+        {
+            Run();
+            s_running = 0;
+        }
+
+        // takes ownership of benchmark, false if other benchmark still running
+        static bool Start(ConsoleBenchmark* bench);
+
+    protected:
+        virtual void Run() = 0;
+
+    private:
+        static ACE_Atomic_Op<ACE_Thread_Mutex, long> s_running;
+        static ACE_Based::Thread* s_thread;
+};
+
+ACE_Atomic_Op<ACE_Thread_Mutex, long> ConsoleBenchmark::s_running;
+ACE_Based::Thread* ConsoleBenchmark::s_thread = NULL;
+
+bool ConsoleBenchmark::Start(ConsoleBenchmark* bench)
+{
+    if (++s_running != 1)
+    {
+        --s_running;
+        delete bench;
+        return false;
+    }
+
+    // thread of previous benchmark already finished its run
+    if (s_thread)
+    {
+        s_thread->wait();
+        delete s_thread;
+    }
+
+    s_thread = new ACE_Based::Thread(bench);
+    return true;
+}
+
+class PlayerLookupBenchmark : public ACE_Based::Runnable
+{
+    public:
+        PlayerLookupBenchmark(std::vector<ObjectGuid> const& guids, std::vector<std::string> const& names, uint32 count) :
+            m_guids(guids), m_names(names), m_count(count), m_found(0), m_guidTime(0), m_nameTime(0) {}
+
+        void run() override
+        {
+            uint32 startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_count; ++i)
+                if (ObjectAccessor::FindPlayer(m_guids[i % m_guids.size()], false))
+                    ++m_found;
+            m_guidTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_count; ++i)
+                if (ObjectAccessor::FindPlayerByName(m_names[i % m_names.size()].c_str()))
+                    ++m_found;
+            m_nameTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+        }
+
+        uint32 GetFound() const { return m_found; }
+        uint32 GetGuidTime() const { return m_guidTime; }
+        uint32 GetNameTime() const { return m_nameTime; }
+
+    private:
+        std::vector<ObjectGuid> const& m_guids;
+        std::vector<std::string> const& m_names;
+        uint32 m_count;
+        uint32 m_found;
+        uint32 m_guidTime;
+        uint32 m_nameTime;
+};
+
+// lookups of all threads run in parallel to world update
+class PlayerLookupBenchmarkRun : public ConsoleBenchmark
+{
+    public:
+        // world thread, players can't log out while their names copied
+        PlayerLookupBenchmarkRun(uint32 threads, uint32 count) : m_threads(threads), m_count(count), m_online(0)
+        {
+            PlayerRegistry::SnapshotPtr players = sObjectAccessor.GetPlayers();
+            for (PlayerRegistry::MapType::const_iterator itr = players->players.begin(); itr != players->players.end(); ++itr)
+            {
+                m_guids.push_back(itr->first);
+                m_names.push_back(itr->second->GetName());
+            }
+            m_online = m_guids.size();
+
+            // nobody online - measure lookup misses
+            if (m_guids.empty())
+            {
+                m_guids.push_back(ObjectGuid(HIGHGUID_PLAYER, uint32(1)));
+                m_names.push_back("Nobody");
+            }
+        }
+
+    protected:
+        void Run() override
+        {
+            std::vector<PlayerLookupBenchmark*> tasks;
+            std::vector<ACE_Based::Thread*> workers;
+
+            uint32 startTime = WorldTimer::getMSTime();
+
+            for (uint32 i = 0; i < m_threads; ++i)
+            {
+                PlayerLookupBenchmark* task = new PlayerLookupBenchmark(m_guids, m_names, m_count);
+                task->incReference();                       // keep results after thread end
+                tasks.push_back(task);
+                workers.push_back(new ACE_Based::Thread(task));
+            }
+
+            for (uint32 i = 0; i < m_threads; ++i)
+            {
+                workers[i]->wait();
+                delete workers[i];
+            }
+
+            uint32 totalTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            uint32 found = 0;
+            uint32 guidTime = 0;
+            uint32 nameTime = 0;
+            for (uint32 i = 0; i < m_threads; ++i)
+            {
+                found += tasks[i]->GetFound();
+                guidTime = std::max(guidTime, tasks[i]->GetGuidTime());
+                nameTime = std::max(nameTime, tasks[i]->GetNameTime());
+                tasks[i]->decReference();
+            }
+
+            uint64 lookups = uint64(m_threads) * m_count;
+            sLog.outString("Player lookup: %u threads x %u lookups, %u players online, %u found", m_threads, m_count, m_online, found);
+            sLog.outString(" by guid: %u ms (" UI64FMTD " lookups/s)", guidTime, guidTime ? lookups * 1000 / guidTime : lookups * 1000);
+            sLog.outString(" by name: %u ms (" UI64FMTD " lookups/s)", nameTime, nameTime ? lookups * 1000 / nameTime : lookups * 1000);
+            sLog.outString(" total: %u ms", totalTime);
+        }
+
+    private:
+        uint32 m_threads;
+        uint32 m_count;
+        uint32 m_online;
+        std::vector<ObjectGuid> m_guids;
+        std::vector<std::string> m_names;
+};
+
+bool ChatHandler::StartConsoleBenchmarkHelper(ConsoleBenchmark* bench)
+{
+    if (!ConsoleBenchmark::Start(bench))
+    {
+        SendSysMessage("Other benchmark still running, wait for its results in server log.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    SendSysMessage("Benchmark started, results will be written to server log.");
+    return true;
+}
+
+bool ChatHandler::HandleDebugPlayerLookupCommand(char* args)
+{
+    uint32 threads;
+    if (!ExtractOptUInt32(&args, threads, 4))
+        return false;
+
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 100000))
+        return false;
+
+    if (!threads || threads > 64 || !count)
+        return false;
+
+    return StartConsoleBenchmarkHelper(new PlayerLookupBenchmarkRun(threads, count));
+}
+
+bool ChatHandler::HandleDebugWorldStateUpdateCommand(char* args)
+{
+    uint32 players;
+    if (!ExtractOptUInt32(&args, players, 3000))
+        return false;
+
+    if (!players)
+        return false;
+
+    Player* player = m_session->GetPlayer();
+
+    uint32 scanned = 0;
+    uint32 startTime = WorldTimer::getMSTime();
+
+    // full states scan with condition check for each state, as before change journal
+    for (uint32 i = 0; i < players; ++i)
+    {
+        if (WorldStateSet* wsSet = sWorldStateMgr.GetWorldStatesFor(player, WORLD_STATE_FLAG_ACTIVE))
+        {
+            scanned += wsSet->count();
+            delete wsSet;
+        }
+    }
+
+    uint32 scanTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    uint32 updated = 0;
+    uint32 currentVersion = sWorldStateMgr.GetVersion();
+    startTime = WorldTimer::getMSTime();
+
+    // usual tick - player already received all changes
+    for (uint32 i = 0; i < players; ++i)
+    {
+        uint32 version = currentVersion;
+        if (WorldStateSet* wsSet = sWorldStateMgr.GetUpdatedWorldStatesFor(player, version))
+        {
+            updated += wsSet->count();
+            delete wsSet;
+        }
+    }
+
+    uint32 journalTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    uint32 resent = 0;
+    startTime = WorldTimer::getMSTime();
+
+    // forced update - all changes of player scopes
+    for (uint32 i = 0; i < players; ++i)
+    {
+        uint32 version = 0;
+        if (WorldStateSet* wsSet = sWorldStateMgr.GetUpdatedWorldStatesFor(player, version))
+        {
+            resent += wsSet->count();
+            delete wsSet;
+        }
+    }
+
+    uint32 fullTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    PSendSysMessage("WorldState update for %u players at your position, %u states total, version %u",
+        players, sWorldStateMgr.GetWorldStatesCount(), currentVersion);
+    PSendSysMessage(" full scan: %u ms (%u states)", scanTime, scanned);
+    PSendSysMessage(" journal, no changes: %u ms (%u states)", journalTime, updated);
+    PSendSysMessage(" journal, forced: %u ms (%u states)", fullTime, resent);
+    return true;
+}
+
+// read all fields of result by column type, returns rows count
+static uint32 ReadSqlResultFields(QueryResult* result, uint64& sum)
+{
+    if (!result)
+        return 0;
+
+    uint32 rows = 0;
+    do
+    {
+        Field* fields = result->Fetch();
+        for (uint32 i = 0; i < result->GetFieldCount(); ++i)
+        {
+            switch (fields[i].GetType())
+            {
+                case Field::DB_TYPE_INTEGER: sum += fields[i].GetUInt32();              break;
+                case Field::DB_TYPE_FLOAT:   sum += uint64(fields[i].GetFloat());       break;
+                default:                     sum += fields[i].GetCppString().size();    break;
+            }
+        }
+        ++rows;
+    }
+    while (result->NextRow());
+
+    delete result;
+    return rows;
+}
+
+// character login queries and creature spawns query, as text and as binary prepared statements
+class SqlReadBenchmark : public ConsoleBenchmark
+{
+    public:
+        SqlReadBenchmark(uint32 guidLow, uint32 loops) : m_guidLow(guidLow), m_loops(loops) {}
+
+    protected:
+        void Run() override
+        {
+            WorldDatabase.ThreadStart();                    // let thread do safe mySQL requests
+            CharacterDatabase.ThreadStart();
+
+            uint64 sum = 0;
+
+            char const* loginQueries[] =
+            {
+                "SELECT * FROM characters WHERE guid = ?",
+                "SELECT data,text,bag,slot,item,item_template FROM character_inventory JOIN item_instance ON character_inventory.item = item_instance.guid WHERE character_inventory.guid = ?",
+                "SELECT spell,active,disabled FROM character_spell WHERE guid = ?",
+                "SELECT caster_guid,item_guid,spell,stackcount,remaincharges,basepoints0,basepoints1,basepoints2,periodictime0,periodictime1,periodictime2,maxduration,remaintime,effIndexMask FROM character_aura WHERE guid = ?",
+                "SELECT quest,status,rewarded,explored,timer,mobcount1,mobcount2,mobcount3,mobcount4,itemcount1,itemcount2,itemcount3,itemcount4,itemcount5,itemcount6 FROM character_queststatus WHERE guid = ?",
+                "SELECT achievement, date FROM character_achievement WHERE guid = ?",
+                "SELECT criteria, counter, date FROM character_achievement_progress WHERE guid = ?"
+            };
+            uint32 const loginQueriesCount = countof(loginQueries);
+            static SqlStatementID loginStmts[countof(loginQueries)];
+
+            uint32 textRows = 0;
+            uint32 startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_loops; ++i)
+            {
+                for (uint32 q = 0; q < loginQueriesCount; ++q)
+                {
+                    std::ostringstream sql;
+                    sql << std::string(loginQueries[q], strlen(loginQueries[q]) - 1) << "'" << m_guidLow << "'";
+                    textRows += ReadSqlResultFields(CharacterDatabase.Query(sql.str().c_str()), sum);
+                }
+            }
+            uint32 textTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            uint32 stmtRows = 0;
+            startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_loops; ++i)
+            {
+                for (uint32 q = 0; q < loginQueriesCount; ++q)
+                {
+                    SqlStatement stmt = CharacterDatabase.CreateStatement(loginStmts[q], loginQueries[q]);
+                    stmtRows += ReadSqlResultFields(stmt.PQuery(m_guidLow), sum);
+                }
+            }
+            uint32 stmtTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            sLog.outString("Character %u login queries x %u loops:", m_guidLow, m_loops);
+            sLog.outString(" text: %u ms (%u rows)", textTime, textRows);
+            sLog.outString(" binary: %u ms (%u rows)", stmtTime, stmtRows);
+
+            // creature spawns, as used by ObjectMgr::LoadCreatures
+            char const* creatureQuery = "SELECT creature.guid, creature.id, map, modelid,"
+                "equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, spawndist, currentwaypoint,"
+                "curhealth, curmana, DeathState, MovementType, spawnMask, phaseMask, event,"
+                "pool_creature.pool_entry, pool_creature_template.pool_entry "
+                "FROM creature "
+                "LEFT OUTER JOIN game_event_creature ON creature.guid = game_event_creature.guid "
+                "LEFT OUTER JOIN pool_creature ON creature.guid = pool_creature.guid "
+                "LEFT OUTER JOIN pool_creature_template ON creature.id = pool_creature_template.id";
+
+            startTime = WorldTimer::getMSTime();
+            textRows = ReadSqlResultFields(WorldDatabase.Query(creatureQuery), sum);
+            textTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            static SqlStatementID creatureStmt;
+            startTime = WorldTimer::getMSTime();
+            SqlStatement stmt = WorldDatabase.CreateStatement(creatureStmt, creatureQuery);
+            stmtRows = ReadSqlResultFields(stmt.Query(), sum);
+            stmtTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            sLog.outString("Creature spawns query:");
+            sLog.outString(" text: %u ms (%u rows)", textTime, textRows);
+            sLog.outString(" binary: %u ms (%u rows)", stmtTime, stmtRows);
+
+            CharacterDatabase.ThreadEnd();
+            WorldDatabase.ThreadEnd();
+        }
+
+    private:
+        uint32 m_guidLow;
+        uint32 m_loops;
+};
+
+bool ChatHandler::HandleDebugSqlReadCommand(char* args)
+{
+    ObjectGuid guid;
+    if (!ExtractPlayerTarget(&args, NULL, &guid))
+        return false;
+
+    uint32 loops;
+    if (!ExtractOptUInt32(&args, loops, 100))
+        return false;
+
+    if (!loops)
+        return false;
+
+    return StartConsoleBenchmarkHelper(new SqlReadBenchmark(guid.GetCounter(), loops));
+}
+
+bool ChatHandler::HandleDebugPlayerSaveCommand(char* /*args*/)
+{
+    static char const* sectionNames[MAX_PLAYER_SAVE_SECTIONS] = { "characters", "auras", "spell cooldowns" };
+
+    SendSysMessage("Player save sections (written / skipped as unchanged):");
+    for (int i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+    {
+        PlayerSaveSectionStats const& stats = Player::GetSaveSectionStats(PlayerSaveSection(i));
+        PSendSysMessage(" %s: saves %ld / %ld, statements %ld / %ld, bytes %ld / %ld", sectionNames[i],
+            stats.written.value(), stats.skipped.value(),
+            stats.statementsWritten.value(), stats.statementsSkipped.value(),
+            stats.bytesWritten.value(), stats.bytesSkipped.value());
+    }
+
+    PSendSysMessage("Autosaves: %u allowed, %u requests delayed, %u ticks throttled by character DB load (async queue %u, average request time %u us)",
+        sPlayerSaveScheduler.GetAllowedSaves(), sPlayerSaveScheduler.GetDelayedRequests(), sPlayerSaveScheduler.GetThrottledTicks(),
+        CharacterDatabase.GetAsyncQueueSize(), CharacterDatabase.GetAsyncAverageTime());
+    return true;
+}
+
+// derived data of all spells by precomputed table and by calculation as before it
+class SpellDerivedDataBenchmark : public ConsoleBenchmark
+{
+    public:
+        explicit SpellDerivedDataBenchmark(uint32 count) : m_count(count) {}
+
+    protected:
+        void Run() override
+        {
+            uint32 sum = 0;
+            uint32 startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_count; ++i)
+            {
+                for (uint32 id = 1; id < sSpellStore.GetNumRows(); ++id)
+                {
+                    SpellEntry const* spellInfo = sSpellStore.LookupEntry(id);
+                    if (!spellInfo)
+                        continue;
+
+                    sum += sSpellMgr.GetSpellProcEvent(id) ? 1 : 0;
+                    sum += sSpellMgr.GetSpellBonusData(id) ? 1 : 0;
+                    sum += sSpellMgr.GetSpellRangeEntry(spellInfo) ? 1 : 0;
+                    sum += GetSpellSpecific(id);
+                    sum += IsPositiveSpell(spellInfo) ? 1 : 0;
+                }
+            }
+            uint32 tableTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            SpellDerivedData data;
+            startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_count; ++i)
+            {
+                for (uint32 id = 1; id < sSpellStore.GetNumRows(); ++id)
+                {
+                    sSpellMgr.CalculateSpellDerivedData(id, data);
+                    sum += data.specific;
+                }
+            }
+            uint32 calcTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            sLog.outString("Spell derived data of all spells x%u: precomputed %u ms, calculated %u ms (checksum %u)", m_count, tableTime, calcTime, sum);
+        }
+
+    private:
+        uint32 m_count;
+};
+
+bool ChatHandler::HandleDebugSpellBenchCommand(char* args)
+{
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 10))
+        return false;
+
+    if (!count)
+        return false;
+
+    return StartConsoleBenchmarkHelper(new SpellDerivedDataBenchmark(count));
+}
+
+// Executions counted for result check
+template<class Base>
+class BenchCountEvent : public Base
+{
+    public:
+        BenchCountEvent(uint32& executed) : Base(0), m_executed(executed) {}
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override { ++m_executed; return true; }
+
+    private:
+        uint32& m_executed;
+};
+
+class BenchPooledEvent : public PooledEvent<BenchPooledEvent>
+{
+    public:
+        BenchPooledEvent(uint32 type) : PooledEvent<BenchPooledEvent>(type) {}
+};
+
+// Event scheduling as before timing wheel, for comparison
+class BenchMultimapEventProcessor
+{
+    public:
+        BenchMultimapEventProcessor() : m_time(0) {}
+        ~BenchMultimapEventProcessor()
+        {
+            for (std::multimap<uint64, BasicEvent*>::iterator itr = m_events.begin(); itr != m_events.end(); ++itr)
+                delete itr->second;
+        }
+
+        void AddEvent(BasicEvent* Event, uint64 e_time) { m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event)); }
+        uint64 CalculateTime(uint64 t_offset) { return m_time + t_offset; }
+
+        void Update(uint32 p_time)
+        {
+            m_time += p_time;
+
+            std::multimap<uint64, BasicEvent*>::iterator i;
+            while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+            {
+                BasicEvent* Event = i->second;
+                m_events.erase(i);
+
+                if (Event->Execute(m_time, p_time))
+                    delete Event;
+            }
+        }
+
+    private:
+        uint64 m_time;
+        std::multimap<uint64, BasicEvent*> m_events;
+};
+
+template<class Processor, class Event>
+static uint32 RunEventBench(uint32 objects, uint32 updates, uint32& executed)
+{
+    std::vector<Processor> processors(objects);
+
+    uint32 startTime = WorldTimer::getMSTime();
+    for (uint32 update = 0; update < updates; ++update)
+    {
+        for (uint32 i = 0; i < objects; ++i)
+        {
+            Processor& processor = processors[i];
+
+            // relocation notify and spell delay like events
+            processor.AddEvent(new BenchCountEvent<Event>(executed), processor.CalculateTime(1000 + (i + update) % 64));
+            processor.AddEvent(new BenchCountEvent<Event>(executed), processor.CalculateTime((i * 7 + update) % 300));
+            processor.Update(50 + (i + update) % 50);
+        }
+    }
+    return WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+class EventSchedulingBenchmark : public ConsoleBenchmark
+{
+    public:
+        EventSchedulingBenchmark(uint32 objects, uint32 updates) : m_objects(objects), m_updates(updates) {}
+
+    protected:
+        void Run() override
+        {
+            uint32 multimapExecuted = 0;
+            uint32 multimapTime = RunEventBench<BenchMultimapEventProcessor, BasicEvent>(m_objects, m_updates, multimapExecuted);
+
+            uint32 wheelExecuted = 0;
+            uint32 wheelTime = RunEventBench<EventProcessor, BasicEvent>(m_objects, m_updates, wheelExecuted);
+
+            // event memory pools are per thread, so world events are not affected
+            uint32 pooledExecuted = 0;
+            uint32 pooledTime = RunEventBench<EventProcessor, BenchPooledEvent>(m_objects, m_updates, pooledExecuted);
+
+            sLog.outString("Event scheduling, %u objects x %u updates (2 events added per object update):", m_objects, m_updates);
+            sLog.outString(" multimap: %u ms (%u executed)", multimapTime, multimapExecuted);
+            sLog.outString(" timing wheel: %u ms (%u executed)", wheelTime, wheelExecuted);
+            sLog.outString(" timing wheel, pooled events: %u ms (%u executed)", pooledTime, pooledExecuted);
+        }
+
+    private:
+        uint32 m_objects;
+        uint32 m_updates;
+};
+
+bool ChatHandler::HandleDebugEventBenchCommand(char* args)
+{
+    uint32 objects;
+    if (!ExtractOptUInt32(&args, objects, 10000))
+        return false;
+
+    uint32 updates;
+    if (!ExtractOptUInt32(&args, updates, 100))
+        return false;
+
+    return StartConsoleBenchmarkHelper(new EventSchedulingBenchmark(objects, updates));
+}
+
+// same as AnyUnitInObjectRangeCheck, but without cell index filter: searchers walk all objects of cells
+class GridBenchWalkCheck
+{
+    public:
+        GridBenchWalkCheck(WorldObject const* obj, float range) : i_check(obj, range) {}
+        WorldObject const& GetFocusObject() const { return i_check.GetFocusObject(); }
+        bool operator()(Unit* u) { return i_check(u); }
+    private:
+        MaNGOS::AnyUnitInObjectRangeCheck i_check;
+};
+
+template<class Check>
+static uint32 RunGridBench(WorldObject* center, float range, uint32 queries, uint32& found)
+{
+    uint32 startTime = WorldTimer::getMSTime();
+    for (uint32 i = 0; i < queries; ++i)
+    {
+        std::list<Unit*> targets;
+        Check check(center, range);
+        MaNGOS::UnitListSearcher<Check> searcher(targets, check);
+        Cell::VisitAllObjects(center, searcher, range);
+        found += targets.size();
+    }
+    return WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+}
+
+// range searches around player, executed by map update thread of player so grids are safe to read
+class GridBenchEvent : public BasicEvent
+{
+    public:
+        GridBenchEvent(Player& owner, float range, uint32 queries)
+            : BasicEvent(WORLDOBJECT_EVENT_TYPE_COMMON), m_owner(owner), m_range(range), m_queries(queries) {}
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            uint32 walkFound = 0;
+            uint32 walkTime = RunGridBench<GridBenchWalkCheck>(&m_owner, m_range, m_queries, walkFound);
+
+            uint32 indexFound = 0;
+            uint32 indexTime = RunGridBench<MaNGOS::AnyUnitInObjectRangeCheck>(&m_owner, m_range, m_queries, indexFound);
+
+            sLog.outString("Grid range search around %s (map %u), %u queries in %.0f yards:", m_owner.GetName(), m_owner.GetMapId(), m_queries, m_range);
+            sLog.outString(" object list walk: %u ms (%u found)", walkTime, walkFound);
+            sLog.outString(" cell index filter: %u ms (%u found)", indexTime, indexFound);
+            return true;
+        }
+
+    private:
+        Player& m_owner;
+        float m_range;
+        uint32 m_queries;
+};
+
+bool ChatHandler::HandleDebugGridBenchCommand(char* args)
+{
+    Player* player;
+    if (!ExtractPlayerTarget(&args, &player))
+        return false;
+
+    uint32 range;
+    if (!ExtractOptUInt32(&args, range, 30))
+        return false;
+
+    uint32 queries;
+    if (!ExtractOptUInt32(&args, queries, 10000))
+        return false;
+
+    if (!range || range > MAX_VISIBILITY_DISTANCE || !queries)
+        return false;
+
+    // only map of player waits for searches, world update continues
+    player->AddEvent(new GridBenchEvent(*player, float(range), queries), 0);
+    SendSysMessage("Benchmark started, results will be written to server log.");
+    return true;
+}
+
+// guid lookups of one Map::Update, executed by map update thread
+class MapStoreBenchEvent : public BasicEvent
+{
+    public:
+        MapStoreBenchEvent(Map& map, uint32 passes) : BasicEvent(WORLDOBJECT_EVENT_TYPE_COMMON), m_map(map), m_passes(passes) {}
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            // store is changed under this lock by objects add/remove from other threads
+            ReadGuard Guard(m_map.GetLock(MAP_LOCK_TYPE_DEFAULT));
+
+            MapObjectStore const& store = m_map.GetObjectsStore();
+
+            // guids resolved by Map::Update: active objects in 3 stages and all objects at client updates
+            std::vector<ObjectGuid> guids;
+            for (GuidSet::const_iterator itr = m_map.GetActiveObjects().begin(); itr != m_map.GetActiveObjects().end(); ++itr)
+                for (uint32 i = 0; i < 3; ++i)
+                    guids.push_back(*itr);
+
+            // old container with same content
+            UNORDERED_MAP<ObjectGuid, WorldObject*> oldStore;
+            for (uint32 slot = 0; slot < store.GetSlotCount(); ++slot)
+            {
+                if (WorldObject* object = store.GetSlotObject(slot))
+                {
+                    guids.push_back(object->GetObjectGuid());
+                    oldStore[object->GetObjectGuid()] = object;
+                }
+            }
+
+            // handles as kept by delayed events (creature wake up)
+            std::vector<MapObjectHandle> handles;
+            for (std::vector<ObjectGuid>::const_iterator itr = guids.begin(); itr != guids.end(); ++itr)
+                handles.push_back(store.GetHandle(*itr));
+
+            uint32 found = 0;
+            uint32 startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_passes; ++i)
+            {
+                for (std::vector<ObjectGuid>::const_iterator itr = guids.begin(); itr != guids.end(); ++itr)
+                {
+                    UNORDERED_MAP<ObjectGuid, WorldObject*>::const_iterator obj = oldStore.find(*itr);
+                    if (obj != oldStore.end() && obj->second)
+                        ++found;
+                }
+            }
+            uint32 hashMapTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_passes; ++i)
+                for (std::vector<ObjectGuid>::const_iterator itr = guids.begin(); itr != guids.end(); ++itr)
+                    if (store.Find(*itr))
+                        ++found;
+            uint32 storeTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            startTime = WorldTimer::getMSTime();
+            for (uint32 i = 0; i < m_passes; ++i)
+                for (std::vector<MapObjectHandle>::const_iterator itr = handles.begin(); itr != handles.end(); ++itr)
+                    if (store.Find(*itr))
+                        ++found;
+            uint32 handleTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+            sLog.outString("Map %u (instance %u) object store: %u objects, %u active, %u lookups per Map::Update x %u passes (found %u):",
+                m_map.GetId(), m_map.GetInstanceId(), store.size(), uint32(m_map.GetActiveObjects().size()), uint32(guids.size()), m_passes, found);
+            sLog.outString(" UNORDERED_MAP by guid: %u ms", hashMapTime);
+            sLog.outString(" slot map by guid: %u ms", storeTime);
+            sLog.outString(" slot map by handle: %u ms", handleTime);
+            return true;
+        }
+
+    private:
+        Map& m_map;
+        uint32 m_passes;
+};
+
+bool ChatHandler::HandleDebugMapStoreBenchCommand(char* args)
+{
+    Player* player;
+    if (!ExtractPlayerTarget(&args, &player))
+        return false;
+
+    uint32 passes;
+    if (!ExtractOptUInt32(&args, passes, 1000))
+        return false;
+
+    if (!passes)
+        return false;
+
+    // only map of player waits for lookups, world update continues
+    player->GetMap()->AddEvent(new MapStoreBenchEvent(*player->GetMap(), passes), 0);
+    SendSysMessage("Benchmark started, results will be written to server log.");
+    return true;
+}
+
+bool ChatHandler::HandleDebugDormancyCommand(char* /*args*/)
+{
+    bool enabled = sWorld.getConfig(CONFIG_BOOL_CREATURE_DORMANCY);
+    Map* map = m_session->GetPlayer()->GetMap();
+
+    uint32 alive = 0;
+    uint32 dormant = 0;
+    {
+        ReadGuard Guard(map->GetLock(MAP_LOCK_TYPE_DEFAULT));
+        MapObjectStore const& store = map->GetObjectsStore();
+
+        for (uint32 slot = 0; slot < store.GetSlotCount(); ++slot)
+        {
+            WorldObject* object = store.GetSlotObject(slot);
+            if (!object || object->GetTypeId() != TYPEID_UNIT)
+                continue;
+
+            Creature* creature = (Creature*)object;
+            if (!creature->isAlive())
+                continue;
+
+            ++alive;
+            if (creature->IsDormant())
+                ++dormant;
+        }
+    }
+
+    // map counters at previous command use, counters are shared with other users (load benchmark)
+    typedef std::map<MapID, std::pair<uint32, uint64> > ActiveCellsStatMap;
+    static ActiveCellsStatMap lastStats;
+
+    std::pair<uint32, uint64>& lastStat = lastStats[MapID(map->GetId(), map->GetInstanceId())];
+
+    // map recreated after previous use
+    if (lastStat.first > map->GetActiveCellsUpdateCount())
+        lastStat = std::pair<uint32, uint64>(0, 0);
+
+    uint32 updates = map->GetActiveCellsUpdateCount() - lastStat.first;
+    uint64 updateTime = map->GetActiveCellsUpdateTime() - lastStat.second;
+    lastStat = std::pair<uint32, uint64>(map->GetActiveCellsUpdateCount(), map->GetActiveCellsUpdateTime());
+
+    PSendSysMessage("Creature dormancy %s, map %u: %u of %u alive creatures dormant.",
+        enabled ? "enabled" : "disabled", map->GetId(), dormant, alive);
+    PSendSysMessage("Active cells update since last call: %u updates, average %u us.",
+        updates, updates ? uint32(updateTime / updates) : 0);
+    return true;
+}
+
+bool ChatHandler::HandleDebugLoadBenchCommand(char* args)
+{
+    if (!*args)
+    {
+        static char const* const stateNames[] = { "idle", "waiting bots login", "settling", "running" };
+
+        LoadBenchmarkState state = sLoadBenchmark.GetState();
+        if (state == LOAD_BENCHMARK_STATE_IDLE)
+        {
+            PSendSysMessage("Load benchmark idle, last report: %s",
+                sLoadBenchmark.GetLastReportFile().empty() ? "none" : sLoadBenchmark.GetLastReportFile().c_str());
+            return true;
+        }
+
+        PSendSysMessage("Load benchmark %s: pattern %s, %u of %u bots online, measured %u of %u sec.", stateNames[state],
+            LoadBenchmark::GetPatternName(sLoadBenchmark.GetPattern()), sLoadBenchmark.GetOnlineBotCount(), sLoadBenchmark.GetBotCount(),
+            sLoadBenchmark.GetElapsedTime() / IN_MILLISECONDS, sLoadBenchmark.GetDuration() / IN_MILLISECONDS);
+        return true;
+    }
+
+    if (ExtractLiteralArg(&args, "stop"))
+    {
+        if (sLoadBenchmark.GetState() == LOAD_BENCHMARK_STATE_IDLE)
+        {
+            SendSysMessage("Load benchmark not started.");
+            SetSentErrorMessage(true);
+            return false;
+        }
+
+        sLoadBenchmark.Stop();
+        PSendSysMessage("Load benchmark stopped, report: %s",
+            sLoadBenchmark.GetLastReportFile().empty() ? "none" : sLoadBenchmark.GetLastReportFile().c_str());
+        return true;
+    }
+
+    Player* master;
+    if (!ExtractPlayerTarget(&args, &master))
+        return false;
+
+    char* patternStr = ExtractLiteralArg(&args);
+    LoadBenchmarkPattern pattern;
+    if (!patternStr || !LoadBenchmark::ParsePattern(patternStr, pattern))
+        return false;
+
+    uint32 botCount;
+    if (!ExtractUInt32(&args, botCount))
+        return false;
+
+    uint32 duration;
+    if (!ExtractUInt32(&args, duration))
+        return false;
+
+    uint32 seed;
+    if (!ExtractOptUInt32(&args, seed, 1))
+        return false;
+
+    std::string error;
+    if (!sLoadBenchmark.Start(master, pattern, botCount, duration, seed, error))
+    {
+        PSendSysMessage("Load benchmark not started: %s.", error.c_str());
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PSendSysMessage("Load benchmark started: pattern %s, %u bots of %s, %u sec, seed %u.",
+        LoadBenchmark::GetPatternName(pattern), sLoadBenchmark.GetBotCount(), master->GetName(), duration, seed);
+    return true;
+}
+
+bool ChatHandler::HandleDebugOpcodeStatsCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        sOpcodeStats.Reset();
+        SendSysMessage("Opcode handler statistics reset.");
+        return true;
+    }
+
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 10))
+        return false;
+
+    std::vector<OpcodeStatReport> report;
+    sOpcodeStats.GetTop(report, count);
+
+    if (report.empty())
+    {
+        SendSysMessage("No opcode handler statistics yet.");
+        return true;
+    }
+
+    for (std::vector<OpcodeStatReport>::const_iterator itr = report.begin(); itr != report.end(); ++itr)
+        PSendSysMessage("%s (0x%.4X) %s: calls " UI64FMTD ", total " UI64FMTD " ms, avg " UI64FMTD " us, max %u us",
+            LookupOpcodeName(itr->opcode), itr->opcode, OpcodeStats::GetThreadName(itr->thread), itr->stat.count,
+            itr->stat.totalTime / 1000, itr->stat.totalTime / itr->stat.count, itr->stat.maxTime);
+
+    return true;
+}
@@ -22,6 +22,7 @@
 #include "../Unit.h"
 #include "../GameObject.h"
 #include "../TransportSystem.h"
+#include "../Map.h"
 
 namespace Movement
 {
@@ -109,6 +110,10 @@ namespace Movement
         unit.m_movementInfo.SetMovementFlags((MovementFlags)moveFlags);
         move_spline.Initialize(args);
 
+        // only playerbots at map, nobody to see the move
+        if (unit.GetMap() && !unit.GetMap()->HaveClientPlayers())
+            return move_spline.Duration();
+
         WorldPacket data(SMSG_MONSTER_MOVE, 64);
         data << unit.GetPackGUID();
 
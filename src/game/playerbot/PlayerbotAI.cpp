@@ -965,53 +965,6 @@ void PlayerbotAI::HandleBotOutgoingPacket(const WorldPacket& packet)
             break;
         }
 
-        case SMSG_CAST_FAILED:
-        {
-            WorldPacket p(packet);
-            uint8 castCount;
-            uint32 spellId;
-            uint8 result;
-
-            p >> castCount >> spellId >> result;
-
-            if (result != SPELL_CAST_OK)
-            {
-                switch (result)
-                {
-                    case SPELL_FAILED_INTERRUPTED:
-                        //TellMaster("spell interrupted (%u)",result);
-                        //DEBUG_LOG("spell interrupted (%u)",result);
-                        return;
-
-                    default:
-                        //TellMaster("Spell failed (%u)",result);
-                        //DEBUG_LOG ("[PlayerbotAI]: HandleBotOutgoingPacket - SMSG_CAST_FAIL: %u", result);
-                        return;
-                }
-            }
-            return;
-        }
-
-        case SMSG_SPELL_FAILURE:
-        {
-            WorldPacket p(packet);
-            uint8 castCount;
-            uint32 spellId;
-            ObjectGuid casterGuid;
-
-            p >> casterGuid.ReadAsPacked();
-            if (casterGuid != m_bot->GetObjectGuid())
-                return;
-
-            p >> castCount >> spellId;
-            if (m_CurrentlyCastingSpellId == spellId)
-            {
-                m_ignoreAIUpdatesUntilTime = time(0);
-                m_CurrentlyCastingSpellId = 0;
-            }
-            return;
-        }
-
         // if a change in speed was detected for the master
         // make sure we have the same mount status
         case SMSG_FORCE_RUN_SPEED_CHANGE:
@@ -1153,206 +1106,6 @@ void PlayerbotAI::HandleBotOutgoingPacket(const WorldPacket& packet)
             return;
         }
 
-        // Handle Group invites (auto accept if master is in group, otherwise decline & send message
-        case SMSG_GROUP_INVITE:
-        {
-            if (m_bot->GetGroupInvite())
-            {
-                const Group* const grp = m_bot->GetGroupInvite();
-                if (!grp)
-                    return;
-
-                Player* const inviter = sObjectMgr.GetPlayer(grp->GetLeaderGuid());
-                if (!inviter)
-                    return;
-
-                WorldPacket p;
-                if (!canObeyCommandFrom(*inviter))
-                {
-                    std::string buf = "I can't accept your invite unless you first invite my master ";
-                    buf += GetMaster()->GetName();
-                    buf += ".";
-                    SendWhisper(buf, *inviter);
-                    m_bot->GetSession()->HandleGroupDeclineOpcode(p); // packet not used
-                }
-                else
-                    m_bot->GetSession()->HandleGroupAcceptOpcode(p);  // packet not used
-            }
-            return;
-        }
-
-        // Handle when another player opens the trade window with the bot
-        // also sends list of tradable items bot can trade if bot is allowed to obey commands from
-        case SMSG_TRADE_STATUS:
-        {
-            if (m_bot->GetTrader() == NULL)
-                break;
-
-            WorldPacket p(packet);
-            uint32 status;
-            p >> status;
-            p.resize(4);
-
-            //4 == TRADE_STATUS_TRADE_ACCEPT
-            if (status == 4)
-                m_bot->GetSession()->HandleAcceptTradeOpcode(p);  // packet not used
-
-            //1 == TRADE_STATUS_BEGIN_TRADE
-            else if (status == 1)
-            {
-                m_bot->GetSession()->HandleBeginTradeOpcode(p); // packet not used
-
-                if (!canObeyCommandFrom(*(m_bot->GetTrader())))
-                {
-                    // TODO: Really? What if I give a bot all my junk so it's inventory is full when a nice green/blue/purple comes along?
-                    SendWhisper("I'm not allowed to trade you any of my items, but you are free to give me money or items.", *(m_bot->GetTrader()));
-                    return;
-                }
-
-                // list out items available for trade
-                std::ostringstream out;
-                std::list<std::string> lsItemsTradable;
-                std::list<std::string> lsItemsUntradable;
-
-                // list out items in main backpack
-                for (uint8 slot = INVENTORY_SLOT_ITEM_START; slot < INVENTORY_SLOT_ITEM_END; slot++)
-                {
-                    const Item* const pItem = m_bot->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
-                    if (pItem)
-                    {
-                        MakeItemLink(pItem, out, true);
-                        if (pItem->CanBeTraded())
-                            lsItemsTradable.push_back(out.str());
-                        else
-                            lsItemsUntradable.push_back(out.str());
-                        out.str("");
-                    }
-                }
-
-                // list out items in other removable backpacks
-                for (uint8 bag = INVENTORY_SLOT_BAG_START; bag < INVENTORY_SLOT_BAG_END; ++bag)
-                {
-                    const Bag* const pBag = (Bag *) m_bot->GetItemByPos(INVENTORY_SLOT_BAG_0, bag);
-                    if (pBag)
-                    {
-                        for (uint8 slot = 0; slot < pBag->GetBagSize(); ++slot)
-                        {
-                            const Item* const pItem = m_bot->GetItemByPos(bag, slot);
-                            if (pItem)
-                            {
-                                MakeItemLink(pItem, out, true);
-                                if (pItem->CanBeTraded())
-                                    lsItemsTradable.push_back(out.str());
-                                else
-                                    lsItemsUntradable.push_back(out.str());
-                                out.str("");
-                            }
-                        }
-                    }
-                }
-
-                ChatHandler ch(m_bot->GetTrader());
-                out.str("");
-                out << "Items I have but cannot trade:";
-                uint32 count = 0;
-                for (std::list<std::string>::iterator iter = lsItemsUntradable.begin(); iter != lsItemsUntradable.end(); iter++)
-                {
-                    out << (*iter);
-                    // Why this roundabout way of posting max 20 items per whisper? To keep the list scrollable.
-                    count++;
-                    if (count % 20 == 0)
-                    {
-                        ch.SendSysMessage(out.str().c_str());
-                        out.str("");
-                    }
-                }
-                if (count > 0)
-                    ch.SendSysMessage(out.str().c_str());
-
-                out.str("");
-                out << "I could give you:";
-                count = 0;
-                for (std::list<std::string>::iterator iter = lsItemsTradable.begin(); iter != lsItemsTradable.end(); iter++)
-                {
-                    out << (*iter);
-                    // Why this roundabout way of posting max 20 items per whisper? To keep the list scrollable.
-                    count++;
-                    if (count % 20 == 0)
-                    {
-                        ch.SendSysMessage(out.str().c_str());
-                        out.str("");
-                    }
-                }
-                if (count > 0)
-                    ch.SendSysMessage(out.str().c_str());
-                else
-                    ch.SendSysMessage("I have nothing to give you.");
-
-                // calculate how much money bot has
-                // send bot the message
-                uint32 copper = m_bot->GetMoney();
-                out.str("");
-                out << "I have |cff00ff00" << Cash(copper) << "|r";
-                SendWhisper(out.str(), *(m_bot->GetTrader()));
-            }
-            return;
-        }
-
-        case SMSG_SPELL_START:
-        {
-            WorldPacket p(packet);
-
-            ObjectGuid castItemGuid;
-            p >> castItemGuid.ReadAsPacked();
-            ObjectGuid casterGuid;
-            p >> casterGuid.ReadAsPacked();
-            if (casterGuid != m_bot->GetObjectGuid())
-                return;
-
-            uint8 castCount;
-            p >> castCount;
-            uint32 spellId;
-            p >> spellId;
-            uint32 castFlags;
-            p >> castFlags;
-            uint32 msTime;
-            p >> msTime;
-
-            const SpellEntry* const pSpellInfo = sSpellStore.LookupEntry(spellId);
-            if (!pSpellInfo)
-                return;
-
-            if (pSpellInfo->AuraInterruptFlags & AURA_INTERRUPT_FLAG_NOT_SEATED)
-                return;
-
-            m_ignoreAIUpdatesUntilTime = time(0) + (msTime / 1000) + 1;
-
-            return;
-        }
-
-        case SMSG_SPELL_GO:
-        {
-            WorldPacket p(packet);
-
-            ObjectGuid castItemGuid;
-            p >> castItemGuid.ReadAsPacked();
-            ObjectGuid casterGuid;
-            p >> casterGuid.ReadAsPacked();
-            if (casterGuid != m_bot->GetObjectGuid())
-                return;
-
-            uint8 castCount;
-            p >> castCount;
-            uint32 spellId;
-            p >> spellId;
-            uint32 castFlags;
-            p >> castFlags;
-            uint32 msTime;
-            p >> msTime;
-
-            return;
-        }
-
         // if someone tries to resurrect, then accept
         case SMSG_RESURRECT_REQUEST:
         {
@@ -1587,6 +1340,176 @@ void PlayerbotAI::HandleBotOutgoingPacket(const WorldPacket& packet)
     }
 }
 
+void PlayerbotAI::HandleGroupInvite()
+{
+    // auto accept if master is in group, otherwise decline & send message
+    const Group* const grp = m_bot->GetGroupInvite();
+    if (!grp)
+        return;
+
+    Player* const inviter = sObjectMgr.GetPlayer(grp->GetLeaderGuid());
+    if (!inviter)
+        return;
+
+    WorldPacket p;
+    if (!canObeyCommandFrom(*inviter))
+    {
+        std::string buf = "I can't accept your invite unless you first invite my master ";
+        buf += GetMaster()->GetName();
+        buf += ".";
+        SendWhisper(buf, *inviter);
+        m_bot->GetSession()->HandleGroupDeclineOpcode(p); // packet not used
+    }
+    else
+        m_bot->GetSession()->HandleGroupAcceptOpcode(p);  // packet not used
+}
+
+// Handle when another player opens the trade window with the bot
+// also sends list of tradable items bot can trade if bot is allowed to obey commands from
+void PlayerbotAI::HandleTradeStatus(TradeStatus status)
+{
+    if (m_bot->GetTrader() == NULL)
+        return;
+
+    if (status == TRADE_STATUS_TRADE_ACCEPT)
+    {
+        WorldPacket p(CMSG_ACCEPT_TRADE, 4);
+        p << uint32(0);                                     // amount traded slots, not used
+        m_bot->GetSession()->HandleAcceptTradeOpcode(p);
+        return;
+    }
+
+    if (status != TRADE_STATUS_BEGIN_TRADE)
+        return;
+
+    WorldPacket p;
+    m_bot->GetSession()->HandleBeginTradeOpcode(p); // packet not used
+
+    if (!canObeyCommandFrom(*(m_bot->GetTrader())))
+    {
+        // TODO: Really? What if I give a bot all my junk so it's inventory is full when a nice green/blue/purple comes along?
+        SendWhisper("I'm not allowed to trade you any of my items, but you are free to give me money or items.", *(m_bot->GetTrader()));
+        return;
+    }
+
+    // list out items available for trade
+    std::ostringstream out;
+    std::list<std::string> lsItemsTradable;
+    std::list<std::string> lsItemsUntradable;
+
+    // list out items in main backpack
+    for (uint8 slot = INVENTORY_SLOT_ITEM_START; slot < INVENTORY_SLOT_ITEM_END; slot++)
+    {
+        const Item* const pItem = m_bot->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
+        if (pItem)
+        {
+            MakeItemLink(pItem, out, true);
+            if (pItem->CanBeTraded())
+                lsItemsTradable.push_back(out.str());
+            else
+                lsItemsUntradable.push_back(out.str());
+            out.str("");
+        }
+    }
+
+    // list out items in other removable backpacks
+    for (uint8 bag = INVENTORY_SLOT_BAG_START; bag < INVENTORY_SLOT_BAG_END; ++bag)
+    {
+        const Bag* const pBag = (Bag *) m_bot->GetItemByPos(INVENTORY_SLOT_BAG_0, bag);
+        if (pBag)
+        {
+            for (uint8 slot = 0; slot < pBag->GetBagSize(); ++slot)
+            {
+                const Item* const pItem = m_bot->GetItemByPos(bag, slot);
+                if (pItem)
+                {
+                    MakeItemLink(pItem, out, true);
+                    if (pItem->CanBeTraded())
+                        lsItemsTradable.push_back(out.str());
+                    else
+                        lsItemsUntradable.push_back(out.str());
+                    out.str("");
+                }
+            }
+        }
+    }
+
+    ChatHandler ch(m_bot->GetTrader());
+    out.str("");
+    out << "Items I have but cannot trade:";
+    uint32 count = 0;
+    for (std::list<std::string>::iterator iter = lsItemsUntradable.begin(); iter != lsItemsUntradable.end(); iter++)
+    {
+        out << (*iter);
+        // Why this roundabout way of posting max 20 items per whisper? To keep the list scrollable.
+        count++;
+        if (count % 20 == 0)
+        {
+            ch.SendSysMessage(out.str().c_str());
+            out.str("");
+        }
+    }
+    if (count > 0)
+        ch.SendSysMessage(out.str().c_str());
+
+    out.str("");
+    out << "I could give you:";
+    count = 0;
+    for (std::list<std::string>::iterator iter = lsItemsTradable.begin(); iter != lsItemsTradable.end(); iter++)
+    {
+        out << (*iter);
+        // Why this roundabout way of posting max 20 items per whisper? To keep the list scrollable.
+        count++;
+        if (count % 20 == 0)
+        {
+            ch.SendSysMessage(out.str().c_str());
+            out.str("");
+        }
+    }
+    if (count > 0)
+        ch.SendSysMessage(out.str().c_str());
+    else
+        ch.SendSysMessage("I have nothing to give you.");
+
+    // calculate how much money bot has
+    // send bot the message
+    uint32 copper = m_bot->GetMoney();
+    out.str("");
+    out << "I have |cff00ff00" << Cash(copper) << "|r";
+    SendWhisper(out.str(), *(m_bot->GetTrader()));
+}
+
+void PlayerbotAI::HandleLootStartRoll(ObjectGuid lootedTarget, uint32 itemSlot, uint8 voteMask)
+{
+    // roll is registered in group after start, so vote at next update
+    BotLootRoll roll;
+    roll.lootedTarget = lootedTarget;
+    roll.itemSlot = itemSlot;
+    roll.voteMask = voteMask;
+    m_lootRolls.push_back(roll);
+}
+
+void PlayerbotAI::HandleSpellStart(const SpellEntry* spellInfo, uint32 castTime)
+{
+    if (spellInfo->AuraInterruptFlags & AURA_INTERRUPT_FLAG_NOT_SEATED)
+        return;
+
+    m_ignoreAIUpdatesUntilTime = time(0) + (castTime / 1000) + 1;
+}
+
+void PlayerbotAI::HandleSpellResult(uint32 spellId, SpellCastResult result)
+{
+    if (result == SPELL_CAST_OK)
+        return;
+
+    // failed or interrupted cast, continue AI updates
+    if (m_CurrentlyCastingSpellId == spellId)
+    {
+        m_ignoreAIUpdatesUntilTime = time(0);
+        m_CurrentlyCastingSpellId = 0;
+    }
+}
+
 uint8 PlayerbotAI::GetHealthPercent(const Unit& target) const
 {
     return (static_cast<float> (target.GetHealth()) / target.GetMaxHealth()) * 100;
@@ -3183,6 +3106,35 @@ void PlayerbotAI::UpdateAI(const uint32 /*p_time*/)
     if (m_bot->IsBeingTeleported() || m_bot->GetTrader())
         return;
 
+    // vote for started loot rolls, pass = 0, need = 1, greed = 2, disenchant = 3
+    for (; !m_lootRolls.empty(); m_lootRolls.pop_front())
+    {
+        BotLootRoll const& roll = m_lootRolls.front();
+
+        Group* group = m_bot->GetGroup();
+        if (!group)
+            continue;
+
+        RollVote vote = CanStore() ? RollVote(urand(0, 3)) : ROLL_PASS;
+        if (!(roll.voteMask & (1 << vote)))
+            vote = ROLL_PASS;
+
+        if (!group->CountRollVote(m_bot, roll.lootedTarget, roll.itemSlot, vote))
+            continue;
+
+        switch (vote)
+        {
+            case ROLL_NEED:
+                m_bot->GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_ROLL_NEED, 1);
+                break;
+            case ROLL_GREED:
+                m_bot->GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_ROLL_GREED, 1);
+                break;
+            default:
+                break;
+        }
+    }
+
     time_t currentTime = time(0);
     if (currentTime < m_ignoreAIUpdatesUntilTime)
         return;
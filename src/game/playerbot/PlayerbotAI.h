@@ -192,6 +192,14 @@ public:
     typedef std::list<uint32> BotSpellList;
     typedef std::vector<uint32> BotTaxiNode;
 
+    struct BotLootRoll
+    {
+        ObjectGuid lootedTarget;
+        uint32 itemSlot;
+        uint8 voteMask;               // allowed RollVoteMask
+    };
+    typedef std::list<BotLootRoll> BotLootRollList;
+
     // attacker query used in PlayerbotAI::FindAttacker()
     enum ATTACKERINFOTYPE
     {
@@ -230,6 +238,14 @@ public:
     // For a list of opcodes that can be caught see Opcodes.cpp (SMSG_* opcodes only)
     void HandleBotOutgoingPacket(const WorldPacket& packet);
 
+    // These are called by server code instead of sending the related packets to the bot session,
+    // so events are not serialized into packets only to be parsed back here
+    void HandleGroupInvite();
+    void HandleTradeStatus(TradeStatus status);
+    void HandleLootStartRoll(ObjectGuid lootedTarget, uint32 itemSlot, uint8 voteMask);
+    void HandleSpellStart(const SpellEntry* spellInfo, uint32 castTime);
+    void HandleSpellResult(uint32 spellId, SpellCastResult result);
+
     // This is called by WorldSession.cpp
     // when it detects that a bot is being teleported. It acknowledges to the server to complete the
     // teleportation
@@ -470,6 +486,7 @@ private:
     BotTaskList m_tasks;                // list of tasks
     BotLootTarget m_lootTargets;        // list of targets
     BotSpellList m_spellsToLearn;       // list of spells
+    BotLootRollList m_lootRolls;        // started loot rolls, voted at next UpdateAI
     ObjectGuid m_lootCurrent;           // current remains of interest
     ObjectGuid m_lootPrev;              // previous loot
     BotLootEntry m_collectObjects;      // object entries searched for in findNearbyGO
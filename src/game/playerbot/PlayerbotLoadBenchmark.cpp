@@ -0,0 +1,543 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "PlayerbotLoadBenchmark.h"
+#include "PlayerbotAI.h"
+#include "PlayerbotMgr.h"
+#include "../Player.h"
+#include "../Creature.h"
+#include "../ObjectMgr.h"
+#include "../MapManager.h"
+#include "../World.h"
+#include "Config/Config.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+#include "revision_nr.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(LoadBenchmark);
+
+static char const* const loadBenchmarkPatternNames[MAX_LOAD_BENCHMARK_PATTERN] = { "city", "quest", "bg", "raid" };
+
+LoadBenchmark::LoadBenchmark() : m_state(LOAD_BENCHMARK_STATE_IDLE), m_pattern(LOAD_BENCHMARK_CITY), m_duration(0), m_seed(0),
+    m_onlineAtStart(0), m_timer(0), m_actionTimer(0), m_elapsed(0),
+    m_sessionsTime(0), m_mapsTime(0), m_charDbQueueSum(0), m_charDbQueueMax(0), m_worldDbQueueMax(0), m_loginDbQueueMax(0),
+    m_sentPackets(0), m_sentBytes(0), m_receivedPackets(0), m_receivedBytes(0)
+{
+}
+
+char const* LoadBenchmark::GetPatternName(LoadBenchmarkPattern pattern)
+{
+    return pattern < MAX_LOAD_BENCHMARK_PATTERN ? loadBenchmarkPatternNames[pattern] : "unknown";
+}
+
+bool LoadBenchmark::ParsePattern(char const* name, LoadBenchmarkPattern& pattern)
+{
+    for (uint32 i = 0; i < MAX_LOAD_BENCHMARK_PATTERN; ++i)
+    {
+        if (strcmp(name, loadBenchmarkPatternNames[i]) == 0)
+        {
+            pattern = LoadBenchmarkPattern(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LoadBenchmark::Start(Player* master, LoadBenchmarkPattern pattern, uint32 botCount, uint32 duration, uint32 seed, std::string& error)
+{
+    if (m_state != LOAD_BENCHMARK_STATE_IDLE)
+    {
+        error = "benchmark already started";
+        return false;
+    }
+
+    if (sWorld.getConfig(CONFIG_BOOL_PLAYERBOT_DISABLE))
+    {
+        error = "playerbots are disabled by PlayerbotAI.DisableBots";
+        return false;
+    }
+
+    if (!botCount || !duration || duration > LOAD_BENCHMARK_MAX_DURATION)
+    {
+        error = "wrong bots count or duration";
+        return false;
+    }
+
+    if (pattern == LOAD_BENCHMARK_RAID)
+    {
+        Creature* target = master->GetMap()->GetAnyTypeCreature(master->GetSelectionGuid());
+        if (!target || !target->isTargetableForAttack())
+        {
+            error = "raid pattern requires selected alive creature";
+            return false;
+        }
+        m_targetGuid = target->GetObjectGuid();
+    }
+    else
+        m_targetGuid.Clear();
+
+    // same characters for same bots count
+    QueryResult* result = CharacterDatabase.PQuery("SELECT guid FROM characters WHERE online = 0 AND guid <> '%u' ORDER BY guid LIMIT %u",
+        master->GetGUIDLow(), botCount);
+    if (!result)
+    {
+        error = "no offline characters";
+        return false;
+    }
+
+    PlayerbotMgr* mgr = master->GetPlayerbotMgr();
+    if (!mgr)
+    {
+        mgr = new PlayerbotMgr(master);
+        master->SetPlayerbotMgr(mgr);
+    }
+
+    m_botGuids.clear();
+    do
+    {
+        ObjectGuid guid = ObjectGuid(HIGHGUID_PLAYER, (*result)[0].GetUInt32());
+        m_botGuids.push_back(guid);
+
+        CharacterDatabase.PExecute("UPDATE characters SET online = 1 WHERE guid = '%u'", guid.GetCounter());
+        mgr->AddPlayerBot(guid);
+        ++mgr->m_botCount;
+    }
+    while (result->NextRow());
+    delete result;
+
+    m_masterGuid = master->GetObjectGuid();
+    m_pattern = pattern;
+    m_duration = duration * IN_MILLISECONDS;
+    m_seed = seed;
+    m_elapsed = 0;
+    m_onlineAtStart = 0;
+    m_timer = LOAD_BENCHMARK_LOGIN_TIMEOUT;
+    m_state = LOAD_BENCHMARK_STATE_LOGIN;
+
+    sLog.outString("LoadBenchmark: started pattern %s with %u bots for %u sec, seed %u, by %s",
+        GetPatternName(pattern), uint32(m_botGuids.size()), duration, seed, master->GetGuidStr().c_str());
+    return true;
+}
+
+void LoadBenchmark::Stop()
+{
+    if (m_state != LOAD_BENCHMARK_STATE_IDLE)
+        Finish("stopped");
+}
+
+Player* LoadBenchmark::GetMaster() const
+{
+    Player* master = sObjectMgr.GetPlayer(m_masterGuid);
+    return master && master->GetPlayerbotMgr() ? master : NULL;
+}
+
+Player* LoadBenchmark::GetBot(uint32 index) const
+{
+    // character can be logged in by real player after bot logout
+    Player* bot = sObjectMgr.GetPlayer(m_botGuids[index]);
+    return bot && bot->IsInWorld() && bot->GetPlayerbotAI() ? bot : NULL;
+}
+
+uint32 LoadBenchmark::GetOnlineBotCount() const
+{
+    uint32 count = 0;
+    for (uint32 i = 0; i < m_botGuids.size(); ++i)
+        if (GetBot(i))
+            ++count;
+
+    return count;
+}
+
+void LoadBenchmark::Update(uint32 diff, uint32 sessionsTime, uint32 mapsTime, uint32 worldTime)
+{
+    if (m_state == LOAD_BENCHMARK_STATE_IDLE)
+        return;
+
+    // bots are logged out with master
+    Player* master = GetMaster();
+    if (!master)
+    {
+        Finish("master logged out");
+        return;
+    }
+
+    switch (m_state)
+    {
+        case LOAD_BENCHMARK_STATE_LOGIN:
+        {
+            // benchmark must not change characters used as bots
+            for (uint32 i = 0; i < m_botGuids.size(); ++i)
+                if (Player* bot = GetBot(i))
+                    bot->SetSaveDisabled(true);
+
+            if (m_timer > diff && GetOnlineBotCount() < m_botGuids.size())
+            {
+                m_timer -= diff;
+                return;
+            }
+
+            PlaceBots(master);
+            m_timer = LOAD_BENCHMARK_SETTLE_TIME;
+            m_state = LOAD_BENCHMARK_STATE_SETTLE;
+            break;
+        }
+        case LOAD_BENCHMARK_STATE_SETTLE:
+        {
+            if (m_timer > diff)
+            {
+                m_timer -= diff;
+                return;
+            }
+
+            ResetStatistic();
+            m_onlineAtStart = GetOnlineBotCount();
+            m_actionTimer = 0;
+            m_state = LOAD_BENCHMARK_STATE_RUNNING;
+            break;
+        }
+        case LOAD_BENCHMARK_STATE_RUNNING:
+        {
+            m_elapsed += diff;
+            m_tickTimes.push_back(diff);
+            m_worldTimes.push_back(worldTime);
+            m_sessionsTime += sessionsTime;
+            m_mapsTime += mapsTime;
+
+            uint32 queueSize = CharacterDatabase.GetAsyncQueueSize();
+            m_charDbQueueSum += queueSize;
+            m_charDbQueueMax = std::max(m_charDbQueueMax, queueSize);
+            m_worldDbQueueMax = std::max(m_worldDbQueueMax, WorldDatabase.GetAsyncQueueSize());
+            m_loginDbQueueMax = std::max(m_loginDbQueueMax, LoginDatabase.GetAsyncQueueSize());
+
+            if (m_actionTimer <= diff)
+            {
+                DriveBots(master);
+                m_actionTimer = LOAD_BENCHMARK_ACTION_TIME;
+            }
+            else
+                m_actionTimer -= diff;
+
+            if (m_elapsed >= m_duration)
+                Finish("completed");
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void LoadBenchmark::PlaceBots(Player* master)
+{
+    m_rand.seed(m_seed);
+
+    Creature* target = m_pattern == LOAD_BENCHMARK_RAID ? master->GetMap()->GetAnyTypeCreature(m_targetGuid) : NULL;
+    WorldObject* center = target ? (WorldObject*)target : (WorldObject*)master;
+
+    uint32 healers = 0;
+    for (uint32 i = 0; i < m_botGuids.size(); ++i)
+    {
+        // random values are taken for all bots, so positions not depend from failed logins
+        float dist = m_rand.rand();
+        float angle = m_rand.rand(2 * M_PI_F);
+
+        switch (m_pattern)
+        {
+            case LOAD_BENCHMARK_CITY:
+                dist = 5.0f + dist * 25.0f;
+                break;
+            case LOAD_BENCHMARK_QUEST:
+                dist = 20.0f + dist * 180.0f;
+                break;
+            case LOAD_BENCHMARK_BATTLEGROUND:
+            {
+                // camps 40 yards before and behind master
+                float campAngle = master->GetOrientation() + (i % 2 ? M_PI_F : 0.0f);
+                float dx = 40.0f * cos(campAngle) + dist * 15.0f * cos(angle);
+                float dy = 40.0f * sin(campAngle) + dist * 15.0f * sin(angle);
+                dist = sqrt(dx * dx + dy * dy);
+                angle = atan2(dy, dx);
+                break;
+            }
+            case LOAD_BENCHMARK_RAID:
+                dist = 5.0f + dist * 10.0f;
+                break;
+            default:
+                break;
+        }
+
+        Player* bot = GetBot(i);
+        if (!bot)
+            continue;
+
+        if (!bot->isAlive())
+        {
+            bot->ResurrectPlayer(1.0f);
+            bot->SpawnCorpseBones();
+        }
+
+        PlayerbotAI* ai = bot->GetPlayerbotAI();
+        ai->SetMovementOrder(PlayerbotAI::MOVEMENT_STAY);
+
+        switch (m_pattern)
+        {
+            case LOAD_BENCHMARK_BATTLEGROUND:
+                bot->SetFFAPvP(true);
+                break;
+            case LOAD_BENCHMARK_RAID:
+            {
+                uint8 botClass = bot->getClass();
+                bool canHeal = botClass == CLASS_PRIEST || botClass == CLASS_DRUID || botClass == CLASS_PALADIN || botClass == CLASS_SHAMAN;
+
+                // one tank, up to fifth of raid healers, others assist master
+                if (i == 0)
+                    ai->SetCombatOrder(PlayerbotAI::ORDERS_TANK);
+                else if (canHeal && healers * 5 < m_botGuids.size())
+                {
+                    ai->SetCombatOrder(PlayerbotAI::ORDERS_HEAL);
+                    ++healers;
+                }
+                else
+                    ai->SetCombatOrder(PlayerbotAI::ORDERS_ASSIST, master);
+                break;
+            }
+            default:
+                break;
+        }
+
+        float x, y, z;
+        center->GetNearPoint(bot, x, y, z, bot->GetObjectBoundingRadius(), dist, angle);
+
+        float orientation = atan2(center->GetPositionY() - y, center->GetPositionX() - x);
+        if (orientation < 0.0f)
+            orientation += 2 * M_PI_F;
+
+        bot->TeleportTo(center->GetMapId(), x, y, z, orientation);
+    }
+}
+
+void LoadBenchmark::DriveBots(Player* master)
+{
+    Creature* target = NULL;
+    if (m_pattern == LOAD_BENCHMARK_RAID)
+    {
+        // keep raid fighting for all duration
+        target = master->GetMap()->GetAnyTypeCreature(m_targetGuid);
+        if (target && !target->isAlive())
+        {
+            target->Respawn();
+            target = NULL;
+        }
+    }
+
+    uint32 count = m_botGuids.size();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint32 roll = m_rand.randInt(99);
+        float angle = m_rand.rand(2 * M_PI_F);
+
+        Player* bot = GetBot(i);
+        if (!bot || bot->IsBeingTeleported())
+            continue;
+
+        if (!bot->isAlive())
+        {
+            bot->ResurrectPlayer(1.0f);
+            bot->SpawnCorpseBones();
+            continue;
+        }
+
+        PlayerbotAI* ai = bot->GetPlayerbotAI();
+
+        switch (m_pattern)
+        {
+            case LOAD_BENCHMARK_QUEST:
+            {
+                if (roll >= 30 || bot->isInCombat())
+                    break;
+
+                float x, y, z;
+                bot->GetNearPoint(bot, x, y, z, bot->GetObjectBoundingRadius(), 5.0f + roll, angle);
+                bot->GetMotionMaster()->MovePoint(0, x, y, z);
+                break;
+            }
+            case LOAD_BENCHMARK_BATTLEGROUND:
+            {
+                if (bot->isInCombat() || count < 2)
+                    break;
+
+                // random bot of other camp
+                uint32 enemyIndex = (roll % ((count + 1) / 2)) * 2 + (1 - i % 2);
+                if (enemyIndex >= count)
+                    break;
+
+                Player* enemy = GetBot(enemyIndex);
+                if (enemy && enemy->isAlive() && !enemy->IsBeingTeleported())
+                    ai->GetCombatTarget(enemy);
+                break;
+            }
+            case LOAD_BENCHMARK_RAID:
+            {
+                if (target && !(ai->GetCombatOrder() & PlayerbotAI::ORDERS_HEAL) && !ai->GetCurrentTarget())
+                    ai->GetCombatTarget(target);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+void LoadBenchmark::ResetStatistic()
+{
+    m_elapsed = 0;
+    m_tickTimes.clear();
+    m_worldTimes.clear();
+    m_sessionsTime = 0;
+    m_mapsTime = 0;
+    m_charDbQueueSum = 0;
+    m_charDbQueueMax = 0;
+    m_worldDbQueueMax = 0;
+    m_loginDbQueueMax = 0;
+    m_sentPackets = 0;
+    m_sentBytes = 0;
+    m_receivedPackets = 0;
+    m_receivedBytes = 0;
+
+    // map counters are shared with other users, measured part is difference to these values
+    m_activeCellsAtStart.clear();
+    MapManager::MapMapType const& maps = sMapMgr.Maps();
+    for (MapManager::MapMapType::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+        m_activeCellsAtStart[std::make_pair(itr->first.GetId(), itr->first.GetInstanceId())] = std::pair<uint32, uint64>(itr->second->GetActiveCellsUpdateCount(), itr->second->GetActiveCellsUpdateTime());
+}
+
+void LoadBenchmark::Finish(char const* reason)
+{
+    if (m_state == LOAD_BENCHMARK_STATE_RUNNING)
+        WriteReport(reason);
+    else
+        sLog.outString("LoadBenchmark: %s before measure start, no report", reason);
+
+    m_state = LOAD_BENCHMARK_STATE_IDLE;
+
+    Player* master = GetMaster();
+    PlayerbotMgr* mgr = master ? master->GetPlayerbotMgr() : NULL;
+
+    for (std::vector<ObjectGuid>::const_iterator itr = m_botGuids.begin(); itr != m_botGuids.end(); ++itr)
+    {
+        if (mgr)
+        {
+            if (mgr->GetPlayerBot(*itr))
+                mgr->LogoutPlayerBot(*itr);
+            --mgr->m_botCount;
+        }
+
+        CharacterDatabase.PExecute("UPDATE characters SET online = 0 WHERE guid = '%u'", itr->GetCounter());
+    }
+
+    m_botGuids.clear();
+}
+
+// percent-th value of sorted values
+static uint32 GetPercentile(std::vector<uint32> const& values, uint32 percent)
+{
+    if (values.empty())
+        return 0;
+
+    return values[(values.size() - 1) * percent / 100];
+}
+
+static void WriteDistribution(FILE* file, char const* name, std::vector<uint32>& values)
+{
+    std::sort(values.begin(), values.end());
+
+    uint64 sum = 0;
+    for (std::vector<uint32>::const_iterator itr = values.begin(); itr != values.end(); ++itr)
+        sum += *itr;
+
+    fprintf(file, "  \"%s\": { \"count\": %u, \"avg\": %.2f, \"p50\": %u, \"p90\": %u, \"p99\": %u, \"max\": %u },\n",
+        name, uint32(values.size()), values.empty() ? 0.0 : double(sum) / values.size(),
+        GetPercentile(values, 50), GetPercentile(values, 90), GetPercentile(values, 99), values.empty() ? 0 : values.back());
+}
+
+void LoadBenchmark::WriteReport(char const* reason)
+{
+    uint64 activeCellsTime = 0;
+    uint32 activeCellsUpdates = 0;
+    MapManager::MapMapType const& maps = sMapMgr.Maps();
+    for (MapManager::MapMapType::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+    {
+        activeCellsTime += itr->second->GetActiveCellsUpdateTime();
+        activeCellsUpdates += itr->second->GetActiveCellsUpdateCount();
+
+        // maps created during measure counted from 0
+        ActiveCellsStatMap::const_iterator start = m_activeCellsAtStart.find(std::make_pair(itr->first.GetId(), itr->first.GetInstanceId()));
+        if (start != m_activeCellsAtStart.end() && start->second.first <= itr->second->GetActiveCellsUpdateCount())
+        {
+            activeCellsUpdates -= start->second.first;
+            activeCellsTime -= start->second.second;
+        }
+    }
+
+    uint32 ticks = m_tickTimes.size();
+    double seconds = m_elapsed ? m_elapsed / 1000.0 : 1.0;
+
+    std::string logsDir = sConfig.GetStringDefault("LogsDir", "");
+    if (!logsDir.empty() && logsDir[logsDir.length() - 1] != '/' && logsDir[logsDir.length() - 1] != '\\')
+        logsDir.append("/");
+
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "loadbench_%s_%u_%u.json", GetPatternName(m_pattern), m_seed, uint32(time(NULL)));
+    m_lastReportFile = logsDir + fileName;
+
+    FILE* file = fopen(m_lastReportFile.c_str(), "w");
+    if (!file)
+    {
+        sLog.outError("LoadBenchmark: can't create report file %s", m_lastReportFile.c_str());
+        return;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"revision\": \"%s\",\n", REVISION_NR);
+    fprintf(file, "  \"pattern\": \"%s\",\n", GetPatternName(m_pattern));
+    fprintf(file, "  \"seed\": %u,\n", m_seed);
+    fprintf(file, "  \"bots\": %u,\n", uint32(m_botGuids.size()));
+    fprintf(file, "  \"bots_online\": %u,\n", m_onlineAtStart);
+    fprintf(file, "  \"duration_ms\": %u,\n", m_elapsed);
+    fprintf(file, "  \"result\": \"%s\",\n", reason);
+    WriteDistribution(file, "tick_ms", m_tickTimes);
+    WriteDistribution(file, "world_update_ms", m_worldTimes);
+    fprintf(file, "  \"phases_avg_ms\": { \"sessions\": %.2f, \"maps\": %.2f, \"active_cells\": %.3f },\n",
+        ticks ? double(m_sessionsTime) / ticks : 0.0, ticks ? double(m_mapsTime) / ticks : 0.0,
+        activeCellsUpdates ? double(activeCellsTime) / 1000.0 / ticks : 0.0);
+    fprintf(file, "  \"packets_per_sec\": { \"sent\": %.1f, \"received\": %.1f },\n",
+        double(m_sentPackets.value()) / seconds, double(m_receivedPackets.value()) / seconds);
+    fprintf(file, "  \"bytes_per_sec\": { \"sent\": %.1f, \"received\": %.1f },\n",
+        double(m_sentBytes.value()) / seconds, double(m_receivedBytes.value()) / seconds);
+    fprintf(file, "  \"char_db_queue\": { \"avg\": %.2f, \"max\": %u },\n",
+        ticks ? double(m_charDbQueueSum) / ticks : 0.0, m_charDbQueueMax);
+    fprintf(file, "  \"world_db_queue_max\": %u,\n", m_worldDbQueueMax);
+    fprintf(file, "  \"login_db_queue_max\": %u\n", m_loginDbQueueMax);
+    fprintf(file, "}\n");
+    fclose(file);
+
+    sLog.outString("LoadBenchmark: %s, %u ticks, tick p50 %u ms p99 %u ms, report %s",
+        reason, ticks, GetPercentile(m_tickTimes, 50), GetPercentile(m_tickTimes, 99), m_lastReportFile.c_str());
+}
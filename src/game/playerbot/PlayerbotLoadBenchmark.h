@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MANGOS_PLAYERBOT_LOAD_BENCHMARK_H
+#define MANGOS_PLAYERBOT_LOAD_BENCHMARK_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "Policies/Singleton.h"
+#include "mersennetwister/MersenneTwister.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+
+#include <vector>
+#include <map>
+
+class Player;
+
+enum LoadBenchmarkPattern
+{
+    LOAD_BENCHMARK_CITY         = 0,                        // bots idle around master
+    LOAD_BENCHMARK_QUEST        = 1,                        // bots spread in zone, random short moves
+    LOAD_BENCHMARK_BATTLEGROUND = 2,                        // two FFA PvP camps fighting each other
+    LOAD_BENCHMARK_RAID         = 3,                        // bots in raid roles around master's target
+    MAX_LOAD_BENCHMARK_PATTERN
+};
+
+enum LoadBenchmarkState
+{
+    LOAD_BENCHMARK_STATE_IDLE,
+    LOAD_BENCHMARK_STATE_LOGIN,                             // waiting bots login
+    LOAD_BENCHMARK_STATE_SETTLE,                            // bots placed, waiting teleports and first updates
+    LOAD_BENCHMARK_STATE_RUNNING                            // measured part
+};
+
+#define LOAD_BENCHMARK_LOGIN_TIMEOUT    (60 * IN_MILLISECONDS)
+#define LOAD_BENCHMARK_SETTLE_TIME      (10 * IN_MILLISECONDS)
+#define LOAD_BENCHMARK_ACTION_TIME      (5 * IN_MILLISECONDS)  // period of scripted bot actions
+#define LOAD_BENCHMARK_MAX_DURATION     3600                // (secs)
+
+/**
+ * Synthetic load generator for comparable benchmarks of server builds.
+ *
+ * Logs in offline characters (ordered by guid) as playerbots of the master player, places them by the
+ * pattern around the master and drives them by script with own random generator initialized by the given
+ * seed, so same characters, pattern and seed give same bot actions. After settle time the world ticks,
+ * update phases, packets and DB queues are measured for the given duration, then bots are logged out
+ * and a JSON report is written to LogsDir. Saves of bot characters are disabled, so their DB state is
+ * same before and after benchmark.
+ */
+class LoadBenchmark
+{
+    public:
+        LoadBenchmark();
+
+        // world thread
+        bool Start(Player* master, LoadBenchmarkPattern pattern, uint32 botCount, uint32 duration, uint32 seed, std::string& error);
+        void Stop();                                        // finish early, report measured part
+        void Update(uint32 diff, uint32 sessionsTime, uint32 mapsTime, uint32 worldTime);
+
+        LoadBenchmarkState GetState() const { return m_state; }
+        LoadBenchmarkPattern GetPattern() const { return m_pattern; }
+        uint32 GetBotCount() const { return m_botGuids.size(); }
+        uint32 GetOnlineBotCount() const;
+        uint32 GetElapsedTime() const { return m_elapsed; }
+        uint32 GetDuration() const { return m_duration; }
+        std::string const& GetLastReportFile() const { return m_lastReportFile; }
+
+        // any thread, counted only while measured
+        void CountSentPacket(uint32 size)
+        {
+            if (m_state == LOAD_BENCHMARK_STATE_RUNNING)
+            {
+                ++m_sentPackets;
+                m_sentBytes += size;
+            }
+        }
+
+        void CountReceivedPacket(uint32 size)
+        {
+            if (m_state == LOAD_BENCHMARK_STATE_RUNNING)
+            {
+                ++m_receivedPackets;
+                m_receivedBytes += size;
+            }
+        }
+
+        static char const* GetPatternName(LoadBenchmarkPattern pattern);
+        static bool ParsePattern(char const* name, LoadBenchmarkPattern& pattern);
+
+    private:
+        Player* GetMaster() const;
+        Player* GetBot(uint32 index) const;
+
+        void PlaceBots(Player* master);
+        void DriveBots(Player* master);
+        void ResetStatistic();
+        void Finish(char const* reason);
+        void WriteReport(char const* reason);
+
+        LoadBenchmarkState m_state;
+        LoadBenchmarkPattern m_pattern;
+        uint32 m_duration;                                  // (msecs) measured part
+        uint32 m_seed;
+        MTRand m_rand;
+
+        ObjectGuid m_masterGuid;
+        ObjectGuid m_targetGuid;                            // raid pattern target
+        std::vector<ObjectGuid> m_botGuids;
+        uint32 m_onlineAtStart;
+
+        uint32 m_timer;                                     // state timeout or time left
+        uint32 m_actionTimer;
+        uint32 m_elapsed;                                   // (msecs) of measured part
+
+        // statistic of measured part
+        std::vector<uint32> m_tickTimes;                    // world loop diffs
+        std::vector<uint32> m_worldTimes;                   // World::Update times
+        uint64 m_sessionsTime;
+        uint64 m_mapsTime;
+        uint64 m_charDbQueueSum;
+        uint32 m_charDbQueueMax;
+        uint32 m_worldDbQueueMax;
+        uint32 m_loginDbQueueMax;
+
+        // active cells update count and time of maps (by map and instance id) at measure start
+        typedef std::map<std::pair<uint32, uint32>, std::pair<uint32, uint64> > ActiveCellsStatMap;
+        ActiveCellsStatMap m_activeCellsAtStart;
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_sentPackets;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_sentBytes;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_receivedPackets;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_receivedBytes;
+
+        std::string m_lastReportFile;
+};
+
+#define sLoadBenchmark MaNGOS::Singleton<LoadBenchmark>::Instance()
+
+#endif
@@ -551,49 +551,6 @@ void PlayerbotMgr::HandleMasterIncomingPacket(const WorldPacket& packet)
             return;
         }
 
-        case CMSG_LOOT_ROLL:
-        {
-
-            WorldPacket p(packet);    //WorldPacket packet for CMSG_LOOT_ROLL, (8+4+1)
-            ObjectGuid Guid;
-            uint32 NumberOfPlayers;
-            uint8 rollType;
-            p.rpos(0);    //reset packet pointer
-            p >> Guid;    //guid of the item rolled
-            p >> NumberOfPlayers;    //number of players invited to roll
-            p >> rollType;    //need,greed or pass on roll
-
-            for (PlayerBotMap::const_iterator it = GetPlayerBotsBegin(); it != GetPlayerBotsEnd(); ++it)
-            {
-
-                uint32 choice;
-
-                Player* const bot = it->second;
-                if (!bot)
-                    return;
-
-                Group* group = bot->GetGroup();
-                if (!group)
-                    return;
-
-                (bot->GetPlayerbotAI()->CanStore()) ? choice = urand(0, 3) : choice = 0;  // pass = 0, need = 1, greed = 2, disenchant = 3
-
-                group->CountRollVote(bot, Guid, NumberOfPlayers, RollVote(choice));
-
-                switch (choice)
-                {
-                    case ROLL_NEED:
-                        bot->GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_ROLL_NEED, 1);
-                        break;
-                    case ROLL_GREED:
-                        bot->GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_ROLL_GREED, 1);
-                        break;
-                    default:
-                        break;
-                }
-            }
-            return;
-        }
         // Handle GOSSIP activate actions, prior to GOSSIP select menu actions
         case CMSG_GOSSIP_HELLO:
         {
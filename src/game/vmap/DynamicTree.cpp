@@ -59,7 +59,8 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
 
     DynTreeImpl() :
         rebalance_timer(CHECK_TREE_PERIOD),
-        unbalanced_times(0)
+        unbalanced_times(0),
+        generation(0)
     {
     }
 
@@ -67,18 +68,22 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
     {
         base::insert(mdl);
         ++unbalanced_times;
+        ++generation;
     }
 
     void remove(const Model& mdl)
     {
         base::remove(mdl);
         ++unbalanced_times;
+        ++generation;
     }
 
     void balance()
     {
         base::balance();
         unbalanced_times = 0;
+        // inserted/removed models are visible for queries only after rebuild
+        ++generation;
     }
 
     void update(uint32 difftime)
@@ -97,6 +102,7 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
 
     ShortTimeTracker rebalance_timer;
     int unbalanced_times;
+    uint32 generation;
 };
 
 DynamicMapTree::DynamicMapTree() : impl(*new DynTreeImpl())
@@ -138,6 +144,16 @@ void DynamicMapTree::update(uint32 t_diff)
     impl.update(t_diff);
 }
 
+void DynamicMapTree::onModelStateChanged(const GameObjectModel& /*mdl*/)
+{
+    ++impl.generation;
+}
+
+uint32 DynamicMapTree::getGeneration() const
+{
+    return impl.generation;
+}
+
 struct DynamicTreeIntersectionCallback
 {
     bool did_hit;
@@ -47,6 +47,11 @@ public:
 
     void balance();
     void update(uint32 diff);
+
+    // notify about collision state change of already inserted model
+    void onModelStateChanged(const GameObjectModel&);
+    // changed each time when results of queries to tree may be changed
+    uint32 getGeneration() const;
 private:
     struct DynTreeImpl& impl;
 };
@@ -47,9 +47,11 @@ namespace VMAP
         private:
             bool iEnableLineOfSightCalc;
             bool iEnableHeightCalc;
+            float iLineOfSightCacheGrid;
+            uint32 iLineOfSightCacheLifeTime;
 
         public:
-            IVMapManager() : iEnableLineOfSightCalc(true), iEnableHeightCalc(true) {}
+            IVMapManager() : iEnableLineOfSightCalc(true), iEnableHeightCalc(true), iLineOfSightCacheGrid(0.5f), iLineOfSightCacheLifeTime(1000) {}
 
             virtual ~IVMapManager(void) {}
 
@@ -83,9 +85,17 @@ namespace VMAP
             */
             void setEnableHeightCalc(bool pVal) { iEnableHeightCalc = pVal; }
 
+            /**
+            Line of sight cache of maps: grid size of cached positions (0 disables cache) and life time of unused results in ms.
+            Used by maps created after the call.
+            */
+            void setLineOfSightCacheSettings(float pGridSize, uint32 pLifeTime) { iLineOfSightCacheGrid = pGridSize; iLineOfSightCacheLifeTime = pLifeTime; }
+
             bool isLineOfSightCalcEnabled() const { return iEnableLineOfSightCalc; }
             bool isHeightCalcEnabled() const { return iEnableHeightCalc; }
             bool isMapLoadingEnabled() const { return iEnableLineOfSightCalc || iEnableHeightCalc; }
+            float getLineOfSightCacheGrid() const { return iLineOfSightCacheGrid; }
+            uint32 getLineOfSightCacheLifeTime() const { return iLineOfSightCacheLifeTime; }
 
             virtual std::string getDirFileName(unsigned int pMapId, int x, int y) const = 0;
             /**
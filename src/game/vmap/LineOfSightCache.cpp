@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LineOfSightCache.h"
+#include "VMapFactory.h"
+
+#include <cmath>
+
+LineOfSightCache::LineOfSightCache() :
+    m_gridSize(VMAP::VMapFactory::createOrGetVMapManager()->getLineOfSightCacheGrid()),
+    m_lifeTime(VMAP::VMapFactory::createOrGetVMapManager()->getLineOfSightCacheLifeTime()),
+    m_rotateTimer(0), m_dynTreeGeneration(0)
+{
+}
+
+bool LineOfSightCache::Key::operator == (Key const& other) const
+{
+    for (int i = 0; i < 6; ++i)
+        if (coords[i] != other.coords[i])
+            return false;
+    return phasemask == other.phasemask;
+}
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const
+{
+    Key key;
+    key.coords[0] = int32(floor(x1 / m_gridSize));
+    key.coords[1] = int32(floor(y1 / m_gridSize));
+    key.coords[2] = int32(floor(z1 / m_gridSize));
+    key.coords[3] = int32(floor(x2 / m_gridSize));
+    key.coords[4] = int32(floor(y2 / m_gridSize));
+    key.coords[5] = int32(floor(z2 / m_gridSize));
+    key.phasemask = phasemask;
+    return key;
+}
+
+uint64 LineOfSightCache::HashKey(Key const& key)
+{
+    // FNV-1a over quantised coords and phasemask, full key compared on lookup
+    uint64 hash = UI64LIT(14695981039346656037);
+    for (int i = 0; i < 6; ++i)
+    {
+        hash ^= uint32(key.coords[i]);
+        hash *= UI64LIT(1099511628211);
+    }
+    hash ^= key.phasemask;
+    hash *= UI64LIT(1099511628211);
+    return hash;
+}
+
+void LineOfSightCache::CheckGeneration(uint32 dynTreeGeneration)
+{
+    if (m_dynTreeGeneration == dynTreeGeneration)
+        return;
+
+    m_dynTreeGeneration = dynTreeGeneration;
+
+    if (m_current.empty() && m_previous.empty())
+        return;
+
+    m_current.clear();
+    m_previous.clear();
+    ++m_stat.invalidations;
+}
+
+bool LineOfSightCache::Lookup(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 dynTreeGeneration, bool& inLOS)
+{
+    if (!IsEnabled())
+        return false;
+
+    Key key = MakeKey(x1, y1, z1, x2, y2, z2, phasemask);
+    uint64 hash = HashKey(key);
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    CheckGeneration(dynTreeGeneration);
+
+    EntryMap::const_iterator itr = m_current.find(hash);
+    if (itr != m_current.end() && itr->second.key == key)
+    {
+        inLOS = itr->second.inLOS;
+        ++m_stat.hits;
+        return true;
+    }
+
+    itr = m_previous.find(hash);
+    if (itr != m_previous.end() && itr->second.key == key)
+    {
+        inLOS = itr->second.inLOS;
+        ++m_stat.hits;
+
+        // still in use - keep it for next generation
+        if (m_current.size() < LOS_CACHE_MAX_ENTRIES)
+            m_current[hash] = itr->second;
+
+        return true;
+    }
+
+    ++m_stat.misses;
+    return false;
+}
+
+void LineOfSightCache::Store(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 dynTreeGeneration, bool inLOS)
+{
+    if (!IsEnabled())
+        return;
+
+    Entry entry;
+    entry.key = MakeKey(x1, y1, z1, x2, y2, z2, phasemask);
+    entry.inLOS = inLOS;
+    uint64 hash = HashKey(entry.key);
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    CheckGeneration(dynTreeGeneration);
+
+    if (m_current.size() >= LOS_CACHE_MAX_ENTRIES)
+        Rotate();
+
+    m_current[hash] = entry;
+}
+
+void LineOfSightCache::Rotate()
+{
+    m_stat.expirations += m_previous.size();
+    m_previous.swap(m_current);
+    m_current.clear();
+    m_rotateTimer = 0;
+}
+
+void LineOfSightCache::Update(uint32 diff)
+{
+    if (!IsEnabled())
+        return;
+
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    m_rotateTimer += diff;
+    if (m_rotateTimer >= m_lifeTime)
+        Rotate();
+}
+
+void LineOfSightCache::Clear()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    m_current.clear();
+    m_previous.clear();
+    m_rotateTimer = 0;
+}
+
+LineOfSightCacheStatistic LineOfSightCache::GetStatistic() const
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    LineOfSightCacheStatistic stat = m_stat;
+    stat.entries = m_current.size() + m_previous.size();
+    stat.gridSize = m_gridSize;
+    return stat;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LINE_OF_SIGHT_CACHE_H
+#define LINE_OF_SIGHT_CACHE_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+#include "Utilities/UnorderedMapSet.h"
+#include <ace/Thread_Mutex.h>
+
+// Hard limit for entries stored in one generation; generations rotated early when reached
+#define LOS_CACHE_MAX_ENTRIES  65536
+
+struct LineOfSightCacheStatistic
+{
+    LineOfSightCacheStatistic() : hits(0), misses(0), invalidations(0), expirations(0), entries(0), gridSize(0.0f) {}
+
+    float GetHitRate() const { return (hits + misses) ? float(hits) * 100.0f / float(hits + misses) : 0.0f; }
+
+    uint64 hits;
+    uint64 misses;
+    uint32 invalidations;
+    uint32 expirations;
+    uint32 entries;
+    float gridSize;
+};
+
+/**
+ * Per-map cache of line of sight results.
+ *
+ * Query endpoints are quantised to a grid (vmap.LOSCache.Grid) and, together with the phasemask,
+ * used as key. Static geometry never changes, so stored results stay valid until the map's
+ * DynamicMapTree reports a change (GameObjectModel inserted, removed or toggled) - then whole
+ * cache is dropped. Entries are aged out by two rotating generations: lookup promotes entries
+ * from previous generation, each rotation drops entries not used since previous rotation.
+ */
+class MANGOS_DLL_SPEC LineOfSightCache
+{
+    public:
+        LineOfSightCache();
+
+        // returns true if result found in cache, result stored in 'inLOS'
+        bool Lookup(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 dynTreeGeneration, bool& inLOS);
+        void Store(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, uint32 dynTreeGeneration, bool inLOS);
+
+        // called every map tick - age out unused entries
+        void Update(uint32 diff);
+        void Clear();
+
+        bool IsEnabled() const { return m_gridSize > 0.0f; }
+        LineOfSightCacheStatistic GetStatistic() const;
+
+    private:
+        struct Key
+        {
+            int32 coords[6];
+            uint32 phasemask;
+
+            bool operator == (Key const& other) const;
+        };
+
+        struct Entry
+        {
+            Key key;
+            bool inLOS;
+        };
+
+        typedef UNORDERED_MAP<uint64, Entry> EntryMap;
+
+        Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
+        static uint64 HashKey(Key const& key);
+
+        // drop all entries if dynamic tree was changed after they were stored, lock must be held
+        void CheckGeneration(uint32 dynTreeGeneration);
+        void Rotate();
+
+        EntryMap m_current;
+        EntryMap m_previous;
+
+        float m_gridSize;
+        uint32 m_lifeTime;
+        uint32 m_rotateTimer;
+        uint32 m_dynTreeGeneration;
+
+        LineOfSightCacheStatistic m_stat;
+
+        mutable ACE_Thread_Mutex m_lock;
+};
+
+#endif
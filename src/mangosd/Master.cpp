@@ -462,6 +462,7 @@ bool Master::_StartDB()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo", "");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    int nHolderConnections = sConfig.GetIntDefault("CharacterDatabaseHolderConnections", 4);
     if(dbstring.empty())
     {
         sLog.outError("BOOT: Character Database not specified in configuration file");
@@ -470,7 +471,6 @@ bool Master::_StartDB()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("BOOT: Character Database total connections: %i", nConnections + 1);
 
 #ifdef MANGOSR2_SINGLE_THREAD
     if (nConnections > 1)
@@ -478,10 +478,16 @@ bool Master::_StartDB()
         sLog.outError("BOOT: Your OS (%s) not support set CharacterDatabaseConnections > 1! Resetted to 1", MANGOSR2_SINGLE_THREAD);
         nConnections = 1;
     }
+    nHolderConnections = 0;
 #endif
 
+    if (nHolderConnections < 0)
+        nHolderConnections = 0;
+
+    sLog.outString("BOOT: Character Database total connections: %i", nConnections + nHolderConnections + 1);
+
     ///- Initialise the Character database
-    if(!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if(!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nHolderConnections))
     {
         sLog.outError("BOOT: Cannot connect to Character database %s",dbstring.c_str());
 
@@ -498,6 +504,18 @@ bool Master::_StartDB()
         return false;
     }
 
+    ///- Replay character writes lost at server crash and journal new ones
+    std::string journal = sConfig.GetStringDefault("CharacterDatabaseJournal", "");
+    if (!journal.empty() && !CharacterDatabase.OpenJournal(journal.c_str(), sConfig.GetBoolDefault("CharacterDatabaseJournalSync", true)))
+    {
+        sLog.outError("BOOT: Cannot open character database journal %s", journal.c_str());
+
+        ///- Wait for already started DB delay threads to end
+        WorldDatabase.HaltDelayThread();
+        CharacterDatabase.HaltDelayThread();
+        return false;
+    }
+
     ///- Get login database info from configuration file
     dbstring = sConfig.GetStringDefault("LoginDatabaseInfo", "");
     nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
@@ -29,6 +29,7 @@
 #include "AuthSocket.h"
 #include "AuthCodes.h"
 #include "PatchHandler.h"
+#include "Metrics/Metrics.h"
 
 #include <openssl/md5.h>
 //#include "Util.h" -- for commented utf8ToUpperOnlyLatin
@@ -52,6 +53,28 @@ enum AccountFlags
     ACCOUNT_FLAG_PROPASS    = 0x00800000,
 };
 
+// Connection and logon counters, exported by metrics listener if enabled
+struct AuthMetrics
+{
+    AuthMetrics() :
+        connections(sMetrics.AddCounter("mangos_realmd_connections_total", "Accepted client connections")),
+        logonSuccess(sMetrics.AddCounter("mangos_realmd_logons_total", "Logon proof results", "result=\"success\"")),
+        logonWrongPassword(sMetrics.AddCounter("mangos_realmd_logons_total", "Logon proof results", "result=\"wrong_password\""))
+    {
+    }
+
+    MetricCounter* connections;
+    MetricCounter* logonSuccess;
+    MetricCounter* logonWrongPassword;
+};
+
+// realmd sockets are handled in single reactor thread
+static AuthMetrics& GetAuthMetrics()
+{
+    static AuthMetrics metrics;
+    return metrics;
+}
+
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some paltform
 #if defined( __GNUC__ )
 #pragma pack(1)
@@ -203,6 +226,7 @@ AuthSocket::~AuthSocket()
 void AuthSocket::OnAccept()
 {
     BASIC_LOG("Accepting connection from '%s'", get_remote_address().c_str());
+    GetAuthMetrics().connections->Inc();
 }
 
 /// Read the packet from the client
@@ -837,6 +861,7 @@ bool AuthSocket::_HandleLogonProof()
     if (!memcmp(M.AsByteArray(), lp.M1, 20))
     {
         BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
+        GetAuthMetrics().logonSuccess->Inc();
 
         ///- Update the sessionkey, last_ip, last login time and reset number of failed logins in the account table for this account
         // No SQL injection (escaped user name) and IP address as received by socket
@@ -868,6 +893,7 @@ bool AuthSocket::_HandleLogonProof()
             send(data, sizeof(data));
         }
         BASIC_LOG("[AuthChallenge] account %s tried to login with wrong password!",_login.c_str ());
+        GetAuthMetrics().logonWrongPassword->Inc();
 
         uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
         if (MaxWrongPassCount > 0)
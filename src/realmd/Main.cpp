@@ -33,6 +33,8 @@
 #include "revision_sql.h"
 #include "revision_R2.h"
 #include "Util.h"
+#include "Metrics/Metrics.h"
+#include "Metrics/MetricsSocket.h"
 #include <openssl/opensslv.h>
 #include <openssl/crypto.h>
 
@@ -281,6 +283,22 @@ extern int main(int argc, char **argv)
         return 1;
     }
 
+    ///- Launch metrics listener in same reactor
+    MetricsSocket::Acceptor metricsAcceptor;
+    MetricGauge* realmsMetric = NULL;
+
+    if (sConfig.GetBoolDefault("Metrics.Enable", false))
+    {
+        std::string metricsIP = sConfig.GetStringDefault("Metrics.IP", "127.0.0.1");
+        uint16 metricsPort = sConfig.GetIntDefault("Metrics.Port", 9102);
+        ACE_INET_Addr metricsAddr(metricsPort, metricsIP.c_str());
+
+        if (metricsAcceptor.open(metricsAddr, ACE_Reactor::instance(), ACE_NONBLOCK) == -1)
+            sLog.outError("BOOT:  realmd can not bind metrics listener to %s:%d", metricsIP.c_str(), metricsPort);
+        else
+            realmsMetric = sMetrics.AddGauge("mangos_realmd_realms", "Realms in realm list");
+    }
+
     ///- Catch termination signals
     HookSignals();
 
@@ -352,6 +370,12 @@ extern int main(int argc, char **argv)
             DETAIL_LOG("BOOT: Ping MySQL to keep connection alive");
             LoginDatabase.Ping();
         }
+
+        if (realmsMetric)
+        {
+            realmsMetric->Set(sRealmList.size());
+            LoginDatabase.UpdateMetrics();
+        }
 #ifdef WIN32
         if (m_ServiceStatus == 0) stopEvent = true;
         while (m_ServiceStatus == 2) Sleep(1000);
@@ -22,6 +22,8 @@
 
 #include "DBCFileLoader.h"
 
+#define DBC_HEADER_SIZE 20                                  // magic, records, fields, record size, string size
+
 DBCFileLoader::DBCFileLoader()
 {
     data = NULL;
@@ -30,39 +32,34 @@ DBCFileLoader::DBCFileLoader()
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    delete[] data;
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)return false;
-
-    if (fread(&header, 4, 1, f) != 1)                       // Number of records
-        return false;
-
-    EndianConvert(header);
-    if (header != 0x43424457)
-        return false;                                       //'WDBC'
+    data = NULL;
+    m_map.close();
 
-    if (fread(&recordCount, 4, 1, f) != 1)                  // Number of records
+    if (m_map.map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ | PROT_WRITE, ACE_MAP_PRIVATE) == -1)
         return false;
 
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                   // Number of fields
+    size_t size = m_map.size();
+    unsigned char* addr = static_cast<unsigned char*>(m_map.addr());
+    if (!addr || size < DBC_HEADER_SIZE)
         return false;
 
-    EndianConvert(fieldCount);
+    uint32 header[5];
+    memcpy(header, addr, sizeof(header));
+    for (int i = 0; i < 5; ++i)
+        EndianConvert(header[i]);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                   // Size of a record
-        return false;
+    if (header[0] != 0x43424457)
+        return false;                                       //'WDBC'
 
-    EndianConvert(recordSize);
+    recordCount = header[1];                                // Number of records
+    fieldCount = header[2];                                 // Number of fields
+    recordSize = header[3];                                 // Size of a record
+    stringSize = header[4];                                 // String size
 
-    if (fread(&stringSize, 4, 1, f) != 1)                   // String size
+    if (uint64(DBC_HEADER_SIZE) + uint64(recordSize) * recordCount + stringSize > size)
         return false;
 
-    EndianConvert(stringSize);
-
+    delete[] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -74,19 +71,13 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = addr + DBC_HEADER_SIZE;
     stringTable = data + recordSize * recordCount;
-
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-        return false;
-
-    fclose(f);
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
     delete[] fieldsOffset;
 }
 
@@ -96,6 +87,77 @@ DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
     return Record(*this, data + id * recordSize);
 }
 
+bool DBCFileLoader::IsDirectFormat(const char* format) const
+{
+#if MANGOS_ENDIAN == MANGOS_LITTLEENDIAN
+    if (!data || strlen(format) != fieldCount || recordSize != fieldCount * sizeof(uint32))
+        return false;
+
+    for (uint32 x = 0; x < fieldCount; ++x)
+        if (format[x] != FT_INT && format[x] != FT_FLOAT && format[x] != FT_IND)
+            return false;
+
+    return true;
+#else
+    // on-disk data little endian, always converted
+    return false;
+#endif
+}
+
+char** DBCFileLoader::CreateIndexTable(const char* format, uint32& records)
+{
+    typedef char* ptr;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    ptr* indexTable;
+    if (i >= 0)
+    {
+        uint32 maxi = 0;
+        // find max index
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            uint32 ind = getRecord(y).getUInt(i);
+            if (ind > maxi)maxi = ind;
+        }
+
+        ++maxi;
+        records = maxi;
+        indexTable = new ptr[maxi];
+        memset(indexTable, 0, maxi * sizeof(ptr));
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new ptr[recordCount];
+    }
+
+    return indexTable;
+}
+
+char** DBCFileLoader::AutoProduceIndex(const char* format, uint32& records)
+{
+    if (!IsDirectFormat(format))
+        return NULL;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    char** indexTable = CreateIndexTable(format, records);
+
+    for (uint32 y = 0; y < recordCount; ++y)
+    {
+        char* record = reinterpret_cast<char*>(data + y * recordSize);
+        if (i >= 0)
+            indexTable[getRecord(y).getUInt(i)] = record;
+        else
+            indexTable[y] = record;
+    }
+
+    return indexTable;
+}
+
 uint32 DBCFileLoader::GetFormatRecordSize(const char* format, int32* index_pos)
 {
     uint32 recordsize = 0;
@@ -154,7 +216,6 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     this func will generate  entry[rows] data;
     */
 
-    typedef char* ptr;
     if (strlen(format) != fieldCount)
         return NULL;
 
@@ -162,26 +223,7 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     int32 i;
     uint32 recordsize = GetFormatRecordSize(format, &i);
 
-    if (i >= 0)
-    {
-        uint32 maxi = 0;
-        // find max index
-        for (uint32 y = 0; y < recordCount; ++y)
-        {
-            uint32 ind = getRecord(y).getUInt(i);
-            if (ind > maxi)maxi = ind;
-        }
-
-        ++maxi;
-        records = maxi;
-        indexTable = new ptr[maxi];
-        memset(indexTable, 0, maxi * sizeof(ptr));
-    }
-    else
-    {
-        records = recordCount;
-        indexTable = new ptr[recordCount];
-    }
+    indexTable = CreateIndexTable(format, records);
 
     char* dataTable = new char[recordCount * recordsize];
 
@@ -234,14 +276,12 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
+uint32 DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
 {
     if (strlen(format) != fieldCount)
-        return NULL;
-
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+        return 0;
 
+    uint32 filled = 0;
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
@@ -266,8 +306,9 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !** slot)
                     {
-                        const char* st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (const char*)stringTable);
+                        // string used in place from mapped file
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
+                        ++filled;
                     }
                     offset += sizeof(char*);
                     break;
@@ -286,5 +327,5 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    return filled;
 }
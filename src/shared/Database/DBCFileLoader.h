@@ -22,6 +22,8 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+#include <ace/Mem_Map.h>
+
 enum FieldFormat
 {
     FT_NA = 'x',                                            // ignore/ default, 4 byte size, in Source String means field is ignored, in Dest String means field is filled with default value
@@ -37,6 +39,14 @@ enum FieldFormat
     FT_LOGIC = 'l'                                          // Logical (boolean)
 };
 
+/**
+ * DBC file access by read only private mapping of file.
+ *
+ * Records and string table used in place while loader exist: records with on-disk layout equal
+ * to C++ structure layout (only 4 byte int/float fields at little endian platform) indexed
+ * directly by AutoProduceIndex, and string fields of converted records point into mapped
+ * string table. Writes to mapped records (hacks in loaded data) are private copy-on-write.
+ */
 class DBCFileLoader
 {
     public:
@@ -93,10 +103,15 @@ class DBCFileLoader
         uint32 GetCols() const { return fieldCount; }
         uint32 GetOffset(size_t id) const { return (fieldsOffset != NULL && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() {return (data != NULL);}
+        bool IsDirectFormat(const char* fmt) const;         // records can be used in place by AutoProduceIndex
+        char** AutoProduceIndex(const char* fmt, uint32& count);
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable);
-        char* AutoProduceStrings(const char* fmt, char* dataTable);
+        uint32 AutoProduceStrings(const char* fmt, char* dataTable);  // return amount of filled string fields
         static uint32 GetFormatRecordSize(const char* format, int32* index_pos = NULL);
     private:
+        char** CreateIndexTable(const char* fmt, uint32& count);
+
+        ACE_Mem_Map m_map;
 
         uint32 recordSize;
         uint32 recordCount;
@@ -24,7 +24,7 @@
 template<class T>
 class DBCStorage
 {
-        typedef std::list<char*> StringPoolList;
+        typedef std::list<DBCFileLoader*> LoaderList;
     public:
         explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(NULL), m_dataTable(NULL) { }
         ~DBCStorage() { Clear(); }
@@ -36,18 +36,33 @@ class DBCStorage
 
         bool Load(char const* fn)
         {
-            DBCFileLoader dbc;
+            DBCFileLoader* dbc = new DBCFileLoader;
             // Check if load was sucessful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc->Load(fn, fmt))
+            {
+                delete dbc;
                 return false;
+            }
+
+            fieldCount = dbc->GetCols();
 
-            fieldCount = dbc.GetCols();
+            // file mapping kept while records or strings used
+            m_loaderList.push_back(dbc);
 
-            // load raw non-string data
-            m_dataTable = (T*)dbc.AutoProduceData(fmt, nCount, (char**&)indexTable);
+            if (dbc->IsDirectFormat(fmt))
+            {
+                // records in file already in structure format
+                indexTable = (T**)dbc->AutoProduceIndex(fmt, nCount);
+            }
+            else
+            {
+                // load raw non-string data
+                m_dataTable = (T*)dbc->AutoProduceData(fmt, nCount, (char**&)indexTable);
 
-            // load strings from dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
+                // link strings from dbc data
+                if (m_dataTable)
+                    dbc->AutoProduceStrings(fmt, (char*)m_dataTable);
+            }
 
             // error in dbc file at loading if NULL
             return indexTable != NULL;
@@ -59,31 +74,38 @@ class DBCStorage
             if (!indexTable)
                 return false;
 
-            DBCFileLoader dbc;
+            // no strings in directly used records
+            if (!m_dataTable)
+                return true;
+
+            DBCFileLoader* dbc = new DBCFileLoader;
             // Check if load was successful, only then continue
-            if (!dbc.Load(fn, fmt))
+            if (!dbc->Load(fn, fmt))
+            {
+                delete dbc;
                 return false;
+            }
 
-            // load strings from another locale dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
+            // link strings from another locale dbc data, file mapping not needed if all strings already set
+            if (dbc->AutoProduceStrings(fmt, (char*)m_dataTable))
+                m_loaderList.push_back(dbc);
+            else
+                delete dbc;
 
             return true;
         }
 
         void Clear()
         {
-            if (!indexTable)
-                return;
-
             delete[]((char*)indexTable);
             indexTable = NULL;
             delete[]((char*)m_dataTable);
             m_dataTable = NULL;
 
-            while (!m_stringPoolList.empty())
+            while (!m_loaderList.empty())
             {
-                delete[] m_stringPoolList.front();
-                m_stringPoolList.pop_front();
+                delete m_loaderList.front();
+                m_loaderList.pop_front();
             }
             nCount = 0;
         }
@@ -112,7 +134,7 @@ class DBCStorage
         char const* fmt;
         T** indexTable;
         T* m_dataTable;
-        StringPoolList m_stringPoolList;
+        LoaderList m_loaderList;
 };
 
 #endif
@@ -19,6 +19,8 @@
 #include "DatabaseEnv.h"
 #include "Config/Config.h"
 #include "Database/SqlOperations.h"
+#include "Database/SqlJournal.h"
+#include "Metrics/Metrics.h"
 
 #include <ctime>
 #include <iostream>
@@ -90,13 +92,23 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id )
     return pStmt->execute();
 }
 
+QueryResult* SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if(nIndex == -1)
+        return NULL;
+
+    SqlPreparedStatement * pStmt = GetStmt(nIndex);
+    pStmt->bind(id);
+    return pStmt->query();
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char * infoString, int nConns /*= 1*/, int nHolderConns /*= 0*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -110,6 +122,18 @@ bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
 
     m_pingIntervallms = sConfig.GetIntDefault ("MaxPingTime", 30) * (MINUTE * 1000);
 
+    // metrics labeled by database name, last field of info string
+    std::string dbName = infoString;
+    std::string::size_type pos = dbName.find_last_of(';');
+    if (pos != std::string::npos)
+        dbName = dbName.substr(pos + 1);
+
+    static uint32 const asyncTimeBounds[] = { 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 1000000 };
+    std::string labels = "db=\"" + dbName + "\"";
+    m_asyncTimeMetric = sMetrics.AddHistogram("mangos_db_async_request_microseconds", "Execution time of async database requests",
+        asyncTimeBounds, countof(asyncTimeBounds), labels.c_str());
+    m_asyncQueueMetric = sMetrics.AddGauge("mangos_db_async_queue_size", "Queued and not executed async database requests", labels.c_str());
+
     //create DB connections
 
     //setup connection pool size
@@ -138,12 +162,43 @@ bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
     if(!m_pAsyncConn->Initialize(infoString))
         return false;
 
+    //create connections for parallel query holders execution
+    if(nHolderConns > MAX_CONNECTION_POOL_SIZE)
+        nHolderConns = MAX_CONNECTION_POOL_SIZE;
+
+    for (int i = 0; i < nHolderConns; ++i)
+    {
+        SqlConnection * pConn = CreateConnection();
+        if(!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pHolderConnections.push_back(pConn);
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
+
+    //threads for query holders, each pings only own connection
+    for (size_t i = 0; i < m_pHolderConnections.size(); ++i)
+    {
+        SqlDelayThread* threadBody = new SqlDelayThread(this, m_pHolderConnections[i], false);
+        m_holderThreadBodies.push_back(threadBody);
+        m_holderThreads.push_back(new ACE_Based::Thread(threadBody));
+    }
+
     return true;
 }
 
+void Database::UpdateMetrics()
+{
+    if (m_asyncQueueMetric)
+        m_asyncQueueMetric->Set(GetAsyncQueueSize());
+}
+
 void Database::StopServer()
 {
     HaltDelayThread();
@@ -165,6 +220,11 @@ void Database::StopServer()
 
     m_pQueryConnections.clear();
 
+    for (size_t i = 0; i < m_pHolderConnections.size(); ++i)
+        delete m_pHolderConnections[i];
+
+    m_pHolderConnections.clear();
+
 }
 
 SqlDelayThread * Database::CreateDelayThread()
@@ -184,13 +244,74 @@ void Database::InitDelayThread()
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_threadBody && m_delayThread)
+    {
+        m_threadBody->Stop();                               //Stop event
+        m_delayThread->wait();                              //Wait for flush to DB
+        delete m_delayThread;                               //This also deletes m_threadBody
+        m_delayThread = NULL;
+        m_threadBody = NULL;
+    }
 
-    m_threadBody->Stop();                                   //Stop event
-    m_delayThread->wait();                                  //Wait for flush to DB
-    delete m_delayThread;                                   //This also deletes m_threadBody
-    m_delayThread = NULL;
-    m_threadBody = NULL;
+    //after delay thread - it can pass holders to them at flush
+    for (size_t i = 0; i < m_holderThreads.size(); ++i)
+    {
+        m_holderThreadBodies[i]->Stop();
+        m_holderThreads[i]->wait();
+        delete m_holderThreads[i];
+    }
+
+    m_holderThreads.clear();
+    m_holderThreadBodies.clear();
+
+    //all queued writes executed
+    delete m_journal;
+    m_journal = NULL;
+}
+
+bool Database::OpenJournal(char const* fileName, bool sync)
+{
+    MANGOS_ASSERT(!m_journal);
+
+    SqlJournal* journal = new SqlJournal(*this);
+    if (!journal->Open(fileName, sync))
+    {
+        delete journal;
+        return false;
+    }
+
+    m_journal = journal;
+    return true;
+}
+
+void Database::DelayWrite(SqlOperation* op)
+{
+    if (!m_journal)
+    {
+        m_threadBody->Delay(op);
+        return;
+    }
+
+    //journal record is always transaction
+    SqlTransaction* trans = new SqlTransaction();
+    trans->DelayExecute(op);
+    DelayTransaction(trans);
+}
+
+void Database::DelayTransaction(SqlTransaction* trans)
+{
+    if (!m_journal || !m_journal->Delay(trans, m_threadBody))
+        m_threadBody->Delay(trans);
+}
+
+bool Database::ExecuteQueryHolder(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback)
+{
+    if (m_holderThreadBodies.empty())
+        return holder->Execute(callback, m_threadBody, m_pResultQueue);
+
+    // split at delay thread, after all earlier queued (character save) requests are done
+    m_threadBody->Delay(new SqlQueryHolderDispatch(holder, callback, m_holderThreadBodies, m_pResultQueue));
+    return true;
 }
 
 void Database::ThreadStart()
@@ -347,7 +468,7 @@ bool Database::Execute(const char *sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        DelayWrite(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -418,7 +539,7 @@ bool Database::CommitTransaction()
         return CommitTransactionDirect();
 
     //add SqlTransaction to the async queue
-    m_threadBody->Delay(m_TransStorage->detach());
+    DelayTransaction(m_TransStorage->detach());
     return true;
 }
 
@@ -559,7 +680,7 @@ bool Database::ExecuteStmt( const SqlStatementID& id, SqlStmtParameters * params
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        DelayWrite(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
@@ -574,6 +695,14 @@ bool Database::DirectExecuteStmt( const SqlStatementID& id, SqlStmtParameters *
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+QueryResult* Database::QueryStmt( const SqlStatementID& id, SqlStmtParameters * params )
+{
+    MANGOS_ASSERT(params);
+    std::auto_ptr<SqlStmtParameters> p(params);
+    SqlConnection::Lock _guard(getQueryConnection());
+    return _guard->QueryStmt(id.ID(), *params);
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char * fmt )
 {
     int nId = -1;
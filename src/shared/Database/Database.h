@@ -30,10 +30,18 @@
 
 class SqlTransaction;
 class SqlResultQueue;
+class SqlJournal;
 class SqlQueryHolder;
 class SqlStmtParameters;
 class SqlParamBinder;
 class Database;
+class MetricHistogram;
+class MetricGauge;
+
+namespace MaNGOS
+{
+    class IQueryCallback;
+}
 
 #define MAX_QUERY_LEN   (32*1024)
 
@@ -63,6 +71,7 @@ class MANGOS_DLL_SPEC SqlConnection
 
         //methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        QueryResult* QueryStmt(int nIndex, const SqlStmtParameters& id);
 
         //SqlConnection object lock
         class Lock
@@ -105,7 +114,8 @@ class MANGOS_DLL_SPEC Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char *infoString, int nConns = 1);
+        // nHolderConns - connections (each with own thread) for parallel execution of query holders, 0 - holders use async connection
+        virtual bool Initialize(const char *infoString, int nConns = 1, int nHolderConns = 0);
         //start worker thread for async DB request execution
         virtual void InitDelayThread();
         //stop worker thread
@@ -221,9 +231,22 @@ class MANGOS_DLL_SPEC Database
         //NO ASYNC TRANSACTIONS DURING SERVER STARTUP - ONLY DURING RUNTIME!!!
         void AllowAsyncTransactions() { m_bAllowAsyncTransactions = true; }
 
+        //replay not applied writes from journal file and journal async writes from now, see SqlJournal
+        bool OpenJournal(char const* fileName, bool sync);
+        bool IsJournalEnabled() const { return m_journal != NULL; }
+
+        //async requests load: not executed requests and average request execution time (microseconds)
+        uint32 GetAsyncQueueSize() const { return m_threadBody ? m_threadBody->GetQueueSize() : 0; }
+        uint32 GetAsyncAverageTime() const { return m_threadBody ? m_threadBody->GetAverageTime() : 0; }
+
+        //metrics of async requests, queue size gauge updated by UpdateMetrics call from owner thread
+        MetricHistogram* GetAsyncTimeMetric() const { return m_asyncTimeMetric; }
+        void UpdateMetrics();
+
     protected:
         Database(): m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_pResultQueue(NULL), m_threadBody(NULL), m_delayThread(NULL),
-            m_bAllowAsyncTransactions(false), m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
+            m_journal(NULL), m_asyncTimeMetric(NULL), m_asyncQueueMetric(NULL), m_bAllowAsyncTransactions(false), m_iStmtIndex(-1),
+            m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
         }
@@ -235,6 +258,13 @@ class MANGOS_DLL_SPEC Database
         //factory method to create SqlDelayThread objects
         virtual SqlDelayThread * CreateDelayThread();
 
+        //queue async write (through journal if enabled)
+        void DelayWrite(SqlOperation* op);
+        void DelayTransaction(SqlTransaction* trans);
+
+        //queue holder queries to holder threads (or to delay thread if no holder connections)
+        bool ExecuteQueryHolder(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback);
+
         class MANGOS_DLL_SPEC TransHelper
         {
             public:
@@ -268,10 +298,12 @@ class MANGOS_DLL_SPEC Database
         SqlConnection * getAsyncConnection() const { return m_pAsyncConn; }
 
         friend class SqlStatement;
+        friend class SqlJournal;
         //PREPARED STATEMENT API
         //query function for prepared statements
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters * params);
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters * params);
+        QueryResult* QueryStmt(const SqlStatementID& id, SqlStmtParameters * params);
 
         //connection helper counters
         int m_nQueryConnPoolSize;                               //current size of query connection pool
@@ -284,9 +316,18 @@ class MANGOS_DLL_SPEC Database
         //only one single DB connection for transactions
         SqlConnection * m_pAsyncConn;
 
+        //connections and threads for query holders, queries of one holder are split between them
+        SqlConnectionContainer m_pHolderConnections;
+        std::vector<SqlDelayThread*> m_holderThreadBodies;  ///< owned by m_holderThreads
+        std::vector<ACE_Based::Thread*> m_holderThreads;
+
         SqlResultQueue *    m_pResultQueue;                  ///< Transaction queues from diff. threads
         SqlDelayThread *    m_threadBody;                    ///< Pointer to delay sql executer (owned by m_delayThread)
         ACE_Based::Thread * m_delayThread;                   ///< Pointer to executer thread
+        SqlJournal *        m_journal;                       ///< Journal of async writes, NULL if disabled
+
+        MetricHistogram *   m_asyncTimeMetric;               ///< Execution time of async requests, microseconds
+        MetricGauge *       m_asyncQueueMetric;              ///< Not executed async requests
 
         bool m_bAllowAsyncTransactions;                      ///< flag which specifies if async transactions are enabled
 
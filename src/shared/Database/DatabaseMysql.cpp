@@ -325,7 +325,7 @@ SqlPreparedStatement * MySQLConnection::CreateStatement( const std::string& fmt
 
 //////////////////////////////////////////////////////////////////////////
 MySqlPreparedStatement::MySqlPreparedStatement( const std::string& fmt, SqlConnection& conn, MYSQL * mysql ) : SqlPreparedStatement(fmt, conn),
-    m_pMySQLConn(mysql), m_stmt(NULL), m_pInputArgs(NULL), m_pResult(NULL), m_pResultMetadata(NULL)
+    m_pMySQLConn(mysql), m_stmt(NULL), m_pInputArgs(NULL), m_pResult(NULL), m_pResultMetadata(NULL), m_pResultBuffers(NULL)
 {
 }
 
@@ -386,7 +386,9 @@ bool MySqlPreparedStatement::prepare()
         /* Get total columns in the query */
         m_nColumns = mysql_num_fields(m_pResultMetadata);
 
-        //bind output buffers
+        //output buffers allocated here, bound at query() - string buffers size depend from result
+        m_pResult = new MYSQL_BIND[m_nColumns];
+        m_pResultBuffers = new ResultBuffer[m_nColumns];
     }
 
     m_bPrepared = true;
@@ -455,6 +457,7 @@ void MySqlPreparedStatement::RemoveBinds()
 
     delete [] m_pInputArgs;
     delete [] m_pResult;
+    delete [] m_pResultBuffers;
 
     mysql_free_result(m_pResultMetadata);
     mysql_stmt_close(m_stmt);
@@ -462,6 +465,7 @@ void MySqlPreparedStatement::RemoveBinds()
     m_stmt = NULL;
     m_pResultMetadata = NULL;
     m_pResult = NULL;
+    m_pResultBuffers = NULL;
     m_pInputArgs = NULL;
 
     m_bPrepared = false;
@@ -482,6 +486,177 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+QueryResult* MySqlPreparedStatement::query()
+{
+    if(!isPrepared() || !isQuery())
+        return NULL;
+
+    uint32 _s = WorldTimer::getMSTime();
+
+    if(mysql_stmt_execute(m_stmt))
+    {
+        sLog.outError("SQL: cannot execute '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return NULL;
+    }
+
+    if(mysql_stmt_store_result(m_stmt))
+    {
+        sLog.outError("SQL: cannot store result of '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return NULL;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL STMT: %s", WorldTimer::getMSTimeDiff(_s,WorldTimer::getMSTime()), m_szFmt.c_str());
+
+    //same as text queries - no result for empty set
+    uint64 rowCount = mysql_stmt_num_rows(m_stmt);
+    if(!rowCount)
+    {
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    BindResult();
+
+    //all rows fetched while connection is held, result does not use statement
+    QueryResultMysqlStmt* result = new QueryResultMysqlStmt(rowCount, m_nColumns);
+
+    MYSQL_FIELD* fields = mysql_fetch_fields(m_pResultMetadata);
+    for (uint64 row = 0; row < rowCount; ++row)
+    {
+        Field* rowFields = result->GetRow(row);
+        for (uint32 i = 0; i < m_nColumns; ++i)
+            rowFields[i].SetType(QueryResultMysql::ConvertNativeType(fields[i].type));
+
+        if(!StoreRow(result, rowFields))
+        {
+            sLog.outError("SQL: cannot fetch result of '%s'", m_szFmt.c_str());
+            sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+            mysql_stmt_free_result(m_stmt);
+            delete result;
+            return NULL;
+        }
+    }
+
+    mysql_stmt_free_result(m_stmt);
+    return result;
+}
+
+void MySqlPreparedStatement::BindResult()
+{
+    memset(m_pResult, 0, sizeof(MYSQL_BIND) * m_nColumns);
+
+    MYSQL_FIELD* fields = mysql_fetch_fields(m_pResultMetadata);
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        MYSQL_BIND& bind = m_pResult[i];
+        ResultBuffer& buffer = m_pResultBuffers[i];
+
+        switch (QueryResultMysql::ConvertNativeType(fields[i].type))
+        {
+            case Field::DB_TYPE_INTEGER:
+                buffer.type = MYSQL_TYPE_LONGLONG;
+                bind.buffer = &buffer.value.i64;
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) ? 1 : 0;
+                break;
+            case Field::DB_TYPE_FLOAT:
+                //DECIMAL has exact text form, fetched as string
+                if(fields[i].type == MYSQL_TYPE_FLOAT)
+                {
+                    buffer.type = MYSQL_TYPE_FLOAT;
+                    bind.buffer = &buffer.value.f;
+                    break;
+                }
+                if(fields[i].type == MYSQL_TYPE_DOUBLE)
+                {
+                    buffer.type = MYSQL_TYPE_DOUBLE;
+                    bind.buffer = &buffer.value.d;
+                    break;
+                }
+                //no break
+            default:
+                //longer values fetched separately in StoreRow()
+                buffer.type = MYSQL_TYPE_STRING;
+                if(buffer.text.size() < 256)
+                    buffer.text.resize(256);
+                bind.buffer = &buffer.text[0];
+                bind.buffer_length = buffer.text.size();
+                break;
+        }
+
+        bind.buffer_type = buffer.type;
+        bind.is_null = &buffer.isNull;
+        bind.length = &buffer.length;
+    }
+
+    if(mysql_stmt_bind_result(m_stmt, m_pResult))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed\n");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+    }
+}
+
+bool MySqlPreparedStatement::StoreRow(QueryResultMysqlStmt* result, Field* fields)
+{
+    int res = mysql_stmt_fetch(m_stmt);
+    if(res != 0 && res != MYSQL_DATA_TRUNCATED)
+        return false;
+
+    bool rebind = false;
+
+    for (uint32 i = 0; i < m_nColumns; ++i)
+    {
+        ResultBuffer& buffer = m_pResultBuffers[i];
+
+        if(buffer.isNull)
+        {
+            fields[i].SetValue(NULL);
+            continue;
+        }
+
+        switch (buffer.type)
+        {
+            case MYSQL_TYPE_LONGLONG:
+                if(m_pResult[i].is_unsigned)
+                    fields[i].SetUInt64(buffer.value.ui64);
+                else
+                    fields[i].SetInt64(buffer.value.i64);
+                break;
+            case MYSQL_TYPE_FLOAT:
+                fields[i].SetFloat(buffer.value.f);
+                break;
+            case MYSQL_TYPE_DOUBLE:
+                fields[i].SetDouble(buffer.value.d);
+                break;
+            default:
+                //value not fit in buffer, grow it and fetch column again
+                if(buffer.length > buffer.text.size())
+                {
+                    buffer.text.resize(buffer.length);
+
+                    MYSQL_BIND& bind = m_pResult[i];
+                    bind.buffer = &buffer.text[0];
+                    bind.buffer_length = buffer.text.size();
+
+                    if(mysql_stmt_fetch_column(m_stmt, &bind, i, 0))
+                        return false;
+
+                    rebind = true;
+                }
+
+                fields[i].SetValue(result->StoreString(&buffer.text[0], buffer.length));
+                break;
+        }
+    }
+
+    //grown buffers used for next rows
+    if(rebind && mysql_stmt_bind_result(m_stmt, m_pResult))
+        return false;
+
+    return true;
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType( const SqlStmtFieldData &data, my_bool &bUnsigned )
 {
     bUnsigned = 0;
@@ -34,6 +34,8 @@
 #include <mysql.h>
 #endif
 
+class QueryResultMysqlStmt;
+
 //MySQL prepared statement class
 class MANGOS_DLL_SPEC MySqlPreparedStatement : public SqlPreparedStatement
 {
@@ -50,6 +52,9 @@ public:
     //execute DML statement
     virtual bool execute();
 
+    //execute query, result fetched in binary form
+    virtual QueryResult* query();
+
 protected:
     //bind parameters
     void addParam(int nIndex, const SqlStmtFieldData& data);
@@ -57,13 +62,28 @@ protected:
     static enum_field_types ToMySQLType( const SqlStmtFieldData &data, my_bool &bUnsigned );
 
 private:
+    //output buffer of one result column
+    struct ResultBuffer
+    {
+        enum_field_types type;                              // integer columns fetched as LONGLONG, FLOAT as FLOAT, DOUBLE as DOUBLE, other as STRING
+        my_bool isNull;
+        unsigned long length;
+        SqlStmtField value;
+        std::vector<char> text;
+    };
+
     void RemoveBinds();
+    //setup output buffers for current result metadata
+    void BindResult();
+    //store fetched row values into result fields, false at error
+    bool StoreRow(QueryResultMysqlStmt* result, Field* fields);
 
     MYSQL * m_pMySQLConn;
     MYSQL_STMT * m_stmt;
     MYSQL_BIND * m_pInputArgs;
     MYSQL_BIND * m_pResult;
     MYSQL_RES *m_pResultMetadata;
+    ResultBuffer * m_pResultBuffers;
 };
 
 class MANGOS_DLL_SPEC MySQLConnection : public SqlConnection
@@ -16,5 +16,34 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
-//#include "DatabaseEnv.h"
+#include "Field.h"
 
+#include <float.h>
+
+const char* Field::FormatNative(char* buffer, size_t size) const
+{
+    // same precision as text protocol
+    switch (mStorage)
+    {
+        case STORAGE_INTEGER:
+            snprintf(buffer, size, SI64FMTD, mNative.i);
+            break;
+        case STORAGE_UINTEGER:
+            snprintf(buffer, size, UI64FMTD, mNative.u);
+            break;
+        case STORAGE_FLOAT:
+            snprintf(buffer, size, "%.*g", FLT_DIG, mNative.f);
+            break;
+        default:
+            snprintf(buffer, size, "%.*g", DBL_DIG, mNative.d);
+            break;
+    }
+    return buffer;
+}
+
+const char* Field::FormatNative() const
+{
+    char* text = new char[MAX_NATIVE_TEXT_SIZE];
+    mValue = FormatNative(text, MAX_NATIVE_TEXT_SIZE);
+    return mValue;
+}
@@ -34,28 +34,46 @@ class Field
             DB_TYPE_BOOL    = 0x04
         };
 
-        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN) {}
-        Field(const char* value, enum DataTypes type) : mValue(value), mType(type) {}
+        Field() : mValue(NULL), mType(DB_TYPE_UNKNOWN), mStorage(STORAGE_TEXT) {}
+        Field(const char* value, enum DataTypes type) : mValue(value), mType(type), mStorage(STORAGE_TEXT) {}
 
-        ~Field() {}
+        ~Field() { ClearNativeText(); }
 
         enum DataTypes GetType() const { return mType; }
-        bool IsNULL() const { return mValue == NULL; }
+        bool IsNULL() const { return mStorage == STORAGE_TEXT && mValue == NULL; }
 
-        const char *GetString() const { return mValue; }
+        const char *GetString() const { return mStorage == STORAGE_TEXT || mValue ? mValue : FormatNative(); }
         std::string GetCppString() const
         {
+            if (mStorage != STORAGE_TEXT && !mValue)
+            {
+                char text[MAX_NATIVE_TEXT_SIZE];
+                return FormatNative(text, sizeof(text));
+            }
             return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
         }
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        float GetFloat() const
+        {
+            if (mStorage == STORAGE_TEXT)
+                return mValue ? static_cast<float>(atof(mValue)) : 0.0f;
+            switch (mStorage)
+            {
+                case STORAGE_FLOAT:  return mNative.f;
+                case STORAGE_DOUBLE: return static_cast<float>(mNative.d);
+                default:             return static_cast<float>(GetNativeInt());
+            }
+        }
+        bool GetBool() const { return mStorage == STORAGE_TEXT ? (mValue ? atoi(mValue) > 0 : false) : GetNativeInt() > 0; }
+        int32 GetInt32() const { return mStorage == STORAGE_TEXT ? (mValue ? static_cast<int32>(atol(mValue)) : int32(0)) : static_cast<int32>(GetNativeInt()); }
+        uint8 GetUInt8() const { return mStorage == STORAGE_TEXT ? (mValue ? static_cast<uint8>(atol(mValue)) : uint8(0)) : static_cast<uint8>(GetNativeInt()); }
+        uint16 GetUInt16() const { return mStorage == STORAGE_TEXT ? (mValue ? static_cast<uint16>(atol(mValue)) : uint16(0)) : static_cast<uint16>(GetNativeInt()); }
+        int16 GetInt16() const { return mStorage == STORAGE_TEXT ? (mValue ? static_cast<int16>(atol(mValue)) : int16(0)) : static_cast<int16>(GetNativeInt()); }
+        uint32 GetUInt32() const { return mStorage == STORAGE_TEXT ? (mValue ? static_cast<uint32>(atol(mValue)) : uint32(0)) : static_cast<uint32>(GetNativeInt()); }
         uint64 GetUInt64() const
         {
+            if (mStorage != STORAGE_TEXT)
+                return mStorage == STORAGE_UINTEGER ? mNative.u : static_cast<uint64>(GetNativeInt());
+
             uint64 value = 0;
             if(!mValue || sscanf(mValue,UI64FMTD,&value) == -1)
                 return 0;
@@ -66,13 +84,64 @@ class Field
         void SetType(enum DataTypes type) { mType = type; }
         //no need for memory allocations to store resultset field strings
         //all we need is to cache pointers returned by different DBMS APIs
-        void SetValue(const char* value) { mValue = value; };
+        void SetValue(const char* value) { ClearNativeText(); mValue = value; mStorage = STORAGE_TEXT; }
+
+        // native values of binary protocol results, no text parsing at access
+        void SetInt64(int64 value) { ClearNativeText(); mNative.i = value; mStorage = STORAGE_INTEGER; }
+        void SetUInt64(uint64 value) { ClearNativeText(); mNative.u = value; mStorage = STORAGE_UINTEGER; }
+        void SetFloat(float value) { ClearNativeText(); mNative.f = value; mStorage = STORAGE_FLOAT; }
+        void SetDouble(double value) { ClearNativeText(); mNative.d = value; mStorage = STORAGE_DOUBLE; }
 
     private:
         Field(Field const&);
         Field& operator=(Field const&);
 
-        const char* mValue;
+        enum StorageTypes
+        {
+            STORAGE_TEXT     = 0,                           // mValue, NULL for NULL field
+            STORAGE_INTEGER  = 1,                           // mNative.i
+            STORAGE_UINTEGER = 2,                           // mNative.u
+            STORAGE_FLOAT    = 3,                           // mNative.f
+            STORAGE_DOUBLE   = 4                            // mNative.d
+        };
+
+        int64 GetNativeInt() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_UINTEGER: return static_cast<int64>(mNative.u);
+                case STORAGE_FLOAT:    return static_cast<int64>(mNative.f);
+                case STORAGE_DOUBLE:   return static_cast<int64>(mNative.d);
+                default:               return mNative.i;
+            }
+        }
+
+        // longest text form of native value
+        enum { MAX_NATIVE_TEXT_SIZE = 32 };
+
+        // text form of native value, for string access to numeric columns
+        const char* FormatNative(char* buffer, size_t size) const;
+        // formatted at first string access and kept in mValue until value changed, so valid while result exists
+        const char* FormatNative() const;
+        void ClearNativeText()
+        {
+            if (mStorage != STORAGE_TEXT)
+            {
+                delete [] mValue;
+                mValue = NULL;
+            }
+        }
+
+        mutable const char* mValue;                         // for native values: own formatted text or NULL
         enum DataTypes mType;
+        uint8 mStorage;
+
+        union
+        {
+            int64 i;
+            uint64 u;
+            float f;
+            double d;
+        } mNative;
 };
 #endif
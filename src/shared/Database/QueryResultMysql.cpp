@@ -72,7 +72,7 @@ void QueryResultMysql::EndQuery()
     }
 }
 
-enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
+enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType)
 {
     switch (mysqlType)
     {
@@ -102,4 +102,57 @@ enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysql
             return Field::DB_TYPE_UNKNOWN;
     }
 }
+
+#define STMT_RESULT_STRING_BLOCK_SIZE   16384
+
+QueryResultMysqlStmt::QueryResultMysqlStmt(uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mNextRow(1), mBlockFree(0)
+{
+    mRows = new Field[rowCount * fieldCount];
+    mCurrentRow = mRows;
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    delete [] mRows;
+
+    for (std::vector<char*>::const_iterator itr = mStringBlocks.begin(); itr != mStringBlocks.end(); ++itr)
+        delete [] *itr;
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (mNextRow >= mRowCount)
+        return false;
+
+    mCurrentRow = GetRow(mNextRow++);
+    return true;
+}
+
+const char* QueryResultMysqlStmt::StoreString(const char* str, size_t length)
+{
+    char* dst;
+
+    // long strings in own block, keep free space of current block
+    if (length + 1 > STMT_RESULT_STRING_BLOCK_SIZE / 4)
+    {
+        dst = new char[length + 1];
+        mStringBlocks.insert(mStringBlocks.empty() ? mStringBlocks.end() : mStringBlocks.end() - 1, dst);
+    }
+    else
+    {
+        if (mBlockFree < length + 1)
+        {
+            mStringBlocks.push_back(new char[STMT_RESULT_STRING_BLOCK_SIZE]);
+            mBlockFree = STMT_RESULT_STRING_BLOCK_SIZE;
+        }
+
+        dst = mStringBlocks.back() + STMT_RESULT_STRING_BLOCK_SIZE - mBlockFree;
+        mBlockFree -= length + 1;
+    }
+
+    memcpy(dst, str, length);
+    dst[length] = 0;
+    return dst;
+}
 #endif
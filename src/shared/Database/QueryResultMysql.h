@@ -39,11 +39,36 @@ class QueryResultMysql : public QueryResult
 
         bool NextRow();
 
+        static enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType);
+
     private:
-        enum Field::DataTypes ConvertNativeType(enum_field_types mysqlType) const;
         void EndQuery();
 
         MYSQL_RES *mResult;
 };
+
+// Result of binary protocol (prepared statement) query: all rows fetched at once with native values
+// in Field, strings stored in result own memory blocks
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        QueryResultMysqlStmt(uint64 rowCount, uint32 fieldCount);
+
+        ~QueryResultMysqlStmt();
+
+        bool NextRow();
+
+        Field* GetRow(uint64 row) { return &mRows[row * mFieldCount]; }
+
+        // copy of string, valid while result exist
+        const char* StoreString(const char* str, size_t length);
+
+    private:
+        Field* mRows;
+        uint64 mNextRow;
+
+        std::vector<char*> mStringBlocks;
+        size_t mBlockFree;                                  // free bytes at end of last block
+};
 #endif
 #endif
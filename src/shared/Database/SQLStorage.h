@@ -262,7 +262,16 @@ class SQLStorageLoaderBase
             void convert_from_str(uint32 field_pos, char* src, D& dst);
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
+        // loaded data dependent from something except table content (must be changed with it) invalidate old snapshots
+        uint32 GetSnapshotKey() const { return 0; }
+
     private:
+        uint32 calculateRecordSize(StorageClass& store);
+
+        std::string getSnapshotFormats(StorageClass& store);
+        bool loadSnapshot(StorageClass& store, std::string const& tableChecksum, uint32 recordsize);
+        void saveSnapshot(StorageClass& store, std::string const& tableChecksum, std::vector<uint32> const& recordIds);
+
         template<class V>
         void storeValue(V value, StorageClass& store, char* record, uint32 field_pos, uint32& offset);
         void storeValue(char const* value, StorageClass& store, char* record, uint32 field_pos, uint32& offset);
@@ -22,6 +22,7 @@
 #include "ProgressBar.h"
 #include "Log.h"
 #include "DBCFileLoader.h"
+#include "SQLStorageSnapshot.h"
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>                                  // S source-type, D destination-type
@@ -164,9 +165,193 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::storeValue(char const* v
     }
 }
 
+template<class DerivedLoader, class StorageClass>
+uint32 SQLStorageLoaderBase<DerivedLoader, StorageClass>::calculateRecordSize(StorageClass& store)
+{
+    uint32 recordsize = 0;
+    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            case FT_LOGIC:
+                recordsize += sizeof(bool);   break;
+            case FT_BYTE:
+                recordsize += sizeof(char);   break;
+            case FT_INT:
+                recordsize += sizeof(uint32); break;
+            case FT_FLOAT:
+                recordsize += sizeof(float);  break;
+            case FT_STRING:
+                recordsize += sizeof(char*);  break;
+            case FT_NA:
+                recordsize += sizeof(uint32); break;
+            case FT_NA_BYTE:
+                recordsize += sizeof(char);   break;
+            case FT_NA_FLOAT:
+                recordsize += sizeof(float);  break;
+            case FT_NA_POINTER:
+                recordsize += sizeof(char*);  break;
+            case FT_IND:
+            case FT_SORT:
+                assert(false && "SQL storage not have sort field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+    return recordsize;
+}
+
+template<class DerivedLoader, class StorageClass>
+std::string SQLStorageLoaderBase<DerivedLoader, StorageClass>::getSnapshotFormats(StorageClass& store)
+{
+    std::string formats = store.GetSrcFormat();
+    formats.append(1, '|');
+    formats.append(store.GetDstFormat());
+    return formats;
+}
+
+template<class DerivedLoader, class StorageClass>
+bool SQLStorageLoaderBase<DerivedLoader, StorageClass>::loadSnapshot(StorageClass& store, std::string const& tableChecksum, uint32 recordsize)
+{
+    DerivedLoader* subclass = (static_cast<DerivedLoader*>(this));
+
+    SQLStorageSnapshotReader reader;
+    if (!reader.Open(store.GetTableName(), tableChecksum, getSnapshotFormats(store), recordsize, subclass->GetSnapshotKey()))
+        return false;
+
+    SQLStorageSnapshotHeader const* header = reader.GetHeader();
+    store.prepareToLoad(header->maxEntry, header->recordCount, recordsize);
+
+    for (uint32 i = 0; i < header->recordCount; ++i)
+    {
+        uint32 recordId;
+        if (!reader.Read(&recordId, sizeof(recordId)))
+            break;
+
+        char* record = store.createRecord(recordId);
+        if (!reader.Read(record, recordsize))
+        {
+            memset(record, 0, recordsize);              // no garbage pointers for Free()
+            break;
+        }
+
+        // pointer fields were stored zeroed, restore them
+        uint32 offset = 0;
+        for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
+        {
+            switch (store.GetDstFormat(x))
+            {
+                case FT_LOGIC:      offset += sizeof(bool);   break;
+                case FT_BYTE:
+                case FT_NA_BYTE:    offset += sizeof(char);   break;
+                case FT_INT:
+                case FT_NA:         offset += sizeof(uint32); break;
+                case FT_FLOAT:
+                case FT_NA_FLOAT:   offset += sizeof(float);  break;
+                case FT_STRING:
+                    if (!reader.ReadString(*((char**)(&record[offset]))))
+                        convert_str_to_str(x, (char const*)NULL, *((char**)(&record[offset])));
+                    offset += sizeof(char*);
+                    break;
+                case FT_NA_POINTER:
+                    subclass->default_fill_to_str(x, NULL, *((char**)(&record[offset])));
+                    offset += sizeof(char*);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // checksum was verified, so only at format bug
+    if (store.GetRecordCount() != header->recordCount)
+    {
+        sLog.outError("Snapshot of %s table has wrong data, table loaded from database", store.GetTableName());
+        store.prepareToLoad(0, 0, recordsize);
+        return false;
+    }
+
+    sLog.outString("%s table loaded from snapshot", store.GetTableName());
+    return true;
+}
+
+template<class DerivedLoader, class StorageClass>
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::saveSnapshot(StorageClass& store, std::string const& tableChecksum, std::vector<uint32> const& recordIds)
+{
+    DerivedLoader* subclass = (static_cast<DerivedLoader*>(this));
+
+    std::vector<char> data;
+    data.reserve(store.GetRecordCount() * (store.GetRecordSize() + sizeof(uint32)));
+
+    for (uint32 i = 0; i < store.GetRecordCount(); ++i)
+    {
+        char const* record = &store.m_data[i * store.GetRecordSize()];
+
+        uint32 recordId = recordIds[i];
+        data.insert(data.end(), (char const*)&recordId, (char const*)&recordId + sizeof(recordId));
+
+        size_t recordStart = data.size();
+        data.insert(data.end(), record, record + store.GetRecordSize());
+
+        uint32 offset = 0;
+        for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
+        {
+            switch (store.GetDstFormat(x))
+            {
+                case FT_LOGIC:      offset += sizeof(bool);   break;
+                case FT_BYTE:
+                case FT_NA_BYTE:    offset += sizeof(char);   break;
+                case FT_INT:
+                case FT_NA:         offset += sizeof(uint32); break;
+                case FT_FLOAT:
+                case FT_NA_FLOAT:   offset += sizeof(float);  break;
+                case FT_STRING:
+                {
+                    char const* str = *((char* const*)(&record[offset]));
+                    uint32 len = str ? strlen(str) : 0;
+                    data.insert(data.end(), (char const*)&len, (char const*)&len + sizeof(len));
+                    data.insert(data.end(), str, str + len);
+                    memset(&data[recordStart + offset], 0, sizeof(char*));
+                    offset += sizeof(char*);
+                    break;
+                }
+                case FT_NA_POINTER:
+                    memset(&data[recordStart + offset], 0, sizeof(char*));
+                    offset += sizeof(char*);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    SQLStorageSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.recordSize = store.GetRecordSize();
+    header.maxEntry = store.GetMaxEntry();
+    header.recordCount = store.GetRecordCount();
+    header.loaderKey = subclass->GetSnapshotKey();
+    strncpy(header.tableChecksum, tableChecksum.c_str(), sizeof(header.tableChecksum) - 1);
+
+    SQLStorageSnapshot::Write(store.GetTableName(), header, getSnapshotFormats(store), data);
+}
+
 template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
+    uint32 recordsize = calculateRecordSize(store);
+
+    // use snapshot if table not changed after its creation
+    std::string tableChecksum;
+    if (SQLStorageSnapshot::IsEnabled())
+    {
+        tableChecksum = SQLStorageSnapshot::GetTableChecksum(store.GetTableName());
+        if (!tableChecksum.empty() && loadSnapshot(store, tableChecksum, recordsize))
+            return;
+    }
+
     Field* fields = NULL;
     QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
     if (!result)
@@ -178,7 +363,6 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
 
     uint32 maxRecordId = (*result)[0].GetUInt32() + 1;
     uint32 recordCount = 0;
-    uint32 recordsize = 0;
     delete result;
 
     result = WorldDatabase.PQuery("SELECT COUNT(*) FROM %s", store.GetTableName());
@@ -211,43 +395,15 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    // get struct size
-    uint32 offset = 0;
-    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
-    {
-        switch (store.GetDstFormat(x))
-        {
-            case FT_LOGIC:
-                recordsize += sizeof(bool);   break;
-            case FT_BYTE:
-                recordsize += sizeof(char);   break;
-            case FT_INT:
-                recordsize += sizeof(uint32); break;
-            case FT_FLOAT:
-                recordsize += sizeof(float);  break;
-            case FT_STRING:
-                recordsize += sizeof(char*);  break;
-            case FT_NA:
-                recordsize += sizeof(uint32); break;
-            case FT_NA_BYTE:
-                recordsize += sizeof(char);   break;
-            case FT_NA_FLOAT:
-                recordsize += sizeof(float);  break;
-            case FT_NA_POINTER:
-                recordsize += sizeof(char*);  break;
-            case FT_IND:
-            case FT_SORT:
-                assert(false && "SQL storage not have sort field types");
-                break;
-            default:
-                assert(false && "unknown format character");
-                break;
-        }
-    }
-
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
+    // record ids in data order, for snapshot
+    std::vector<uint32> recordIds;
+    if (!tableChecksum.empty())
+        recordIds.reserve(recordCount);
+
+    uint32 offset = 0;
     BarGoLink bar(recordCount);
     do
     {
@@ -257,6 +413,9 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         char* record = store.createRecord(fields[0].GetUInt32());
         offset = 0;
 
+        if (!tableChecksum.empty())
+            recordIds.push_back(fields[0].GetUInt32());
+
         // dependend on dest-size
         // iterate two indexes: x over dest, y over source
         //                      y++ If and only If x != FT_NA*
@@ -305,6 +464,9 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+
+    if (!tableChecksum.empty())
+        saveSnapshot(store, tableChecksum, recordIds);
 }
 
 #endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SQLStorageSnapshot.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_unistd.h>
+
+std::string SQLStorageSnapshot::m_directory;
+
+void SQLStorageSnapshot::SetDirectory(std::string const& dir)
+{
+    m_directory = dir;
+
+    if (!m_directory.empty() && m_directory[m_directory.size() - 1] != '/' && m_directory[m_directory.size() - 1] != '\\')
+        m_directory.append("/");
+}
+
+std::string SQLStorageSnapshot::GetTableChecksum(char const* tableName)
+{
+#ifndef DO_POSTGRESQL
+    QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE %s", tableName);
+    if (!result)
+        return std::string();
+
+    // NULL checksum for not existing table
+    char const* checksum = (*result)[1].GetString();
+    std::string str = checksum ? checksum : "";
+    delete result;
+
+    if (str.size() >= sizeof(((SQLStorageSnapshotHeader*)NULL)->tableChecksum))
+        return std::string();
+
+    return str;
+#else
+    // no cheap table content checksum, always load from SQL
+    return std::string();
+#endif
+}
+
+std::string SQLStorageSnapshot::GetFileName(char const* tableName)
+{
+    return m_directory + tableName + ".snapshot";
+}
+
+uint64 SQLStorageSnapshot::Hash(char const* data, size_t size, uint64 hash /*= FNV-1a offset basis*/)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= uint8(data[i]);
+        hash *= UI64LIT(1099511628211);
+    }
+    return hash;
+}
+
+bool SQLStorageSnapshot::Write(char const* tableName, SQLStorageSnapshotHeader& header, std::string const& formats, std::vector<char> const& data)
+{
+    header.magic = SQLSTORAGE_SNAPSHOT_MAGIC;
+    header.version = SQLSTORAGE_SNAPSHOT_VERSION;
+    header.pointerSize = sizeof(char*);
+    header.formatSize = formats.size();
+    header.dataSize = data.size();
+    header.dataHash = Hash(formats.c_str(), formats.size());
+    if (!data.empty())
+        header.dataHash = Hash(&data[0], data.size(), header.dataHash);
+
+    std::string fileName = GetFileName(tableName);
+    std::string tmpName = fileName + ".tmp";
+
+    FILE* f = fopen(tmpName.c_str(), "wb");
+    if (!f)
+    {
+        sLog.outError("SQLStorageSnapshot: can't create snapshot file %s", tmpName.c_str());
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+        fwrite(formats.c_str(), formats.size(), 1, f) == 1 &&
+        (data.empty() || fwrite(&data[0], data.size(), 1, f) == 1);
+
+    ok = fclose(f) == 0 && ok;
+
+    // replace old snapshot only by complete file
+    if (ok)
+    {
+        ACE_OS::unlink(fileName.c_str());
+        ok = ACE_OS::rename(tmpName.c_str(), fileName.c_str()) == 0;
+    }
+
+    if (!ok)
+    {
+        sLog.outError("SQLStorageSnapshot: can't write snapshot file %s", fileName.c_str());
+        ACE_OS::unlink(tmpName.c_str());
+    }
+
+    return ok;
+}
+
+bool SQLStorageSnapshotReader::Open(char const* tableName, std::string const& tableChecksum, std::string const& formats, uint32 recordSize, uint32 loaderKey)
+{
+    std::string fileName = SQLStorageSnapshot::GetFileName(tableName);
+
+    if (m_map.map(fileName.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
+        return false;
+
+    size_t size = m_map.size();
+    char const* addr = static_cast<char const*>(m_map.addr());
+    if (!addr || size < sizeof(SQLStorageSnapshotHeader))
+        return false;
+
+    SQLStorageSnapshotHeader const* header = reinterpret_cast<SQLStorageSnapshotHeader const*>(addr);
+
+    if (header->magic != SQLSTORAGE_SNAPSHOT_MAGIC || header->version != SQLSTORAGE_SNAPSHOT_VERSION ||
+        header->pointerSize != sizeof(char*) || header->recordSize != recordSize || header->loaderKey != loaderKey)
+        return false;
+
+    // table changed after snapshot creation
+    if (strncmp(header->tableChecksum, tableChecksum.c_str(), sizeof(header->tableChecksum)) != 0)
+        return false;
+
+    if (header->formatSize != formats.size() || sizeof(SQLStorageSnapshotHeader) + header->formatSize + header->dataSize != size)
+        return false;
+
+    char const* format = addr + sizeof(SQLStorageSnapshotHeader);
+    if (memcmp(format, formats.c_str(), formats.size()) != 0)
+        return false;
+
+    if (SQLStorageSnapshot::Hash(format, size - sizeof(SQLStorageSnapshotHeader)) != header->dataHash)
+    {
+        sLog.outError("SQLStorageSnapshot: snapshot file %s is corrupted, table loaded from database", fileName.c_str());
+        return false;
+    }
+
+    m_header = header;
+    m_pos = format + header->formatSize;
+    m_end = addr + size;
+    return true;
+}
+
+bool SQLStorageSnapshotReader::Read(void* dst, size_t size)
+{
+    if (size_t(m_end - m_pos) < size)
+        return false;
+
+    memcpy(dst, m_pos, size);
+    m_pos += size;
+    return true;
+}
+
+bool SQLStorageSnapshotReader::ReadString(char*& dst)
+{
+    uint32 len;
+    if (!Read(&len, sizeof(len)) || size_t(m_end - m_pos) < len)
+        return false;
+
+    dst = new char[len + 1];
+    memcpy(dst, m_pos, len);
+    dst[len] = 0;
+    m_pos += len;
+    return true;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLSTORAGE_SNAPSHOT_H
+#define SQLSTORAGE_SNAPSHOT_H
+
+#include "Common.h"
+
+#include <ace/Mem_Map.h>
+
+#include <string>
+#include <vector>
+
+#define SQLSTORAGE_SNAPSHOT_MAGIC       0x51534E53          // 'SNSQ'
+#define SQLSTORAGE_SNAPSHOT_VERSION     1
+
+struct SQLStorageSnapshotHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint32 pointerSize;                                     // records stored in memory layout
+    uint32 recordSize;
+    uint32 maxEntry;
+    uint32 recordCount;
+    uint32 loaderKey;                                       // loader specific key, see SQLStorageLoaderBase::GetSnapshotKey
+    uint32 formatSize;                                      // src + dst format strings size
+    uint64 dataSize;
+    uint64 dataHash;                                        // hash of format strings and data
+    char tableChecksum[32];                                 // table content checksum reported by database
+};
+
+/**
+ * Binary snapshots of SQLStorage content.
+ *
+ * After SQL load storage records (strings stored after fixed part of records) are written to
+ * <SnapshotDir>/<table>.snapshot. At next load, if database reports same table checksum and storage
+ * formats, record size and loader key are the same, records are copied from mapped snapshot file
+ * instead of SQL query and text fields parsing. Checksum of snapshot data is verified before use.
+ */
+class SQLStorageSnapshot
+{
+    public:
+        // empty directory disable snapshots
+        static void SetDirectory(std::string const& dir);
+        static bool IsEnabled() { return !m_directory.empty(); }
+
+        // checksum of table content by database, empty string if not supported
+        static std::string GetTableChecksum(char const* tableName);
+
+        static std::string GetFileName(char const* tableName);
+
+        static uint64 Hash(char const* data, size_t size, uint64 hash = UI64LIT(14695981039346656037));
+
+        // write header, formats and data into temporary file and replace old snapshot
+        static bool Write(char const* tableName, SQLStorageSnapshotHeader& header, std::string const& formats, std::vector<char> const& data);
+
+    private:
+        static std::string m_directory;
+};
+
+// Read only access to snapshot file data
+class SQLStorageSnapshotReader
+{
+    public:
+        SQLStorageSnapshotReader() : m_header(NULL), m_pos(NULL), m_end(NULL) {}
+
+        // map file and validate header and data checksum
+        bool Open(char const* tableName, std::string const& tableChecksum, std::string const& formats, uint32 recordSize, uint32 loaderKey);
+
+        SQLStorageSnapshotHeader const* GetHeader() const { return m_header; }
+
+        bool Read(void* dst, size_t size);
+        bool ReadString(char*& dst);                        // allocate copy of next string
+
+    private:
+        ACE_Mem_Map m_map;
+        SQLStorageSnapshotHeader const* m_header;
+        char const* m_pos;
+        char const* m_end;
+};
+
+#endif
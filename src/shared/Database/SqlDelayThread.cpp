@@ -19,8 +19,10 @@
 #include "Database/SqlDelayThread.h"
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
+#include "Metrics/Metrics.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase /*= true*/) :
+    m_dbEngine(db), m_dbConnection(conn), m_pingDatabase(pingDatabase), m_running(true), m_queueSize(0), m_averageTime(0)
 {
 }
 
@@ -52,7 +54,13 @@ void SqlDelayThread::run()
         if((loopCounter++) >= pingEveryLoop)
         {
             loopCounter = 0;
-            m_dbEngine->Ping();
+            if (m_pingDatabase)
+                m_dbEngine->Ping();
+            else
+            {
+                SqlConnection::Lock guard(m_dbConnection);
+                delete guard->Query("SELECT 1");
+            }
         }
     }
 
@@ -71,7 +79,17 @@ void SqlDelayThread::ProcessRequests()
     SqlOperation* s = NULL;
     while (m_sqlQueue.next(s))
     {
+        ACE_Time_Value startTime = ACE_OS::gettimeofday();
+
         s->Execute(m_dbConnection);
         delete s;
+        --m_queueSize;
+
+        ACE_UINT64 time;
+        (ACE_OS::gettimeofday() - startTime).to_usec(time);
+        m_averageTime = uint32((uint64(m_averageTime) * 7 + time) / 8);
+
+        if (MetricHistogram* metric = m_dbEngine->GetAsyncTimeMetric())
+            metric->Observe(time);
     }
 }
@@ -20,6 +20,7 @@
 #define __SQLDELAYTHREAD_H
 
 #include "ace/Thread_Mutex.h"
+#include "ace/Atomic_Op.h"
 #include "LockedQueue.h"
 #include "Threading.h"
 
@@ -36,17 +37,24 @@ class SqlDelayThread : public ACE_Based::Runnable
         SqlQueue m_sqlQueue;                                ///< Queue of SQL statements
         Database* m_dbEngine;                               ///< Pointer to used Database engine
         SqlConnection * m_dbConnection;                     ///< Pointer to DB connection
+        bool m_pingDatabase;                                ///< Ping all connections of m_dbEngine or only own
         volatile bool m_running;
 
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_queueSize;  ///< Queued and not yet executed requests
+        volatile uint32 m_averageTime;                      ///< Moving average of request execution time, in microseconds
+
         //process all enqueued requests
         void ProcessRequests();
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingDatabase = true);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
-        bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
+        bool Delay(SqlOperation* sql) { ++m_queueSize; m_sqlQueue.add(sql); return true; }
+
+        uint32 GetQueueSize() const { return uint32(m_queueSize.value()); }
+        uint32 GetAverageTime() const { return m_averageTime; }
 
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
@@ -0,0 +1,478 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SqlJournal.h"
+#include "SqlDelayThread.h"
+#include "DatabaseEnv.h"
+#include "ByteBuffer.h"
+#include "Log.h"
+#include "Threading.h"
+
+#include <ace/OS_NS_fcntl.h>
+#include <ace/OS_NS_unistd.h>
+#include <ace/OS_NS_stdio.h>
+
+#define SQL_JOURNAL_HEADER_SIZE     16                      // payload size, checksum, sequence
+
+class SqlJournalSyncThread : public ACE_Based::Runnable
+{
+    public:
+        explicit SqlJournalSyncThread(SqlJournal& journal) : m_journal(journal) {}
+
+        void run() { m_journal.SyncLoop(); }
+
+    private:
+        SqlJournal& m_journal;
+};
+
+SqlJournal::SqlJournal(Database& db) : m_db(db), m_file(ACE_INVALID_HANDLE), m_retryFile(ACE_INVALID_HANDLE), m_retrySize(0),
+    m_sync(true), m_appended(m_lock), m_lastSequence(0), m_appliedSequence(0), m_syncedSequence(0), m_size(0),
+    m_syncThread(NULL), m_stopSync(false)
+{
+}
+
+SqlJournal::~SqlJournal()
+{
+    if (m_syncThread)
+    {
+        {
+            ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+            m_stopSync = true;
+            m_appended.signal();
+        }
+
+        m_syncThread->wait();
+        delete m_syncThread;
+    }
+
+    if (m_retryFile != ACE_INVALID_HANDLE)
+    {
+        ACE_OS::close(m_retryFile);
+        if (!m_retrySize)
+            ACE_OS::unlink(m_retryFileName.c_str());
+    }
+
+    if (m_file == ACE_INVALID_HANDLE)
+        return;
+
+    // all queued records executed at delay thread stop, nothing to replay
+    if (m_appliedSequence == m_lastSequence)
+        ACE_OS::ftruncate(m_file, 0);
+
+    ACE_OS::close(m_file);
+}
+
+bool SqlJournal::Open(char const* fileName, bool sync)
+{
+    m_sync = sync;
+
+    QueryResult* result = m_db.Query("SELECT sequence FROM sql_journal");
+    if (!result)
+    {
+        sLog.outError("SqlJournal: table `sql_journal` not exist or empty, journal can't be used");
+        return false;
+    }
+
+    uint64 applied = (*result)[0].GetUInt64();
+    delete result;
+
+    m_retryFileName = std::string(fileName) + ".retry";
+
+    // failed records are older than not applied ones of journal
+    ByteBuffer failed;
+    std::set<uint64> retried;
+    std::vector<uint8> retryContent;
+    if (ReadFile(m_retryFileName, retryContent))
+        ReplayRetry(retryContent, failed, retried);
+
+    m_lastSequence = Replay(fileName, applied, retried, failed);
+    if (!retried.empty() && *retried.rbegin() > m_lastSequence)
+        m_lastSequence = *retried.rbegin();                 // new records must not reuse sequence of kept ones
+
+    m_appliedSequence = m_lastSequence;
+    m_syncedSequence = m_lastSequence;
+
+    // records failed again kept for next start, replaced at once
+    std::string retryNewName = m_retryFileName + ".new";
+    m_retryFile = ACE_OS::open(retryNewName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, ACE_DEFAULT_FILE_PERMS);
+    if (m_retryFile == ACE_INVALID_HANDLE ||
+        (failed.size() && ACE_OS::write(m_retryFile, failed.contents(), failed.size()) != ssize_t(failed.size())) ||
+        ACE_OS::fsync(m_retryFile) != 0 || ACE_OS::rename(retryNewName.c_str(), m_retryFileName.c_str()) != 0)
+    {
+        sLog.outError("SqlJournal: can't write retry file %s", m_retryFileName.c_str());
+        return false;
+    }
+
+    m_retrySize = failed.size();
+
+    m_file = ACE_OS::open(fileName, O_RDWR | O_CREAT | O_TRUNC | O_BINARY, ACE_DEFAULT_FILE_PERMS);
+    if (m_file == ACE_INVALID_HANDLE)
+    {
+        sLog.outError("SqlJournal: can't create journal file %s", fileName);
+        return false;
+    }
+
+    m_size = 0;
+
+    if (m_sync)
+        m_syncThread = new ACE_Based::Thread(new SqlJournalSyncThread(*this));
+
+    sLog.outString("SqlJournal: journal %s started at sequence " UI64FMTD, fileName, m_lastSequence);
+    return true;
+}
+
+bool SqlJournal::Delay(SqlTransaction* trans, SqlDelayThread* thread)
+{
+    ByteBuffer data(256);
+    data << uint32(0) << uint32(0) << uint64(0);            // header, filled after payload
+
+    if (!trans->Serialize(m_db, data))
+        return false;
+
+    uint32 size = uint32(data.size() - SQL_JOURNAL_HEADER_SIZE);
+    data.put<uint32>(0, size);
+    data.put<uint32>(4, Checksum(data.contents() + SQL_JOURNAL_HEADER_SIZE, size));
+
+    // same order in file and in delay thread queue
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    uint64 sequence = ++m_lastSequence;
+    data.put<uint64>(8, sequence);
+
+    uint64 offset = m_size;
+    if (ACE_OS::write(m_file, data.contents(), data.size()) != ssize_t(data.size()))
+        sLog.outError("SqlJournal: can't write journal record " UI64FMTD ", it will be lost at crash", sequence);
+
+    m_size += data.size();
+
+    if (m_sync)
+        m_appended.signal();
+
+    trans->DelayExecute(CreateSequenceUpdate(sequence));
+    thread->Delay(new SqlJournalRecord(*this, trans, sequence, offset, size));
+    return true;
+}
+
+void SqlJournal::SyncLoop()
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    for (;;)
+    {
+        while (!m_stopSync && m_syncedSequence == m_lastSequence)
+            m_appended.wait();
+
+        if (m_syncedSequence == m_lastSequence)
+            break;
+
+        // one sync for all records appended until now, appends continue meantime
+        uint64 lastSequence = m_lastSequence;
+
+        guard.release();
+        ACE_OS::fsync(m_file);
+        guard.acquire();
+
+        m_syncedSequence = lastSequence;
+    }
+}
+
+void SqlJournal::KeepFailed(uint64 sequence, uint64 offset, uint32 size)
+{
+    // record is not truncated yet, it is not applied
+    std::vector<uint8> record(SQL_JOURNAL_HEADER_SIZE + size);
+    uint64 recordSequence = 0;
+    if (ACE_OS::pread(m_file, &record[0], record.size(), ACE_OFF_T(offset)) == ssize_t(record.size()))
+        memcpy(&recordSequence, &record[8], sizeof(recordSequence));
+
+    if (recordSequence != sequence)
+    {
+        sLog.outError("SqlJournal: transaction of record " UI64FMTD " failed and record can't be read, it is lost", sequence);
+        return;
+    }
+
+    if (ACE_OS::write(m_retryFile, &record[0], record.size()) != ssize_t(record.size()))
+    {
+        sLog.outError("SqlJournal: transaction of record " UI64FMTD " failed and can't be kept in %s, it is lost", sequence, m_retryFileName.c_str());
+        return;
+    }
+
+    if (m_sync)
+        ACE_OS::fsync(m_retryFile);
+
+    m_retrySize += record.size();
+
+    sLog.outError("SqlJournal: transaction of record " UI64FMTD " failed, kept in %s for replay at next start", sequence, m_retryFileName.c_str());
+}
+
+void SqlJournal::SetApplied(uint64 sequence)
+{
+    ACE_Guard<ACE_Thread_Mutex> guard(m_lock);
+
+    m_appliedSequence = sequence;
+
+    // reset journal only if nothing queued, else not applied records can be lost
+    if (sequence != m_lastSequence || m_size < SQL_JOURNAL_TRUNCATE_SIZE)
+        return;
+
+    ACE_OS::ftruncate(m_file, 0);
+    ACE_OS::lseek(m_file, 0, SEEK_SET);
+    m_size = 0;
+}
+
+uint32 SqlJournal::Checksum(uint8 const* data, size_t size)
+{
+    // FNV-1a
+    uint32 hash = 2166136261U;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+SqlOperation* SqlJournal::CreateSequenceUpdate(uint64 sequence) const
+{
+    char sql[64];
+    snprintf(sql, sizeof(sql), "UPDATE sql_journal SET sequence = " UI64FMTD, sequence);
+    return new SqlPlainRequest(sql);
+}
+
+template<typename T>
+static void ReadParam(ByteBuffer& data, SqlStmtParameters* params)
+{
+    T value;
+    data.read(reinterpret_cast<uint8*>(&value), sizeof(T));
+    params->addParam(SqlStmtFieldData(value));
+}
+
+SqlTransaction* SqlJournal::ReadRecord(Database& db, ByteBuffer& data)
+{
+    SqlTransaction* trans = new SqlTransaction();
+
+    try
+    {
+        uint32 count = data.read<uint32>();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            std::string sql;
+            switch (data.read<uint8>())
+            {
+                case SQL_OPERATION_PLAIN:
+                    data >> sql;
+                    trans->DelayExecute(new SqlPlainRequest(sql.c_str()));
+                    break;
+                case SQL_OPERATION_PREPARED:
+                {
+                    data >> sql;
+
+                    // statement indexes are different in every run
+                    SqlStatementID id;
+                    db.CreateStatement(id, sql.c_str());
+
+                    uint32 paramsCount = data.read<uint32>();
+                    SqlStmtParameters* params = new SqlStmtParameters(paramsCount);
+                    trans->DelayExecute(new SqlPreparedRequest(id.ID(), params));
+
+                    for (uint32 j = 0; j < paramsCount; ++j)
+                    {
+                        switch (data.read<uint8>())
+                        {
+                            case FIELD_BOOL:    ReadParam<bool>(data, params);   break;
+                            case FIELD_UI8:     ReadParam<uint8>(data, params);  break;
+                            case FIELD_UI16:    ReadParam<uint16>(data, params); break;
+                            case FIELD_UI32:    ReadParam<uint32>(data, params); break;
+                            case FIELD_UI64:    ReadParam<uint64>(data, params); break;
+                            case FIELD_I8:      ReadParam<int8>(data, params);   break;
+                            case FIELD_I16:     ReadParam<int16>(data, params);  break;
+                            case FIELD_I32:     ReadParam<int32>(data, params);  break;
+                            case FIELD_I64:     ReadParam<int64>(data, params);  break;
+                            case FIELD_FLOAT:   ReadParam<float>(data, params);  break;
+                            case FIELD_DOUBLE:  ReadParam<double>(data, params); break;
+                            case FIELD_STRING:
+                            {
+                                std::string str;
+                                data >> str;
+                                params->addParam(SqlStmtFieldData(str.c_str()));
+                                break;
+                            }
+                            default:
+                                delete trans;
+                                return NULL;
+                        }
+                    }
+                    break;
+                }
+                default:
+                    delete trans;
+                    return NULL;
+            }
+        }
+    }
+    catch (ByteBufferException&)
+    {
+        delete trans;
+        return NULL;
+    }
+
+    return trans;
+}
+
+bool SqlJournal::ReadFile(std::string const& fileName, std::vector<uint8>& content)
+{
+    FILE* f = fopen(fileName.c_str(), "rb");
+    if (!f)
+        return false;
+
+    uint8 buf[64 * 1024];
+    size_t readed;
+    while ((readed = fread(buf, 1, sizeof(buf), f)) > 0)
+        content.insert(content.end(), buf, buf + readed);
+    fclose(f);
+
+    return true;
+}
+
+void SqlJournal::ReplayRetry(std::vector<uint8> const& content, ByteBuffer& failed, std::set<uint64>& sequences)
+{
+    uint32 replayed = 0;
+
+    // written completely before rename, no partial records
+    size_t pos = 0;
+    while (pos + SQL_JOURNAL_HEADER_SIZE <= content.size())
+    {
+        uint32 size, checksum;
+        uint64 sequence;
+        memcpy(&size, &content[pos], sizeof(size));
+        memcpy(&checksum, &content[pos + 4], sizeof(checksum));
+        memcpy(&sequence, &content[pos + 8], sizeof(sequence));
+
+        uint8 const* record = &content[pos];
+        uint8 const* payload = record + SQL_JOURNAL_HEADER_SIZE;
+
+        if (content.size() - pos - SQL_JOURNAL_HEADER_SIZE < size || Checksum(payload, size) != checksum)
+        {
+            sLog.outError("SqlJournal: broken record at offset " SIZEFMTD " of retry file %s, rest of file ignored", pos, m_retryFileName.c_str());
+            break;
+        }
+
+        pos += SQL_JOURNAL_HEADER_SIZE + size;
+        sequences.insert(sequence);
+
+        ByteBuffer data(size);
+        data.append(payload, size);
+
+        // sequence of DB not changed, records after it may be applied already
+        SqlTransaction* trans = ReadRecord(m_db, data);
+        if (trans && trans->Execute(m_db.getAsyncConnection()))
+            ++replayed;
+        else
+        {
+            sLog.outError("SqlJournal: record " UI64FMTD " of retry file %s failed again, kept", sequence, m_retryFileName.c_str());
+            failed.append(record, SQL_JOURNAL_HEADER_SIZE + size);
+        }
+
+        delete trans;
+    }
+
+    sLog.outString("SqlJournal: %u failed records replayed from retry file %s", replayed, m_retryFileName.c_str());
+}
+
+uint64 SqlJournal::Replay(std::string const& fileName, uint64 applied, std::set<uint64> const& retried, ByteBuffer& failed)
+{
+    std::vector<uint8> content;
+    if (!ReadFile(fileName, content))                       // first start with journal
+        return applied;
+
+    uint64 lastSequence = applied;
+    uint32 replayed = 0;
+    uint32 unreadable = 0;
+
+    size_t pos = 0;
+    while (pos + SQL_JOURNAL_HEADER_SIZE <= content.size())
+    {
+        uint32 size, checksum;
+        uint64 sequence;
+        memcpy(&size, &content[pos], sizeof(size));
+        memcpy(&checksum, &content[pos + 4], sizeof(checksum));
+        memcpy(&sequence, &content[pos + 8], sizeof(sequence));
+
+        uint8 const* record = &content[pos];
+        uint8 const* payload = record + SQL_JOURNAL_HEADER_SIZE;
+
+        // record write not finished at crash
+        if (content.size() - pos - SQL_JOURNAL_HEADER_SIZE < size || Checksum(payload, size) != checksum)
+        {
+            sLog.outError("SqlJournal: incomplete record at offset " SIZEFMTD " of journal %s, rest of journal ignored", pos, fileName.c_str());
+            break;
+        }
+
+        pos += SQL_JOURNAL_HEADER_SIZE + size;
+
+        // executed before crash, or failed and replayed from retry file already
+        if (sequence <= lastSequence || retried.find(sequence) != retried.end())
+            continue;
+
+        ByteBuffer data(size);
+        data.append(payload, size);
+
+        if (SqlTransaction* trans = ReadRecord(m_db, data))
+        {
+            trans->DelayExecute(CreateSequenceUpdate(sequence));
+
+            if (trans->Execute(m_db.getAsyncConnection()))
+                ++replayed;
+            else
+            {
+                sLog.outError("SqlJournal: record " UI64FMTD " of journal %s failed, kept in %s", sequence, fileName.c_str(), m_retryFileName.c_str());
+                failed.append(record, SQL_JOURNAL_HEADER_SIZE + size);
+            }
+
+            delete trans;
+        }
+        else
+        {
+            sLog.outError("SqlJournal: record " UI64FMTD " of journal %s can't be read", sequence, fileName.c_str());
+            ++unreadable;
+        }
+
+        lastSequence = sequence;
+    }
+
+    sLog.outString("SqlJournal: %u records replayed from journal %s (last applied before: " UI64FMTD ")", replayed, fileName.c_str(), applied);
+
+    // keep for manual check, journal file itself recreated
+    if (unreadable)
+    {
+        std::string failedName = fileName + ".failed";
+        sLog.outError("SqlJournal: %u records of journal %s can't be read, journal copy kept as %s", unreadable, fileName.c_str(), failedName.c_str());
+        ACE_OS::unlink(failedName.c_str());
+        ACE_OS::rename(fileName.c_str(), failedName.c_str());
+    }
+
+    return lastSequence;
+}
+
+bool SqlJournalRecord::Execute(SqlConnection* conn)
+{
+    bool res = m_trans->Execute(conn);
+    if (!res)
+        m_journal.KeepFailed(m_sequence, m_offset, m_size);
+    m_journal.SetApplied(m_sequence);
+    return res;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SQLJOURNAL_H
+#define SQLJOURNAL_H
+
+#include "Common.h"
+#include "Database/SqlOperations.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#define SQL_JOURNAL_TRUNCATE_SIZE   (4 * 1024 * 1024)       // journal file reset at this size after all records applied
+
+class Database;
+class SqlDelayThread;
+
+namespace ACE_Based
+{
+    class Thread;
+}
+
+/**
+ * Write-behind journal of async DB writes.
+ *
+ * Every async write (transaction or single statement) is serialized and appended to the journal file
+ * before it is queued at the delay thread, in the queue order and with increasing sequence number. The
+ * queued transaction also updates `sql_journal`.`sequence` to its number, so the DB always knows the
+ * last applied record. With sync enabled own thread syncs the journal file to disk as soon as records
+ * are appended (one fsync for all records appended until then), independent of DB progress.
+ *
+ * A record whose transaction failed is copied to <journal>.retry file. At server start the records of
+ * retry file are executed again first, then records with sequence above the DB one (queued but not
+ * executed at crash) are replayed in order, then the journal starts empty. Records failed again are
+ * kept in retry file. The journal file is truncated when it is big enough and all its records are applied.
+ *
+ * Record: uint32 payload size, uint32 payload checksum, uint64 sequence, payload (serialized SqlTransaction)
+ */
+class SqlJournal
+{
+    public:
+        explicit SqlJournal(Database& db);
+        ~SqlJournal();
+
+        // replay not applied records of existing journal file and start new journal
+        bool Open(char const* fileName, bool sync);
+
+        // journal transaction and queue it at delay thread, false if transaction can't be journaled
+        bool Delay(SqlTransaction* trans, SqlDelayThread* thread);
+
+        // delay thread side, after executing record
+        void KeepFailed(uint64 sequence, uint64 offset, uint32 size);
+        void SetApplied(uint64 sequence);
+
+        // sync thread loop, ends at journal close after last sync
+        void SyncLoop();
+
+    private:
+        static uint32 Checksum(uint8 const* data, size_t size);
+
+        // read operations of one record, NULL for unexpected data
+        static SqlTransaction* ReadRecord(Database& db, ByteBuffer& data);
+
+        SqlOperation* CreateSequenceUpdate(uint64 sequence) const;
+
+        static bool ReadFile(std::string const& fileName, std::vector<uint8>& content);
+
+        // execute records of retry file, copy of failed ones added to failed
+        void ReplayRetry(std::vector<uint8> const& content, ByteBuffer& failed, std::set<uint64>& sequences);
+        // execute not applied records of journal file, copy of failed ones added to failed, return last sequence
+        uint64 Replay(std::string const& fileName, uint64 applied, std::set<uint64> const& retried, ByteBuffer& failed);
+
+        Database& m_db;
+        ACE_HANDLE m_file;
+        ACE_HANDLE m_retryFile;
+        std::string m_retryFileName;
+        uint64 m_retrySize;
+        bool m_sync;
+
+        ACE_Thread_Mutex m_lock;                            // append, truncate and sync state
+        ACE_Condition_Thread_Mutex m_appended;              // signaled at append and stop for sync thread
+        uint64 m_lastSequence;                              // last appended
+        uint64 m_appliedSequence;                           // last executed
+        uint64 m_syncedSequence;                            // last synced to disk
+        uint64 m_size;                                      // current file size
+
+        ACE_Based::Thread* m_syncThread;
+        bool m_stopSync;
+};
+
+// journaled transaction as queued at delay thread
+class SqlJournalRecord : public SqlOperation
+{
+    public:
+        SqlJournalRecord(SqlJournal& journal, SqlTransaction* trans, uint64 sequence, uint64 offset, uint32 size) :
+            m_journal(journal), m_trans(trans), m_sequence(sequence), m_offset(offset), m_size(size) {}
+        ~SqlJournalRecord() { delete m_trans; }
+
+        bool Execute(SqlConnection* conn);
+
+    private:
+        SqlJournal& m_journal;
+        SqlTransaction* m_trans;
+        uint64 m_sequence;
+        uint64 m_offset;                                    // position of record in journal file
+        uint32 m_size;                                      // payload size
+};
+
+#endif
@@ -20,6 +20,7 @@
 #include "SqlDelayThread.h"
 #include "DatabaseEnv.h"
 #include "DatabaseImpl.h"
+#include "ByteBuffer.h"
 
 #define LOCK_DB_CONN(conn) SqlConnection::Lock guard(conn)
 
@@ -32,6 +33,13 @@ bool SqlPlainRequest::Execute(SqlConnection *conn)
     return conn->Execute(m_sql);
 }
 
+bool SqlPlainRequest::Serialize(Database const& /*db*/, ByteBuffer& data) const
+{
+    data << uint8(SQL_OPERATION_PLAIN);
+    data << m_sql;
+    return true;
+}
+
 SqlTransaction::~SqlTransaction()
 {
     while(!m_queue.empty())
@@ -65,6 +73,17 @@ bool SqlTransaction::Execute(SqlConnection *conn)
     return conn->CommitTransaction();
 }
 
+bool SqlTransaction::Serialize(Database const& db, ByteBuffer& data) const
+{
+    data << uint32(m_queue.size());
+
+    for (size_t i = 0; i < m_queue.size(); ++i)
+        if (!m_queue[i]->Serialize(db, data))
+            return false;
+
+    return true;
+}
+
 SqlPreparedRequest::SqlPreparedRequest(int nIndex, SqlStmtParameters * arg ) : m_nIndex(nIndex), m_param(arg)
 {
 }
@@ -80,6 +99,27 @@ bool SqlPreparedRequest::Execute( SqlConnection *conn )
     return conn->ExecuteStmt(m_nIndex, *m_param);
 }
 
+bool SqlPreparedRequest::Serialize(Database const& db, ByteBuffer& data) const
+{
+    data << uint8(SQL_OPERATION_PREPARED);
+    data << db.GetStmtString(m_nIndex);
+
+    SqlStmtParameters::ParameterContainer const& params = m_param->params();
+    data << uint32(params.size());
+
+    for (SqlStmtParameters::ParameterContainer::const_iterator itr = params.begin(); itr != params.end(); ++itr)
+    {
+        data << uint8(itr->type());
+
+        if (itr->type() == FIELD_STRING)
+            data << itr->toStr();
+        else
+            data.append(static_cast<uint8 const*>(itr->buff()), itr->size());
+    }
+
+    return true;
+}
+
 /// ---- ASYNC QUERIES ----
 
 bool SqlQuery::Execute(SqlConnection *conn)
@@ -119,6 +159,28 @@ bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback * callback, SqlDelayThread *
     return true;
 }
 
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback * callback, std::vector<SqlDelayThread*> const& threads, SqlResultQueue *queue)
+{
+    if(!callback || threads.empty() || !queue)
+        return false;
+
+    size_t queries = 0;
+    for(size_t i = 0; i < m_queries.size(); ++i)
+        if(m_queries[i].first != NULL || m_stmtQueries[i].second != NULL)
+            ++queries;
+
+    size_t parts = std::min(threads.size(), queries);
+    if(parts <= 1)
+        return Execute(callback, threads[0], queue);
+
+    /// first query (usually main object data) in first part, so in front of its thread queue
+    SqlQueryHolderEx::PartsCounter* partsLeft = new SqlQueryHolderEx::PartsCounter(long(parts));
+    for(size_t part = 0; part < parts; ++part)
+        threads[part]->Delay(new SqlQueryHolderEx(this, callback, queue, part, parts, partsLeft));
+
+    return true;
+}
+
 bool SqlQueryHolder::SetQuery(size_t index, const char *sql)
 {
     if(m_queries.size() <= index)
@@ -127,10 +189,10 @@ bool SqlQueryHolder::SetQuery(size_t index, const char *sql)
         return false;
     }
 
-    if(m_queries[index].first != NULL)
+    if(m_queries[index].first != NULL || m_stmtQueries[index].second != NULL)
     {
         sLog.outError("Attempt assign query to holder index (" SIZEFMTD ") where other query stored (Old: [%s] New: [%s])",
-            index,m_queries[index].first,sql);
+            index,m_queries[index].first ? m_queries[index].first : "statement",sql);
         return false;
     }
 
@@ -162,6 +224,30 @@ bool SqlQueryHolder::SetPQuery(size_t index, const char *format, ...)
     return SetQuery(index,szQuery);
 }
 
+bool SqlQueryHolder::SetStmtQuery(size_t index, SqlStatement& stmt)
+{
+    SqlStmtParameters* params = stmt.detach();
+
+    if(m_queries.size() <= index || params->boundParams() != stmt.arguments())
+    {
+        sLog.outError("Query index (" SIZEFMTD ") out of range (size: " SIZEFMTD ") or wrong parameters for statement: %s",
+            index, m_queries.size(), stmt.m_pDB->GetStmtString(stmt.ID()).c_str());
+        delete params;
+        return false;
+    }
+
+    if(m_queries[index].first != NULL || m_stmtQueries[index].second != NULL)
+    {
+        sLog.outError("Attempt assign statement to holder index (" SIZEFMTD ") where other query stored (New: [%s])",
+            index, stmt.m_pDB->GetStmtString(stmt.ID()).c_str());
+        delete params;
+        return false;
+    }
+
+    m_stmtQueries[index] = SqlStmtQuery(stmt.ID(), params);
+    return true;
+}
+
 QueryResult* SqlQueryHolder::GetResult(size_t index)
 {
     if(index < m_queries.size())
@@ -172,6 +258,11 @@ QueryResult* SqlQueryHolder::GetResult(size_t index)
             delete [] (const_cast<char*>(m_queries[index].first));
             m_queries[index].first = NULL;
         }
+        if(m_stmtQueries[index].second != NULL)
+        {
+            delete m_stmtQueries[index].second;
+            m_stmtQueries[index].second = NULL;
+        }
         /// when you get a result aways remember to delete it!
         return m_queries[index].second;
     }
@@ -192,9 +283,10 @@ SqlQueryHolder::~SqlQueryHolder()
     {
         /// if the result was never used, free the resources
         /// results used already (getresult called) are expected to be deleted
-        if(m_queries[i].first != NULL)
+        if(m_queries[i].first != NULL || m_stmtQueries[i].second != NULL)
         {
             delete [] (const_cast<char*>(m_queries[i].first));
+            delete m_stmtQueries[i].second;
             if(m_queries[i].second)
                 delete m_queries[i].second;
         }
@@ -205,6 +297,15 @@ void SqlQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_stmtQueries.resize(size, SqlStmtQuery(-1, (SqlStmtParameters*)NULL));
+}
+
+bool SqlQueryHolderDispatch::Execute(SqlConnection * /*conn*/)
+{
+    if(!m_holder)
+        return false;
+
+    return m_holder->Execute(m_callback, m_threads, m_queue);
 }
 
 bool SqlQueryHolderEx::Execute(SqlConnection *conn)
@@ -212,16 +313,26 @@ bool SqlQueryHolderEx::Execute(SqlConnection *conn)
     if(!m_holder || !m_callback || !m_queue)
         return false;
 
-    LOCK_DB_CONN(conn);
-    /// we can do this, we are friends
-    std::vector<SqlQueryHolder::SqlResultPair> &queries = m_holder->m_queries;
-    for(size_t i = 0; i < queries.size(); i++)
     {
-        /// execute all queries in the holder and pass the results
-        char const *sql = queries[i].first;
-        if(sql) m_holder->SetResult(i, conn->Query(sql));
+        LOCK_DB_CONN(conn);
+        /// we can do this, we are friends
+        std::vector<SqlQueryHolder::SqlResultPair> &queries = m_holder->m_queries;
+        for(size_t i = m_part; i < queries.size(); i += m_parts)
+        {
+            /// execute all queries of this part and pass the results
+            char const *sql = queries[i].first;
+            if(sql) m_holder->SetResult(i, conn->Query(sql));
+            else if(SqlStmtParameters* params = m_holder->m_stmtQueries[i].second)
+                m_holder->SetResult(i, conn->QueryStmt(m_holder->m_stmtQueries[i].first, *params));
+        }
     }
 
+    /// other parts still running
+    if(m_partsLeft && --(*m_partsLeft) > 0)
+        return true;
+
+    delete m_partsLeft;
+
     /// sync with the caller thread
     m_queue->add(m_callback);
 
@@ -22,6 +22,7 @@
 #include "Common.h"
 
 #include "ace/Thread_Mutex.h"
+#include "ace/Atomic_Op.h"
 #include "LockedQueue.h"
 #include <queue>
 #include "Utilities/Callback.h"
@@ -32,12 +33,22 @@ class Database;
 class SqlConnection;
 class SqlDelayThread;
 class SqlStmtParameters;
+class SqlStatement;
+class ByteBuffer;
+
+enum SqlOperationType                                       // serialized operation type
+{
+    SQL_OPERATION_PLAIN         = 0,
+    SQL_OPERATION_PREPARED      = 1,
+};
 
 class SqlOperation
 {
     public:
         virtual void OnRemove() { delete this; }
         virtual bool Execute(SqlConnection *conn) = 0;
+        // write operation data for replay by SqlJournal, false if operation can't be replayed
+        virtual bool Serialize(Database const& /*db*/, ByteBuffer& /*data*/) const { return false; }
         virtual ~SqlOperation() {}
 };
 
@@ -51,6 +62,7 @@ class SqlPlainRequest : public SqlOperation
         SqlPlainRequest(const char *sql) : m_sql(mangos_strdup(sql)){}
         ~SqlPlainRequest() { char* tofree = const_cast<char*>(m_sql); delete [] tofree; }
         bool Execute(SqlConnection *conn);
+        bool Serialize(Database const& db, ByteBuffer& data) const;
 };
 
 class SqlTransaction : public SqlOperation
@@ -65,6 +77,7 @@ class SqlTransaction : public SqlOperation
         void DelayExecute(SqlOperation * sql)   {   m_queue.push_back(sql); }
 
         bool Execute(SqlConnection *conn);
+        bool Serialize(Database const& db, ByteBuffer& data) const;
 };
 
 class SqlPreparedRequest : public SqlOperation
@@ -74,6 +87,7 @@ class SqlPreparedRequest : public SqlOperation
         ~SqlPreparedRequest();
 
         bool Execute(SqlConnection *conn);
+        bool Serialize(Database const& db, ByteBuffer& data) const;
 
     private:
         const int m_nIndex;
@@ -114,26 +128,54 @@ class SqlQueryHolder
     private:
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
+        typedef std::pair<int, SqlStmtParameters*> SqlStmtQuery;    // statement index and bound parameters
+        std::vector<SqlStmtQuery> m_stmtQueries;
     public:
         SqlQueryHolder() {}
         ~SqlQueryHolder();
         bool SetQuery(size_t index, const char *sql);
         bool SetPQuery(size_t index, const char *format, ...) ATTR_PRINTF(3,4);
+        // prepared statement query with bound parameters, executed by binary protocol where supported
+        bool SetStmtQuery(size_t index, SqlStatement& stmt);
         void SetSize(size_t size);
         QueryResult* GetResult(size_t index);
         void SetResult(size_t index, QueryResult *result);
         bool Execute(MaNGOS::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue);
+        // split queries between threads, each with own connection
+        bool Execute(MaNGOS::IQueryCallback * callback, std::vector<SqlDelayThread*> const& threads, SqlResultQueue *queue);
+};
+
+/// passes holder queries to holder threads, queued at delay thread to not read data before its pending updates
+class SqlQueryHolderDispatch : public SqlOperation
+{
+    private:
+        SqlQueryHolder * m_holder;
+        MaNGOS::IQueryCallback * m_callback;
+        std::vector<SqlDelayThread*> m_threads;
+        SqlResultQueue * m_queue;
+    public:
+        SqlQueryHolderDispatch(SqlQueryHolder *holder, MaNGOS::IQueryCallback * callback, std::vector<SqlDelayThread*> const& threads, SqlResultQueue * queue)
+            : m_holder(holder), m_callback(callback), m_threads(threads), m_queue(queue) {}
+        bool Execute(SqlConnection *conn);
 };
 
+/// parts of one holder executed in parallel on different connections, last finished part calls back
 class SqlQueryHolderEx : public SqlOperation
 {
+    public:
+        typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> PartsCounter;
+
     private:
         SqlQueryHolder * m_holder;
         MaNGOS::IQueryCallback * m_callback;
         SqlResultQueue * m_queue;
+        size_t m_part;                                      // executes queries m_part, m_part + m_parts, ...
+        size_t m_parts;
+        PartsCounter * m_partsLeft;                         // shared by all parts, NULL for single part
     public:
-        SqlQueryHolderEx(SqlQueryHolder *holder, MaNGOS::IQueryCallback * callback, SqlResultQueue * queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+        SqlQueryHolderEx(SqlQueryHolder *holder, MaNGOS::IQueryCallback * callback, SqlResultQueue * queue,
+            size_t part = 0, size_t parts = 1, PartsCounter * partsLeft = NULL)
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_part(part), m_parts(parts), m_partsLeft(partsLeft) {}
         bool Execute(SqlConnection *conn);
 };
 #endif                                                      //__SQLOPERATIONS_H
@@ -207,6 +207,9 @@ class MANGOS_DLL_SPEC SqlStatement
         bool Execute();
         bool DirectExecute();
 
+        //sync query, MySQL results are fetched by binary protocol - fields hold native values
+        QueryResult* Query();
+
         //templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
         bool PExecute(ParamType1 param1)
@@ -242,6 +245,21 @@ class MANGOS_DLL_SPEC SqlStatement
             return Execute();
         }
 
+        template<typename ParamType1>
+        QueryResult* PQuery(ParamType1 param1)
+        {
+            arg(param1);
+            return Query();
+        }
+
+        template<typename ParamType1, typename ParamType2>
+        QueryResult* PQuery(ParamType1 param1, ParamType2 param2)
+        {
+            arg(param1);
+            arg(param2);
+            return Query();
+        }
+
         //bind parameters with specified type
         void addBool(bool var) { arg(var); }
         void addUInt8(uint8 var) { arg(var); }
@@ -261,6 +279,7 @@ class MANGOS_DLL_SPEC SqlStatement
     protected:
         //don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        friend class SqlQueryHolder;
         SqlStatement(const SqlStatementID& index, Database& db) : m_index(index), m_pDB(&db), m_pParams(NULL) {}
 
     private:
@@ -314,6 +333,8 @@ class MANGOS_DLL_SPEC SqlPreparedStatement
 
         //execute statement w/o result set
         virtual bool execute() = 0;
+        //execute query statement, NULL for empty result
+        virtual QueryResult* query() = 0;
 
     protected:
         SqlPreparedStatement(const std::string& fmt, SqlConnection& conn):
@@ -341,6 +362,7 @@ class MANGOS_DLL_SPEC SqlPlainPreparedStatement : public SqlPreparedStatement
         virtual void bind(const SqlStmtParameters& holder);
 
         virtual bool execute();
+        virtual QueryResult* query();
 
     protected:
         void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt);
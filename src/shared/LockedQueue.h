@@ -129,6 +129,13 @@ namespace ACE_Based
                 ACE_Guard<LockType> g(this->_lock);
                 return _queue.empty();
             }
+
+            ///! Number of queued items with locks held
+            size_t size()
+            {
+                ACE_Guard<LockType> g(this->_lock);
+                return _queue.size();
+            }
     };
 }
 #endif
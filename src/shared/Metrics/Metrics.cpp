@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "Metrics/Metrics.h"
+
+#include <ace/TSS_T.h>
+
+INSTANTIATE_SINGLETON_1(MetricsRegistry);
+
+namespace
+{
+    ACE_Atomic_Op<ACE_Thread_Mutex, long> s_nextShard(0);
+
+    struct MetricShardIndex
+    {
+        MetricShardIndex() : index(uint32(s_nextShard++) & (METRIC_SHARDS - 1)) {}
+
+        uint32 index;
+    };
+
+    typedef ACE_TSS<MetricShardIndex> MetricShardIndexTSS;
+    MetricShardIndexTSS s_shardIndex;
+
+    void AppendSample(std::string& out, std::string const& name, char const* suffix, std::string const& labels, char const* extraLabels, char const* value)
+    {
+        out += name;
+        out += suffix;
+
+        if (!labels.empty() || *extraLabels)
+        {
+            out += '{';
+            out += labels;
+            if (!labels.empty() && *extraLabels)
+                out += ',';
+            out += extraLabels;
+            out += '}';
+        }
+
+        out += ' ';
+        out += value;
+        out += '\n';
+    }
+
+    void AppendSample(std::string& out, std::string const& name, char const* suffix, std::string const& labels, char const* extraLabels, uint64 value)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), UI64FMTD, value);
+        AppendSample(out, name, suffix, labels, extraLabels, buf);
+    }
+}
+
+uint32 GetMetricShard()
+{
+    return s_shardIndex->index;
+}
+
+uint64 MetricCounter::GetValue() const
+{
+    uint64 value = 0;
+    for (uint32 i = 0; i < METRIC_SHARDS; ++i)
+        value += uint64(m_shards[i].value.value());
+
+    return value;
+}
+
+MetricHistogram::MetricHistogram(uint32 const* bounds, uint32 boundsCount) : m_bounds(bounds, bounds + boundsCount)
+{
+    // per shard: bucket counts, overflow bucket and sum
+    uint32 const perLine = METRIC_CACHE_LINE / sizeof(MetricValue);
+    m_shardStride = (boundsCount + 2 + perLine - 1) / perLine * perLine;
+    m_values = new MetricValue[m_shardStride * METRIC_SHARDS];
+}
+
+MetricHistogram::~MetricHistogram()
+{
+    delete[] m_values;
+}
+
+void MetricHistogram::GetCounts(std::vector<uint64>& counts, uint64& sum) const
+{
+    counts.assign(m_bounds.size() + 1, 0);
+    sum = 0;
+
+    for (uint32 shard = 0; shard < METRIC_SHARDS; ++shard)
+    {
+        MetricValue const* values = &m_values[shard * m_shardStride];
+        for (uint32 i = 0; i < counts.size(); ++i)
+            counts[i] += uint64(values[i].value());
+        sum += uint64(values[m_bounds.size() + 1].value());
+    }
+}
+
+MetricCounterArray::MetricCounterArray(uint32 size, char const* labelName, LabelFunc labelFunc) :
+    m_size(size), m_labelName(labelName), m_labelFunc(labelFunc)
+{
+    m_values = new MetricValue[size * METRIC_SHARDS];
+}
+
+MetricCounterArray::~MetricCounterArray()
+{
+    delete[] m_values;
+}
+
+uint64 MetricCounterArray::GetValue(uint32 index) const
+{
+    if (index >= m_size)
+        return 0;
+
+    uint64 value = 0;
+    for (uint32 shard = 0; shard < METRIC_SHARDS; ++shard)
+        value += uint64(m_values[shard * m_size + index].value());
+
+    return value;
+}
+
+MetricsRegistry::MetricsRegistry()
+{
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    for (FamilyMap::const_iterator itr = m_families.begin(); itr != m_families.end(); ++itr)
+    {
+        for (std::vector<Metric>::const_iterator mItr = itr->second.metrics.begin(); mItr != itr->second.metrics.end(); ++mItr)
+        {
+            switch (itr->second.type)
+            {
+                case METRIC_TYPE_COUNTER:       delete (MetricCounter*)mItr->metric;      break;
+                case METRIC_TYPE_GAUGE:         delete (MetricGauge*)mItr->metric;        break;
+                case METRIC_TYPE_HISTOGRAM:     delete (MetricHistogram*)mItr->metric;    break;
+                case METRIC_TYPE_COUNTER_ARRAY: delete (MetricCounterArray*)mItr->metric; break;
+            }
+        }
+    }
+}
+
+void* MetricsRegistry::Find(char const* name, MetricType type, char const* labels)
+{
+    FamilyMap::const_iterator itr = m_families.find(name);
+    if (itr == m_families.end())
+        return NULL;
+
+    MANGOS_ASSERT(itr->second.type == type);
+
+    for (std::vector<Metric>::const_iterator mItr = itr->second.metrics.begin(); mItr != itr->second.metrics.end(); ++mItr)
+        if (mItr->labels == labels)
+            return mItr->metric;
+
+    return NULL;
+}
+
+void MetricsRegistry::Insert(char const* name, char const* help, MetricType type, char const* labels, void* metric)
+{
+    Family& family = m_families[name];
+    if (family.metrics.empty())
+    {
+        family.type = type;
+        family.help = help;
+    }
+
+    Metric entry;
+    entry.labels = labels;
+    entry.metric = metric;
+    family.metrics.push_back(entry);
+}
+
+MetricCounter* MetricsRegistry::AddCounter(char const* name, char const* help, char const* labels /*= ""*/)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, NULL);
+
+    if (void* metric = Find(name, METRIC_TYPE_COUNTER, labels))
+        return (MetricCounter*)metric;
+
+    MetricCounter* counter = new MetricCounter;
+    Insert(name, help, METRIC_TYPE_COUNTER, labels, counter);
+    return counter;
+}
+
+MetricGauge* MetricsRegistry::AddGauge(char const* name, char const* help, char const* labels /*= ""*/)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, NULL);
+
+    if (void* metric = Find(name, METRIC_TYPE_GAUGE, labels))
+        return (MetricGauge*)metric;
+
+    MetricGauge* gauge = new MetricGauge;
+    Insert(name, help, METRIC_TYPE_GAUGE, labels, gauge);
+    return gauge;
+}
+
+MetricHistogram* MetricsRegistry::AddHistogram(char const* name, char const* help, uint32 const* bounds, uint32 boundsCount, char const* labels /*= ""*/)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, NULL);
+
+    if (void* metric = Find(name, METRIC_TYPE_HISTOGRAM, labels))
+        return (MetricHistogram*)metric;
+
+    MetricHistogram* histogram = new MetricHistogram(bounds, boundsCount);
+    Insert(name, help, METRIC_TYPE_HISTOGRAM, labels, histogram);
+    return histogram;
+}
+
+MetricCounterArray* MetricsRegistry::AddCounterArray(char const* name, char const* help, uint32 size, char const* labelName, MetricCounterArray::LabelFunc labelFunc,
+    char const* labels /*= ""*/)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, NULL);
+
+    if (void* metric = Find(name, METRIC_TYPE_COUNTER_ARRAY, labels))
+        return (MetricCounterArray*)metric;
+
+    MetricCounterArray* counters = new MetricCounterArray(size, labelName, labelFunc);
+    Insert(name, help, METRIC_TYPE_COUNTER_ARRAY, labels, counters);
+    return counters;
+}
+
+std::string MetricsRegistry::Export()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, std::string());
+
+    std::string out;
+    out.reserve(64 * 1024);
+
+    char buf[128];
+    std::vector<uint64> counts;
+
+    for (FamilyMap::const_iterator itr = m_families.begin(); itr != m_families.end(); ++itr)
+    {
+        std::string const& name = itr->first;
+        Family const& family = itr->second;
+
+        char const* typeName = "counter";
+        if (family.type == METRIC_TYPE_GAUGE)
+            typeName = "gauge";
+        else if (family.type == METRIC_TYPE_HISTOGRAM)
+            typeName = "histogram";
+
+        out += "# HELP " + name + " " + family.help + "\n";
+        out += "# TYPE " + name + " " + typeName + "\n";
+
+        for (std::vector<Metric>::const_iterator mItr = family.metrics.begin(); mItr != family.metrics.end(); ++mItr)
+        {
+            switch (family.type)
+            {
+                case METRIC_TYPE_COUNTER:
+                    AppendSample(out, name, "", mItr->labels, "", ((MetricCounter const*)mItr->metric)->GetValue());
+                    break;
+                case METRIC_TYPE_GAUGE:
+                    snprintf(buf, sizeof(buf), SI64FMTD, ((MetricGauge const*)mItr->metric)->GetValue());
+                    AppendSample(out, name, "", mItr->labels, "", buf);
+                    break;
+                case METRIC_TYPE_HISTOGRAM:
+                {
+                    MetricHistogram const* histogram = (MetricHistogram const*)mItr->metric;
+                    uint64 sum;
+                    histogram->GetCounts(counts, sum);
+
+                    uint64 total = 0;
+                    for (uint32 i = 0; i < counts.size(); ++i)
+                    {
+                        total += counts[i];
+                        if (i < histogram->GetBounds().size())
+                            snprintf(buf, sizeof(buf), "le=\"%u\"", histogram->GetBounds()[i]);
+                        else
+                            snprintf(buf, sizeof(buf), "le=\"+Inf\"");
+                        AppendSample(out, name, "_bucket", mItr->labels, buf, total);
+                    }
+
+                    AppendSample(out, name, "_sum", mItr->labels, "", sum);
+                    AppendSample(out, name, "_count", mItr->labels, "", total);
+                    break;
+                }
+                case METRIC_TYPE_COUNTER_ARRAY:
+                {
+                    MetricCounterArray const* counters = (MetricCounterArray const*)mItr->metric;
+                    for (uint32 i = 0; i < counters->GetSize(); ++i)
+                    {
+                        if (uint64 value = counters->GetValue(i))
+                        {
+                            snprintf(buf, sizeof(buf), "%s=\"%s\"", counters->GetLabelName(), counters->GetLabel(i));
+                            AppendSample(out, name, "", mItr->labels, buf, value);
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    return out;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MANGOS_METRICS_H
+#define MANGOS_METRICS_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+
+#include <map>
+#include <vector>
+
+#define METRIC_SHARDS           16                          // power of 2
+#define METRIC_CACHE_LINE       64
+
+/// 64-bit atomic value, ACE_Atomic_Op is lock-free only for long, which is 32-bit on Windows
+class MetricValue
+{
+    public:
+        MetricValue() : m_value(0) {}
+
+#if COMPILER == COMPILER_MICROSOFT
+        void Add(int64 value) { InterlockedExchangeAdd64(&m_value, value); }
+        void Set(int64 value) { InterlockedExchange64(&m_value, value); }
+        int64 value() const { return InterlockedCompareExchange64(const_cast<LONGLONG volatile*>(&m_value), 0, 0); }
+
+    private:
+        LONGLONG volatile m_value;
+#else
+        void Add(int64 value) { __sync_fetch_and_add(&m_value, value); }
+        void Set(int64 value)
+        {
+            int64 old = m_value;
+            while (!__sync_bool_compare_and_swap(&m_value, old, value))
+                old = m_value;
+        }
+        int64 value() const { return __sync_fetch_and_add(const_cast<int64 volatile*>(&m_value), 0); }
+
+    private:
+        int64 volatile m_value;
+#endif
+
+        MetricValue(MetricValue const&);
+        MetricValue& operator=(MetricValue const&);
+};
+
+// shard of current thread, threads get shards in order of first metric use
+uint32 GetMetricShard();
+
+/// Monotonic counter, sharded by threads so hot paths of different threads not share cache lines
+class MANGOS_DLL_SPEC MetricCounter
+{
+    public:
+        MetricCounter() {}
+
+        void Inc(uint64 value = 1) { m_shards[GetMetricShard()].value.Add(int64(value)); }
+        uint64 GetValue() const;
+
+    private:
+        struct Shard
+        {
+            Shard() {}
+
+            MetricValue value;
+            char pad[METRIC_CACHE_LINE - sizeof(MetricValue)];
+        };
+
+        Shard m_shards[METRIC_SHARDS];
+};
+
+/// Current value, expected to be set by one owner
+class MANGOS_DLL_SPEC MetricGauge
+{
+    public:
+        MetricGauge() {}
+
+        void Set(int64 value) { m_value.Set(value); }
+        void Add(int64 value) { m_value.Add(value); }
+        int64 GetValue() const { return m_value.value(); }
+
+    private:
+        MetricValue m_value;
+};
+
+/// Distribution of integer observations in buckets with upper bounds, sharded as counter
+class MANGOS_DLL_SPEC MetricHistogram
+{
+    public:
+        MetricHistogram(uint32 const* bounds, uint32 boundsCount);
+        ~MetricHistogram();
+
+        void Observe(uint64 value)
+        {
+            uint32 bucket = 0;
+            while (bucket < m_bounds.size() && value > m_bounds[bucket])
+                ++bucket;
+
+            MetricValue* shard = &m_values[GetMetricShard() * m_shardStride];
+            shard[bucket].Add(1);
+            shard[m_bounds.size() + 1].Add(int64(value));
+        }
+
+        std::vector<uint32> const& GetBounds() const { return m_bounds; }
+        // not cumulative counts per bucket, last is count over last bound
+        void GetCounts(std::vector<uint64>& counts, uint64& sum) const;
+
+    private:
+        std::vector<uint32> m_bounds;
+        uint32 m_shardStride;                               // bucket counts and sum, aligned to cache line
+        MetricValue* m_values;
+};
+
+/// Counters for small index space (opcodes), label value of index provided by function, sharded as counter
+class MANGOS_DLL_SPEC MetricCounterArray
+{
+    public:
+        typedef char const* (*LabelFunc)(uint32 index);
+
+        MetricCounterArray(uint32 size, char const* labelName, LabelFunc labelFunc);
+        ~MetricCounterArray();
+
+        void Inc(uint32 index, uint64 value = 1) { if (index < m_size) m_values[GetMetricShard() * m_size + index].Add(int64(value)); }
+        uint64 GetValue(uint32 index) const;
+
+        uint32 GetSize() const { return m_size; }
+        char const* GetLabelName() const { return m_labelName.c_str(); }
+        char const* GetLabel(uint32 index) const { return m_labelFunc(index); }
+
+    private:
+        uint32 m_size;
+        MetricValue* m_values;                              // shard-major, threads write separate ranges
+        std::string m_labelName;
+        LabelFunc m_labelFunc;
+};
+
+/**
+ * Registry of process metrics, exported in Prometheus text format by MetricsSocket.
+ *
+ * Metrics are created once (usually at startup) and never removed, so returned pointers can be kept
+ * and updated without registry lock. Metrics with same name and different labels form one family,
+ * labels are given as preformatted text: key="value",key2="value2".
+ */
+class MANGOS_DLL_SPEC MetricsRegistry
+{
+    public:
+        MetricsRegistry();
+        ~MetricsRegistry();
+
+        MetricCounter* AddCounter(char const* name, char const* help, char const* labels = "");
+        MetricGauge* AddGauge(char const* name, char const* help, char const* labels = "");
+        MetricHistogram* AddHistogram(char const* name, char const* help, uint32 const* bounds, uint32 boundsCount, char const* labels = "");
+        MetricCounterArray* AddCounterArray(char const* name, char const* help, uint32 size, char const* labelName, MetricCounterArray::LabelFunc labelFunc,
+            char const* labels = "");
+
+        // text exposition of all metrics, callable from any thread
+        std::string Export();
+
+    private:
+        enum MetricType
+        {
+            METRIC_TYPE_COUNTER,
+            METRIC_TYPE_GAUGE,
+            METRIC_TYPE_HISTOGRAM,
+            METRIC_TYPE_COUNTER_ARRAY
+        };
+
+        struct Metric
+        {
+            std::string labels;
+            void* metric;
+        };
+
+        struct Family
+        {
+            MetricType type;
+            std::string help;
+            std::vector<Metric> metrics;
+        };
+
+        typedef std::map<std::string, Family> FamilyMap;
+
+        void* Find(char const* name, MetricType type, char const* labels);
+        void Insert(char const* name, char const* help, MetricType type, char const* labels, void* metric);
+
+        ACE_Thread_Mutex m_lock;
+        FamilyMap m_families;
+};
+
+#define sMetrics MaNGOS::Singleton<MetricsRegistry>::Instance()
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "Metrics/MetricsSocket.h"
+#include "Metrics/Metrics.h"
+
+MetricsSocket::MetricsSocket() : MetricsHandler(), m_requestLen(0)
+{
+}
+
+int MetricsSocket::handle_input(ACE_HANDLE)
+{
+    ssize_t readBytes = peer().recv(m_request + m_requestLen, METRICS_REQUEST_SIZE - m_requestLen - 1);
+    if (readBytes <= 0)
+    {
+        if (readBytes < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
+            return 0;
+
+        return -1;                                          // closed by peer or error
+    }
+
+    m_requestLen += readBytes;
+    m_request[m_requestLen] = '\0';
+
+    // wait for full request head
+    if (!strstr(m_request, "\r\n\r\n") && !strstr(m_request, "\n\n"))
+    {
+        if (m_requestLen + 1 >= METRICS_REQUEST_SIZE)
+        {
+            SendResponse("413 Request Entity Too Large", "");
+            return -1;
+        }
+
+        return 0;
+    }
+
+    if (strncmp(m_request, "GET /metrics ", 13) == 0 || strncmp(m_request, "GET /metrics?", 13) == 0)
+        SendResponse("200 OK", sMetrics.Export());
+    else
+        SendResponse("404 Not Found", "");
+
+    return -1;                                              // one response per connection
+}
+
+void MetricsSocket::SendResponse(char const* status, std::string const& body)
+{
+    char head[256];
+    int headLen = snprintf(head, sizeof(head),
+                           "HTTP/1.0 %s\r\n"
+                           "Content-Type: text/plain; version=0.0.4\r\n"
+                           "Content-Length: " SIZEFMTD "\r\n"
+                           "Connection: close\r\n"
+                           "\r\n", status, body.size());
+
+    if (peer().send_n(head, headLen) != headLen)
+        return;
+
+    if (!body.empty())
+        peer().send_n(body.c_str(), body.size());
+}
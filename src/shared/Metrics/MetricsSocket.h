@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2005-2012 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MANGOS_METRICSSOCKET_H
+#define MANGOS_METRICSSOCKET_H
+
+#include "Common.h"
+
+#include <ace/Synch_Traits.h>
+#include <ace/Svc_Handler.h>
+#include <ace/SOCK_Acceptor.h>
+#include <ace/SOCK_Stream.h>
+#include <ace/Acceptor.h>
+
+#define METRICS_REQUEST_SIZE    2048
+
+typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> MetricsHandler;
+
+/**
+ * Minimal HTTP/1.0 responder for metrics scraping.
+ *
+ * Reads request head, answers "GET /metrics" with MetricsRegistry text export and closes connection.
+ * Runs in thread of reactor the acceptor was opened on, so the reactor must not serve latency sensitive sockets
+ * (mangosd uses own metrics network thread). Listener is expected to be bound to local address only.
+ */
+class MetricsSocket : public MetricsHandler
+{
+    public:
+        typedef ACE_Acceptor<MetricsSocket, ACE_SOCK_ACCEPTOR> Acceptor;
+
+        MetricsSocket();
+
+        /// Called when we can read from the socket.
+        virtual int handle_input(ACE_HANDLE = ACE_INVALID_HANDLE) override;
+
+    private:
+        void SendResponse(char const* status, std::string const& body);
+
+        char m_request[METRICS_REQUEST_SIZE];
+        size_t m_requestLen;
+};
+
+#endif
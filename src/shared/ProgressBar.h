@@ -32,6 +32,7 @@ class MANGOS_DLL_SPEC BarGoLink
         void step();
 
         static void SetOutputState(bool on);
+        static bool GetOutputState() { return m_showOutput; }
     private:
         void init(int row_count);
 